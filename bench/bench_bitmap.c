@@ -0,0 +1,102 @@
+/**
+ * @file bench_bitmap.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Benchmark del dibujo de mapas de bits contra la copia pixel por pixel
+ *
+ * Copia un icono de 32x32 con sh1106_DrawBitmap, alineado a una pagina y desplazado dentro de la
+ * pagina, y lo compara con la misma copia hecha con sh1106_DevDrawPixel.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include <stdio.h>
+#include <time.h>
+#include "sh1106.h"
+#include "sh1106_bitmap.h"
+
+/* === Private variable declarations =========================================================== */
+static sh1106_t display;
+static uint8_t buffer[BUFFER_SIZE];
+static uint8_t icon_data[4 * 32], icon_mask[4 * 32];
+static sh1106_bitmap_t icon = {.data = icon_data, .width = 32, .height = 32};
+static sh1106_bitmap_t sprite = {.data = icon_data, .mask = icon_mask, .width = 32, .height = 32};
+
+/* === Private function declarations =========================================================== */
+/**
+ * @brief Tiempo monotono en nanosegundos.
+ */
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void pixel_copy(int x, int y) {
+    for (int i = 0; i < icon.width; i++) {
+        for (int j = 0; j < icon.height; j++) {
+            bool set = icon_data[(j / 8) * icon.width + i] & (1 << (j % 8));
+            sh1106_DevDrawPixel(&display, x + i, y + j, set ? WHITE : BLACK);
+        }
+    }
+}
+
+static void copy_aligned(void) {
+    sh1106_DrawBitmap(&display, &icon, 40, 16, SH1106_ROP_COPY);
+}
+
+static void pixel_copy_aligned(void) {
+    pixel_copy(40, 16);
+}
+
+static void copy_unaligned(void) {
+    sh1106_DrawBitmap(&display, &icon, 40, 19, SH1106_ROP_COPY);
+}
+
+static void pixel_copy_unaligned(void) {
+    pixel_copy(40, 19);
+}
+
+static void xor_sprite(void) {
+    sh1106_DrawBitmap(&display, &sprite, 40, 19, SH1106_ROP_XOR);
+}
+
+/**
+ * @brief Ejecuta una operacion la cantidad de veces indicada y devuelve los ns por operacion.
+ */
+static double measure(void (*operation)(void), long iterations) {
+    double start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        operation();
+    }
+    return (now_ns() - start) / iterations;
+}
+
+static void compare(const char * name, void (*fast)(void), void (*slow)(void), long iterations) {
+    double fast_ns = measure(fast, iterations);
+    double slow_ns = measure(slow, iterations);
+    printf("%-16s %10.1f ns/op   pixel a pixel %10.1f ns/op   x%.1f\n", name, fast_ns, slow_ns,
+           slow_ns / fast_ns);
+}
+
+/* === Public function declarations ============================================================ */
+int main(void) {
+    sh1106_config_t config = {.buffer = buffer,
+                              .width = SH1106_WHIDTH,
+                              .height = SH1106_HEIGHT,
+                              .column_offset = SH1106_COLUMN_OFFSET,
+                              .transport = &sh1106_i2c_transport};
+    sh1106_DevCreate(&display, &config);
+    for (unsigned i = 0; i < sizeof(icon_data); i++) {
+        icon_data[i] = i * 37 + 11;
+        icon_mask[i] = ~(i * 13);
+    }
+
+    compare("Copy 32x32", copy_aligned, pixel_copy_aligned, 100000);
+    compare("Copy 32x32 y+3", copy_unaligned, pixel_copy_unaligned, 100000);
+    printf("%-16s %10.1f ns/op\n", "XOR sprite y+3", measure(xor_sprite, 100000));
+    return 0;
+}
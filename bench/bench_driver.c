@@ -0,0 +1,439 @@
+/**
+ * @file bench_driver.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Benchmark de todas las operaciones del driver, con tiempo de CPU y costo estimado del bus
+ *
+ * Cada operacion se ejecuta sobre la HAL de prueba, que no envia nada pero registra las
+ * transacciones y los bytes. Por cada operacion se reporta:
+ *
+ * <ul>
+ *   <li>ns/op: tiempo de CPU del driver en la PC, sirve para comparar versiones del driver.</li>
+ *   <li>tr/op y B/op: transacciones y bytes por operacion. Son deterministas, por lo que
+ * cualquier cambio es una diferencia real en lo que se envia.</li>
+ *   <li>us/op: tiempo que ocuparia ese trafico en cada bus de bus_model.h.</li>
+ * </ul>
+ *
+ * Las operaciones con prefijo SPI usan un display con sh1106_spi_transport, cuyo trafico ya no
+ * tiene bytes de control, y las de prefijo Gather uno con sh1106_i2c_gather_transport, que no copia
+ * los datos. Las de prefijo Shadow usan un display I2C con sombra de la DDRAM. Las demas usan el
+ * display por defecto por I2C; las de prefijo Widget dibujan con una pantalla de widgets. Las de
+ * prefijo Rotate90 usan el display Gather girado un cuarto de vuelta (sin SH1106_PANEL), y las de
+ * prefijo Gray un display I2C en escala de grises de 2 bits. Con SH1106_STRIP las de prefijo Strip
+ * usan un display I2C en modo tira.
+ *
+ * Uso: bench_driver [--json] [--bus i2c:400000] [--bus spi:8000000] ...
+ *
+ * Con --json se escribe un objeto JSON por linea, para compararlo con bench/compare.py. Sin --bus
+ * se usan I2C a 100 kHz, 400 kHz y 1 MHz y SPI a 8 MHz.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "sh1106.h"
+#include "sh1106_gfx.h"
+#include "sh1106_font.h"
+#include "sh1106_font_5x7.h"
+#include "sh1106_bitmap.h"
+#include "sh1106_gather.h"
+#include "sh1106_spi.h"
+#include "sh1106_widget.h"
+#include "sh1106_gray.h"
+#include "fake_hal.h"
+#include "bus_model.h"
+
+/* === Private macros definitions ============================================================== */
+#define MAX_BUSES (8)
+
+/* === Private data type declarations ========================================================== */
+/**
+ * @brief Operacion medida. setup se ejecuta antes de cada iteracion y no se mide.
+ */
+typedef struct {
+    const char * name;
+    void (*setup)(void);
+    void (*run)(unsigned i);
+    unsigned iterations;
+} operation_t;
+
+/* === Private variable declarations =========================================================== */
+static uint8_t icon_data[4 * 32];
+static const sh1106_bitmap_t icon = {.data = icon_data, .width = 32, .height = 32};
+
+static sh1106_t spi_display, gather_display;
+static uint8_t spi_buffer[BUFFER_SIZE], spi_front[BUFFER_SIZE];
+static uint8_t gather_buffer[BUFFER_SIZE], gather_front[BUFFER_SIZE];
+static sh1106_t shadow_display;
+static uint8_t shadow_buffer[BUFFER_SIZE], shadow_ddram[BUFFER_SIZE];
+
+static sh1106_t rotated_display;
+static uint8_t rotated_buffer[BUFFER_SIZE], rotated_front[BUFFER_SIZE];
+
+static sh1106_t gray_display;
+static uint8_t gray_buffer[BUFFER_SIZE];
+static uint8_t gray_planes[SH1106_GRAY_BUFFER_SIZE(SH1106_WHIDTH, SH1106_HEIGHT, 2)];
+static sh1106_gray_t gray;
+
+#if SH1106_STRIP
+static sh1106_t strip_display;
+static uint8_t strip_buffer[SH1106_WHIDTH], strip_list[SH1106_STRIP_LIST_SIZE];
+#endif
+
+static sh1106_screen_t screen;
+static sh1106_widget_t *screen_number, *screen_bar;
+
+static bus_model_t buses[MAX_BUSES];
+static unsigned bus_count;
+
+/* === Private function declarations =========================================================== */
+/**
+ * @brief Tiempo monotono en nanosegundos.
+ */
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void nothing(void) {
+}
+
+static void clean_screen(void) {
+    sh1106_UpdateScreen();
+}
+
+static void dirty_screen(void) {
+    sh1106_InvalidateAll();
+}
+
+static void dirty_pixel(void) {
+    sh1106_UpdateScreen();
+    sh1106_DrawPixel(64, 32, WHITE);
+}
+
+static void dirty_spi_screen(void) {
+    sh1106_DevInvalidateAll(&spi_display);
+}
+
+static void dirty_gather_screen(void) {
+    sh1106_DevInvalidateAll(&gather_display);
+}
+
+static void run_init(unsigned i) {
+    sh1106_Init();
+}
+
+static void run_warm_init(unsigned i) {
+    sh1106_WarmInit();
+}
+
+static void run_sleep_wake(unsigned i) {
+    sh1106_Sleep();
+    sh1106_Wake();
+}
+
+static void run_update_full(unsigned i) {
+    sh1106_UpdateScreenFull();
+}
+
+static void run_update(unsigned i) {
+    sh1106_UpdateScreen();
+}
+
+static void run_update_async(unsigned i) {
+    sh1106_UpdateScreenAsync(NULL);
+}
+
+static void run_spi_update(unsigned i) {
+    sh1106_DevUpdateScreen(&spi_display);
+}
+
+static void run_spi_update_async(unsigned i) {
+    sh1106_DevUpdateScreenAsync(&spi_display, NULL);
+}
+
+static void run_gather_update(unsigned i) {
+    sh1106_DevUpdateScreen(&gather_display);
+}
+
+#ifndef SH1106_PANEL
+static void dirty_rotated_screen(void) {
+    sh1106_DevInvalidateAll(&rotated_display);
+}
+
+static void run_rotated_update(unsigned i) {
+    sh1106_DevUpdateScreen(&rotated_display);
+}
+
+static void run_rotated_update_async(unsigned i) {
+    sh1106_DevUpdateScreenAsync(&rotated_display, NULL);
+}
+#endif
+
+static void run_gather_update_async(unsigned i) {
+    sh1106_DevUpdateScreenAsync(&gather_display, NULL);
+}
+
+static void run_fill(unsigned i) {
+    sh1106_Fill((i & 1) ? WHITE : BLACK);
+}
+
+static void run_draw_pixel(unsigned i) {
+    sh1106_DrawPixel(i & 127, (i >> 7) & 63, (i & 1) ? WHITE : BLACK);
+}
+
+static void run_fill_rect(unsigned i) {
+    sh1106_FillRect(sh1106_Default(), 10, 5, 100, 40, (i & 1) ? WHITE : BLACK);
+}
+
+static void run_draw_line(unsigned i) {
+    sh1106_DrawLine(sh1106_Default(), 0, 3, 127, 60, WHITE);
+}
+
+static void run_draw_circle(unsigned i) {
+    sh1106_DrawCircle(sh1106_Default(), 64, 32, 30, WHITE);
+}
+
+static void run_fill_circle(unsigned i) {
+    sh1106_FillCircle(sh1106_Default(), 64, 32, 30, WHITE);
+}
+
+static void run_draw_arc(unsigned i) {
+    sh1106_DrawArc(sh1106_Default(), 64, 32, 30, 30, 300, WHITE);
+}
+
+static void run_draw_string(unsigned i) {
+    sh1106_DrawString(sh1106_Default(), &sh1106_font_5x7, 1, 27, "Temperatura: 23.5 C", WHITE);
+}
+
+static void run_draw_bitmap(unsigned i) {
+    sh1106_DrawBitmap(sh1106_Default(), &icon, 48, 13, SH1106_ROP_XOR);
+}
+
+/**
+ * @brief Cuadro de una aplicacion que borra y redibuja toda la pantalla, con un digito que cambia.
+ */
+static void redraw(sh1106_t * dev, unsigned i) {
+    char text[] = "Temperatura: 23.5 C";
+    text[16] = '0' + i % 10;
+    sh1106_DevFill(dev, BLACK);
+    sh1106_DrawString(dev, &sh1106_font_5x7, 1, 27, text, WHITE);
+    sh1106_DrawRect(dev, 0, 0, 128, 64, WHITE);
+    sh1106_DevUpdateScreen(dev);
+}
+
+static void run_redraw(unsigned i) {
+    redraw(sh1106_Default(), i);
+}
+
+static void run_shadow_redraw(unsigned i) {
+    redraw(&shadow_display, i);
+}
+
+#if SH1106_STRIP
+static void run_strip_redraw(unsigned i) {
+    redraw(&strip_display, i);
+}
+#endif
+
+/**
+ * @brief El mismo cuadro que redraw con widgets: solo se redibuja el numero que cambia, y una
+ * barra que cambia cada 10 cuadros.
+ */
+static void run_widget_update(unsigned i) {
+    sh1106_NumberSet(screen_number, 230 + i % 10);
+    sh1106_BarSet(screen_bar, (i / 10) % 100);
+    sh1106_ScreenRender(&screen);
+    sh1106_UpdateScreen();
+}
+
+/**
+ * @brief Un cuadro de escala de grises: barras de los 4 niveles, que cambian de plano a plano solo
+ * donde los niveles 1 y 2 difieren.
+ */
+static void run_gray_tick(unsigned i) {
+    sh1106_GrayTick(&gray, i);
+}
+
+static void run_scroll_update(unsigned i) {
+    sh1106_Scroll(1);
+    sh1106_UpdateScreen();
+}
+
+/**
+ * @brief Operaciones medidas. Las operaciones nuevas del driver se agregan a esta tabla.
+ */
+static const operation_t operations[] = {
+    {"Init", nothing, run_init, 2000},
+    {"WarmInit", nothing, run_warm_init, 20000},
+    {"Sleep_Wake", nothing, run_sleep_wake, 20000},
+    {"UpdateScreenFull", nothing, run_update_full, 2000},
+    {"UpdateScreen_clean", clean_screen, run_update, 200000},
+    {"UpdateScreen_1px", dirty_pixel, run_update, 20000},
+    {"UpdateScreen_all", dirty_screen, run_update, 2000},
+    {"UpdateScreenAsync_all", dirty_screen, run_update_async, 2000},
+    {"Gather_UpdateScreen_all", dirty_gather_screen, run_gather_update, 2000},
+    {"Gather_UpdateScreenAsync_all", dirty_gather_screen, run_gather_update_async, 2000},
+#ifndef SH1106_PANEL
+    {"Rotate90_UpdateScreen_all", dirty_rotated_screen, run_rotated_update, 2000},
+    {"Rotate90_UpdateScreenAsync_all", dirty_rotated_screen, run_rotated_update_async, 2000},
+#endif
+    {"SPI_UpdateScreen_all", dirty_spi_screen, run_spi_update, 2000},
+    {"SPI_UpdateScreenAsync_all", dirty_spi_screen, run_spi_update_async, 2000},
+    {"Fill", nothing, run_fill, 200000},
+    {"DrawPixel", nothing, run_draw_pixel, 2000000},
+    {"FillRect_100x40", nothing, run_fill_rect, 200000},
+    {"DrawLine_diagonal", nothing, run_draw_line, 200000},
+    {"DrawCircle_r30", nothing, run_draw_circle, 200000},
+    {"FillCircle_r30", nothing, run_fill_circle, 200000},
+    {"DrawArc_r30", nothing, run_draw_arc, 200000},
+    {"DrawString_19ch", nothing, run_draw_string, 200000},
+    {"DrawBitmap_32x32", nothing, run_draw_bitmap, 200000},
+    {"Scroll_UpdateScreen", nothing, run_scroll_update, 2000},
+    {"Redraw_UpdateScreen", nothing, run_redraw, 2000},
+    {"Shadow_Redraw_UpdateScreen", nothing, run_shadow_redraw, 2000},
+#if SH1106_STRIP
+    {"Strip_Redraw_UpdateScreen", nothing, run_strip_redraw, 2000},
+#endif
+    {"Widget_UpdateScreen", nothing, run_widget_update, 2000},
+    {"Gray_Tick", nothing, run_gray_tick, 2000},
+};
+
+/**
+ * @brief Mide una operacion: el tiempo de CPU de run y el trafico que genera run en la HAL.
+ */
+static void measure(const operation_t * op, double * ns, fake_hal_traffic_t * traffic) {
+    double total = 0;
+
+    memset(traffic, 0, sizeof(*traffic));
+    sh1106_Init();
+    sh1106_UpdateScreen();
+    for (unsigned i = 0; i < op->iterations; i++) {
+        op->setup();
+        fake_hal_reset();
+        double start = now_ns();
+        op->run(i);
+        total += now_ns() - start;
+
+        fake_hal_traffic_t sent = fake_hal_traffic();
+        traffic->transactions += sent.transactions;
+        traffic->bytes += sent.bytes;
+        traffic->control += sent.control;
+    }
+    *ns = total / op->iterations;
+}
+
+int main(int argc, char * argv[]) {
+    bool json = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (strcmp(argv[i], "--bus") == 0 && i + 1 < argc && bus_count < MAX_BUSES) {
+            if (bus_model_parse(argv[++i], &buses[bus_count]) != 0) {
+                fprintf(stderr, "bus invalido: %s\n", argv[i]);
+                return 1;
+            }
+            bus_count++;
+        } else {
+            fprintf(stderr, "uso: %s [--json] [--bus i2c:400000] ...\n", argv[0]);
+            return 1;
+        }
+    }
+    if (bus_count == 0) {
+        static const char * defaults[] = {"i2c:100000", "i2c:400000", "i2c:1000000", "spi:8000000"};
+        for (unsigned i = 0; i < sizeof(defaults) / sizeof(defaults[0]); i++) {
+            bus_model_parse(defaults[i], &buses[bus_count++]);
+        }
+    }
+    sh1106_config_t spi_config = {.buffer = spi_buffer,
+                                  .front = spi_front,
+                                  .width = SH1106_WHIDTH,
+                                  .height = SH1106_HEIGHT,
+                                  .column_offset = SH1106_COLUMN_OFFSET,
+                                  .transport = &sh1106_spi_transport};
+    sh1106_DevCreate(&spi_display, &spi_config);
+    sh1106_config_t gather_config = spi_config;
+    gather_config.buffer = gather_buffer;
+    gather_config.front = gather_front;
+    gather_config.address = SH1106_I2C_ADDRESS;
+    gather_config.transport = &sh1106_i2c_gather_transport;
+    sh1106_DevCreate(&gather_display, &gather_config);
+    sh1106_config_t shadow_config = gather_config;
+    shadow_config.buffer = shadow_buffer;
+    shadow_config.front = NULL;
+    shadow_config.shadow = shadow_ddram;
+    shadow_config.transport = &sh1106_i2c_transport;
+    sh1106_DevCreate(&shadow_display, &shadow_config);
+#if SH1106_STRIP
+    sh1106_config_t strip_config = shadow_config;
+    strip_config.buffer = strip_buffer;
+    strip_config.shadow = NULL;
+    strip_config.list = strip_list;
+    strip_config.list_size = sizeof(strip_list);
+    sh1106_DevCreate(&strip_display, &strip_config);
+#endif
+    sh1106_config_t rotated_config = gather_config;
+    rotated_config.buffer = rotated_buffer;
+    rotated_config.front = rotated_front;
+    rotated_config.orientation = SH1106_ROTATE_90;
+    sh1106_DevCreate(&rotated_display, &rotated_config);
+    sh1106_config_t gray_config = shadow_config;
+    gray_config.buffer = gray_buffer;
+    gray_config.shadow = NULL;
+    sh1106_DevCreate(&gray_display, &gray_config);
+    sh1106_GrayCreate(&gray, &gray_display, gray_planes, 2, SH1106_GRAY_PWM);
+    for (uint8_t level = 0; level < SH1106_GRAY_LEVELS(2); level++) {
+        sh1106_GrayFillRect(&gray, 1 + level * 32, 20, 30, 24, level);
+    }
+    sh1106_ScreenCreate(&screen, sh1106_Default(), BLACK);
+    sh1106_LabelCreate(&screen, 1, 27, 78, 8, &sh1106_font_5x7, "Temperatura:");
+    screen_number = sh1106_NumberCreate(&screen, 79, 27, 24, 8, &sh1106_font_5x7, 0);
+    screen_bar = sh1106_BarCreate(&screen, 1, 40, 126, 8, 0, 100, 0);
+    for (unsigned i = 0; i < sizeof(icon_data); i++) {
+        icon_data[i] = (uint8_t)(i * 37 + 11);
+    }
+
+    if (!json) {
+        printf("%-30s %10s %8s %8s", "operacion", "ns/op", "tr/op", "B/op");
+        for (unsigned b = 0; b < bus_count; b++) {
+            printf(" %10s", buses[b].name);
+        }
+        printf("   (us/op)\n");
+    }
+    for (unsigned o = 0; o < sizeof(operations) / sizeof(operations[0]); o++) {
+        const operation_t * op = &operations[o];
+        fake_hal_traffic_t traffic;
+        double ns;
+
+        measure(op, &ns, &traffic);
+
+        if (json) {
+            printf("{\"op\":\"%s\",\"iterations\":%u,\"cpu_ns\":%.1f,\"transactions\":%.2f,"
+                   "\"bytes\":%.2f,\"bus_us\":{",
+                   op->name, op->iterations, ns, (double)traffic.transactions / op->iterations,
+                   (double)traffic.bytes / op->iterations);
+        } else {
+            printf("%-30s %10.1f %8.2f %8.2f", op->name, ns,
+                   (double)traffic.transactions / op->iterations,
+                   (double)traffic.bytes / op->iterations);
+        }
+        for (unsigned b = 0; b < bus_count; b++) {
+            double us = bus_model_us(&buses[b], &traffic) / op->iterations;
+            if (json) {
+                printf("%s\"%s\":%.2f", (b == 0) ? "" : ",", buses[b].name, us);
+            } else {
+                printf(" %10.2f", us);
+            }
+        }
+        printf(json ? "}}\n" : "\n");
+    }
+    return 0;
+}
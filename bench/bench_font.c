@@ -0,0 +1,87 @@
+/**
+ * @file bench_font.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Benchmark del dibujo de texto, en caracteres por milisegundo
+ *
+ * Mide sh1106_DrawString con la fuente de 5x7 alineada a una pagina y desplazada dentro de la
+ * pagina, y lo compara con el mismo texto dibujado pixel por pixel con sh1106_DevDrawPixel.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include <stdio.h>
+#include <time.h>
+#include "sh1106.h"
+#include "sh1106_font.h"
+#include "sh1106_font_5x7.h"
+
+/* === Private macros definitions ============================================================== */
+#define LINE       "The quick brown fox!"
+#define LINE_CHARS (sizeof(LINE) - 1)
+
+/* === Private variable declarations =========================================================== */
+static sh1106_t display;
+static uint8_t buffer[BUFFER_SIZE];
+
+/* === Private function declarations =========================================================== */
+/**
+ * @brief Tiempo monotono en nanosegundos.
+ */
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void string_aligned(void) {
+    sh1106_DrawString(&display, &sh1106_font_5x7, 2, 16, LINE, WHITE);
+}
+
+static void string_unaligned(void) {
+    sh1106_DrawString(&display, &sh1106_font_5x7, 2, 19, LINE, WHITE);
+}
+
+static void string_pixels(void) {
+    const sh1106_font_t * font = &sh1106_font_5x7;
+    int x = 2;
+    for (const char * c = LINE; *c != '\0'; c++, x += font->width + font->spacing) {
+        const uint8_t * glyph = &font->bitmap[(*c - font->first) * font->width];
+        for (int column = 0; column < font->width; column++) {
+            for (int row = 0; row < font->height; row++) {
+                if (glyph[column] & (1 << row)) {
+                    sh1106_DevDrawPixel(&display, x + column, 19 + row, WHITE);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Ejecuta una operacion la cantidad de veces indicada y devuelve los caracteres por ms.
+ */
+static double chars_per_ms(void (*operation)(void), long iterations) {
+    double start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        operation();
+    }
+    return iterations * LINE_CHARS / ((now_ns() - start) / 1e6);
+}
+
+/* === Public function declarations ============================================================ */
+int main(void) {
+    sh1106_config_t config = {.buffer = buffer,
+                              .width = SH1106_WHIDTH,
+                              .height = SH1106_HEIGHT,
+                              .column_offset = SH1106_COLUMN_OFFSET,
+                              .transport = &sh1106_i2c_transport};
+    sh1106_DevCreate(&display, &config);
+
+    printf("%-16s %10.0f chars/ms\n", "5x7 alineada", chars_per_ms(string_aligned, 100000));
+    printf("%-16s %10.0f chars/ms\n", "5x7 desplazada", chars_per_ms(string_unaligned, 100000));
+    printf("%-16s %10.0f chars/ms\n", "pixel a pixel", chars_per_ms(string_pixels, 20000));
+    return 0;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file bench_gfx.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Benchmark de las primitivas de dibujo contra el dibujo pixel por pixel
+ *
+ * Compara las primitivas (rectangulos, lineas y circunferencias) contra los mismos dibujos hechos
+ * con sh1106_DevDrawPixel, que es lo unico que tenia el driver antes de las primitivas.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "sh1106.h"
+#include "sh1106_gfx.h"
+
+/* === Private variable declarations =========================================================== */
+static sh1106_t display;
+static uint8_t buffer[BUFFER_SIZE];
+
+/* === Private function declarations =========================================================== */
+/**
+ * @brief Tiempo monotono en nanosegundos.
+ */
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void pixel_rect(int x, int y, int width, int height) {
+    for (int i = x; i < x + width; i++) {
+        for (int j = y; j < y + height; j++) {
+            sh1106_DevDrawPixel(&display, i, j, WHITE);
+        }
+    }
+}
+
+static void fill_rect_100x40(void) {
+    sh1106_FillRect(&display, 10, 5, 100, 40, WHITE);
+}
+
+static void pixel_rect_100x40(void) {
+    pixel_rect(10, 5, 100, 40);
+}
+
+static void hline_128(void) {
+    sh1106_DrawHLine(&display, 0, 20, 128, WHITE);
+}
+
+static void pixel_hline_128(void) {
+    pixel_rect(0, 20, 128, 1);
+}
+
+static void vline_64(void) {
+    sh1106_DrawVLine(&display, 40, 0, 64, WHITE);
+}
+
+static void pixel_vline_64(void) {
+    pixel_rect(40, 0, 1, 64);
+}
+
+static void line_diagonal(void) {
+    sh1106_DrawLine(&display, 0, 3, 127, 60, WHITE);
+}
+
+static void pixel_line_diagonal(void) {
+    int x0 = 0, y0 = 3, x1 = 127, y1 = 60;
+    int dx = abs(x1 - x0), dy = -abs(y1 - y0), error = dx + dy;
+    while (1) {
+        sh1106_DevDrawPixel(&display, x0, y0, WHITE);
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        int error2 = 2 * error;
+        if (error2 >= dy) {
+            error += dy;
+            x0++;
+        }
+        if (error2 <= dx) {
+            error += dx;
+            y0++;
+        }
+    }
+}
+
+static void circle_30(void) {
+    sh1106_DrawCircle(&display, 64, 32, 30, WHITE);
+}
+
+static void pixel_circle(int cx, int cy, int r, int fill) {
+    int x = r, y = 0, error = 1 - r;
+    while (x >= y) {
+        static const int8_t sign[4][2] = {{1, 1}, {-1, 1}, {1, -1}, {-1, -1}};
+        for (int i = 0; i < 4; i++) {
+            if (fill) {
+                pixel_rect(cx + sign[i][0] * x, cy - y, 1, 2 * y + 1);
+                pixel_rect(cx + sign[i][0] * y, cy - x, 1, 2 * x + 1);
+            } else {
+                sh1106_DevDrawPixel(&display, cx + sign[i][0] * x, cy + sign[i][1] * y, WHITE);
+                sh1106_DevDrawPixel(&display, cx + sign[i][0] * y, cy + sign[i][1] * x, WHITE);
+            }
+        }
+        y++;
+        if (error < 0) {
+            error += 2 * y + 1;
+        } else {
+            x--;
+            error += 2 * (y - x) + 1;
+        }
+    }
+}
+
+static void pixel_circle_30(void) {
+    pixel_circle(64, 32, 30, 0);
+}
+
+static void fill_circle_30(void) {
+    sh1106_FillCircle(&display, 64, 32, 30, WHITE);
+}
+
+static void pixel_fill_circle_30(void) {
+    pixel_circle(64, 32, 30, 1);
+}
+
+/**
+ * @brief Ejecuta una operacion la cantidad de veces indicada y devuelve los ns por operacion.
+ */
+static double measure(void (*operation)(void), long iterations) {
+    double start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        operation();
+    }
+    return (now_ns() - start) / iterations;
+}
+
+static void compare(const char * name, void (*fast)(void), void (*slow)(void), long iterations) {
+    double fast_ns = measure(fast, iterations);
+    double slow_ns = measure(slow, iterations);
+    printf("%-16s %10.1f ns/op   pixel a pixel %10.1f ns/op   x%.1f\n", name, fast_ns, slow_ns,
+           slow_ns / fast_ns);
+}
+
+/* === Public function declarations ============================================================ */
+int main(void) {
+    sh1106_config_t config = {.buffer = buffer,
+                              .width = SH1106_WHIDTH,
+                              .height = SH1106_HEIGHT,
+                              .column_offset = SH1106_COLUMN_OFFSET,
+                              .transport = &sh1106_i2c_transport};
+    sh1106_DevCreate(&display, &config);
+
+    compare("FillRect 100x40", fill_rect_100x40, pixel_rect_100x40, 20000);
+    compare("HLine 128", hline_128, pixel_hline_128, 200000);
+    compare("VLine 64", vline_64, pixel_vline_64, 200000);
+    compare("Line 127x57", line_diagonal, pixel_line_diagonal, 100000);
+    compare("Circle r30", circle_30, pixel_circle_30, 100000);
+    compare("FillCircle r30", fill_circle_30, pixel_fill_circle_30, 5000);
+    return 0;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file bus_model.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Source File - Modelo de costo del bus para los benchmarks
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bus_model.h"
+
+/* === Private macros definitions ============================================================== */
+#define I2C_FRAME_BITS (1 + 9 + 1) ///< @brief Start, direccion con su ACK y stop.
+#define I2C_BYTE_BITS  (9)         ///< @brief 8 bits de datos mas el ACK.
+#define SPI_BYTE_BITS  (8)         ///< @brief 8 bits de datos.
+
+/* === Public function declarations ============================================================ */
+int bus_model_parse(const char * text, bus_model_t * bus) {
+    const char * separator = strchr(text, ':');
+    char * end;
+
+    if (separator == NULL) {
+        return -1;
+    }
+    if (strncmp(text, "i2c", separator - text) == 0) {
+        bus->kind = BUS_I2C;
+    } else if (strncmp(text, "spi", separator - text) == 0) {
+        bus->kind = BUS_SPI;
+    } else {
+        return -1;
+    }
+    bus->clock_hz = strtoul(separator + 1, &end, 10);
+    if (*end != '\0' || bus->clock_hz == 0) {
+        return -1;
+    }
+
+    if (bus->clock_hz % 1000000 == 0) {
+        snprintf(bus->name, sizeof(bus->name), "%.3s_%um", text, bus->clock_hz / 1000000);
+    } else if (bus->clock_hz % 1000 == 0) {
+        snprintf(bus->name, sizeof(bus->name), "%.3s_%uk", text, bus->clock_hz / 1000);
+    } else {
+        snprintf(bus->name, sizeof(bus->name), "%.3s_%u", text, bus->clock_hz);
+    }
+    return 0;
+}
+
+double bus_model_us(const bus_model_t * bus, const fake_hal_traffic_t * traffic) {
+    double bits;
+
+    if (bus->kind == BUS_I2C) {
+        bits = (double)traffic->transactions * I2C_FRAME_BITS;
+        bits += (double)traffic->bytes * I2C_BYTE_BITS;
+    } else {
+        bits = (double)(traffic->bytes - traffic->control) * SPI_BYTE_BITS;
+    }
+    return bits * 1e6 / bus->clock_hz;
+}
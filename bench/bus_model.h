@@ -0,0 +1,56 @@
+/**
+ * @file bus_model.h
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Header File - Modelo de costo del bus para los benchmarks
+ *
+ * Estima cuanto tardaria en el bus el trafico registrado por la HAL de prueba:
+ *
+ * <ul>
+ *   <li>I2C: cada transaccion tiene start, byte de direccion y stop, y cada byte ocupa 9 ciclos de
+ * reloj (8 bits mas el ACK). Se envian todos los bytes, incluidos los de control.</li>
+ *   <li>SPI de 4 hilos: cada byte ocupa 8 ciclos de reloj y no hay bytes de control, ya que
+ * comando o dato se indica con el pin D/C.</li>
+ * </ul>
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#ifndef BUS_MODEL_H
+#define BUS_MODEL_H
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include <stdint.h>
+#include "fake_hal.h"
+
+/* === Public data type declarations =========================================================== */
+typedef enum {
+    BUS_I2C, ///< @brief I2C, con direccion y bytes de control.
+    BUS_SPI, ///< @brief SPI de 4 hilos, con pin D/C.
+} bus_kind_t;
+
+/**
+ * @brief Bus con su frecuencia de reloj.
+ */
+typedef struct {
+    char name[16];     ///< @brief Nombre para los reportes, por ejemplo "i2c_400k".
+    bus_kind_t kind;   ///< @brief Tipo de bus.
+    uint32_t clock_hz; ///< @brief Frecuencia de reloj en Hz.
+} bus_model_t;
+
+/* === Public function declarations ============================================================ */
+/**
+ * @brief Interpreta un bus escrito como "i2c:400000" o "spi:8000000".
+ *
+ * @return int: 0 si el texto es valido.
+ */
+int bus_model_parse(const char * text, bus_model_t * bus);
+
+/**
+ * @brief Tiempo en microsegundos que ocuparia el trafico en el bus.
+ */
+double bus_model_us(const bus_model_t * bus, const fake_hal_traffic_t * traffic);
+
+#endif /* BUS_MODEL_H */
@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+"""Compara dos salidas de bench_driver --json y marca las regresiones.
+
+El trafico por operacion (transacciones y bytes) es determinista, por lo que cualquier aumento es
+una regresion. El tiempo de CPU depende de la maquina, por lo que solo se marca si empeora mas que
+el umbral indicado.
+
+Uso:
+    make -C bench json
+    python3 bench/compare.py base.json build/bench/bench_driver.json --cpu 20
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    """Devuelve {operacion: resultado} leyendo un objeto JSON por linea."""
+    with open(path, encoding="utf-8") as results:
+        return {entry["op"]: entry for entry in map(json.loads, results) if entry}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("base", help="resultados de referencia")
+    parser.add_argument("current", help="resultados nuevos")
+    parser.add_argument("--cpu", type=float, default=20.0,
+                        help="aumento de ns/op tolerado, en porcentaje (20)")
+    args = parser.parse_args()
+
+    base = load(args.base)
+    current = load(args.current)
+    regressions = 0
+    for name, new in current.items():
+        old = base.get(name)
+        if old is None:
+            print("%-24s nueva" % name)
+            continue
+        notes = []
+        for key in ("transactions", "bytes"):
+            if new[key] > old[key] + 1e-9:
+                notes.append("%s %.2f -> %.2f" % (key, old[key], new[key]))
+        change = 100.0 * (new["cpu_ns"] - old["cpu_ns"]) / old["cpu_ns"] if old["cpu_ns"] else 0
+        if change > args.cpu:
+            notes.append("cpu_ns %+.1f%%" % change)
+        print("%-24s %+7.1f%% cpu  %s" % (name, change, ", ".join(notes) or "ok"))
+        regressions += bool(notes)
+    sys.exit(1 if regressions else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,99 @@
+/**
+ * @file fake_hal.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Source File - HAL de prueba para los benchmarks
+ *
+ * Acepta todas las transacciones sin enviarlas, para medir solo el tiempo de CPU del driver, y
+ * registra el trafico que se hubiera enviado.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "fake_hal.h"
+
+/* === Private variable declarations =========================================================== */
+static fake_hal_traffic_t traffic;
+
+/* === Private function declarations =========================================================== */
+/**
+ * @brief Registra una transaccion, contando sus bytes de control: despues de un byte de control
+ * con Co=1 viene un solo byte y otro byte de control, con Co=0 el resto es un stream.
+ */
+static void record(const hal_iovec_t * iov, uint8_t count) {
+    bool control = true, stream = false;
+
+    for (uint8_t i = 0; i < count && !stream; i++) {
+        for (size_t j = 0; j < iov[i].size && !stream; j++) {
+            if (control) {
+                traffic.control++;
+                stream = (iov[i].data[j] & 0x80) == 0;
+            }
+            control = !control;
+        }
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        traffic.bytes += iov[i].size;
+    }
+    traffic.transactions++;
+}
+
+/* === Public function declarations ============================================================ */
+void fake_hal_reset(void) {
+    traffic.transactions = 0;
+    traffic.bytes = 0;
+    traffic.control = 0;
+}
+
+fake_hal_traffic_t fake_hal_traffic(void) {
+    return traffic;
+}
+
+status_t HAL_I2C_send(uint8_t address, uint8_t * data, size_t size) {
+    hal_iovec_t iov = {data, size};
+    record(&iov, 1);
+    return HAL_OK;
+}
+
+status_t HAL_I2C_send_async(uint8_t address, uint8_t * data, size_t size,
+                            hal_i2c_callback_t callback, void * context) {
+    HAL_I2C_send(address, data, size);
+    callback(context, HAL_OK);
+    return HAL_OK;
+}
+
+status_t HAL_I2C_sendv(uint8_t address, const hal_iovec_t * iov, uint8_t count) {
+    record(iov, count);
+    return HAL_OK;
+}
+
+status_t HAL_I2C_sendv_async(uint8_t address, const hal_iovec_t * iov, uint8_t count,
+                             hal_i2c_callback_t callback, void * context) {
+    record(iov, count);
+    callback(context, HAL_OK);
+    return HAL_OK;
+}
+
+void HAL_SPI_select(uint8_t device, bool selected) {
+    if (selected) {
+        traffic.transactions++;
+    }
+}
+
+void HAL_SPI_set_dc(uint8_t device, bool data) {
+}
+
+status_t HAL_SPI_write(uint8_t device, const uint8_t * data, size_t size) {
+    traffic.bytes += size;
+    return HAL_OK;
+}
+
+status_t HAL_SPI_write_async(uint8_t device, const uint8_t * data, size_t size,
+                             hal_spi_callback_t callback, void * context) {
+    traffic.bytes += size;
+    callback(context, HAL_OK);
+    return HAL_OK;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file fake_hal.h
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Header File - HAL de prueba para los benchmarks
+ *
+ * La HAL de prueba acepta todas las transacciones I2C y SPI sin enviarlas y cuenta las
+ * transacciones (en SPI, las activaciones de CS) y los bytes que recibe, para estimar el tiempo que ocuparian en el bus con bus_model.h.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#ifndef FAKE_HAL_H
+#define FAKE_HAL_H
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include <stdint.h>
+#include "hal_i2c.h"
+#include "hal_spi.h"
+
+/* === Public data type declarations =========================================================== */
+/**
+ * @brief Trafico registrado por la HAL de prueba.
+ */
+typedef struct {
+    uint64_t transactions; ///< @brief Transacciones recibidas.
+    uint64_t bytes;        ///< @brief Bytes recibidos, incluidos los bytes de control.
+    uint64_t control;      ///< @brief Bytes de control del sh1106 dentro de esos bytes.
+} fake_hal_traffic_t;
+
+/* === Public function declarations ============================================================ */
+/**
+ * @brief Pone en cero el trafico registrado.
+ */
+void fake_hal_reset(void);
+
+/**
+ * @brief Trafico registrado desde la ultima llamada a fake_hal_reset.
+ */
+fake_hal_traffic_t fake_hal_traffic(void);
+
+#endif /* FAKE_HAL_H */
@@ -14,11 +14,58 @@
 #define INC_HAL_I2C_H
 /* === Inclusion de archivos de cabecera  ====================================================== */
 #include "stdint.h"
+#include "stddef.h"
 
 /* === Typedef declarations ==================================================================== */
 typedef enum { HAL_OK, HAL_ERROR, HAL_BUSY } status_t;
 
+/**
+ * @brief Tramo de una transaccion armada por partes, para enviarla sin juntarla en un buffer.
+ */
+typedef struct {
+    const uint8_t * data; ///< @brief Primer byte del tramo.
+    size_t size;          ///< @brief Cantidad de bytes del tramo.
+} hal_iovec_t;
+
+/**
+ * @brief Funcion que la HAL llama (normalmente desde la interrupcion de fin de transmision) al
+ * terminar una transaccion iniciada con HAL_I2C_send_async.
+ */
+typedef void (*hal_i2c_callback_t)(void * context, status_t status);
+
 /* === Public function declarations ============================================================ */
-status_t HAL_I2C_send(uint8_t * data, uint8_t size);
+/**
+ * @brief Escribe una transaccion completa en el bus (start, direccion, datos, stop).
+ *
+ * Los datos se envian tal cual, el primer byte es el byte de control del sh1106.
+ *
+ * @param address: Direccion del dispositivo en el bus, de 7 bits.
+ */
+status_t HAL_I2C_send(uint8_t address, uint8_t * data, size_t size);
+
+/**
+ * @brief Inicia una transaccion sin esperar a que termine (por interrupcion o DMA).
+ *
+ * El buffer debe permanecer sin cambios hasta que la HAL llame a callback con el resultado y el
+ * puntero context recibido.
+ */
+status_t HAL_I2C_send_async(uint8_t address, uint8_t * data, size_t size,
+                            hal_i2c_callback_t callback, void * context);
+
+/**
+ * @brief Escribe una transaccion completa formada por varios tramos consecutivos, sin copiarlos
+ * (por ejemplo con las transferencias secuenciales de la HAL de STM32 o una lista de DMA).
+ *
+ * @param iov: Tramos de la transaccion, en orden.
+ * @param count: Cantidad de tramos.
+ */
+status_t HAL_I2C_sendv(uint8_t address, const hal_iovec_t * iov, uint8_t count);
+
+/**
+ * @brief Version sin espera de HAL_I2C_sendv. Los tramos y sus datos deben permanecer sin cambios
+ * hasta que la HAL llame a callback.
+ */
+status_t HAL_I2C_sendv_async(uint8_t address, const hal_iovec_t * iov, uint8_t count,
+                             hal_i2c_callback_t callback, void * context);
 
 #endif
@@ -0,0 +1,56 @@
+/**
+ * @file hal_spi.h
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Header File (Fake) - Archivo de cabecera para utiizar FFF.
+ *
+ * Funciones de una supuesta HAL de SPI para el transporte SPI de 4 hilos del sh1106. Ademas de
+ * SCLK y MOSI cada display usa dos pines propios: CS, que encierra la transaccion, y D/C, que
+ * indica si los bytes son comandos (0) o datos (1). La HAL elige los pines con el numero de
+ * dispositivo. La funciones Aqui declaradas estan mockeadas.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+#ifndef INC_HAL_SPI_H
+#define INC_HAL_SPI_H
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "stdint.h"
+#include "stdbool.h"
+#include "hal_i2c.h"
+
+/* === Typedef declarations ==================================================================== */
+/**
+ * @brief Funcion que la HAL llama (normalmente desde la interrupcion de fin de transmision) al
+ * terminar una escritura iniciada con HAL_SPI_write_async.
+ */
+typedef void (*hal_spi_callback_t)(void * context, status_t status);
+
+/* === Public function declarations ============================================================ */
+/**
+ * @brief Activa (selected en true) o libera el pin CS del dispositivo.
+ *
+ * @param device: Numero de dispositivo, con el que la HAL elige sus pines CS y D/C.
+ */
+void HAL_SPI_select(uint8_t device, bool selected);
+
+/**
+ * @brief Fija el pin D/C del dispositivo: false para comandos, true para datos.
+ */
+void HAL_SPI_set_dc(uint8_t device, bool data);
+
+/**
+ * @brief Escribe bytes en el bus y espera a que terminen. No modifica CS ni D/C.
+ */
+status_t HAL_SPI_write(uint8_t device, const uint8_t * data, size_t size);
+
+/**
+ * @brief Inicia una escritura sin esperar a que termine (por interrupcion o DMA).
+ *
+ * El buffer debe permanecer sin cambios hasta que la HAL llame a callback con el resultado y el
+ * puntero context recibido.
+ */
+status_t HAL_SPI_write_async(uint8_t device, const uint8_t * data, size_t size,
+                             hal_spi_callback_t callback, void * context);
+
+#endif
@@ -10,109 +10,1504 @@
 
 /* === Inclusion de archivos de cabecera  ====================================================== */
 #include "sh1106.h"
+#include "sh1106_word.h"
+#if SH1106_STRIP
+#include "sh1106_strip.h"
+#endif
+
+/* === Private function prototypes ============================================================= */
+static sh1106_status_t sh1106_I2cSend(sh1106_t * dev, const sh1106_iovec_t * iov, uint8_t count);
+#if SH1106_ASYNC
+static sh1106_status_t sh1106_I2cSendAsync(sh1106_t * dev, const sh1106_iovec_t * iov,
+                                           uint8_t count);
+#endif
 
 /* === Public variable declarations ============================================================ */
+#if SH1106_STRIP
+uint8_t SH1106_Buffer[SH1106_WHIDTH] = {0};
+#else
 uint8_t SH1106_Buffer[BUFFER_SIZE] = {0};
+#endif
 
-/* === Public function declarations ============================================================ */
-sh1106_status_t sh1106_SendCmd(uint8_t cmd) {
-    return (HAL_I2C_send(&cmd, 1));
+const sh1106_transport_t sh1106_i2c_transport = {
+    .send = sh1106_I2cSend,
+#if SH1106_ASYNC
+    .send_async = sh1106_I2cSendAsync,
+#endif
+    .max_transfer = SH1106_BATCH_SIZE,
 };
 
-sh1106_status_t sh1106_SendData(uint8_t * data, size_t size) {
-    return (HAL_I2C_send(data, size));
+/* === Private variable declarations =========================================================== */
+#if SH1106_BATCH_SIZE < SH1106_MIN_TRANSFER
+#error "SH1106_BATCH_SIZE debe alcanzar para los comandos de direccion de una pagina"
+#endif
+
+#if SH1106_MAX_TRANSFER != 0 && SH1106_MAX_TRANSFER < SH1106_MIN_TRANSFER
+#error "SH1106_MAX_TRANSFER debe ser 0 o al menos SH1106_MIN_TRANSFER"
+#endif
+
+#if SH1106_STRIP && (defined(SH1106_PANEL) || SH1106_SHADOW)
+#error "SH1106_STRIP no admite SH1106_PANEL ni SH1106_SHADOW"
+#endif
+
+/**
+ * @brief Byte de control de las transacciones que continuan los datos de la anterior.
+ */
+static const uint8_t sh1106_data_control = CONTROL_DATA_STREAM;
+
+/**
+ * @brief Comandos de configuracion que no dependen del display, en el orden en que se envian.
+ * El panel queda apagado mientras se configura el convertidor DC-DC.
+ */
+static const uint8_t sh1106_init_commands[] = {
+    DISPLAY_OFF,
+    FIRT_PAGE_ADD,
+    FIRT_COLUM_ADD_L,
+    FIRT_COLUM_ADD_H,
+    DISPLAY_NORMAL,
+    RAT_OSC_FREQ_CONF,
+    0xF0,
+    CHARG_DISCHAR_PERI,
+    0x22,
+    SET_VCOM_DESEL_LEV,
+    0x20,
+    SET_DC_DC_CONTROL,
+    DC_DC_ENABLE,
 };
 
-sh1106_status_t sh1106_ContrasSet(uint8_t contrast) {
-    uint8_t cmd[] = {SET_CONSTRAS, contrast};
-    for (uint8_t i = 0; i < sizeof(cmd); i++) {
-        if (sh1106_SendCmd(i) == SH1106_ERROR) {
-            return SH1106_ERROR;
-        };
-    };
-    return HAL_OK;
+#if SH1106_ASYNC && !SH1106_STRIP
+
+/**
+ * @brief Buffer de transmision del display por defecto.
+ */
+static uint8_t SH1106_FrontBuffer[BUFFER_SIZE];
+#endif
+
+#if SH1106_STRIP
+/**
+ * @brief Lista de dibujo del display por defecto.
+ */
+static uint8_t SH1106_List[SH1106_STRIP_LIST_SIZE];
+#endif
+
+#if SH1106_SHADOW
+/**
+ * @brief Sombra de la DDRAM del display por defecto.
+ */
+static uint8_t SH1106_ShadowBuffer[BUFFER_SIZE];
+#endif
+
+/**
+ * @brief Display por defecto, usado por las funciones sin argumento sh1106_t (capa de
+ * compatibilidad). Dibuja sobre SH1106_Buffer.
+ */
+static sh1106_t sh1106_default = {
+    .buffer = SH1106_Buffer,
+#if SH1106_ASYNC && !SH1106_STRIP
+    .front = SH1106_FrontBuffer,
+#endif
+    .width = SH1106_WHIDTH,
+    .height = SH1106_HEIGHT,
+    .pages = SH1106_PAGES,
+    .column_offset = SH1106_COLUMN_OFFSET,
+    .address = SH1106_I2C_ADDRESS,
+    .transport = &sh1106_i2c_transport,
+    .max_transfer = SH1106_MAX_TRANSFER,
+    .fresh = true,
+#if SH1106_SHADOW
+    .shadow = SH1106_ShadowBuffer,
+#endif
+    .merge_gap = SH1106_MERGE_GAP,
+    .contrast = SH1106_CONTRAST,
+#if SH1106_STRIP
+    .list = SH1106_List,
+    .list_size = SH1106_STRIP_LIST_SIZE,
+#endif
 };
 
-sh1106_status_t sh1106_UpdateScreen(void) {
-    for (uint8_t i = 0; i < SH1106_HEIGHT / 8; i++) {
-        uint8_t command[] = {(FIRT_PAGE_ADD + i), FIRT_COLUM_ADD_L, FIRT_COLUM_ADD_H};
-        for (uint8_t j = 0; j < (sizeof(command)); j++) {
-            if (sh1106_SendCmd(command[j]) == SH1106_ERROR) {
-                return SH1106_ERROR;
+/* === Private function declarations =========================================================== */
+/**
+ * @brief Indica si el bus del display esta tomado por una actualizacion asincronica.
+ */
+static bool sh1106_BusBusy(sh1106_t * dev) {
+#if SH1106_ASYNC
+    if (dev->async_status != SH1106_BUSY) {
+        return false;
+    }
+#if SH1106_STATS
+    dev->counters.async_busy++;
+#endif
+    return true;
+#else
+    (void)dev;
+    return false;
+#endif
+}
+
+/**
+ * @brief Suma a los contadores el resultado de una transaccion, si fallo.
+ */
+static inline void sh1106_CountStatus(sh1106_t * dev, sh1106_status_t status) {
+#if SH1106_STATS
+    if (status == SH1106_BUSY) {
+        dev->counters.bus_busy++;
+    } else if (status != SH1106_OK) {
+        dev->counters.errors++;
+    }
+#else
+    (void)dev;
+    (void)status;
+#endif
+}
+
+/**
+ * @brief Suma a los contadores una transaccion entregada al transporte y su resultado.
+ */
+static inline void sh1106_CountTransaction(sh1106_t * dev, const sh1106_iovec_t * iov,
+                                           uint8_t count, sh1106_status_t status) {
+#if SH1106_STATS
+    dev->counters.transactions++;
+    for (uint8_t i = 0; i < count; i++) {
+        dev->counters.bus_bytes += iov[i].size;
+    }
+#else
+    (void)iov;
+    (void)count;
+#endif
+    sh1106_CountStatus(dev, status);
+}
+
+/**
+ * @brief Comienzo de una actualizacion: avisa a la funcion de traza y lee el reloj.
+ */
+static inline void sh1106_FlushStart(sh1106_t * dev) {
+#if SH1106_STATS
+    if (dev->trace != NULL) {
+        dev->trace(dev, SH1106_TRACE_FLUSH_START, SH1106_OK);
+    }
+    if (dev->clock != NULL) {
+        dev->flush_start = dev->clock();
+    }
+#else
+    (void)dev;
+#endif
+}
+
+/**
+ * @brief Fin de una actualizacion: suma su duracion al histograma y avisa a la funcion de traza.
+ */
+static inline void sh1106_FlushEnd(sh1106_t * dev, sh1106_status_t status) {
+#if SH1106_STATS
+    dev->counters.flushes++;
+    if (dev->clock != NULL) {
+        uint32_t ticks = dev->clock() - dev->flush_start;
+        uint8_t bucket = 0;
+        while (bucket < SH1106_STATS_BUCKETS - 1 && (ticks >> bucket) != 0) {
+            bucket++;
+        }
+        dev->counters.latency[bucket]++;
+        if (ticks > dev->counters.latency_max) {
+            dev->counters.latency_max = ticks;
+        }
+    }
+    if (dev->trace != NULL) {
+        dev->trace(dev, SH1106_TRACE_FLUSH_END, status);
+    }
+#else
+    (void)dev;
+    (void)status;
+#endif
+}
+
+/**
+ * @brief Indica si el display esta girado un cuarto de vuelta: el buffer de dibujo tiene el ancho
+ * y el alto del panel intercambiados. Con SH1106_PANEL nunca lo esta.
+ */
+static inline bool sh1106_QuarterTurn(const sh1106_t * dev) {
+#ifdef SH1106_PANEL
+    (void)dev;
+    return false;
+#else
+    return dev->orientation >= SH1106_ROTATE_90;
+#endif
+}
+
+/**
+ * @brief Indica si el display esta en modo tira: el buffer de dibujo es de una pagina y el
+ * contenido esta en la lista de dibujo.
+ */
+static inline bool sh1106_StripMode(const sh1106_t * dev) {
+#if SH1106_STRIP
+    return dev->list != NULL;
+#else
+    (void)dev;
+    return false;
+#endif
+}
+
+/**
+ * @brief Ancho del panel en pixeles.
+ */
+static inline uint8_t sh1106_PanelWidth(const sh1106_t * dev) {
+    return sh1106_QuarterTurn(dev) ? sh1106_DevHeight(dev) : sh1106_DevWidth(dev);
+}
+
+/**
+ * @brief Alto del panel en pixeles.
+ */
+static inline uint8_t sh1106_PanelHeight(const sh1106_t * dev) {
+    return sh1106_QuarterTurn(dev) ? sh1106_DevWidth(dev) : sh1106_DevHeight(dev);
+}
+
+/**
+ * @brief Paginas del panel.
+ */
+static inline uint8_t sh1106_PanelPages(const sh1106_t * dev) {
+    return sh1106_PanelHeight(dev) / 8;
+}
+
+/**
+ * @brief Indica si la orientacion invierte los segmentos o los COM en el controlador.
+ */
+static bool sh1106_SegmentRemap(sh1106_orientation_t orientation) {
+    return orientation == SH1106_ROTATE_180 || orientation == SH1106_MIRROR_X ||
+           orientation == SH1106_ROTATE_270;
+}
+
+static bool sh1106_ComRemap(sh1106_orientation_t orientation) {
+    return orientation == SH1106_ROTATE_180 || orientation == SH1106_MIRROR_Y ||
+           orientation == SH1106_ROTATE_270;
+}
+
+/**
+ * @brief Direccion de la DDRAM de la primera columna del panel. Con los segmentos invertidos la
+ * columna c de la DDRAM maneja el segmento 131 - c, por lo que el panel empieza en la direccion
+ * que queda del otro lado.
+ */
+static uint8_t sh1106_ColumnStart(const sh1106_t * dev, sh1106_orientation_t orientation) {
+    if (sh1106_SegmentRemap(orientation)) {
+        return SH1106_MAX_WIDTH - sh1106_PanelWidth(dev) - sh1106_DevColumnOffset(dev);
+    }
+    return sh1106_DevColumnOffset(dev);
+}
+
+/**
+ * @brief Bytes maximos por transaccion del display, el menor entre el suyo y el del transporte,
+ * o 0 sin limite.
+ */
+static size_t sh1106_MaxTransfer(sh1106_t * dev) {
+    size_t own = dev->max_transfer, transport = dev->transport->max_transfer;
+    if (own == 0 || (transport != 0 && transport < own)) {
+        return transport;
+    }
+    return own;
+}
+
+/**
+ * @brief Bytes de comandos y control que entran en una transaccion agrupada del display.
+ */
+static uint16_t sh1106_BatchCapacity(sh1106_t * dev) {
+    size_t limit = sh1106_MaxTransfer(dev);
+    return (limit != 0 && limit < SH1106_BATCH_SIZE) ? limit : SH1106_BATCH_SIZE;
+}
+
+/**
+ * @brief Arma los tramos de la proxima transaccion de una transaccion agrupada: los comandos (o
+ * solo el byte de control si continua datos de la anterior) y los datos que entren en el maximo
+ * del display. Descuenta los datos incluidos de los pendientes.
+ *
+ * @return uint8_t: Cantidad de tramos armados en batch->iov.
+ */
+static uint8_t sh1106_BatchNext(sh1106_batch_t * batch) {
+    size_t limit = sh1106_MaxTransfer(batch->dev);
+    size_t chunk = batch->data_size;
+
+    if (batch->size > 0) {
+        batch->iov[0].data = batch->buffer;
+        batch->iov[0].size = batch->size;
+        batch->size = 0;
+    } else {
+        batch->iov[0].data = &sh1106_data_control;
+        batch->iov[0].size = 1;
+    }
+    if (chunk == 0) {
+        return 1;
+    }
+    if (limit != 0 && batch->iov[0].size + chunk > limit) {
+        chunk = limit - batch->iov[0].size;
+    }
+    batch->iov[1].data = batch->data;
+    batch->iov[1].size = chunk;
+    batch->data += chunk;
+    batch->data_size -= chunk;
+    return 2;
+}
+
+/**
+ * @brief Suma una actualizacion de pantalla a los contadores. Los comandos pendientes que se
+ * enviaron (contraste y start line) se comparan contra una actualizacion completa que tambien los
+ * envia.
+ */
+static void sh1106_CountFlush(sh1106_t * dev, bool full, uint8_t pending, uint32_t sent) {
+    uint32_t complete = sh1106_PanelPages(dev) * (3 + sh1106_PanelWidth(dev)) + pending;
+    dev->stats.flushes++;
+    dev->stats.full_flushes += full ? 1 : 0;
+    dev->stats.bytes_sent += sent;
+    dev->stats.bytes_saved += (sent < complete) ? complete - sent : 0;
+}
+
+/**
+ * @brief Bytes de los comandos pendientes (contraste y start line) de la proxima actualizacion.
+ */
+static uint8_t sh1106_PendingBytes(const sh1106_t * dev) {
+    return (dev->contrast_pending ? 2 : 0) + (dev->scroll_pending ? 1 : 0);
+}
+
+/**
+ * @brief Indica que los comandos pendientes ya se enviaron.
+ */
+static void sh1106_PendingSent(sh1106_t * dev) {
+    dev->contrast_pending = false;
+    dev->scroll_pending = false;
+}
+
+/**
+ * @brief Comienza la transaccion de una actualizacion. Si hay un contraste o un desplazamiento
+ * pendientes, viajan en la misma transaccion que la primera pagina.
+ */
+static void sh1106_BatchStart(sh1106_t * dev) {
+    sh1106_BatchInit(&dev->batch, dev);
+    if (dev->contrast_pending) {
+        sh1106_BatchCmd(&dev->batch, SET_CONSTRAS);
+        sh1106_BatchCmd(&dev->batch, dev->contrast);
+    }
+    if (dev->scroll_pending) {
+        sh1106_BatchCmd(&dev->batch, SET_START_LINE | (dev->scroll * 8));
+    }
+}
+
+/**
+ * @brief Carga en la transaccion los comandos de direccion de la columna first de una pagina del
+ * panel. La pagina es logica, se envia a la pagina de la DDRAM que le corresponde segun el
+ * desplazamiento.
+ */
+static sh1106_status_t sh1106_BatchAddress(sh1106_t * dev, uint8_t page, uint8_t first) {
+    uint8_t column = first + sh1106_ColumnStart(dev, dev->orientation);
+    uint8_t ddram_page = (page + dev->scroll) % SH1106_MAX_PAGES;
+    uint8_t command[] = {(FIRT_PAGE_ADD + ddram_page), FIRT_COLUM_ADD_L | (column & 0x0F),
+                         FIRT_COLUM_ADD_H | (column >> 4)};
+    return sh1106_BatchCmds(&dev->batch, command, sizeof(command));
+}
+
+/**
+ * @brief Carga en la transaccion los comandos de direccion de una pagina del panel y sus columnas
+ * [first, end), tomadas de row (la pagina completa).
+ */
+static sh1106_status_t sh1106_BatchPage(sh1106_t * dev, const uint8_t * row, uint8_t page,
+                                        uint8_t first, uint8_t end) {
+    sh1106_status_t status = sh1106_BatchAddress(dev, page, first);
+    if (status != SH1106_OK) {
+        return status;
+    }
+    return sh1106_BatchData(&dev->batch, &row[first], end - first);
+}
+
+/**
+ * @brief Relacion de multiplex y configuracion de los pads COM del panel. Con SH1106_PANEL son
+ * las del perfil, sino dependen del alto del display.
+ *
+ * @return bool: false si no hay configuracion para el alto del display.
+ */
+static bool sh1106_PanelCom(const sh1106_t * dev, uint8_t * mux_ratio, uint8_t * com_pads) {
+#ifdef SH1106_PANEL
+    (void)dev;
+    *mux_ratio = SH1106_PANEL_FIELD(SH1106_PANEL, MUX_RATIO);
+    *com_pads = SH1106_PANEL_FIELD(SH1106_PANEL, COM_PADS);
+    return true;
+#else
+    switch (sh1106_PanelHeight(dev)) {
+    case 32:
+        *mux_ratio = MUX_RATIO_32HEIGHT;
+        *com_pads = PADS_HARD_SEQUEN;
+        return true;
+    case 64:
+        *mux_ratio = MUX_RATIO_64HEIGHT;
+        *com_pads = PADS_HARD_ALTERNA;
+        return true;
+    default:
+        return false;
+    }
+#endif
+}
+
+/**
+ * @brief Envia una lista de comandos en una transaccion.
+ */
+static sh1106_status_t sh1106_SendCmds(sh1106_t * dev, const uint8_t * cmds, size_t count) {
+    if (sh1106_BusBusy(dev)) {
+        return SH1106_BUSY;
+    }
+    sh1106_BatchInit(&dev->batch, dev);
+    sh1106_status_t status = sh1106_BatchCmds(&dev->batch, cmds, count);
+    if (status != SH1106_OK) {
+        return status;
+    }
+    return sh1106_BatchFlush(&dev->batch);
+}
+
+/**
+ * @brief Envia la configuracion del controlador en una transaccion: la tabla fija, la orientacion,
+ * los pads COM del panel, el contraste del display y la start line del desplazamiento indicado.
+ * El panel se enciende al final, con todo configurado.
+ */
+static sh1106_status_t sh1106_SendInit(sh1106_t * dev, uint8_t scroll) {
+    uint8_t mux_ratio, com_pads;
+
+    if (sh1106_BusBusy(dev)) {
+        return SH1106_BUSY;
+    }
+    if (!sh1106_PanelCom(dev, &mux_ratio, &com_pads)) {
+        return SH1106_ERROR;
+    }
+    uint8_t cmd[] = {
+        sh1106_SegmentRemap(dev->orientation) ? RE_MAP_SEG_INVERT : RE_MAP_SEG_NORMAL,
+        sh1106_ComRemap(dev->orientation) ? COM_OUT_SCAN_NORMA : COM_OUT_SCAN_INVER,
+        MUX_RATIO_CONFIG,
+        mux_ratio,
+        PADS_HARD_CONFIG,
+        com_pads,
+        SET_CONSTRAS,
+        dev->contrast,
+        SET_START_LINE | (scroll * 8),
+        DISPLAY_ON,
+    };
+
+    sh1106_BatchInit(&dev->batch, dev);
+    if (sh1106_BatchCmds(&dev->batch, sh1106_init_commands, sizeof(sh1106_init_commands)) !=
+            SH1106_OK ||
+        sh1106_BatchCmds(&dev->batch, cmd, sizeof(cmd)) != SH1106_OK ||
+        sh1106_BatchFlush(&dev->batch) != SH1106_OK) {
+        return SH1106_ERROR;
+    }
+    dev->scroll = scroll;
+    sh1106_PendingSent(dev);
+    return SH1106_OK;
+}
+
+/**
+ * @brief Primera columna de [first, end) en la que el buffer difiere de la sombra, o end. Avanza
+ * de a una palabra mientras son iguales y luego ubica el byte.
+ */
+static uint8_t sh1106_FindChange(const uint8_t * buffer, const uint8_t * shadow, uint8_t first,
+                                 uint8_t end) {
+    while (first + sizeof(sh1106_word_t) <= end) {
+        sh1106_word_t a, b;
+        memcpy(&a, &buffer[first], sizeof(a));
+        memcpy(&b, &shadow[first], sizeof(b));
+        if (a != b) {
+            break;
+        }
+        first += sizeof(sh1106_word_t);
+    }
+    while (first < end && buffer[first] == shadow[first]) {
+        first++;
+    }
+    return first;
+}
+
+/**
+ * @brief Primera columna de [first, end) en la que el buffer es igual a la sombra, o end.
+ */
+static uint8_t sh1106_FindSame(const uint8_t * buffer, const uint8_t * shadow, uint8_t first,
+                               uint8_t end) {
+    while (first < end && buffer[first] != shadow[first]) {
+        first++;
+    }
+    return first;
+}
+
+/**
+ * @brief Envia las columnas [first, end) de una pagina del buffer de dibujo en una transaccion
+ * (junto con la start line si esta pendiente) y actualiza la sombra.
+ */
+static sh1106_status_t sh1106_SendRun(sh1106_t * dev, uint8_t page, uint8_t first, uint8_t end,
+                                      uint32_t * sent) {
+    sh1106_BatchStart(dev);
+    *sent += sh1106_PendingBytes(dev) + 3 + end - first;
+    const uint8_t * row = &dev->buffer[sh1106_DevWidth(dev) * page];
+    if (sh1106_BatchPage(dev, row, page, first, end) != SH1106_OK ||
+        sh1106_BatchFlush(&dev->batch) != SH1106_OK) {
+        dev->shadow_stale |= 1 << page;
+        return SH1106_ERROR;
+    }
+    sh1106_PendingSent(dev);
+    if (dev->shadow != NULL) {
+        uint16_t offset = sh1106_DevWidth(dev) * page + first;
+        memcpy(&dev->shadow[offset], &dev->buffer[offset], end - first);
+    }
+    return SH1106_OK;
+}
+
+/**
+ * @brief Envia los tramos de las columnas [first, end) de una pagina que difieren de la sombra.
+ * Un tramo se extiende sobre las columnas iguales si el siguiente cambio esta a merge_gap
+ * columnas o menos.
+ */
+static sh1106_status_t sh1106_SendChanges(sh1106_t * dev, uint8_t page, uint8_t first,
+                                          uint8_t end, uint32_t * sent) {
+    const uint8_t * buffer = &dev->buffer[sh1106_DevWidth(dev) * page];
+    const uint8_t * shadow = &dev->shadow[sh1106_DevWidth(dev) * page];
+    uint8_t run = sh1106_FindChange(buffer, shadow, first, end);
+
+    while (run < end) {
+        uint8_t run_end = sh1106_FindSame(buffer, shadow, run, end);
+        uint8_t next = sh1106_FindChange(buffer, shadow, run_end, end);
+        while (next < end && next - run_end <= dev->merge_gap) {
+            run_end = sh1106_FindSame(buffer, shadow, next, end);
+            next = sh1106_FindChange(buffer, shadow, run_end, end);
+        }
+        if (sh1106_SendRun(dev, page, run, run_end, sent) != SH1106_OK) {
+            return SH1106_ERROR;
+        }
+        run = next;
+    }
+    return SH1106_OK;
+}
+
+/**
+ * @brief Indica si una pagina se compara contra la sombra, o se envia todo su rango modificado.
+ */
+static bool sh1106_UseShadow(sh1106_t * dev, bool full, uint8_t page) {
+    return dev->shadow != NULL && !full && !(dev->shadow_stale & (1 << page));
+}
+
+/**
+ * @brief Envia las regiones modificadas de cada pagina, o las paginas completas.
+ */
+static sh1106_status_t sh1106_SendPages(sh1106_t * dev, bool full, uint32_t * sent) {
+    for (uint8_t i = 0; i < sh1106_DevPages(dev); i++) {
+        uint8_t first = full ? 0 : dev->dirty_first[i];
+        uint8_t end = full ? sh1106_DevWidth(dev) : dev->dirty_end[i];
+        if (end == 0) {
+            continue;
+        }
+        // Los comandos de direccion y los datos de cada tramo viajan en una sola transaccion.
+        sh1106_status_t status = sh1106_UseShadow(dev, full, i)
+                                     ? sh1106_SendChanges(dev, i, first, end, sent)
+                                     : sh1106_SendRun(dev, i, first, end, sent);
+        if (status != SH1106_OK) {
+            return SH1106_ERROR;
+        }
+        dev->shadow_stale &= ~(1 << i);
+        dev->dirty_end[i] = 0;
+    }
+    return SH1106_OK;
+}
+
+/**
+ * @brief Gira 90 grados en sentido horario un bloque de 8x8 pixeles: in son 8 columnas de una
+ * pagina del buffer girado y out las 8 columnas que ocupan en una pagina del panel, con
+ * out[7 - j] bit b = in[b] bit j. La trasposicion se hace en una palabra de 64 bits, intercambiando
+ * bloques de 1, 2 y 4 bits.
+ */
+static void sh1106_RotateBlock(const uint8_t * in, uint8_t * out) {
+    uint64_t x = 0, t;
+
+    for (uint8_t i = 0; i < 8; i++) {
+        x |= (uint64_t)in[i] << (8 * i);
+    }
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAull;
+    x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCull;
+    x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ull;
+    x ^= t ^ (t << 28);
+    for (uint8_t i = 0; i < 8; i++) {
+        out[7 - i] = (uint8_t)(x >> (8 * i));
+    }
+}
+
+/**
+ * @brief Columnas [first, end) de cada pagina del panel que cubren las regiones modificadas del
+ * buffer girado. La pagina p del buffer ocupa las 8 columnas del panel que terminan en
+ * width - 8 * p, y cada bloque de 8 columnas del buffer una pagina del panel.
+ */
+static void sh1106_RotatedRanges(sh1106_t * dev, bool full, uint8_t * first, uint8_t * end) {
+    memset(end, 0, SH1106_MAX_PAGES);
+    for (uint8_t page = 0; page < sh1106_DevPages(dev); page++) {
+        uint8_t dirty_first = full ? 0 : dev->dirty_first[page];
+        uint8_t dirty_end = full ? sh1106_DevWidth(dev) : dev->dirty_end[page];
+        if (dirty_end == 0) {
+            continue;
+        }
+        uint8_t column = sh1106_PanelWidth(dev) - 8 * (page + 1);
+        for (uint8_t panel_page = dirty_first / 8; panel_page <= (dirty_end - 1) / 8;
+             panel_page++) {
+            if (end[panel_page] == 0 || column < first[panel_page]) {
+                first[panel_page] = column;
+            }
+            if (column + 8 > end[panel_page]) {
+                end[panel_page] = column + 8;
             }
         }
-        if (sh1106_SendData(&SH1106_Buffer[SH1106_WHIDTH * i], SH1106_WHIDTH) == SH1106_ERROR) {
+        dev->dirty_end[page] = 0;
+    }
+    dev->dirty_all = false;
+    dev->fresh = false;
+}
+
+/**
+ * @brief Arma las columnas [first, end) de una pagina del panel a partir del buffer girado, en
+ * row (la pagina completa). first y end son multiplos de 8.
+ */
+static void sh1106_RotatePage(const sh1106_t * dev, uint8_t page, uint8_t first, uint8_t end,
+                              uint8_t * row) {
+    for (uint8_t column = first; column < end; column += 8) {
+        uint8_t source = (sh1106_PanelWidth(dev) - 8 - column) / 8;
+        sh1106_RotateBlock(&dev->buffer[sh1106_DevWidth(dev) * source + 8 * page], &row[column]);
+    }
+}
+
+/**
+ * @brief Actualizacion de un display girado un cuarto de vuelta: cada pagina del panel con
+ * cambios se arma en la pila y se envia en una transaccion.
+ */
+static sh1106_status_t sh1106_SendRotated(sh1106_t * dev, bool full, uint32_t * sent) {
+    uint8_t first[SH1106_MAX_PAGES], end[SH1106_MAX_PAGES];
+    uint8_t row[SH1106_MAX_WIDTH];
+
+    sh1106_RotatedRanges(dev, full, first, end);
+    for (uint8_t page = 0; page < sh1106_PanelPages(dev); page++) {
+        if (end[page] == 0) {
+            continue;
+        }
+        sh1106_RotatePage(dev, page, first[page], end[page], row);
+        sh1106_BatchStart(dev);
+        *sent += sh1106_PendingBytes(dev) + 3 + end[page] - first[page];
+        if (sh1106_BatchPage(dev, row, page, first[page], end[page]) != SH1106_OK ||
+            sh1106_BatchFlush(&dev->batch) != SH1106_OK) {
+            dev->dirty_all = true;
             return SH1106_ERROR;
         }
+        sh1106_PendingSent(dev);
     }
     return SH1106_OK;
-};
+}
 
-sh1106_status_t sh1106_Fill(sh1106_color_t color) {
-    memset(SH1106_Buffer, (color == BLACK) ? 0x00 : 0xFF, sizeof(SH1106_Buffer));
+#if SH1106_STRIP
+/**
+ * @brief Actualizacion de un display en modo tira: cada pagina se dibuja en el buffer a partir de
+ * la lista de dibujo y se envia completa, en una transaccion.
+ */
+static sh1106_status_t sh1106_SendStrips(sh1106_t * dev, uint32_t * sent) {
+    for (uint8_t page = 0; page < sh1106_DevPages(dev); page++) {
+        sh1106_StripRender(dev, page);
+        sh1106_BatchStart(dev);
+        *sent += sh1106_PendingBytes(dev) + 3 + sh1106_DevWidth(dev);
+        if (sh1106_BatchPage(dev, dev->buffer, page, 0, sh1106_DevWidth(dev)) != SH1106_OK ||
+            sh1106_BatchFlush(&dev->batch) != SH1106_OK) {
+            return SH1106_ERROR;
+        }
+        sh1106_PendingSent(dev);
+    }
+    // Las funciones de dibujo marcan la pagina 0 al reproducir la lista.
+    memset(dev->dirty_end, 0, sizeof(dev->dirty_end));
     return SH1106_OK;
-};
+}
+#endif
 
-sh1106_status_t sh1106_Init(void) {
-    uint8_t cmd1[] = {FIRT_PAGE_ADD,      COM_OUT_SCAN_INVER,
-                      FIRT_COLUM_ADD_L,   FIRT_COLUM_ADD_H,
-                      RE_MAP_SEG_NORMAL,  DISPLAY_NORMAL,
-                      RAT_OSC_FREQ_CONF,  0xF0,
-                      CHARG_DISCHAR_PERI, 0x22,
-                      SET_VCOM_DESEL_LEV, 0x20,
-                      SET_DC_DC_CONTROL,  DC_DC_ENABLE,
-                      DISPLAY_ON};
-
-    for (uint8_t i = 0; i < sizeof(cmd1); i++) {
-        if (sh1106_SendCmd(cmd1[i]) == SH1106_ERROR) {
+/**
+ * @brief Actualizacion sincronica de la pantalla, con el bus ya libre.
+ */
+static sh1106_status_t sh1106_Flush(sh1106_t * dev) {
+    uint32_t sent = 0;
+    bool full = dev->dirty_all || dev->fresh;
+    uint8_t pending = sh1106_PendingBytes(dev);
+    sh1106_status_t status;
+
+#if SH1106_STRIP
+    if (sh1106_StripMode(dev)) {
+        full = true;
+        status = sh1106_SendStrips(dev, &sent);
+    } else
+#endif
+    if (sh1106_QuarterTurn(dev)) {
+        status = sh1106_SendRotated(dev, full, &sent);
+    } else {
+        status = sh1106_SendPages(dev, full, &sent);
+    }
+    if (status != SH1106_OK) {
+        return SH1106_ERROR;
+    }
+    dev->dirty_all = false;
+    dev->fresh = false;
+
+    // Contraste o desplazamiento sin paginas para enviar, por ejemplo luego de una actualizacion
+    // fallida
+    if (sh1106_PendingBytes(dev) != 0) {
+        sh1106_BatchStart(dev);
+        if (sh1106_BatchFlush(&dev->batch) != SH1106_OK) {
             return SH1106_ERROR;
         }
+        sent += sh1106_PendingBytes(dev);
+        sh1106_PendingSent(dev);
     }
 
-    if (SH1106_HEIGHT == 32) {
-        uint8_t cmd2[] = {MUX_RATIO_CONFIG, MUX_RATIO_32HEIGHT, PADS_HARD_CONFIG, PADS_HARD_SEQUEN};
-        for (uint8_t i = 0; i < sizeof(cmd2); i++) {
-            if (sh1106_SendCmd(cmd2[i]) == SH1106_ERROR) {
-                return SH1106_ERROR;
-            }
+    sh1106_CountFlush(dev, full, pending, sent);
+    return SH1106_OK;
+}
+
+#if SH1106_ASYNC
+/**
+ * @brief Termina la actualizacion asincronica. Si fallo, la proxima actualizacion envia la
+ * pantalla completa ya que no se sabe que llego a la DDRAM.
+ */
+static void sh1106_AsyncFinish(sh1106_t * dev, sh1106_status_t status) {
+    if (status != SH1106_OK) {
+        dev->dirty_all = true;
+        dev->contrast_pending = true;
+        dev->scroll_pending = true;
+    }
+    dev->async_status = status;
+    sh1106_FlushEnd(dev, status);
+    if (dev->async_callback != NULL) {
+        dev->async_callback(dev, status);
+    }
+}
+
+/**
+ * @brief Inicia la transmision de la proxima transaccion de la transaccion agrupada del display.
+ */
+static void sh1106_AsyncSend(sh1106_t * dev) {
+    uint8_t count = sh1106_BatchNext(&dev->batch);
+    sh1106_status_t status = dev->transport->send_async(dev, dev->batch.iov, count);
+    sh1106_CountTransaction(dev, dev->batch.iov, count, status);
+    if (status != SH1106_OK) {
+        sh1106_AsyncFinish(dev, SH1106_ERROR);
+    }
+}
+
+/**
+ * @brief Inicia la transmision de la siguiente pagina con cambios, o termina si no quedan.
+ */
+static void sh1106_AsyncNextPage(sh1106_t * dev) {
+    while (dev->async_page < sh1106_PanelPages(dev) && dev->async_end[dev->async_page] == 0) {
+        dev->async_page++;
+    }
+    if (dev->async_page == sh1106_PanelPages(dev)) {
+        if (sh1106_PendingBytes(dev) != 0) {
+            // Contraste o desplazamiento sin paginas para enviar: los comandos viajan solos.
+            sh1106_BatchStart(dev);
+            sh1106_PendingSent(dev);
+            sh1106_AsyncSend(dev);
+            return;
+        }
+        sh1106_AsyncFinish(dev, SH1106_OK);
+        return;
+    }
+
+    uint8_t page = dev->async_page++;
+    // Los comandos entran en el buffer de la transaccion (SH1106_MIN_TRANSFER), no hay envios
+    // intermedios. Los datos quedan por referencia al buffer de transmision.
+    sh1106_BatchStart(dev);
+    sh1106_BatchPage(dev, &dev->front[sh1106_PanelWidth(dev) * page], page,
+                     dev->async_first[page], dev->async_end[page]);
+    sh1106_PendingSent(dev);
+    sh1106_AsyncSend(dev);
+}
+#endif
+
+/**
+ * @brief Junta los tramos de una transaccion en el buffer de la transaccion agrupada del display.
+ * El primer tramo suele ser ese mismo buffer, y entonces no se mueve.
+ *
+ * @return size_t: Tamaño de la transaccion.
+ */
+static size_t sh1106_I2cFrame(sh1106_t * dev, const sh1106_iovec_t * iov, uint8_t count) {
+    size_t size = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (iov[i].data != &dev->batch.buffer[size]) {
+            memmove(&dev->batch.buffer[size], iov[i].data, iov[i].size);
+        }
+        size += iov[i].size;
+    }
+    return size;
+}
+
+/**
+ * @brief Envio por I2C usando la HAL, a la direccion del display.
+ */
+static sh1106_status_t sh1106_I2cSend(sh1106_t * dev, const sh1106_iovec_t * iov, uint8_t count) {
+    size_t size = sh1106_I2cFrame(dev, iov, count);
+    return sh1106_FromHal(HAL_I2C_send(dev->address, dev->batch.buffer, size));
+}
+
+#if SH1106_ASYNC
+/**
+ * @brief Fin de transmision I2C, la HAL la llama desde su interrupcion.
+ */
+static void sh1106_I2cDone(void * context, status_t status) {
+    sh1106_TransferDone((sh1106_t *)context, sh1106_FromHal(status));
+}
+
+/**
+ * @brief Envio I2C sin bloqueo, el display viaja como contexto de la funcion de fin.
+ */
+static sh1106_status_t sh1106_I2cSendAsync(sh1106_t * dev, const sh1106_iovec_t * iov,
+                                           uint8_t count) {
+    size_t size = sh1106_I2cFrame(dev, iov, count);
+    return sh1106_FromHal(
+        HAL_I2C_send_async(dev->address, dev->batch.buffer, size, sh1106_I2cDone, dev));
+}
+#endif
+
+/* === Public function declarations ============================================================ */
+sh1106_status_t sh1106_DevCreate(sh1106_t * dev, const sh1106_config_t * config) {
+    if (config->buffer == NULL || config->transport == NULL || config->width == 0 ||
+        config->height == 0 || config->height % 8 != 0 ||
+        config->width + config->column_offset > SH1106_MAX_WIDTH ||
+        config->height > SH1106_MAX_PAGES * 8 ||
+        (config->max_transfer != 0 && config->max_transfer < SH1106_MIN_TRANSFER)) {
+        return SH1106_ERROR;
+    }
+    bool quarter_turn = config->orientation >= SH1106_ROTATE_90;
+    if (config->orientation > SH1106_ROTATE_270 ||
+        (quarter_turn && (config->width % 8 != 0 || config->shadow != NULL))) {
+        return SH1106_ERROR;
+    }
+#ifdef SH1106_PANEL
+    if (config->width != SH1106_WHIDTH || config->height != SH1106_HEIGHT ||
+        config->column_offset != SH1106_COLUMN_OFFSET || quarter_turn) {
+        return SH1106_ERROR;
+    }
+#endif
+    if (config->list != NULL && (!SH1106_STRIP || config->front != NULL ||
+                                 config->shadow != NULL || quarter_turn)) {
+        return SH1106_ERROR;
+    }
+
+    memset(dev, 0, sizeof(*dev));
+    dev->buffer = config->buffer;
+    dev->width = quarter_turn ? config->height : config->width;
+    dev->height = quarter_turn ? config->width : config->height;
+    dev->pages = dev->height / 8;
+    dev->orientation = config->orientation;
+    dev->column_offset = config->column_offset;
+    dev->address = config->address;
+    dev->transport = config->transport;
+    dev->max_transfer = config->max_transfer;
+    dev->fresh = true;
+    dev->shadow = config->shadow;
+    dev->merge_gap = (config->merge_gap != 0) ? config->merge_gap : SH1106_MERGE_GAP;
+    dev->contrast = SH1106_CONTRAST;
+#if SH1106_ASYNC
+    dev->front = config->front;
+    dev->async_status = SH1106_OK;
+#endif
+#if SH1106_STRIP
+    dev->list = config->list;
+    dev->list_size = config->list_size;
+#endif
+    sh1106_BatchInit(&dev->batch, dev);
+    return SH1106_OK;
+}
+
+sh1106_t * sh1106_Default(void) {
+    return &sh1106_default;
+}
+
+sh1106_status_t sh1106_DevSendCmd(sh1106_t * dev, uint8_t cmd) {
+    if (sh1106_BusBusy(dev)) {
+        return SH1106_BUSY;
+    }
+    sh1106_BatchInit(&dev->batch, dev);
+    sh1106_BatchCmd(&dev->batch, cmd);
+    return sh1106_BatchFlush(&dev->batch);
+}
+
+sh1106_status_t sh1106_DevSendData(sh1106_t * dev, uint8_t * data, size_t size) {
+    if (sh1106_BusBusy(dev)) {
+        return SH1106_BUSY;
+    }
+    sh1106_BatchInit(&dev->batch, dev);
+    if (sh1106_BatchData(&dev->batch, data, size) != SH1106_OK) {
+        return SH1106_ERROR;
+    }
+    return sh1106_BatchFlush(&dev->batch);
+}
+
+void sh1106_BatchInit(sh1106_batch_t * batch, sh1106_t * dev) {
+    batch->dev = dev;
+    batch->size = 0;
+    batch->mode = CONTROL_CMD_SINGLE;
+    batch->data = NULL;
+    batch->data_size = 0;
+}
+
+sh1106_status_t sh1106_BatchCmd(sh1106_batch_t * batch, uint8_t cmd) {
+    if (batch->size == sh1106_BatchCapacity(batch->dev) || batch->mode == CONTROL_DATA_STREAM) {
+        sh1106_status_t status = sh1106_BatchFlush(batch);
+        if (status != SH1106_OK) {
+            return status;
+        }
+    }
+    if (batch->size == 0) {
+        batch->buffer[batch->size++] = CONTROL_CMD_STREAM;
+        batch->mode = CONTROL_CMD_STREAM;
+    }
+    batch->buffer[batch->size++] = cmd;
+#if SH1106_STATS
+    batch->dev->counters.commands++;
+#endif
+    return SH1106_OK;
+}
+
+sh1106_status_t sh1106_BatchCmds(sh1106_batch_t * batch, const uint8_t * cmds, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        sh1106_status_t status = sh1106_BatchCmd(batch, cmds[i]);
+        if (status != SH1106_OK) {
+            return status;
         }
-    } else if (SH1106_HEIGHT == 64) {
-        uint8_t cmd3[] = {MUX_RATIO_CONFIG, MUX_RATIO_64HEIGHT, PADS_HARD_CONFIG,
-                          PADS_HARD_ALTERNA};
-        for (uint8_t i = 0; i < sizeof(cmd3); i++) {
-            if (sh1106_SendCmd(cmd3[i]) == SH1106_ERROR) {
-                return SH1106_ERROR;
+    }
+    return SH1106_OK;
+}
+
+sh1106_status_t sh1106_BatchData(sh1106_batch_t * batch, const uint8_t * data, size_t size) {
+    sh1106_status_t status;
+
+    if (size == 0) {
+        return SH1106_OK;
+    }
+    // Una transaccion lleva un solo stream de datos, al final.
+    if (batch->mode == CONTROL_DATA_STREAM) {
+        status = sh1106_BatchFlush(batch);
+        if (status != SH1106_OK) {
+            return status;
+        }
+    }
+
+    if (batch->mode == CONTROL_CMD_STREAM && batch->size > 0) {
+        // Los comandos pasan de [0x00 c0 c1 ...] a [0x80 c0 0x80 c1 ... 0x40] para poder agregar
+        // datos, dejando lugar para al menos un byte de datos.
+        uint16_t count = batch->size - 1;
+        if (2 * count + 2 > sh1106_BatchCapacity(batch->dev)) {
+            status = sh1106_BatchFlush(batch);
+            if (status != SH1106_OK) {
+                return status;
+            }
+        } else {
+            for (uint16_t i = count; i > 0; i--) {
+                batch->buffer[2 * i - 1] = batch->buffer[i];
+                batch->buffer[2 * i - 2] = CONTROL_CMD_SINGLE;
             }
+            batch->size = 2 * count;
         }
-    } else {
+    }
+
+    batch->buffer[batch->size++] = CONTROL_DATA_STREAM;
+    batch->mode = CONTROL_DATA_STREAM;
+    batch->data = data;
+    batch->data_size = size;
+#if SH1106_STATS
+    batch->dev->counters.data_bytes += size;
+#endif
+    return SH1106_OK;
+}
+
+sh1106_status_t sh1106_BatchFlush(sh1106_batch_t * batch) {
+    sh1106_status_t status = SH1106_OK;
+
+    if (batch->size == 0) {
+        return SH1106_OK;
+    }
+    if (sh1106_BusBusy(batch->dev)) {
+        return SH1106_BUSY;
+    }
+    do {
+        uint8_t count = sh1106_BatchNext(batch);
+        status = batch->dev->transport->send(batch->dev, batch->iov, count);
+        sh1106_CountTransaction(batch->dev, batch->iov, count, status);
+    } while (status == SH1106_OK && batch->data_size > 0);
+    sh1106_BatchInit(batch, batch->dev);
+    return status;
+}
+
+sh1106_status_t sh1106_DevWritePage(sh1106_t * dev, uint8_t page, uint8_t first,
+                                    const uint8_t * data, uint8_t size) {
+    if (sh1106_BusBusy(dev)) {
+        return SH1106_BUSY;
+    }
+    if (page >= sh1106_PanelPages(dev) || size == 0 || first + size > sh1106_PanelWidth(dev)) {
         return SH1106_ERROR;
     }
 
-    if (sh1106_ContrasSet(0x80) == SH1106_ERROR) {
+    sh1106_BatchStart(dev);
+    if (sh1106_BatchAddress(dev, page, first) != SH1106_OK ||
+        sh1106_BatchData(&dev->batch, data, size) != SH1106_OK ||
+        sh1106_BatchFlush(&dev->batch) != SH1106_OK) {
+        dev->shadow_stale |= 1 << page;
         return SH1106_ERROR;
     }
+    sh1106_PendingSent(dev);
+    // La sombra sigue a la DDRAM: la proxima actualizacion restaura lo que difiera del buffer.
+    if (dev->shadow != NULL) {
+        memcpy(&dev->shadow[sh1106_DevWidth(dev) * page + first], data, size);
+    }
+    return SH1106_OK;
+}
+
+sh1106_status_t sh1106_DevContrasSet(sh1106_t * dev, uint8_t contrast) {
+    uint8_t cmd[] = {SET_CONSTRAS, contrast};
+    sh1106_status_t status = sh1106_SendCmds(dev, cmd, sizeof(cmd));
+    if (status == SH1106_OK) {
+        dev->contrast = contrast;
+        dev->contrast_pending = false;
+    }
+    return status;
+}
+
+void sh1106_DevContrasSetOnUpdate(sh1106_t * dev, uint8_t contrast) {
+    dev->contrast = contrast;
+    dev->contrast_pending = true;
+}
+
+void sh1106_DevInvalidate(sh1106_t * dev, uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+    uint8_t dev_width = sh1106_DevWidth(dev), dev_height = sh1106_DevHeight(dev);
+
+    if (x >= dev_width || y >= dev_height || width == 0 || height == 0) {
+        return;
+    }
+    uint8_t end = (width > dev_width - x) ? dev_width : x + width;
+    uint8_t last = (height > dev_height - y) ? dev_height - 1 : y + height - 1;
+    for (uint8_t page = y / 8; page <= last / 8; page++) {
+        sh1106_DevMarkDirty(dev, page, x, end);
+    }
+}
+
+void sh1106_DevMarkDirty(sh1106_t * dev, uint8_t page, uint8_t first, uint8_t end) {
+#if SH1106_STATS
+    dev->counters.drawn_columns += end - first;
+#endif
+    if (dev->dirty_end[page] == 0) {
+        dev->dirty_first[page] = first;
+        dev->dirty_end[page] = end;
+        return;
+    }
+    if (first < dev->dirty_first[page]) {
+        dev->dirty_first[page] = first;
+    }
+    if (end > dev->dirty_end[page]) {
+        dev->dirty_end[page] = end;
+    }
+}
+
+void sh1106_DevCopyPage(sh1106_t * dev, uint8_t page, uint8_t first, const uint8_t * data,
+                        uint8_t size) {
+    uint8_t * row = &dev->buffer[sh1106_DevWidth(dev) * page + first];
+    uint8_t changed = sh1106_FindChange(row, data, 0, size);
+
+    if (changed == size) {
+        return;
+    }
+    while (row[size - 1] == data[size - 1]) {
+        size--;
+    }
+    memcpy(&row[changed], &data[changed], size - changed);
+    sh1106_DevMarkDirty(dev, page, first + changed, first + size);
+}
+
+void sh1106_DevInvalidateAll(sh1106_t * dev) {
+    dev->dirty_all = true;
+    if (dev->scroll != 0) {
+        dev->scroll_pending = true;
+    }
+}
+
+sh1106_status_t sh1106_DevUpdateScreen(sh1106_t * dev) {
+    if (sh1106_BusBusy(dev)) {
+        return SH1106_BUSY;
+    }
+    sh1106_FlushStart(dev);
+    sh1106_status_t status = sh1106_Flush(dev);
+    sh1106_FlushEnd(dev, status);
+    return status;
+}
+
+sh1106_status_t sh1106_DevUpdateScreenFull(sh1106_t * dev) {
+    sh1106_DevInvalidateAll(dev);
+    return sh1106_DevUpdateScreen(dev);
+}
+
+void sh1106_DevSetMergeGap(sh1106_t * dev, uint8_t gap) {
+    dev->merge_gap = gap;
+}
 
-    if (sh1106_Fill(BLACK) == SH1106_ERROR) {
+sh1106_status_t sh1106_FromHal(status_t status) {
+    switch (status) {
+    case HAL_OK:
+        return SH1106_OK;
+    case HAL_BUSY:
+        return SH1106_BUSY;
+    default:
         return SH1106_ERROR;
     }
+}
+
+#if SH1106_ASYNC
+sh1106_status_t sh1106_DevSwapBuffers(sh1106_t * dev) {
+    bool full = dev->dirty_all || dev->fresh;
 
-    if (sh1106_UpdateScreen() == SH1106_ERROR) {
+    if (dev->front == NULL) {
         return SH1106_ERROR;
     }
+    if (sh1106_BusBusy(dev)) {
+        return SH1106_BUSY;
+    }
+    if (sh1106_QuarterTurn(dev)) {
+        // El buffer de transmision tiene el formato del panel: se arma girado.
+        sh1106_RotatedRanges(dev, full, dev->async_first, dev->async_end);
+        for (uint8_t i = 0; i < sh1106_PanelPages(dev); i++) {
+            sh1106_RotatePage(dev, i, dev->async_first[i], dev->async_end[i],
+                              &dev->front[sh1106_PanelWidth(dev) * i]);
+        }
+        return SH1106_OK;
+    }
 
+    for (uint8_t i = 0; i < sh1106_DevPages(dev); i++) {
+        uint8_t first = full ? 0 : dev->dirty_first[i];
+        uint8_t end = full ? sh1106_DevWidth(dev) : dev->dirty_end[i];
+        if (end != 0 && sh1106_UseShadow(dev, full, i)) {
+            // La transmision envia un solo tramo por pagina: el rango se recorta a los cambios.
+            const uint8_t * buffer = &dev->buffer[sh1106_DevWidth(dev) * i];
+            const uint8_t * shadow = &dev->shadow[sh1106_DevWidth(dev) * i];
+            first = sh1106_FindChange(buffer, shadow, first, end);
+            while (end > first && buffer[end - 1] == shadow[end - 1]) {
+                end--;
+            }
+            if (first == end) {
+                end = 0;
+            }
+        }
+        dev->async_first[i] = first;
+        dev->async_end[i] = end;
+        if (end != 0) {
+            uint16_t offset = sh1106_DevWidth(dev) * i + first;
+            memcpy(&dev->front[offset], &dev->buffer[offset], end - first);
+            // Si la transmision falla, la siguiente actualizacion envia la pantalla completa.
+            if (dev->shadow != NULL) {
+                memcpy(&dev->shadow[offset], &dev->buffer[offset], end - first);
+            }
+        }
+        dev->shadow_stale &= ~(1 << i);
+        dev->dirty_end[i] = 0;
+    }
+    dev->dirty_all = false;
+    dev->fresh = false;
     return SH1106_OK;
 }
 
-sh1106_status_t sh1106_DrawPixel(uint8_t x, uint8_t y, sh1106_color_t color) {
-    if (x >= SH1106_WHIDTH || y >= SH1106_HEIGHT) {
+sh1106_status_t sh1106_DevUpdateScreenAsync(sh1106_t * dev, sh1106_async_callback_t callback) {
+    bool full = dev->dirty_all || dev->fresh;
+    uint32_t sent = 0;
+
+    if (dev->transport->send_async == NULL) {
+        return SH1106_ERROR;
+    }
+    sh1106_status_t status = sh1106_DevSwapBuffers(dev);
+    if (status != SH1106_OK) {
+        return status;
+    }
+    for (uint8_t i = 0; i < sh1106_PanelPages(dev); i++) {
+        if (dev->async_end[i] != 0) {
+            sent += 3 + dev->async_end[i] - dev->async_first[i];
+        }
+    }
+    sent += sh1106_PendingBytes(dev);
+    sh1106_CountFlush(dev, full, sh1106_PendingBytes(dev), sent);
+
+    dev->async_callback = callback;
+    dev->async_page = 0;
+    dev->async_status = SH1106_BUSY;
+    sh1106_FlushStart(dev);
+    sh1106_AsyncNextPage(dev);
+    return (dev->async_status == SH1106_ERROR) ? SH1106_ERROR : SH1106_OK;
+}
+
+sh1106_status_t sh1106_DevAsyncStatus(sh1106_t * dev) {
+    return dev->async_status;
+}
+
+void sh1106_TransferDone(sh1106_t * dev, sh1106_status_t status) {
+    if (status != SH1106_OK) {
+        sh1106_CountStatus(dev, status);
+        sh1106_AsyncFinish(dev, SH1106_ERROR);
+        return;
+    }
+    if (dev->batch.data_size > 0) {
+        sh1106_AsyncSend(dev);
+        return;
+    }
+    sh1106_AsyncNextPage(dev);
+}
+#endif
+
+void sh1106_DevGetFlushStats(sh1106_t * dev, sh1106_flush_stats_t * stats) {
+    *stats = dev->stats;
+}
+
+void sh1106_DevResetFlushStats(sh1106_t * dev) {
+    memset(&dev->stats, 0, sizeof(dev->stats));
+}
+
+sh1106_status_t sh1106_DevFill(sh1106_t * dev, sh1106_color_t color) {
+#if SH1106_STRIP
+    if (dev->list != NULL) {
+        sh1106_StripClear(dev, color);
+        sh1106_DevInvalidateAll(dev);
+        return SH1106_OK;
+    }
+#endif
+    memset(dev->buffer, (color == BLACK) ? 0x00 : 0xFF,
+           sh1106_DevWidth(dev) * sh1106_DevPages(dev));
+    if (dev->shadow == NULL) {
+        sh1106_DevInvalidateAll(dev);
+        return SH1106_OK;
+    }
+    // Con sombra la DDRAM sigue siendo conocida, la actualizacion compara todas las paginas.
+    for (uint8_t page = 0; page < sh1106_DevPages(dev); page++) {
+        sh1106_DevMarkDirty(dev, page, 0, sh1106_DevWidth(dev));
+    }
+    return SH1106_OK;
+}
+
+#if SH1106_STATS
+void sh1106_DevGetCounters(const sh1106_t * dev, sh1106_counters_t * counters) {
+    *counters = dev->counters;
+}
+
+void sh1106_DevResetCounters(sh1106_t * dev) {
+    memset(&dev->counters, 0, sizeof(dev->counters));
+}
+
+void sh1106_DevSetClock(sh1106_t * dev, sh1106_clock_t clock) {
+    dev->clock = clock;
+}
+
+void sh1106_DevSetTrace(sh1106_t * dev, sh1106_trace_t trace) {
+    dev->trace = trace;
+}
+#endif
+
+sh1106_status_t sh1106_DevInit(sh1106_t * dev) {
+    sh1106_status_t status = sh1106_SendInit(dev, 0);
+    if (status != SH1106_OK) {
+        return status;
+    }
+
+    // La DDRAM tiene contenido desconocido: se borra completa, aunque el display tenga sombra.
+    sh1106_DevFill(dev, BLACK);
+    sh1106_DevInvalidateAll(dev);
+    if (sh1106_DevUpdateScreen(dev) == SH1106_ERROR) {
+        return SH1106_ERROR;
+    }
+
+    return SH1106_OK;
+}
+
+sh1106_status_t sh1106_DevWarmInit(sh1106_t * dev) {
+    sh1106_status_t status = sh1106_SendInit(dev, dev->scroll);
+    if (status != SH1106_OK) {
+        return status;
+    }
+
+    // La DDRAM tiene lo ultimo que se envio: solo queda pendiente lo modificado desde entonces.
+    dev->fresh = false;
+    return SH1106_OK;
+}
+
+sh1106_status_t sh1106_DevSleep(sh1106_t * dev) {
+    static const uint8_t cmd[] = {DISPLAY_OFF, SET_DC_DC_CONTROL, DC_DC_DISABLE};
+    return sh1106_SendCmds(dev, cmd, sizeof(cmd));
+}
+
+sh1106_status_t sh1106_DevWake(sh1106_t * dev) {
+    static const uint8_t cmd[] = {SET_DC_DC_CONTROL, DC_DC_ENABLE, DISPLAY_ON};
+    return sh1106_SendCmds(dev, cmd, sizeof(cmd));
+}
+
+sh1106_status_t sh1106_DevSetOrientation(sh1106_t * dev, sh1106_orientation_t orientation) {
+    if (orientation > SH1106_ROTATE_270 ||
+        (orientation >= SH1106_ROTATE_90) != (dev->orientation >= SH1106_ROTATE_90)) {
+        return SH1106_ERROR;
+    }
+
+    uint8_t cmd[] = {sh1106_SegmentRemap(orientation) ? RE_MAP_SEG_INVERT : RE_MAP_SEG_NORMAL,
+                     sh1106_ComRemap(orientation) ? COM_OUT_SCAN_NORMA : COM_OUT_SCAN_INVER};
+    sh1106_status_t status = sh1106_SendCmds(dev, cmd, sizeof(cmd));
+    if (status != SH1106_OK) {
+        return status;
+    }
+    // Si el panel pasa a ocupar otras columnas de la DDRAM, su contenido se envia de nuevo.
+    if (sh1106_ColumnStart(dev, orientation) != sh1106_ColumnStart(dev, dev->orientation)) {
+        sh1106_DevInvalidateAll(dev);
+    }
+    dev->orientation = orientation;
+    return SH1106_OK;
+}
+
+sh1106_status_t sh1106_DevDrawPixel(sh1106_t * dev, uint8_t x, uint8_t y, sh1106_color_t color) {
+    if (x >= sh1106_DevWidth(dev) || y >= sh1106_DevHeight(dev)) {
         return SH1106_ERROR;
     }
+#if SH1106_STRIP
+    if (sh1106_DevRecording(dev)) {
+        return sh1106_StripPixel(dev, x, y, color);
+    }
+#endif
 
     if (color == WHITE) {
-        SH1106_Buffer[x + (y / 8) * SH1106_WHIDTH] |= 1 << (y % 8);
+        dev->buffer[x + (y / 8) * sh1106_DevWidth(dev)] |= 1 << (y % 8);
     } else {
-        SH1106_Buffer[x + (y / 8) * SH1106_WHIDTH] &= ~(1 << (y % 8));
+        dev->buffer[x + (y / 8) * sh1106_DevWidth(dev)] &= ~(1 << (y % 8));
     }
+    sh1106_DevMarkDirty(dev, y / 8, x, x + 1);
 
     return SH1106_OK;
 }
+
+sh1106_status_t sh1106_DevScroll(sh1106_t * dev, int8_t pages) {
+    uint8_t count = (pages < 0) ? -pages : pages;
+    uint8_t width = sh1106_DevWidth(dev);
+
+    if (sh1106_BusBusy(dev)) {
+        return SH1106_BUSY;
+    }
+    if (sh1106_QuarterTurn(dev) || sh1106_StripMode(dev)) {
+        return SH1106_ERROR;
+    }
+    if (count == 0) {
+        return SH1106_OK;
+    }
+    dev->scroll = (dev->scroll + SH1106_MAX_PAGES + pages % SH1106_MAX_PAGES) % SH1106_MAX_PAGES;
+    dev->scroll_pending = true;
+    if (count >= sh1106_DevPages(dev)) {
+        dev->shadow_stale = 0xFF;
+        return sh1106_DevFill(dev, BLACK);
+    }
+
+    // El contenido que sigue en pantalla se mueve en el buffer junto con sus regiones modificadas,
+    // y las paginas expuestas quedan en negro, completas para enviar.
+    uint8_t kept = sh1106_DevPages(dev) - count;
+    uint8_t from = (pages > 0) ? count : 0;
+    uint8_t to = (pages > 0) ? 0 : count;
+    uint8_t exposed = (pages > 0) ? kept : 0;
+
+    memmove(&dev->buffer[to * width], &dev->buffer[from * width], kept * width);
+    memmove(&dev->dirty_first[to], &dev->dirty_first[from], kept);
+    memmove(&dev->dirty_end[to], &dev->dirty_end[from], kept);
+    memset(&dev->buffer[exposed * width], 0x00, count * width);
+    for (uint8_t page = exposed; page < exposed + count; page++) {
+        dev->dirty_first[page] = 0;
+        dev->dirty_end[page] = width;
+    }
+    // La sombra sigue a la DDRAM igual que el buffer. Las paginas expuestas muestran paginas de la
+    // DDRAM con contenido anterior, se envian completas.
+    if (dev->shadow != NULL) {
+        memmove(&dev->shadow[to * width], &dev->shadow[from * width], kept * width);
+        uint8_t stale = (pages > 0) ? dev->shadow_stale >> count : dev->shadow_stale << count;
+        dev->shadow_stale = stale | (uint8_t)(((1 << count) - 1) << exposed);
+    }
+    return SH1106_OK;
+}
+
+/* === Capa de compatibilidad (display por defecto) ============================================ */
+sh1106_status_t sh1106_SendCmd(uint8_t cmd) {
+    return sh1106_DevSendCmd(&sh1106_default, cmd);
+};
+
+sh1106_status_t sh1106_SendData(uint8_t * data, size_t size) {
+    return sh1106_DevSendData(&sh1106_default, data, size);
+};
+
+sh1106_status_t sh1106_ContrasSet(uint8_t contrast) {
+    return sh1106_DevContrasSet(&sh1106_default, contrast);
+};
+
+void sh1106_ContrasSetOnUpdate(uint8_t contrast) {
+    sh1106_DevContrasSetOnUpdate(&sh1106_default, contrast);
+}
+
+void sh1106_Invalidate(uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+    sh1106_DevInvalidate(&sh1106_default, x, y, width, height);
+}
+
+void sh1106_InvalidateAll(void) {
+    sh1106_DevInvalidateAll(&sh1106_default);
+}
+
+sh1106_status_t sh1106_UpdateScreen(void) {
+    return sh1106_DevUpdateScreen(&sh1106_default);
+};
+
+sh1106_status_t sh1106_UpdateScreenFull(void) {
+    return sh1106_DevUpdateScreenFull(&sh1106_default);
+}
+
+void sh1106_SetMergeGap(uint8_t gap) {
+    sh1106_DevSetMergeGap(&sh1106_default, gap);
+}
+
+#if SH1106_ASYNC
+sh1106_status_t sh1106_SwapBuffers(void) {
+    return sh1106_DevSwapBuffers(&sh1106_default);
+}
+
+sh1106_status_t sh1106_UpdateScreenAsync(sh1106_async_callback_t callback) {
+    return sh1106_DevUpdateScreenAsync(&sh1106_default, callback);
+}
+
+sh1106_status_t sh1106_AsyncStatus(void) {
+    return sh1106_DevAsyncStatus(&sh1106_default);
+}
+#endif
+
+void sh1106_GetFlushStats(sh1106_flush_stats_t * stats) {
+    sh1106_DevGetFlushStats(&sh1106_default, stats);
+}
+
+void sh1106_ResetFlushStats(void) {
+    sh1106_DevResetFlushStats(&sh1106_default);
+}
+
+sh1106_status_t sh1106_Fill(sh1106_color_t color) {
+    return sh1106_DevFill(&sh1106_default, color);
+};
+
+sh1106_status_t sh1106_Init(void) {
+    return sh1106_DevInit(&sh1106_default);
+}
+
+sh1106_status_t sh1106_WarmInit(void) {
+    return sh1106_DevWarmInit(&sh1106_default);
+}
+
+sh1106_status_t sh1106_Sleep(void) {
+    return sh1106_DevSleep(&sh1106_default);
+}
+
+sh1106_status_t sh1106_Wake(void) {
+    return sh1106_DevWake(&sh1106_default);
+}
+
+sh1106_status_t sh1106_SetOrientation(sh1106_orientation_t orientation) {
+    return sh1106_DevSetOrientation(&sh1106_default, orientation);
+}
+
+sh1106_status_t sh1106_DrawPixel(uint8_t x, uint8_t y, sh1106_color_t color) {
+    return sh1106_DevDrawPixel(&sh1106_default, x, y, color);
+}
+
+sh1106_status_t sh1106_Scroll(int8_t pages) {
+    return sh1106_DevScroll(&sh1106_default, pages);
+}
@@ -4,22 +4,32 @@
  * @brief Header File - Driver para SH1106 - Pantalla OLED
  *
  * Este archivo tiene todas las definiciones necesararias para trabajar con la pantalla oled con
- * controlador sh1106. Actualmente solo funcion usando I2C sobre la HAL de STM32, pero se ira
- * haciendo crecer la libreria para funcionar usando otros protocolos de comunicacion, otras
- * plataformas como ESP. Se incorpora el uso de DMA (Acceso Directo a Memoria) en futuras
- * versiones.
+ * controlador sh1106. Funciona sobre I2C (sh1106_i2c_transport, o por tramos con
+ * sh1106_i2c_gather_transport de sh1106_gather.h) o SPI de 4 hilos (sh1106_spi_transport, en
+ * sh1106_spi.h), eligiendo el transporte de cada display. Con SH1106_ASYNC habilitado la pantalla
+ * puede actualizarse sin bloquear, usando una transmision por interrupcion o DMA de la HAL y un
+ * segundo buffer.
  *
- * <b>FUNCIONES PENDIENTES DE DESARROLLO</b>
- * <ul>
- *   <li>Funcion que dibuje una linea.</li>
- *   <li>Funcion que dibuje un rectangulo.</li>
- *   <li>Funcion que dibuje un circulo.</li>
- *   <li>Funcion que dibuje un circulo relleno.</li>
- *   <li>Funcion que dibuje un arco de circunferencia.</li>
- *   <li>Funcion que dibuje un caracter.</li>
- *   <li>Funcion que dibuje un string.</li>
- *   <li>Funcion que dibuje mapa de bits monocromaticos.</li>
- * </ul>
+ * Cada display se representa con un sh1106_t (buffer, geometria, direccion y transporte), que se
+ * pasa a las funciones sh1106_Dev*. Esto permite manejar varios displays en el mismo bus sin
+ * memoria dinamica. Las funciones sin argumento sh1106_t operan sobre el display por defecto
+ * (sh1106_Default), que usa SH1106_Buffer y la geometria de SH1106_WHIDTH y SH1106_HEIGHT.
+ * Ninguna funcion es reentrante: si varias tareas actualizan un display, lo hacen a traves de la
+ * cola de envios de sh1106_queue.h.
+ *
+ * Con SH1106_PANEL (ver sh1106_panel.h) la geometria de todos los displays se fija en compilacion
+ * a la de un perfil de panel, y deja de leerse de cada sh1106_t.
+ *
+ * Con SH1106_STATS cada display cuenta sus transacciones, errores y la duracion de sus
+ * actualizaciones, y avisa el inicio y el fin de cada actualizacion (ver sh1106_counters_t).
+ *
+ * Con SH1106_STRIP un display puede trabajar en modo tira (ver sh1106_strip.h): las funciones de
+ * dibujo se guardan en una lista y la actualizacion dibuja y envia una pagina por vez, con un
+ * buffer de una sola pagina.
+ *
+ * Las lineas, rectangulos, circulos y arcos estan en sh1106_gfx.h, el texto en sh1106_font.h,
+ * los mapas de bits en sh1106_bitmap.h y las imagenes comprimidas en sh1106_image.h. Las capas
+ * que se dibujan por separado y se combinan antes de enviar estan en sh1106_layer.h.
  */
 
 #ifndef INC_SH1106_H_
@@ -28,18 +38,146 @@
 /* === Inclusion de archivos de cabecera  ====================================================== */
 #include "stdint.h"
 #include "stddef.h"
+#include "stdbool.h"
 #include <string.h>
 #include "hal_i2c.h"
+#include "sh1106_panel.h"
 
 /* === Definicion de los macros publicos ======================================================= */
+#ifdef SH1106_PANEL
+#define SH1106_WHIDTH        SH1106_PANEL_FIELD(SH1106_PANEL, WIDTH)  ///< @brief Ancho del perfil
+#define SH1106_HEIGHT        SH1106_PANEL_FIELD(SH1106_PANEL, HEIGHT) ///< @brief Alto del perfil
+#define SH1106_COLUMN_OFFSET SH1106_PANEL_FIELD(SH1106_PANEL, COLUMN_OFFSET)
+#else
 #define SH1106_WHIDTH (128) ///< @brief Ancho de la pantalla en pixeles
 #define SH1106_HEIGHT (64)  ///< @brief Alto de la pantalla en pixeles
+#endif
 
 /**
  * @brief Tamaño del buffer para almacenar datos de la DDRAM, que se nviaran a la pantalla
  */
 #define BUFFER_SIZE (SH1106_WHIDTH * SH1106_HEIGHT / 8)
 
+#define SH1106_PAGES (SH1106_HEIGHT / 8) ///< @brief Cantidad de paginas (bloques de 8 filas)
+
+#define SH1106_MAX_WIDTH (132) ///< @brief Columnas de la DDRAM del controlador
+#define SH1106_MAX_PAGES (8)   ///< @brief Paginas de la DDRAM del controlador
+
+/**
+ * @brief Paginas maximas del buffer de dibujo. Con el display girado un cuarto de vuelta las
+ * columnas del panel pasan a ser filas del buffer.
+ */
+#define SH1106_MAX_DRAW_PAGES (SH1106_MAX_WIDTH / 8)
+
+/**
+ * @brief Tamaño del buffer necesario para un display de las dimensiones indicadas.
+ */
+#define SH1106_BUFFER_SIZE(width, height) ((width) * (height) / 8)
+
+#ifndef SH1106_I2C_ADDRESS
+#define SH1106_I2C_ADDRESS (0x3C) ///< @brief Direccion I2C (7 bits) del display por defecto
+#endif
+
+/**
+ * @brief Primera columna de la DDRAM conectada al panel del display por defecto. Los paneles de
+ * 128 columnas montados sobre los 132 del controlador suelen usar un offset de 2.
+ */
+#ifndef SH1106_COLUMN_OFFSET
+#define SH1106_COLUMN_OFFSET (0)
+#endif
+
+/**
+ * @brief Capacidad del buffer de comandos y bytes de control de una transaccion agrupada
+ * (sh1106_batch_t). Los datos no se copian a este buffer, salvo en sh1106_i2c_transport, que
+ * necesita la transaccion contigua y por eso la limita a este tamaño.
+ */
+#ifndef SH1106_BATCH_SIZE
+#define SH1106_BATCH_SIZE (255)
+#endif
+
+/**
+ * @brief Bytes maximos por transaccion en el bus del display por defecto, o 0 sin limite (por
+ * ejemplo el maximo de un DMA). Los datos que no entran se envian en varias transacciones, que el
+ * controlador escribe a continuacion. Cada display puede indicar el suyo en sh1106_config_t.
+ */
+#ifndef SH1106_MAX_TRANSFER
+#define SH1106_MAX_TRANSFER (0)
+#endif
+
+/**
+ * @brief Minimo valor de max_transfer: los comandos de direccion de una pagina, el contraste y la
+ * start line como pares con Co=1, el byte de control de los datos y un byte de datos.
+ */
+#define SH1106_MIN_TRANSFER (2 * 6 + 2)
+
+/**
+ * @brief Habilita la sombra de la DDRAM en el display por defecto (ver sh1106_config_t.shadow).
+ * Agrega un buffer de BUFFER_SIZE bytes.
+ */
+#ifndef SH1106_SHADOW
+#define SH1106_SHADOW (0)
+#endif
+
+/**
+ * @brief Columnas sin cambios que se envian igual para unir dos tramos modificados de una pagina,
+ * en lugar de abrir otra transaccion. En I2C cada tramo nuevo cuesta la direccion, los 3 comandos
+ * de direccion con su byte de control y el control de los datos (unos 8 bytes); en SPI, los 3
+ * comandos.
+ */
+#ifndef SH1106_MERGE_GAP
+#define SH1106_MERGE_GAP (8)
+#endif
+
+/**
+ * @brief Habilita la actualizacion de pantalla asincronica (sh1106_UpdateScreenAsync). Agrega un
+ * segundo buffer de BUFFER_SIZE bytes y requiere HAL_I2C_send_async.
+ */
+#ifndef SH1106_ASYNC
+#define SH1106_ASYNC (0)
+#endif
+
+/**
+ * @brief Habilita el modo tira (ver sh1106_strip.h). El display por defecto pasa a usar un buffer
+ * de una pagina (SH1106_WHIDTH bytes) y una lista de dibujo de SH1106_STRIP_LIST_SIZE bytes, en
+ * lugar de BUFFER_SIZE bytes de buffer y otros tantos de buffer de transmision.
+ */
+#ifndef SH1106_STRIP
+#define SH1106_STRIP (0)
+#endif
+
+/**
+ * @brief Bytes de la lista de dibujo del display por defecto en modo tira.
+ */
+#ifndef SH1106_STRIP_LIST_SIZE
+#define SH1106_STRIP_LIST_SIZE (256)
+#endif
+
+/**
+ * @brief Habilita los contadores de cada display (sh1106_DevGetCounters), el histograma de
+ * duracion de las actualizaciones y las funciones de traza. Sin SH1106_STATS no agregan memoria ni
+ * instrucciones.
+ */
+#ifndef SH1106_STATS
+#define SH1106_STATS (0)
+#endif
+
+/**
+ * @brief Intervalos del histograma de duracion de las actualizaciones: el intervalo 0 cuenta las
+ * de 0 ticks del reloj, el i las de 2^(i-1) a 2^i - 1 ticks, y el ultimo todas las mas largas.
+ */
+#ifndef SH1106_STATS_BUCKETS
+#define SH1106_STATS_BUCKETS (16)
+#endif
+
+/**
+ * @brief Bytes de control del protocolo I2C del sh1106. Cada transaccion es una secuencia de
+ * pares (control, dato). Con Co=1 el controlador espera otro byte de control despues del dato, con
+ * Co=0 todos los bytes restantes de la transaccion se interpretan segun D/C.
+ */
+#define CONTROL_CMD_STREAM  (0x00) ///< @brief Co=0 D/C=0, el resto de la transaccion son comandos
+#define CONTROL_CMD_SINGLE  (0x80) ///< @brief Co=1 D/C=0, un solo comando y otro byte de control
+#define CONTROL_DATA_STREAM (0x40) ///< @brief Co=0 D/C=1, el resto de la transaccion son datos
+
 // Comandos.
 #define DISPLAY_ON  (0xAF) ///< @brief Enviar este comando enciende la pantalla
 #define DISPLAY_OFF (0xAE) ///< @brief Enviar este comando apaga la pantalla
@@ -49,6 +187,12 @@
  */
 #define SET_CONSTRAS     (0x81)
 
+/**
+ * @brief Fila de la DDRAM que se muestra en la primera fila de la pantalla, se suma la fila
+ * (0 a 63). Cambiarla desplaza verticalmente la imagen sin reenviar la DDRAM.
+ */
+#define SET_START_LINE (0x40)
+
 #define FIRT_PAGE_ADD    (0xB0) ///< @brief Comando para poscionarse en la pagina 0.
 #define FIRT_COLUM_ADD_H (0X10) ///< @brief Bit mas signficativos de la primera columna
 #define FIRT_COLUM_ADD_L (0X00) ///< @brief Bit menos signficativos de la primera columna
@@ -135,8 +279,15 @@
  * panel debe estar apagada mientras se emite este comando.
  */
 #define SET_DC_DC_CONTROL (0xAD)
-#define DC_DC_DISABLE     (0x8A) ///< @brief habilita el convertidor DC-DD (Vpp interno).
-#define DC_DC_ENABLE      (0x8A) ///< @brief deshabilita el convertidor DC-DD (Vpp externo).
+#define DC_DC_DISABLE     (0x8A) ///< @brief deshabilita el convertidor DC-DC (Vpp externo).
+#define DC_DC_ENABLE      (0x8B) ///< @brief habilita el convertidor DC-DC (Vpp interno).
+
+/**
+ * @brief Contraste con el que se crean los displays, hasta que se cambie con sh1106_ContrasSet.
+ */
+#ifndef SH1106_CONTRAST
+#define SH1106_CONTRAST (0x80)
+#endif
 
 /* === Typedef declarations ==================================================================== */
 /**
@@ -159,11 +310,548 @@ typedef enum {
     WHITE = 0x01  // pixel encendido
 } sh1106_color_t;
 
+/**
+ * @brief Orientacion del contenido respecto del panel montado.
+ *
+ * Los giros de 180 grados y los espejos los hace el controlador, invirtiendo el sentido de los
+ * segmentos (RE_MAP_SEG_INVERT) y de los COM (COM_OUT_SCAN_NORMA), sin costo de CPU. Los giros de
+ * un cuarto de vuelta intercambian el ancho y el alto del buffer de dibujo: el driver traspone
+ * bloques de 8x8 pixeles al enviar cada pagina, y el de 270 grados agrega el giro de 180 del
+ * controlador.
+ */
+typedef enum {
+    SH1106_ROTATE_0 = 0, ///< @brief Sin giro.
+    SH1106_ROTATE_180,   ///< @brief Giro de 180 grados.
+    SH1106_MIRROR_X,     ///< @brief Espejo horizontal: la columna x se ve en width - 1 - x.
+    SH1106_MIRROR_Y,     ///< @brief Espejo vertical: la fila y se ve en height - 1 - y.
+    SH1106_ROTATE_90,    ///< @brief Giro de 90 grados en sentido horario.
+    SH1106_ROTATE_270,   ///< @brief Giro de 270 grados en sentido horario.
+} sh1106_orientation_t;
+
+/**
+ * @brief Contadores de la actualizacion de pantalla.
+ *
+ * Permiten medir cuanto trafico se ahorra al enviar solo las regiones modificadas del buffer. Los
+ * bytes se cuentan como bytes de comando mas bytes de datos enviados a la HAL.
+ */
+typedef struct {
+    uint32_t flushes;      ///< @brief Cantidad de llamadas a sh1106_UpdateScreen.
+    uint32_t full_flushes; ///< @brief Actualizaciones que enviaron la pantalla completa.
+    uint32_t bytes_sent;   ///< @brief Bytes (comandos + datos) enviados.
+    uint32_t bytes_saved;  ///< @brief Bytes no enviados respecto a actualizaciones completas.
+} sh1106_flush_stats_t;
+
+typedef struct sh1106_s sh1106_t;
+
+#if SH1106_STATS
+/**
+ * @brief Contadores de un display, con SH1106_STATS.
+ *
+ * Los comandos y datos se cuentan al cargarlos en una transaccion y las transacciones al
+ * entregarlas al transporte. Los estados SH1106_BUSY se separan segun su origen: el transporte (el
+ * bus lo tiene otro dispositivo) o el propio display (una actualizacion asincronica en curso).
+ */
+typedef struct {
+    uint32_t commands;      ///< @brief Comandos enviados.
+    uint32_t data_bytes;    ///< @brief Bytes de datos para la DDRAM enviados.
+    uint32_t transactions;  ///< @brief Transacciones entregadas al transporte.
+    uint32_t bus_bytes;     ///< @brief Bytes de las transacciones, con los bytes de control.
+    uint32_t errors;        ///< @brief Transacciones que el transporte termino con error.
+    uint32_t bus_busy;      ///< @brief Transacciones que el transporte rechazo por bus ocupado.
+    uint32_t async_busy;    ///< @brief Llamadas rechazadas por una actualizacion en curso.
+    uint32_t drawn_columns; ///< @brief Columnas de 8 pixeles marcadas como modificadas.
+    uint32_t flushes;       ///< @brief Actualizaciones terminadas, bien o con error.
+    uint32_t latency_max;   ///< @brief Mayor duracion de una actualizacion, en ticks del reloj.
+    /**
+     * @brief Histograma de duracion de las actualizaciones (ver SH1106_STATS_BUCKETS). Sin reloj
+     * no se completa.
+     */
+    uint32_t latency[SH1106_STATS_BUCKETS];
+} sh1106_counters_t;
+
+/**
+ * @brief Reloj con el que se mide la duracion de las actualizaciones, por ejemplo un contador de
+ * ciclos o de microsegundos. Puede desbordar: se usa la diferencia entre dos lecturas.
+ */
+typedef uint32_t (*sh1106_clock_t)(void);
+
+/**
+ * @brief Eventos que se informan a la funcion de traza.
+ */
+typedef enum {
+    SH1106_TRACE_FLUSH_START = 0, ///< @brief Comienza una actualizacion.
+    SH1106_TRACE_FLUSH_END,       ///< @brief Termina una actualizacion, con su resultado.
+} sh1106_trace_event_t;
+
+/**
+ * @brief Funcion de traza. El fin de una actualizacion asincronica se informa desde
+ * sh1106_TransferDone, normalmente en una interrupcion.
+ *
+ * @param dev: Display que se actualiza.
+ * @param event: Evento.
+ * @param status: Resultado de la actualizacion, SH1106_OK en SH1106_TRACE_FLUSH_START.
+ */
+typedef void (*sh1106_trace_t)(sh1106_t * dev, sh1106_trace_event_t event,
+                               sh1106_status_t status);
+#endif
+
+/**
+ * @brief Tramo de una transaccion: los transportes reciben cada transaccion como una lista de
+ * tramos consecutivos, para no tener que juntar comandos y datos en un buffer.
+ */
+typedef hal_iovec_t sh1106_iovec_t;
+
+/**
+ * @brief Transaccion agrupada de comandos y datos.
+ *
+ * Acumula comandos en un buffer, intercalando los bytes de control necesarios, y agrega los datos
+ * al final por referencia, sin copiarlos: la transaccion se envia como dos tramos, el buffer y los
+ * datos. Los comandos se agrupan en un stream (un solo byte de control); si luego se agregan
+ * datos, los comandos ya cargados se convierten a pares con Co=1 y los datos se envian al final
+ * con un unico byte de control. Como despues de un stream de datos el controlador no acepta mas
+ * bytes de control, agregar un comando o mas datos despues de datos envia la transaccion
+ * pendiente y comienza otra. Lo mismo ocurre cuando se llena el buffer. Si la transaccion supera
+ * el maximo del display, los datos restantes se envian en transacciones siguientes.
+ */
+typedef struct {
+    sh1106_t * dev;                    ///< @brief Display al que se envia la transaccion.
+    uint8_t buffer[SH1106_BATCH_SIZE]; ///< @brief Comandos, incluyendo bytes de control.
+    uint16_t size;                     ///< @brief Cantidad de bytes cargados en buffer.
+    uint8_t mode;                      ///< @brief Ultimo byte de control stream cargado.
+    const uint8_t * data;              ///< @brief Datos pendientes de enviar, por referencia.
+    size_t data_size;                  ///< @brief Cantidad de datos pendientes.
+    sh1106_iovec_t iov[2];             ///< @brief Tramos de la transaccion que se esta enviando.
+} sh1106_batch_t;
+
+/**
+ * @brief Funcion que el driver llama al terminar una actualizacion asincronica, con el resultado.
+ */
+typedef void (*sh1106_async_callback_t)(sh1106_t * dev, sh1106_status_t status);
+
+/**
+ * @brief Transporte por el que el driver llega al controlador.
+ *
+ * Las transacciones se entregan ya armadas, con los bytes de control del sh1106: indican que bytes
+ * son comandos y cuales datos. El transporte I2C los envia tal cual; el SPI los traduce al pin D/C.
+ * Para probar el driver sin hardware alcanza con un transporte propio que registre lo recibido.
+ */
+typedef struct {
+    /**
+     * @brief Envia una transaccion, formada por count tramos consecutivos, y espera a que termine.
+     */
+    sh1106_status_t (*send)(sh1106_t * dev, const sh1106_iovec_t * iov, uint8_t count);
+#if SH1106_ASYNC
+    /**
+     * @brief Inicia una transaccion sin esperar. Al terminar, el transporte debe llamar a
+     * sh1106_TransferDone. NULL si el transporte no lo soporta.
+     */
+    sh1106_status_t (*send_async)(sh1106_t * dev, const sh1106_iovec_t * iov, uint8_t count);
+#endif
+    size_t max_transfer; ///< @brief Bytes maximos por transaccion del transporte, 0 sin limite.
+} sh1106_transport_t;
+
+/**
+ * @brief Parametros para crear un display con sh1106_DevCreate.
+ */
+typedef struct {
+    uint8_t * buffer;                     ///< @brief Buffer de dibujo (SH1106_BUFFER_SIZE).
+    uint8_t * front;                      ///< @brief Buffer de transmision o NULL (sin async).
+    uint8_t width;                        ///< @brief Ancho del panel en pixeles.
+    uint8_t height;                       ///< @brief Alto del panel en pixeles, multiplo de 8.
+    /**
+     * @brief Orientacion inicial. Los giros de un cuarto de vuelta necesitan un ancho de panel
+     * multiplo de 8, no admiten sombra ni desplazamiento, y no estan disponibles con SH1106_PANEL.
+     */
+    sh1106_orientation_t orientation;
+    uint8_t column_offset;                ///< @brief Primera columna de la DDRAM del panel.
+    uint8_t address;                      ///< @brief Direccion I2C (7 bits) o dispositivo SPI.
+    const sh1106_transport_t * transport; ///< @brief Transporte, por ejemplo sh1106_i2c_transport.
+    size_t max_transfer;                  ///< @brief Bytes maximos por transaccion, 0 sin limite.
+    /**
+     * @brief Sombra de la DDRAM (SH1106_BUFFER_SIZE) o NULL. Con sombra, la actualizacion compara
+     * las regiones modificadas contra lo que ya tiene el controlador y envia solo los tramos que
+     * cambiaron, aunque la aplicacion redibuje toda la pantalla en cada cuadro.
+     */
+    uint8_t * shadow;
+    uint8_t merge_gap; ///< @brief Columnas sin cambios que unen dos tramos, 0 es SH1106_MERGE_GAP.
+    /**
+     * @brief Lista de dibujo del modo tira, o NULL para dibujar en un buffer completo. Solo con
+     * SH1106_STRIP; buffer pasa a ser de una pagina (width bytes) y no se admiten buffer de
+     * transmision, sombra ni giros de un cuarto de vuelta.
+     */
+    uint8_t * list;
+    uint16_t list_size; ///< @brief Bytes de la lista de dibujo.
+} sh1106_config_t;
+
+/**
+ * @brief Display sh1106.
+ *
+ * La aplicacion reserva la estructura (estatica o en la pila) y la inicializa con sh1106_DevCreate.
+ * Los campos son de uso interno del driver, solo deben leerse.
+ */
+struct sh1106_s {
+    uint8_t * buffer;                     ///< @brief Buffer de dibujo, pagina por pagina.
+    uint8_t width;                        ///< @brief Ancho del buffer de dibujo en pixeles.
+    uint8_t height;                       ///< @brief Alto del buffer de dibujo en pixeles.
+    uint8_t pages;                        ///< @brief Cantidad de paginas (height / 8).
+    sh1106_orientation_t orientation;     ///< @brief Orientacion del contenido.
+    uint8_t column_offset;                ///< @brief Primera columna de la DDRAM del panel.
+    uint8_t address;                      ///< @brief Direccion o dispositivo en el bus.
+    const sh1106_transport_t * transport; ///< @brief Transporte usado para llegar al display.
+    size_t max_transfer;                  ///< @brief Bytes maximos por transaccion, 0 sin limite.
+
+    /**
+     * @brief Rango de columnas modificadas de cada pagina, [dirty_first, dirty_end). Una pagina
+     * sin cambios tiene dirty_end en 0.
+     */
+    uint8_t dirty_first[SH1106_MAX_DRAW_PAGES];
+    uint8_t dirty_end[SH1106_MAX_DRAW_PAGES];
+    bool dirty_all; ///< @brief La proxima actualizacion envia la pantalla completa.
+    /**
+     * @brief Display recien creado: se desconoce la DDRAM y la proxima actualizacion envia la
+     * pantalla completa, salvo que antes se haga un reinicio en caliente.
+     */
+    bool fresh;
+
+    uint8_t * shadow;     ///< @brief Contenido de la DDRAM, por pagina logica, o NULL.
+    uint8_t shadow_stale; ///< @brief Paginas (un bit cada una) con la sombra desactualizada.
+    uint8_t merge_gap;    ///< @brief Columnas sin cambios maximas entre tramos que se unen.
+
+    sh1106_flush_stats_t stats; ///< @brief Contadores de actualizacion de pantalla.
+    sh1106_batch_t batch;       ///< @brief Transaccion usada por el driver para este display.
+
+    uint8_t scroll;        ///< @brief Pagina de la DDRAM que se muestra arriba (start line / 8).
+    bool scroll_pending;   ///< @brief La proxima actualizacion envia la start line.
+    uint8_t contrast;      ///< @brief Contraste, se vuelve a enviar en un reinicio en caliente.
+    bool contrast_pending; ///< @brief La proxima actualizacion envia el contraste.
+
+#if SH1106_STATS
+    sh1106_counters_t counters; ///< @brief Contadores del display.
+    sh1106_clock_t clock;       ///< @brief Reloj de las actualizaciones, o NULL.
+    sh1106_trace_t trace;       ///< @brief Funcion de traza, o NULL.
+    uint32_t flush_start;       ///< @brief Lectura del reloj al comenzar la actualizacion.
+#endif
+
+#if SH1106_ASYNC
+    uint8_t * front; ///< @brief Buffer de transmision de la actualizacion asincronica.
+    /**
+     * @brief Rango de columnas de cada pagina que envia la transmision en curso.
+     */
+    uint8_t async_first[SH1106_MAX_PAGES];
+    uint8_t async_end[SH1106_MAX_PAGES];
+    uint8_t async_page;                     ///< @brief Proxima pagina a revisar para enviar.
+    volatile sh1106_status_t async_status;  ///< @brief SH1106_BUSY mientras se transmite.
+    sh1106_async_callback_t async_callback; ///< @brief Funcion de fin de la actualizacion.
+#endif
+
+#if SH1106_STRIP
+    uint8_t * list;            ///< @brief Lista de dibujo del modo tira, o NULL.
+    uint16_t list_size;        ///< @brief Bytes de la lista de dibujo.
+    uint16_t list_used;        ///< @brief Bytes ocupados de la lista de dibujo.
+    sh1106_color_t background; ///< @brief Color del ultimo sh1106_Fill, fondo de cada pagina.
+    bool replaying;            ///< @brief Se esta dibujando una pagina a partir de la lista.
+#endif
+};
+
+/* === Public inline function declarations ===================================================== */
+/**
+ * @brief Ancho del display en pixeles. Con SH1106_PANEL es una constante del perfil.
+ */
+static inline uint8_t sh1106_DevWidth(const sh1106_t * dev) {
+#ifdef SH1106_PANEL
+    (void)dev;
+    return SH1106_WHIDTH;
+#else
+    return dev->width;
+#endif
+}
+
+/**
+ * @brief Alto del display en pixeles. Con SH1106_PANEL es una constante del perfil.
+ */
+static inline uint8_t sh1106_DevHeight(const sh1106_t * dev) {
+#ifdef SH1106_PANEL
+    (void)dev;
+    return SH1106_HEIGHT;
+#else
+    return dev->height;
+#endif
+}
+
+/**
+ * @brief Paginas del display. Con SH1106_PANEL es una constante del perfil.
+ */
+static inline uint8_t sh1106_DevPages(const sh1106_t * dev) {
+#ifdef SH1106_PANEL
+    (void)dev;
+    return SH1106_PAGES;
+#else
+    return dev->pages;
+#endif
+}
+
+/**
+ * @brief Primera columna de la DDRAM conectada al panel. Con SH1106_PANEL es una constante del
+ * perfil.
+ */
+static inline uint8_t sh1106_DevColumnOffset(const sh1106_t * dev) {
+#ifdef SH1106_PANEL
+    (void)dev;
+    return SH1106_COLUMN_OFFSET;
+#else
+    return dev->column_offset;
+#endif
+}
+
+#if SH1106_STRIP
+/**
+ * @brief Indica si las funciones de dibujo deben guardarse en la lista del modo tira en lugar de
+ * dibujar en el buffer.
+ */
+static inline bool sh1106_DevRecording(const sh1106_t * dev) {
+    return dev->list != NULL && !dev->replaying;
+}
+#endif
+
+/* === Public variable declarations ============================================================ */
+/**
+ * @brief Transporte I2C sobre HAL_I2C_send y HAL_I2C_send_async. La HAL necesita la transaccion
+ * contigua, por lo que los datos se copian a continuacion de los comandos, en el buffer de la
+ * transaccion agrupada del display, y cada transaccion se limita a SH1106_BATCH_SIZE bytes.
+ */
+extern const sh1106_transport_t sh1106_i2c_transport;
+
 /* === Public function declarations ============================================================ */
+/**
+ * @brief Inicializa la estructura de un display. No envia nada al controlador, para eso se usa
+ * sh1106_DevInit.
+ *
+ * @param dev: Display a inicializar.
+ * @param config: Buffers, geometria, direccion y transporte del display.
+ * @return sh1106_status_t: SH1106_ERROR si la geometria no entra en la DDRAM del controlador (o no
+ * es la del perfil SH1106_PANEL), faltan el buffer o el transporte, o max_transfer es menor a
+ * SH1106_MIN_TRANSFER.
+ */
+sh1106_status_t sh1106_DevCreate(sh1106_t * dev, const sh1106_config_t * config);
+
+/**
+ * @brief Display por defecto, sobre el que operan las funciones de la capa de compatibilidad.
+ *
+ * @return sh1106_t*: Puntero al display por defecto.
+ */
+sh1106_t * sh1106_Default(void);
+
+/**
+ * @brief Igual que sh1106_SendCmd, sobre el display indicado.
+ */
+sh1106_status_t sh1106_DevSendCmd(sh1106_t * dev, uint8_t cmd);
+
+/**
+ * @brief Igual que sh1106_SendData, sobre el display indicado.
+ */
+sh1106_status_t sh1106_DevSendData(sh1106_t * dev, uint8_t * data, size_t size);
+
+/**
+ * @brief Escribe datos directamente en la DDRAM, a partir de una columna de una pagina del panel,
+ * sin pasar por el buffer de dibujo, que no se modifica ni se marca.
+ *
+ * La pagina y la columna son las del panel (con el display girado un cuarto de vuelta, las del
+ * panel sin girar). Si hay sombra se actualiza, por lo que la proxima actualizacion envia lo que
+ * difiera del buffer en las regiones modificadas.
+ *
+ * @param dev: Display destino.
+ * @param page: Pagina del panel.
+ * @param first: Primera columna del panel.
+ * @param data: Datos, una columna de 8 pixeles por byte con el bit 0 arriba.
+ * @param size: Cantidad de bytes.
+ * @return sh1106_status_t: SH1106_ERROR si los datos no entran en la pagina o fallo el envio,
+ * SH1106_BUSY si hay una actualizacion asincronica en curso.
+ */
+sh1106_status_t sh1106_DevWritePage(sh1106_t * dev, uint8_t page, uint8_t first,
+                                    const uint8_t * data, uint8_t size);
+
+/**
+ * @brief Igual que sh1106_ContrasSet, sobre el display indicado.
+ */
+sh1106_status_t sh1106_DevContrasSet(sh1106_t * dev, uint8_t contrast);
+
+/**
+ * @brief Igual que sh1106_ContrasSetOnUpdate, sobre el display indicado.
+ */
+void sh1106_DevContrasSetOnUpdate(sh1106_t * dev, uint8_t contrast);
+
+/**
+ * @brief Igual que sh1106_Fill, sobre el display indicado.
+ */
+sh1106_status_t sh1106_DevFill(sh1106_t * dev, sh1106_color_t color);
+
+/**
+ * @brief Igual que sh1106_Invalidate, sobre el display indicado.
+ */
+void sh1106_DevInvalidate(sh1106_t * dev, uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
+/**
+ * @brief Marca como modificado el rango de columnas [first, end) de una pagina.
+ *
+ * Pensada para las funciones de dibujo, que ya recortaron los limites y conocen las paginas que
+ * modifican. No verifica los argumentos.
+ *
+ * @param dev: Display modificado.
+ * @param page: Pagina modificada.
+ * @param first: Primera columna modificada.
+ * @param end: Columna siguiente a la ultima modificada.
+ */
+void sh1106_DevMarkDirty(sh1106_t * dev, uint8_t page, uint8_t first, uint8_t end);
+
+/**
+ * @brief Copia columnas de una pagina al buffer de dibujo y marca como modificado solo el tramo
+ * entre la primera y la ultima columna que cambiaron, para las funciones que arman cuadros
+ * completos fuera del buffer (capas, colas, escala de grises). No verifica los argumentos ni
+ * admite el modo tira.
+ *
+ * @param dev: Display.
+ * @param page: Pagina.
+ * @param first: Columna de data[0].
+ * @param data: Columnas a copiar.
+ * @param size: Cantidad de columnas.
+ */
+void sh1106_DevCopyPage(sh1106_t * dev, uint8_t page, uint8_t first, const uint8_t * data,
+                        uint8_t size);
+
+/**
+ * @brief Igual que sh1106_InvalidateAll, sobre el display indicado.
+ */
+void sh1106_DevInvalidateAll(sh1106_t * dev);
+
+/**
+ * @brief Igual que sh1106_UpdateScreen, sobre el display indicado.
+ */
+sh1106_status_t sh1106_DevUpdateScreen(sh1106_t * dev);
+
+/**
+ * @brief Igual que sh1106_UpdateScreenFull, sobre el display indicado.
+ */
+sh1106_status_t sh1106_DevUpdateScreenFull(sh1106_t * dev);
+
+/**
+ * @brief Igual que sh1106_SetMergeGap, sobre el display indicado.
+ */
+void sh1106_DevSetMergeGap(sh1106_t * dev, uint8_t gap);
+
+/**
+ * @brief Convierte el estado devuelto por la HAL al estado del driver. La usan los transportes.
+ *
+ * @param status: Estado de la HAL.
+ * @return sh1106_status_t: Estado equivalente del driver.
+ */
+sh1106_status_t sh1106_FromHal(status_t status);
+
+#if SH1106_ASYNC
+/**
+ * @brief Igual que sh1106_SwapBuffers, sobre el display indicado.
+ *
+ * @return sh1106_status_t: SH1106_ERROR si el display no tiene buffer de transmision.
+ */
+sh1106_status_t sh1106_DevSwapBuffers(sh1106_t * dev);
+
+/**
+ * @brief Igual que sh1106_UpdateScreenAsync, sobre el display indicado.
+ *
+ * @return sh1106_status_t: SH1106_ERROR si el display no tiene buffer de transmision o su
+ * transporte no soporta envios sin bloqueo.
+ */
+sh1106_status_t sh1106_DevUpdateScreenAsync(sh1106_t * dev, sh1106_async_callback_t callback);
+
+/**
+ * @brief Igual que sh1106_AsyncStatus, sobre el display indicado.
+ */
+sh1106_status_t sh1106_DevAsyncStatus(sh1106_t * dev);
+
+/**
+ * @brief Fin de una transaccion iniciada con send_async del transporte.
+ *
+ * La llama el transporte (normalmente desde una interrupcion), no la aplicacion.
+ *
+ * @param dev: Display cuya transaccion termino.
+ * @param status: Resultado de la transaccion.
+ */
+void sh1106_TransferDone(sh1106_t * dev, sh1106_status_t status);
+#endif
+
+/**
+ * @brief Igual que sh1106_GetFlushStats, sobre el display indicado.
+ */
+void sh1106_DevGetFlushStats(sh1106_t * dev, sh1106_flush_stats_t * stats);
+
+/**
+ * @brief Igual que sh1106_ResetFlushStats, sobre el display indicado.
+ */
+void sh1106_DevResetFlushStats(sh1106_t * dev);
+
+#if SH1106_STATS
+/**
+ * @brief Copia los contadores del display.
+ */
+void sh1106_DevGetCounters(const sh1106_t * dev, sh1106_counters_t * counters);
+
+/**
+ * @brief Pone en cero los contadores del display.
+ */
+void sh1106_DevResetCounters(sh1106_t * dev);
+
+/**
+ * @brief Indica el reloj con el que se mide la duracion de las actualizaciones, o NULL para no
+ * medirla.
+ */
+void sh1106_DevSetClock(sh1106_t * dev, sh1106_clock_t clock);
+
+/**
+ * @brief Indica la funcion que se llama al comenzar y al terminar cada actualizacion, o NULL.
+ */
+void sh1106_DevSetTrace(sh1106_t * dev, sh1106_trace_t trace);
+#endif
+
+/**
+ * @brief Igual que sh1106_Init, sobre el display indicado.
+ */
+sh1106_status_t sh1106_DevInit(sh1106_t * dev);
+
+/**
+ * @brief Igual que sh1106_WarmInit, sobre el display indicado.
+ */
+sh1106_status_t sh1106_DevWarmInit(sh1106_t * dev);
+
+/**
+ * @brief Igual que sh1106_Sleep, sobre el display indicado.
+ */
+sh1106_status_t sh1106_DevSleep(sh1106_t * dev);
+
+/**
+ * @brief Igual que sh1106_Wake, sobre el display indicado.
+ */
+sh1106_status_t sh1106_DevWake(sh1106_t * dev);
+
+/**
+ * @brief Igual que sh1106_SetOrientation, sobre el display indicado.
+ */
+sh1106_status_t sh1106_DevSetOrientation(sh1106_t * dev, sh1106_orientation_t orientation);
+
+/**
+ * @brief Igual que sh1106_DrawPixel, sobre el display indicado.
+ */
+sh1106_status_t sh1106_DevDrawPixel(sh1106_t * dev, uint8_t x, uint8_t y, sh1106_color_t color);
+
+/**
+ * @brief Igual que sh1106_Scroll, sobre el display indicado.
+ */
+sh1106_status_t sh1106_DevScroll(sh1106_t * dev, int8_t pages);
+
+/* === Capa de compatibilidad (display por defecto) ============================================ */
 /**
  * @brief Envia un comando determinado al sh1106.
  * @param cmd - Comando a enviar (ver #defines de sh1106.h).
- * @note Nota 1: para I2C se usa HAL_I2C_Mem_Write de ST, 0x00 es el bit de control con Co=0 D/C=0.
+ * @note Nota 1: el comando se envia en su propia transaccion precedido del byte de control
+ * CONTROL_CMD_STREAM. Para enviar varios comandos juntos usar sh1106_BatchCmd.
  * @return sh1106_status_t: Estado de la operacion.
  */
 sh1106_status_t sh1106_SendCmd(uint8_t cmd);
@@ -172,12 +860,61 @@ sh1106_status_t sh1106_SendCmd(uint8_t cmd);
  * @brief Envia un stream de datos a la DDRAM
  * @param data - puntero al buffer de datos a enviar
  * @param size - tamaño de buffer a envair
- * @note Nota 1: para para I2C se usa HAL_I2C_Mem_Write de ST, 0x40 es el bit de control con Co=0
- * D/C=1.
+ * @note Nota 1: los datos se envian precedidos del byte de control CONTROL_DATA_STREAM, sin
+ * copiarlos, en tantas transacciones como sea necesario segun el maximo por transaccion.
  * @return sh1106_status_t: Estado de la operacion.
  */
 sh1106_status_t sh1106_SendData(uint8_t * data, size_t size);
 
+/**
+ * @brief Vacia una transaccion agrupada sin enviarla.
+ *
+ * @param batch: Transaccion a inicializar.
+ * @param dev: Display al que se enviara la transaccion.
+ */
+void sh1106_BatchInit(sh1106_batch_t * batch, sh1106_t * dev);
+
+/**
+ * @brief Agrega un comando a una transaccion agrupada.
+ *
+ * @param batch: Transaccion donde se agrega el comando.
+ * @param cmd: Comando a agregar (ver #defines de sh1106.h).
+ * @return sh1106_status_t: Estado de la operacion. Solo puede fallar si fue necesario enviar la
+ * transaccion pendiente.
+ */
+sh1106_status_t sh1106_BatchCmd(sh1106_batch_t * batch, uint8_t cmd);
+
+/**
+ * @brief Agrega una lista de comandos a una transaccion agrupada.
+ *
+ * @param batch: Transaccion donde se agregan los comandos.
+ * @param cmds: Puntero a los comandos.
+ * @param count: Cantidad de comandos.
+ * @return sh1106_status_t: Estado de la operacion.
+ */
+sh1106_status_t sh1106_BatchCmds(sh1106_batch_t * batch, const uint8_t * cmds, size_t count);
+
+/**
+ * @brief Agrega datos para la DDRAM a una transaccion agrupada.
+ *
+ * Los datos no se copian: deben permanecer sin cambios hasta que se envie la transaccion.
+ *
+ * @param batch: Transaccion donde se agregan los datos.
+ * @param data: Puntero a los datos.
+ * @param size: Cantidad de bytes.
+ * @return sh1106_status_t: Estado de la operacion.
+ */
+sh1106_status_t sh1106_BatchData(sh1106_batch_t * batch, const uint8_t * data, size_t size);
+
+/**
+ * @brief Envia lo acumulado en una transaccion agrupada y la deja vacia.
+ *
+ * @param batch: Transaccion a enviar. Si esta vacia no se realiza ninguna transaccion.
+ * @return sh1106_status_t: Estado de la operacion. SH1106_BUSY si hay una actualizacion
+ * asincronica en curso (el bus esta ocupado).
+ */
+sh1106_status_t sh1106_BatchFlush(sh1106_batch_t * batch);
+
 /**
  * @brief
  *
@@ -190,18 +927,66 @@ sh1106_status_t sh1106_SendData(uint8_t * data, size_t size);
  */
 sh1106_status_t sh1106_ContrasSet(uint8_t contrast);
 
+/**
+ * @brief Cambia el contraste junto con la proxima actualizacion de pantalla: el comando viaja en
+ * la misma transaccion que la primera pagina, por lo que el cuadro nuevo no se muestra con el
+ * contraste anterior ni el anterior con el nuevo mas alla de esa pagina. Si no hay paginas para
+ * enviar, la actualizacion envia solo el contraste.
+ *
+ * @param contrast: Contraste, de 0 a 255.
+ */
+void sh1106_ContrasSetOnUpdate(uint8_t contrast);
+
 /**
  * @brief LLena la variable buffer con los bits del color correspondiente.
  *
+ * En modo tira vacia la lista de dibujo: el color pasa a ser el fondo de todas las paginas.
+ *
  * @param color: Es el color que se desea usar para rellenar la pantalla, pudiendo ser blanco o
  * negro.
  * @return sh1106_status_t: Estado de la operacion.
  */
 sh1106_status_t sh1106_Fill(sh1106_color_t color);
 
+/**
+ * @brief Marca como modificada una region rectangular del buffer.
+ *
+ * Las funciones de dibujo del driver marcan automaticamente lo que modifican. Esta funcion solo es
+ * necesaria si la aplicacion escribe directamente sobre SH1106_Buffer. La region se recorta a los
+ * limites de la pantalla.
+ *
+ * @param x: Coordenada en "x" de la esquina superior izquierda.
+ * @param y: Coordenada en "y" de la esquina superior izquierda.
+ * @param width: Ancho de la region en pixeles.
+ * @param height: Alto de la region en pixeles.
+ */
+void sh1106_Invalidate(uint8_t x, uint8_t y, uint8_t width, uint8_t height);
+
+/**
+ * @brief Fuerza que la proxima actualizacion envie la pantalla completa.
+ *
+ * Se usa cuando el contenido de la DDRAM es desconocido (por ejemplo luego de un reset del
+ * display).
+ */
+void sh1106_InvalidateAll(void);
+
 /**
  * @brief Actualizacion de pantalla.
  *
+ * Solo se envian las paginas que fueron modificadas desde la ultima actualizacion y, dentro de
+ * cada pagina, solo el rango de columnas modificado. Si se llamo a sh1106_InvalidateAll (o a
+ * sh1106_Fill) se envia la pantalla completa.
+ *
+ * Si el display tiene sombra de la DDRAM, el rango modificado de cada pagina se compara (de a una
+ * palabra) contra la sombra y solo se envian los tramos de columnas que cambiaron. Dos tramos
+ * separados por hasta merge_gap columnas iguales se envian juntos. sh1106_Fill no fuerza la
+ * pantalla completa, por lo que borrar y redibujar todo en cada cuadro envia solo lo que cambio.
+ * Si la aplicacion escribe la DDRAM sin pasar por esta funcion, debe llamar a
+ * sh1106_InvalidateAll.
+ *
+ * En modo tira cada pagina se dibuja en el buffer de una pagina reproduciendo la lista de dibujo y
+ * se envia completa, por lo que siempre se envia la pantalla completa.
+ *
  * Envia de el contenido del buffer (por I2C) a la DDRAM del display. El controlador divide el
  * "alto" de la pantalla en bloques de 8 pixeles (de arriba hacia abajo), cada uno de estos grupo
  * corresponde a una "pagina" y cuando nos posicionamos en una pagina debemos pasar la direccion de
@@ -211,35 +996,100 @@ sh1106_status_t sh1106_Fill(sh1106_color_t color);
  * direccion de las columnas nuevamente. Este proceso se realiza hasta cubrir todas las paginas del
  * alto seteado.
  *
- * @note Nota 1: Esta version no tiene en cuenta offset que puede existir en el conexionado fisico
- * de los segmentos y el tamaño de la pantalla oled. Si la pantalla conectada al driver es de un
- * ancho menor al ancho maximo del driver, y se encuentra fisicamente conectada a un segmento
- * distiton de 0 (es decir esta despalzada), puede ser que la infomarcion que se vea en pantalla
- * apareza desplazada e incompleta. Esto se solucionara en futuras versiones.
+ * @note Nota 1: Si la pantalla conectada al driver es de un ancho menor al ancho maximo del driver
+ * y se encuentra fisicamente conectada a un segmento distinto de 0 (es decir esta desplazada), la
+ * direccion de columna se corrige con el column_offset del display (SH1106_COLUMN_OFFSET para el
+ * display por defecto).
  *
  * @return sh1106_status_t: Estado de la operacion.
  */
 sh1106_status_t sh1106_UpdateScreen(void);
 
+/**
+ * @brief Actualizacion completa de pantalla, sin importar las regiones modificadas.
+ *
+ * @return sh1106_status_t: Estado de la operacion.
+ */
+sh1106_status_t sh1106_UpdateScreenFull(void);
+
+/**
+ * @brief Cambia cuantas columnas sin cambios pueden separar dos tramos que se envian juntos al
+ * comparar contra la sombra de la DDRAM.
+ *
+ * @param gap: Columnas sin cambios, 0 envia solo los bytes que cambiaron.
+ */
+void sh1106_SetMergeGap(uint8_t gap);
+
+#if SH1106_ASYNC
+/**
+ * @brief Copia el buffer de dibujo (SH1106_Buffer) al buffer de transmision.
+ *
+ * Solo se copian las regiones modificadas, que pasan a ser las que enviara la proxima
+ * transmision. SH1106_Buffer conserva su contenido, por lo que se puede seguir dibujando el
+ * siguiente cuadro sobre el anterior.
+ *
+ * @return sh1106_status_t: SH1106_BUSY si hay una transmision en curso, ya que el buffer de
+ * transmision esta en uso.
+ */
+sh1106_status_t sh1106_SwapBuffers(void);
+
+/**
+ * @brief Actualizacion de pantalla sin bloqueo.
+ *
+ * Llama a sh1106_SwapBuffers e inicia la transmision de la primera pagina modificada con
+ * HAL_I2C_send_async. Las paginas siguientes se envian desde la funcion de fin de transmision, por
+ * lo que mientras tanto la aplicacion puede dibujar el siguiente cuadro en SH1106_Buffer.
+ *
+ * @param callback: Funcion a llamar al terminar de enviar el cuadro, puede ser NULL. Se ejecuta en
+ * el contexto de la interrupcion de la HAL.
+ * @return sh1106_status_t: SH1106_OK si la transmision comenzo (o no habia nada que enviar),
+ * SH1106_BUSY si todavia se esta enviando el cuadro anterior.
+ */
+sh1106_status_t sh1106_UpdateScreenAsync(sh1106_async_callback_t callback);
+
+/**
+ * @brief Estado de la actualizacion asincronica.
+ *
+ * @return sh1106_status_t: SH1106_BUSY mientras haya una transmision en curso, sino el resultado
+ * de la ultima actualizacion asincronica.
+ */
+sh1106_status_t sh1106_AsyncStatus(void);
+#endif
+
+/**
+ * @brief Copia los contadores de actualizacion de pantalla.
+ *
+ * @param stats: Puntero donde se copian los contadores.
+ */
+void sh1106_GetFlushStats(sh1106_flush_stats_t * stats);
+
+/**
+ * @brief Pone en cero los contadores de actualizacion de pantalla.
+ */
+void sh1106_ResetFlushStats(void);
+
 /**
  * @brief Configuracion de parametros.
  *
- * La funcion de inicializacion, envia de formar secuencial los comandos de configuracion necesario
- * para poder empezar a utilizar el display.
+ * La funcion de inicializacion, envia en una sola transaccion los comandos de configuracion
+ * necesarios para poder empezar a utilizar el display. Los comandos fijos estan en una tabla
+ * constante, a la que se agregan los que dependen del display (orientacion, pads COM, contraste y
+ * start line).
  *
  * <ul>
+ *   <li>Apagar el display mientras se configura.</li>
  *   <li>Indicar la direccion de pagina 0.</li>
  *   <li>Indicar la direccion de columna 0 (comando doble).</li>
- *   <li>Indicar el sentido de incremento de las direcciones de los pines COMMON.</li>
- *   <li>Setear el contraste.</li>
- *   <li>Indicar el sentido de incremento de las direcciones de los pines SEGMENT.</li>
  *   <li>Indicar la relacion entre el estado del pixel y el valor de dato de la DDRAM.</li>
- *   <li>Configurar el Ratio Multiplexacion.</li>
  *   <li>Configurar el divisor de clock y la frecuencia del oscilador interno.</li>
  *   <li>Seterar los periodos de pre-carga y descarga.</li>
- *   <li>Configurar los PADs.</li>
  *   <li>Setear el valor de VCOM.</li>
  *   <li>Habilitar el convertidor DC/DC interno (para no usar Vpp externo).</li>
+ *   <li>Indicar el sentido de los pines SEGMENT y COMMON segun la orientacion.</li>
+ *   <li>Configurar el Ratio Multiplexacion.</li>
+ *   <li>Configurar los PADs.</li>
+ *   <li>Setear el contraste.</li>
+ *   <li>Setear la start line.</li>
  *   <li>Encender el display.</li>
  *   <li>Limpiar el buffer donde se cargan los datos a enviar a la DDRAM</li>
  *   <li>Enviar los datos a la pantalla</li>
@@ -249,6 +1099,50 @@ sh1106_status_t sh1106_UpdateScreen(void);
  */
 sh1106_status_t sh1106_Init(void);
 
+/**
+ * @brief Reinicio en caliente: configura el controlador sin borrar ni reenviar la pantalla.
+ *
+ * Envia la misma transaccion de configuracion que sh1106_Init, con el contraste y el
+ * desplazamiento actuales, y toma el contenido de la DDRAM como intacto: por ejemplo luego de un
+ * reset del microcontrolador con el display alimentado y el buffer en memoria retenida. Las
+ * regiones modificadas que quedaban pendientes, incluso la pantalla completa invalidada, se
+ * conservan y se envian en la proxima actualizacion.
+ *
+ * @return sh1106_status_t: Estado de la operacion.
+ */
+sh1106_status_t sh1106_WarmInit(void);
+
+/**
+ * @brief Pasa el display a bajo consumo: apaga el panel y el convertidor DC-DC.
+ *
+ * El controlador conserva la DDRAM y la configuracion, y sigue aceptando actualizaciones de
+ * pantalla mientras duerme.
+ *
+ * @return sh1106_status_t: Estado de la operacion.
+ */
+sh1106_status_t sh1106_Sleep(void);
+
+/**
+ * @brief Sale del bajo consumo: enciende el convertidor DC-DC y el panel, en una transaccion.
+ *
+ * @return sh1106_status_t: Estado de la operacion.
+ */
+sh1106_status_t sh1106_Wake(void);
+
+/**
+ * @brief Cambia la orientacion del contenido, en una transaccion.
+ *
+ * El giro de 180 grados y los espejos se aplican en el controlador sobre lo que ya tiene la DDRAM,
+ * por lo que no se reenvia la pantalla salvo que cambie la primera columna del panel en la DDRAM
+ * (paneles que no estan centrados en las 132 columnas). El ancho y el alto del buffer de dibujo
+ * no pueden cambiar: los giros de un cuarto de vuelta solo se cambian entre si.
+ *
+ * @param orientation: Orientacion nueva.
+ * @return sh1106_status_t: SH1106_ERROR si la orientacion no es valida o cambia las dimensiones
+ * del buffer de dibujo.
+ */
+sh1106_status_t sh1106_SetOrientation(sh1106_orientation_t orientation);
+
 /**
  * @brief Dibuja un pixel en un punto determinado de la pantalla del color deseado.
  *
@@ -258,4 +1152,24 @@ sh1106_status_t sh1106_Init(void);
  * @return sh1106_status_t: Estado de la operacion.
  */
 sh1106_status_t sh1106_DrawPixel(uint8_t x, uint8_t y, sh1106_color_t color);
+
+/**
+ * @brief Desplaza verticalmente el contenido de la pantalla una cantidad de paginas.
+ *
+ * El desplazamiento lo hace el controlador cambiando la start line, por lo que el contenido que
+ * sigue en pantalla no se reenvia. La DDRAM funciona como un anillo de 8 paginas: la pagina logica
+ * p (la que se ve en la posicion p desde arriba) esta en la pagina (p + scroll) % 8 de la DDRAM, y
+ * sh1106_UpdateScreen aplica esa correspondencia al enviar cada pagina.
+ *
+ * SH1106_Buffer sigue representando lo que se ve en pantalla: se desplaza en memoria junto con sus
+ * regiones modificadas, de modo que las funciones de dibujo no cambian. Las paginas que quedan
+ * expuestas se borran y se marcan como modificadas; la aplicacion dibuja en ellas y la proxima
+ * actualizacion envia la nueva start line junto con esas paginas, en la misma transaccion.
+ *
+ * @param pages: Paginas a desplazar. Positivo desplaza el contenido hacia arriba (las paginas
+ * nuevas aparecen abajo, como en un log) y negativo hacia abajo.
+ * @return sh1106_status_t: SH1106_BUSY si hay una actualizacion asincronica en curso, o
+ * SH1106_ERROR si el display esta girado un cuarto de vuelta o en modo tira.
+ */
+sh1106_status_t sh1106_Scroll(int8_t pages);
 #endif /* INC_SH1106_H_ */
@@ -0,0 +1,158 @@
+/**
+ * @file sh1106_bitmap.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Source File - Mapas de bits monocromaticos para el driver SH1106
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106_bitmap.h"
+#include "sh1106_strip.h"
+
+/* === Private macros definitions ============================================================== */
+/**
+ * @brief Recorre las columnas de una pagina combinando origen y destino con la operacion indicada.
+ *
+ * Cada byte del origen (y de la mascara) se arma con la parte baja de la pagina "lo" y la parte
+ * alta de la pagina "hi", desplazadas para quedar alineadas con la pagina destino. Sin mascara
+ * (mask_lo en NULL) se modifican todos los bits de area.
+ */
+#define SH1106_BLIT_COLUMNS(operation)                                                             \
+    for (uint8_t i = 0; i < count; i++) {                                                          \
+        uint8_t s = (uint8_t)((src_lo[i] >> shift) | (src_hi[i] << (8 - shift)));                  \
+        uint8_t m = area;                                                                          \
+        if (mask_lo != NULL) {                                                                     \
+            m &= (uint8_t)((mask_lo[i] >> shift) | (mask_hi[i] << (8 - shift)));                   \
+        }                                                                                          \
+        uint8_t d = dst[i];                                                                        \
+        dst[i] = (d & ~m) | ((operation) & m);                                                     \
+    }
+
+/* === Private variable declarations =========================================================== */
+/**
+ * @brief Pagina vacia, se usa como origen de las filas fuera del mapa de bits.
+ */
+static const uint8_t blank_page[SH1106_MAX_WIDTH] = {0};
+
+/* === Private function declarations =========================================================== */
+/**
+ * @brief Direccion de una pagina de una imagen, o una pagina fija si queda fuera de la imagen.
+ */
+static inline const uint8_t * sh1106_SourcePage(const uint8_t * image, int16_t page,
+                                                uint8_t pages, uint8_t width, int16_t column,
+                                                const uint8_t * outside) {
+    if (page < 0 || page >= pages) {
+        return outside;
+    }
+    return &image[page * width + column];
+}
+
+/**
+ * @brief Combina una pagina del destino con la operacion de raster.
+ */
+static void sh1106_BlitPage(uint8_t * dst, const uint8_t * src_lo, const uint8_t * src_hi,
+                            const uint8_t * mask_lo, const uint8_t * mask_hi, uint8_t shift,
+                            uint8_t area, uint8_t count, sh1106_rop_t rop) {
+    switch (rop) {
+    case SH1106_ROP_COPY:
+        SH1106_BLIT_COLUMNS(s);
+        break;
+    case SH1106_ROP_OR:
+        SH1106_BLIT_COLUMNS(d | s);
+        break;
+    case SH1106_ROP_AND:
+        SH1106_BLIT_COLUMNS(d & s);
+        break;
+    case SH1106_ROP_XOR:
+        SH1106_BLIT_COLUMNS(d ^ s);
+        break;
+    default:
+        SH1106_BLIT_COLUMNS(d & ~s);
+        break;
+    }
+}
+
+/* === Public function declarations ============================================================ */
+sh1106_status_t sh1106_DrawBitmap(sh1106_t * dev, const sh1106_bitmap_t * bitmap, int16_t x,
+                                  int16_t y, sh1106_rop_t rop) {
+    return sh1106_DrawBitmapRegion(dev, bitmap, 0, 0, bitmap->width, bitmap->height, x, y, rop);
+}
+
+sh1106_status_t sh1106_DrawBitmapRegion(sh1106_t * dev, const sh1106_bitmap_t * bitmap,
+                                        int16_t src_x, int16_t src_y, int16_t width,
+                                        int16_t height, int16_t x, int16_t y, sh1106_rop_t rop) {
+    if (rop > SH1106_ROP_AND_NOT) {
+        return SH1106_ERROR;
+    }
+#if SH1106_STRIP
+    if (sh1106_DevRecording(dev)) {
+        return sh1106_StripBitmap(dev, bitmap, src_x, src_y, width, height, x, y, rop);
+    }
+#endif
+
+    // Recorte de la region contra el mapa de bits
+    if (src_x < 0) {
+        x -= src_x;
+        width += src_x;
+        src_x = 0;
+    }
+    if (src_y < 0) {
+        y -= src_y;
+        height += src_y;
+        src_y = 0;
+    }
+    if (width > bitmap->width - src_x) {
+        width = bitmap->width - src_x;
+    }
+    if (height > bitmap->height - src_y) {
+        height = bitmap->height - src_y;
+    }
+
+    // Recorte contra la pantalla
+    int16_t first = (x < 0) ? -x : 0;
+    int16_t end = (x + width > sh1106_DevWidth(dev)) ? sh1106_DevWidth(dev) - x : width;
+    int16_t top = (y < 0) ? 0 : y;
+    int16_t bottom = (y + height > sh1106_DevHeight(dev)) ? sh1106_DevHeight(dev) : y + height;
+    if (first >= end || top >= bottom) {
+        return SH1106_OK;
+    }
+
+    uint8_t pages = (bitmap->height + 7) >> 3;
+    uint8_t count = end - first;
+    int16_t column = src_x + first;
+
+    for (int16_t page = top >> 3; page <= (bottom - 1) >> 3; page++) {
+        // Fila de la region que cae en el bit 0 de la pagina destino, y su ubicacion en el origen.
+        // row es mayor o igual a -7, por lo que source + 8 no es negativo.
+        int16_t row = page * 8 - y;
+        int16_t source = src_y + row;
+        int16_t source_page = ((source + 8) >> 3) - 1;
+        uint8_t shift = source - source_page * 8;
+
+        // Bits de la pagina destino que corresponden a filas de la region
+        int16_t low = (row < 0) ? -row : 0;
+        int16_t high = (height - row < 8) ? height - row : 8;
+        uint8_t area = (uint8_t)(0xFF << low) & (uint8_t)(0xFF >> (8 - high));
+
+        const uint8_t * src_lo = sh1106_SourcePage(bitmap->data, source_page, pages,
+                                                   bitmap->width, column, blank_page);
+        const uint8_t * src_hi = sh1106_SourcePage(bitmap->data, source_page + 1, pages,
+                                                   bitmap->width, column, blank_page);
+        const uint8_t * mask_lo = NULL;
+        const uint8_t * mask_hi = NULL;
+        if (bitmap->mask != NULL) {
+            mask_lo = sh1106_SourcePage(bitmap->mask, source_page, pages, bitmap->width, column,
+                                        blank_page);
+            mask_hi = sh1106_SourcePage(bitmap->mask, source_page + 1, pages, bitmap->width,
+                                        column, blank_page);
+        }
+
+        sh1106_BlitPage(&dev->buffer[page * sh1106_DevWidth(dev) + x + first], src_lo, src_hi,
+                        mask_lo, mask_hi, shift, area, count, rop);
+        sh1106_DevMarkDirty(dev, page, x + first, x + end);
+    }
+    return SH1106_OK;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file sh1106_bitmap.h
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Header File - Mapas de bits monocromaticos para el driver SH1106
+ *
+ * Los mapas de bits tienen el mismo formato que el buffer del display: (height + 7) / 8 paginas de
+ * width bytes, con una columna de 8 pixeles por byte y el bit 0 arriba. Se copian al buffer byte
+ * por byte combinandolos con una operacion de raster. Si la fila destino no es multiplo de 8, cada
+ * byte del destino se arma con dos bytes de paginas consecutivas del origen, sin escribir pixeles
+ * sueltos.
+ *
+ * Un sprite agrega una mascara con el mismo formato: solo se modifican los pixeles en los que la
+ * mascara vale 1. Sin mascara se modifica todo el rectangulo del mapa de bits.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#ifndef INC_SH1106_BITMAP_H_
+#define INC_SH1106_BITMAP_H_
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106.h"
+
+/* === Public data type declarations =========================================================== */
+/**
+ * @brief Operacion de raster con la que se combina el origen (S) con el destino (D).
+ */
+typedef enum {
+    SH1106_ROP_COPY = 0, ///< @brief D = S
+    SH1106_ROP_OR,       ///< @brief D = D | S
+    SH1106_ROP_AND,      ///< @brief D = D & S
+    SH1106_ROP_XOR,      ///< @brief D = D ^ S
+    SH1106_ROP_AND_NOT,  ///< @brief D = D & ~S
+} sh1106_rop_t;
+
+/**
+ * @brief Mapa de bits monocromatico, por paginas, opcionalmente con mascara.
+ */
+typedef struct {
+    const uint8_t * data; ///< @brief Pixeles, (height + 7) / 8 paginas de width bytes.
+    const uint8_t * mask; ///< @brief Mascara con el mismo formato, o NULL.
+    uint8_t width;        ///< @brief Ancho en pixeles.
+    uint8_t height;       ///< @brief Alto en pixeles.
+} sh1106_bitmap_t;
+
+/* === Public function declarations ============================================================ */
+/**
+ * @brief Dibuja un mapa de bits completo.
+ *
+ * @param dev: Display sobre el que se dibuja.
+ * @param bitmap: Mapa de bits.
+ * @param x: Coordenada en "x" de la esquina superior izquierda.
+ * @param y: Coordenada en "y" de la esquina superior izquierda.
+ * @param rop: Operacion de raster.
+ * @return sh1106_status_t: SH1106_ERROR si la operacion de raster no es valida.
+ */
+sh1106_status_t sh1106_DrawBitmap(sh1106_t * dev, const sh1106_bitmap_t * bitmap, int16_t x,
+                                  int16_t y, sh1106_rop_t rop);
+
+/**
+ * @brief Dibuja una region de un mapa de bits, por ejemplo un cuadro de una animacion.
+ *
+ * La region se recorta contra el mapa de bits y el resultado contra la pantalla.
+ *
+ * @param dev: Display sobre el que se dibuja.
+ * @param bitmap: Mapa de bits.
+ * @param src_x: Coordenada en "x" de la region dentro del mapa de bits.
+ * @param src_y: Coordenada en "y" de la region dentro del mapa de bits.
+ * @param width: Ancho de la region.
+ * @param height: Alto de la region.
+ * @param x: Coordenada en "x" donde se dibuja la esquina superior izquierda de la region.
+ * @param y: Coordenada en "y" donde se dibuja la esquina superior izquierda de la region.
+ * @param rop: Operacion de raster.
+ * @return sh1106_status_t: SH1106_ERROR si la operacion de raster no es valida.
+ */
+sh1106_status_t sh1106_DrawBitmapRegion(sh1106_t * dev, const sh1106_bitmap_t * bitmap,
+                                        int16_t src_x, int16_t src_y, int16_t width,
+                                        int16_t height, int16_t x, int16_t y, sh1106_rop_t rop);
+
+#endif /* INC_SH1106_BITMAP_H_ */
@@ -0,0 +1,73 @@
+/**
+ * @file sh1106_flusher.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Source File - Tarea de envio de sh1106_queue.h sobre hilos POSIX
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include <errno.h>
+#include "sh1106_flusher.h"
+
+/* === Private function declarations =========================================================== */
+/**
+ * @brief Envia lo pendiente y guarda el resultado si fallo.
+ */
+static void sh1106_FlusherFlush(sh1106_flusher_t * flusher) {
+    sh1106_status_t status = sh1106_QueueFlush(flusher->queue);
+    if (status != SH1106_OK) {
+        atomic_store(&flusher->status, status);
+    }
+}
+
+/**
+ * @brief Hilo de envio: espera un aviso, descarta los que se acumularon y envia una vez.
+ */
+static void * sh1106_FlusherThread(void * context) {
+    sh1106_flusher_t * flusher = (sh1106_flusher_t *)context;
+
+    while (!atomic_load(&flusher->stop)) {
+        while (sem_wait(&flusher->wakeup) != 0 && errno == EINTR) {
+        }
+        // Los avisos que llegaron mientras tanto quedan cubiertos por este envio.
+        while (sem_trywait(&flusher->wakeup) == 0) {
+        }
+        sh1106_FlusherFlush(flusher);
+    }
+    // Lo que se entrego antes de pedir la detencion tambien se envia.
+    sh1106_FlusherFlush(flusher);
+    return NULL;
+}
+
+/* === Public function declarations ============================================================ */
+sh1106_status_t sh1106_FlusherInit(sh1106_flusher_t * flusher) {
+    flusher->queue = NULL;
+    atomic_init(&flusher->stop, false);
+    atomic_init(&flusher->status, SH1106_OK);
+    return (sem_init(&flusher->wakeup, 0, 0) == 0) ? SH1106_OK : SH1106_ERROR;
+}
+
+sh1106_status_t sh1106_FlusherStart(sh1106_flusher_t * flusher, sh1106_queue_t * queue) {
+    flusher->queue = queue;
+    atomic_store(&flusher->stop, false);
+    if (pthread_create(&flusher->thread, NULL, sh1106_FlusherThread, flusher) != 0) {
+        return SH1106_ERROR;
+    }
+    return SH1106_OK;
+}
+
+void sh1106_FlusherNotify(void * context) {
+    sh1106_flusher_t * flusher = (sh1106_flusher_t *)context;
+    sem_post(&flusher->wakeup);
+}
+
+sh1106_status_t sh1106_FlusherStop(sh1106_flusher_t * flusher) {
+    atomic_store(&flusher->stop, true);
+    sem_post(&flusher->wakeup);
+    pthread_join(flusher->thread, NULL);
+    sem_destroy(&flusher->wakeup);
+    return atomic_exchange(&flusher->status, SH1106_OK);
+}
@@ -0,0 +1,75 @@
+/**
+ * @file sh1106_flusher.h
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Header File - Tarea de envio de sh1106_queue.h sobre hilos POSIX
+ *
+ * Implementacion para Linux de la tarea de envio: un hilo que espera el aviso de la cola en un
+ * semaforo y llama a sh1106_QueueFlush. Los avisos que llegan mientras envia se juntan en una
+ * sola actualizacion. La cola se configura con notify = sh1106_FlusherNotify y context = el
+ * flusher.
+ *
+ * En un RTOS la tarea de envio es una tarea de la aplicacion con el mismo ciclo: esperar el aviso
+ * (por ejemplo ulTaskNotifyTake) y llamar a sh1106_QueueFlush.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#ifndef INC_SH1106_FLUSHER_H_
+#define INC_SH1106_FLUSHER_H_
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include <pthread.h>
+#include <semaphore.h>
+#include "sh1106_queue.h"
+
+/* === Public data type declarations =========================================================== */
+/**
+ * @brief Hilo de envio de una cola.
+ */
+typedef struct {
+    sh1106_queue_t * queue;         ///< @brief Cola que envia.
+    pthread_t thread;               ///< @brief Hilo de envio.
+    sem_t wakeup;                   ///< @brief Avisos de la cola.
+    atomic_bool stop;               ///< @brief El hilo debe terminar.
+    _Atomic sh1106_status_t status; ///< @brief Resultado del ultimo envio fallido, o SH1106_OK.
+} sh1106_flusher_t;
+
+/* === Public function declarations ============================================================ */
+/**
+ * @brief Inicializa el flusher, antes de crear la cola que lo usa como contexto de notify.
+ *
+ * @param flusher: Flusher.
+ * @return sh1106_status_t: SH1106_ERROR si no se pudo crear el semaforo.
+ */
+sh1106_status_t sh1106_FlusherInit(sh1106_flusher_t * flusher);
+
+/**
+ * @brief Inicia el hilo de envio de la cola.
+ *
+ * @param flusher: Flusher inicializado.
+ * @param queue: Cola creada con notify = sh1106_FlusherNotify y context = flusher.
+ * @return sh1106_status_t: SH1106_ERROR si no se pudo crear el hilo.
+ */
+sh1106_status_t sh1106_FlusherStart(sh1106_flusher_t * flusher, sh1106_queue_t * queue);
+
+/**
+ * @brief Aviso de la cola: despierta al hilo de envio. Sin bloqueo, se puede llamar desde un
+ * manejador de senales.
+ *
+ * @param context: Flusher.
+ */
+void sh1106_FlusherNotify(void * context);
+
+/**
+ * @brief Detiene el hilo de envio despues de enviar lo pendiente y libera el semaforo.
+ *
+ * @param flusher: Flusher iniciado.
+ * @return sh1106_status_t: Resultado del ultimo envio fallido, o SH1106_OK si no fallo ninguno
+ * desde el anterior que se informo.
+ */
+sh1106_status_t sh1106_FlusherStop(sh1106_flusher_t * flusher);
+
+#endif /* INC_SH1106_FLUSHER_H_ */
@@ -0,0 +1,217 @@
+/**
+ * @file sh1106_font.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Source File - Fuentes y texto para el driver SH1106
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106_font.h"
+#include "sh1106_strip.h"
+
+/* === Private data type declarations ========================================================== */
+/**
+ * @brief Glifo listo para dibujar, independiente del tipo de fuente.
+ */
+typedef struct {
+    const uint8_t * data; ///< @brief Primer byte del glifo.
+    uint8_t width;        ///< @brief Columnas del glifo.
+    int8_t x_offset;      ///< @brief Desplazamiento de la primera columna respecto del cursor.
+    uint8_t advance;      ///< @brief Avance del cursor, incluido el espaciado de la fuente.
+} sh1106_glyph_ref_t;
+
+/* === Private function declarations =========================================================== */
+/**
+ * @brief Busca un caracter en la fuente.
+ *
+ * @return bool: false si el caracter no esta en la fuente.
+ */
+static bool sh1106_FindGlyph(const sh1106_font_t * font, char c, sh1106_glyph_ref_t * glyph) {
+    uint8_t code = (uint8_t)c;
+
+    if (code < font->first || code > font->last) {
+        return false;
+    }
+    if (font->glyphs == NULL) {
+        uint8_t pages = (font->height + 7) >> 3;
+        glyph->data = &font->bitmap[(uint16_t)(code - font->first) * font->width * pages];
+        glyph->width = font->width;
+        glyph->x_offset = 0;
+        glyph->advance = font->width + font->spacing;
+    } else {
+        const sh1106_glyph_t * entry = &font->glyphs[code - font->first];
+        glyph->data = &font->bitmap[entry->offset];
+        glyph->width = entry->width;
+        glyph->x_offset = entry->x_offset;
+        glyph->advance = entry->advance + font->spacing;
+    }
+    return true;
+}
+
+/**
+ * @brief Ajuste de kerning entre dos caracteres, por busqueda binaria en la tabla de la fuente.
+ */
+static int8_t sh1106_Kerning(const sh1106_font_t * font, char left, char right) {
+    uint16_t key = ((uint16_t)(uint8_t)left << 8) | (uint8_t)right;
+    uint16_t low = 0, high = font->kerning_count;
+
+    while (low < high) {
+        uint16_t middle = (low + high) / 2;
+        const sh1106_kerning_t * pair = &font->kerning[middle];
+        uint16_t pair_key = ((uint16_t)pair->left << 8) | pair->right;
+        if (pair_key == key) {
+            return pair->adjust;
+        } else if (pair_key < key) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Escribe una pagina de un glifo en una pagina del buffer.
+ *
+ * Recibe las columnas ya recortadas y los bits ya desplazados a su posicion dentro de la pagina:
+ * bits en 1 son los pixeles del glifo que se escriben. fill es 0xFF para blanco y 0x00 para negro.
+ */
+static inline void sh1106_BlitColumns(uint8_t * dst, const uint8_t * src, uint8_t count,
+                                      int8_t shift, uint8_t fill) {
+    if (shift >= 0) {
+        for (uint8_t i = 0; i < count; i++) {
+            uint8_t bits = src[i] << shift;
+            dst[i] = (dst[i] & ~bits) | (fill & bits);
+        }
+    } else {
+        for (uint8_t i = 0; i < count; i++) {
+            uint8_t bits = src[i] >> -shift;
+            dst[i] = (dst[i] & ~bits) | (fill & bits);
+        }
+    }
+}
+
+/**
+ * @brief Dibuja un glifo con la esquina superior izquierda de su celda en (x, y).
+ *
+ * Cada pagina del glifo se escribe en la pagina del buffer que le corresponde y, si "y" no es
+ * multiplo de 8, tambien en la siguiente con el desplazamiento complementario.
+ */
+static void sh1106_BlitGlyph(sh1106_t * dev, const sh1106_font_t * font,
+                             const sh1106_glyph_ref_t * glyph, int16_t x, int16_t y,
+                             sh1106_color_t color) {
+    int16_t first = 0, end = glyph->width;
+    uint8_t pages = (font->height + 7) >> 3;
+    uint8_t fill = (color == WHITE) ? 0xFF : 0x00;
+
+    x += glyph->x_offset;
+    if (x < 0) {
+        first = -x;
+    }
+    if (x + end > sh1106_DevWidth(dev)) {
+        end = sh1106_DevWidth(dev) - x;
+    }
+    if (first >= end || y >= sh1106_DevHeight(dev) || y + font->height <= 0) {
+        return;
+    }
+
+    // Division por 8 redondeando hacia abajo, tambien para "y" negativo
+    int16_t page = (y >= 0) ? (y >> 3) : -((7 - y) >> 3);
+    int8_t shift = y - page * 8;
+    uint8_t count = end - first;
+    uint8_t * column = &dev->buffer[x + first];
+
+    for (uint8_t glyph_page = 0; glyph_page < pages; glyph_page++) {
+        const uint8_t * src = &glyph->data[glyph_page * glyph->width + first];
+        int16_t top = page + glyph_page;
+
+        if (top >= 0 && top < sh1106_DevPages(dev)) {
+            sh1106_BlitColumns(&column[top * sh1106_DevWidth(dev)], src, count, shift, fill);
+            sh1106_DevMarkDirty(dev, top, x + first, x + end);
+        }
+        if (shift != 0 && top + 1 >= 0 && top + 1 < sh1106_DevPages(dev)) {
+            sh1106_BlitColumns(&column[(top + 1) * sh1106_DevWidth(dev)], src, count, shift - 8,
+                               fill);
+            sh1106_DevMarkDirty(dev, top + 1, x + first, x + end);
+        }
+    }
+}
+
+/* === Public function declarations ============================================================ */
+sh1106_status_t sh1106_DrawChar(sh1106_t * dev, const sh1106_font_t * font, int16_t x, int16_t y,
+                                char c, sh1106_color_t color) {
+    sh1106_glyph_ref_t glyph;
+
+    if (!sh1106_FindGlyph(font, c, &glyph)) {
+        return SH1106_ERROR;
+    }
+#if SH1106_STRIP
+    if (sh1106_DevRecording(dev)) {
+        return sh1106_StripChar(dev, font, x, y, c, color);
+    }
+#endif
+    sh1106_BlitGlyph(dev, font, &glyph, x, y, color);
+    return SH1106_OK;
+}
+
+sh1106_status_t sh1106_DrawString(sh1106_t * dev, const sh1106_font_t * font, int16_t x, int16_t y,
+                                  const char * str, sh1106_color_t color) {
+    sh1106_status_t status = SH1106_OK;
+    sh1106_glyph_ref_t glyph;
+    char previous = '\0';
+
+#if SH1106_STRIP
+    // Los caracteres sin glifo se informan al guardar el texto, igual que al dibujarlo.
+    if (sh1106_DevRecording(dev)) {
+        for (const char * c = str; *c != '\0'; c++) {
+            if (!sh1106_FindGlyph(font, *c, &glyph)) {
+                status = SH1106_ERROR;
+            }
+        }
+        return (sh1106_StripString(dev, font, x, y, str, color) == SH1106_OK) ? status
+                                                                              : SH1106_ERROR;
+    }
+#endif
+    if (y >= sh1106_DevHeight(dev) || y + font->height <= 0) {
+        return SH1106_OK;
+    }
+    for (; *str != '\0'; str++) {
+        if (!sh1106_FindGlyph(font, *str, &glyph)) {
+            status = SH1106_ERROR;
+            continue;
+        }
+        if (previous != '\0' && font->kerning_count > 0) {
+            x += sh1106_Kerning(font, previous, *str);
+        }
+        if (x + glyph.x_offset >= sh1106_DevWidth(dev)) {
+            break;
+        }
+        if (x + glyph.x_offset + glyph.width > 0) {
+            sh1106_BlitGlyph(dev, font, &glyph, x, y, color);
+        }
+        x += glyph.advance;
+        previous = *str;
+    }
+    return status;
+}
+
+int16_t sh1106_MeasureString(const sh1106_font_t * font, const char * str) {
+    sh1106_glyph_ref_t glyph;
+    char previous = '\0';
+    int16_t width = 0;
+
+    for (; *str != '\0'; str++) {
+        if (!sh1106_FindGlyph(font, *str, &glyph)) {
+            continue;
+        }
+        if (previous != '\0' && font->kerning_count > 0) {
+            width += sh1106_Kerning(font, previous, *str);
+        }
+        width += glyph.advance;
+        previous = *str;
+    }
+    return (previous != '\0') ? width - font->spacing : width;
+}
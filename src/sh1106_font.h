@@ -0,0 +1,110 @@
+/**
+ * @file sh1106_font.h
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Header File - Fuentes y texto para el driver SH1106
+ *
+ * Los glifos se guardan con el mismo formato que el buffer del display: por paginas de 8 filas y,
+ * dentro de cada pagina, una columna por byte con el bit 0 arriba. Dibujar un caracter es copiar
+ * columnas enteras al buffer: si "y" es multiplo de 8 cada byte del glifo cae en un byte del
+ * buffer, y si no se reparte entre dos paginas con un desplazamiento.
+ *
+ * Las fuentes pueden ser de ancho fijo (sin tabla de glifos) o proporcionales, y opcionalmente
+ * tener una tabla de kerning. Se generan a partir de fuentes BDF con tools/bdf2c.py.
+ *
+ * El texto se dibuja con fondo transparente: en WHITE se encienden los pixeles del glifo y en BLACK
+ * se apagan, sin tocar el resto de la celda.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#ifndef INC_SH1106_FONT_H_
+#define INC_SH1106_FONT_H_
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106.h"
+
+/* === Public data type declarations =========================================================== */
+/**
+ * @brief Glifo de una fuente proporcional.
+ */
+typedef struct {
+    uint16_t offset; ///< @brief Posicion del primer byte del glifo en el bitmap de la fuente.
+    uint8_t width;   ///< @brief Columnas del glifo.
+    int8_t x_offset; ///< @brief Desplazamiento de la primera columna respecto del cursor.
+    uint8_t advance; ///< @brief Avance del cursor despues del glifo.
+} sh1106_glyph_t;
+
+/**
+ * @brief Ajuste del avance entre dos caracteres consecutivos.
+ */
+typedef struct {
+    uint8_t left;  ///< @brief Caracter de la izquierda.
+    uint8_t right; ///< @brief Caracter de la derecha.
+    int8_t adjust; ///< @brief Pixeles que se suman al avance del caracter de la izquierda.
+} sh1106_kerning_t;
+
+/**
+ * @brief Fuente.
+ *
+ * Cada glifo ocupa (height + 7) / 8 paginas de width bytes. En las fuentes de ancho fijo todos los
+ * glifos tienen font->width columnas y estan uno a continuacion del otro; en las proporcionales la
+ * tabla glyphs indica donde empieza cada uno y su ancho.
+ */
+typedef struct {
+    const uint8_t * bitmap;           ///< @brief Glifos, por paginas y por columnas.
+    const sh1106_glyph_t * glyphs;    ///< @brief Tabla de glifos, NULL en fuentes de ancho fijo.
+    const sh1106_kerning_t * kerning; ///< @brief Pares de kerning ordenados, o NULL.
+    uint16_t kerning_count;           ///< @brief Cantidad de pares de kerning.
+    uint8_t first;                    ///< @brief Primer caracter de la fuente.
+    uint8_t last;                     ///< @brief Ultimo caracter de la fuente.
+    uint8_t width;                    ///< @brief Columnas de cada glifo (ancho fijo).
+    uint8_t height;                   ///< @brief Alto de la fuente en pixeles (hasta 32).
+    uint8_t spacing;                  ///< @brief Columnas vacias entre caracteres.
+} sh1106_font_t;
+
+/* === Public function declarations ============================================================ */
+/**
+ * @brief Dibuja un caracter.
+ *
+ * @param dev: Display sobre el que se dibuja.
+ * @param font: Fuente.
+ * @param x: Coordenada en "x" del cursor.
+ * @param y: Coordenada en "y" del borde superior de la celda.
+ * @param c: Caracter a dibujar.
+ * @param color: Color del caracter.
+ * @return sh1106_status_t: SH1106_ERROR si el caracter no esta en la fuente.
+ */
+sh1106_status_t sh1106_DrawChar(sh1106_t * dev, const sh1106_font_t * font, int16_t x, int16_t y,
+                                char c, sh1106_color_t color);
+
+/**
+ * @brief Dibuja un string, aplicando el kerning de la fuente.
+ *
+ * Los caracteres que quedan completamente fuera de la pantalla no se recorren, y el dibujo termina
+ * en el primer caracter que empieza a la derecha de la pantalla.
+ *
+ * @param dev: Display sobre el que se dibuja.
+ * @param font: Fuente.
+ * @param x: Coordenada en "x" del comienzo del string.
+ * @param y: Coordenada en "y" del borde superior del texto.
+ * @param str: String terminado en '\0'.
+ * @param color: Color del texto.
+ * @return sh1106_status_t: SH1106_ERROR si algun caracter no esta en la fuente. Esos caracteres
+ * no se dibujan ni avanzan el cursor.
+ */
+sh1106_status_t sh1106_DrawString(sh1106_t * dev, const sh1106_font_t * font, int16_t x, int16_t y,
+                                  const char * str, sh1106_color_t color);
+
+/**
+ * @brief Ancho en pixeles de un string, con kerning y sin el espaciado del ultimo caracter.
+ *
+ * @param font: Fuente.
+ * @param str: String terminado en '\0'.
+ * @return int16_t: Ancho en pixeles.
+ */
+int16_t sh1106_MeasureString(const sh1106_font_t * font, const char * str);
+
+#endif /* INC_SH1106_FONT_H_ */
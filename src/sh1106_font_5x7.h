@@ -0,0 +1,20 @@
+/**
+ * @file sh1106_font_5x7.h
+ * @brief Header File - Fuente sh1106_font_5x7 para el driver SH1106
+ *
+ * Generado con tools/bdf2c.py a partir de sh1106_5x7.bdf, no modificar a mano.
+ */
+
+#ifndef INC_SH1106_FONT_5X7_H_
+#define INC_SH1106_FONT_5X7_H_
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106_font.h"
+
+/* === Public variable declarations ============================================================ */
+/**
+ * @brief Fuente de 8 pixeles de alto, caracteres ' ' a '~'.
+ */
+extern const sh1106_font_t sh1106_font_5x7;
+
+#endif /* INC_SH1106_FONT_5X7_H_ */
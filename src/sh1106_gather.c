@@ -0,0 +1,55 @@
+/**
+ * @file sh1106_gather.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Source File - Transporte I2C por tramos para el driver SH1106
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106_gather.h"
+
+/* === Private function prototypes ============================================================= */
+static sh1106_status_t sh1106_GatherSend(sh1106_t * dev, const sh1106_iovec_t * iov,
+                                         uint8_t count);
+#if SH1106_ASYNC
+static sh1106_status_t sh1106_GatherSendAsync(sh1106_t * dev, const sh1106_iovec_t * iov,
+                                              uint8_t count);
+#endif
+
+/* === Public variable declarations ============================================================ */
+const sh1106_transport_t sh1106_i2c_gather_transport = {
+    .send = sh1106_GatherSend,
+#if SH1106_ASYNC
+    .send_async = sh1106_GatherSendAsync,
+#endif
+    .max_transfer = 0,
+};
+
+/* === Private function declarations =========================================================== */
+/**
+ * @brief Envio por I2C de los tramos de la transaccion, sin juntarlos.
+ */
+static sh1106_status_t sh1106_GatherSend(sh1106_t * dev, const sh1106_iovec_t * iov,
+                                         uint8_t count) {
+    return sh1106_FromHal(HAL_I2C_sendv(dev->address, iov, count));
+}
+
+#if SH1106_ASYNC
+/**
+ * @brief Fin de transmision I2C, la HAL la llama desde su interrupcion.
+ */
+static void sh1106_GatherDone(void * context, status_t status) {
+    sh1106_TransferDone((sh1106_t *)context, sh1106_FromHal(status));
+}
+
+/**
+ * @brief Envio I2C sin bloqueo de los tramos de la transaccion, sin juntarlos.
+ */
+static sh1106_status_t sh1106_GatherSendAsync(sh1106_t * dev, const sh1106_iovec_t * iov,
+                                              uint8_t count) {
+    return sh1106_FromHal(HAL_I2C_sendv_async(dev->address, iov, count, sh1106_GatherDone, dev));
+}
+#endif
@@ -0,0 +1,32 @@
+/**
+ * @file sh1106_gather.h
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Header File - Transporte I2C por tramos para el driver SH1106
+ *
+ * Para HAL que pueden enviar una transaccion formada por varios tramos (transferencias secuenciales
+ * o listas de DMA). Los comandos y los datos de una pagina viajan como tramos de una misma
+ * transaccion, sin copiarlos al buffer de la transaccion agrupada y sin limite de tamaño.
+ *
+ * Para usarlo se crea el display con .transport = &sh1106_i2c_gather_transport. La HAL debe
+ * proveer HAL_I2C_sendv y, con SH1106_ASYNC, HAL_I2C_sendv_async; sh1106_i2c_transport solo
+ * necesita HAL_I2C_send.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#ifndef INC_SH1106_GATHER_H_
+#define INC_SH1106_GATHER_H_
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106.h"
+
+/* === Public variable declarations ============================================================ */
+/**
+ * @brief Transporte I2C sobre HAL_I2C_sendv y HAL_I2C_sendv_async.
+ */
+extern const sh1106_transport_t sh1106_i2c_gather_transport;
+
+#endif /* INC_SH1106_GATHER_H_ */
@@ -0,0 +1,511 @@
+/**
+ * @file sh1106_gfx.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Source File - Primitivas de dibujo para el driver SH1106
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106_gfx.h"
+#include "sh1106_strip.h"
+#include <stdlib.h>
+
+/* === Private data type declarations ========================================================== */
+/**
+ * @brief Arco de circunferencia, con los vectores de sus extremos en formato Q14.
+ */
+typedef struct {
+    int32_t start_x, start_y; ///< @brief Direccion del angulo inicial.
+    int32_t end_x, end_y;     ///< @brief Direccion del angulo final.
+    bool large;               ///< @brief El arco abarca mas de 180 grados.
+    bool full;                ///< @brief El arco es la circunferencia completa.
+} sh1106_arc_t;
+
+/* === Private variable declarations =========================================================== */
+/**
+ * @brief Seno de 0 a 90 grados, en formato Q14 (16384 = 1).
+ */
+static const int16_t sine_table[91] = {
+    0,     286,   572,   857,   1143,  1428,  1713,  1997,  2280,  2563,  2845,  3126,  3406,
+    3686,  3964,  4240,  4516,  4790,  5063,  5334,  5604,  5872,  6138,  6402,  6664,  6924,
+    7182,  7438,  7692,  7943,  8192,  8438,  8682,  8923,  9162,  9397,  9630,  9860,  10087,
+    10311, 10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365, 12551, 12733,
+    12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044, 14189, 14330, 14466, 14598, 14726,
+    14849, 14968, 15082, 15191, 15296, 15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964,
+    16026, 16083, 16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382, 16384};
+
+/* === Private function declarations =========================================================== */
+/**
+ * @brief Marca como modificado el rectangulo [x0, x1) x [y0, y1), ya recortado a la pantalla.
+ */
+static void sh1106_MarkRect(sh1106_t * dev, int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    for (uint8_t page = y0 >> 3; page <= (y1 - 1) >> 3; page++) {
+        sh1106_DevMarkDirty(dev, page, x0, x1);
+    }
+}
+
+/**
+ * @brief Escribe un pixel sin verificar los limites. fill es 0xFF para blanco y 0x00 para negro.
+ */
+static inline void sh1106_Plot(sh1106_t * dev, int16_t x, int16_t y, uint8_t fill) {
+    uint8_t * byte = &dev->buffer[(y >> 3) * sh1106_DevWidth(dev) + x];
+    uint8_t mask = 1 << (y & 7);
+    *byte = (*byte & ~mask) | (fill & mask);
+}
+
+/**
+ * @brief Escribe un pixel solo si esta dentro de la pantalla.
+ */
+static inline void sh1106_PlotClip(sh1106_t * dev, int16_t x, int16_t y, uint8_t fill) {
+    if (x >= 0 && y >= 0 && x < sh1106_DevWidth(dev) && y < sh1106_DevHeight(dev)) {
+        sh1106_Plot(dev, x, y, fill);
+    }
+}
+
+/**
+ * @brief Intervalo de valores de k >= 0 para los que p0 + step * k cae dentro de [0, limit).
+ *
+ * @return bool: false si el intervalo es vacio.
+ */
+static bool sh1106_AxisRange(int32_t p0, int8_t step, int32_t limit, int32_t * low,
+                             int32_t * high) {
+    *low = (step > 0) ? -p0 : p0 - limit + 1;
+    *high = (step > 0) ? limit - 1 - p0 : p0;
+    if (*low < 0) {
+        *low = 0;
+    }
+    return *low <= *high;
+}
+
+/**
+ * @brief Avanza una fila el puntero y la mascara del pixel, cambiando de pagina si hace falta.
+ */
+static inline void sh1106_StepRow(uint8_t ** byte, uint8_t * mask, int8_t step, uint8_t width) {
+    if (step > 0) {
+        *mask <<= 1;
+        if (*mask == 0) {
+            *mask = 0x01;
+            *byte += width;
+        }
+    } else {
+        *mask >>= 1;
+        if (*mask == 0) {
+            *mask = 0x80;
+            *byte -= width;
+        }
+    }
+}
+
+/**
+ * @brief Octantes de una circunferencia que tocan la pantalla.
+ *
+ * El bit k corresponde al octante k, en el orden en que sh1106_CirclePoints escribe los puntos.
+ * Cada octante se aproxima por su rectangulo contenedor: la coordenada "mayor" del punto va de
+ * r / raiz(2) a r y la "menor" de 0 a r / raiz(2).
+ */
+static uint8_t sh1106_CircleOctants(const sh1106_t * dev, int16_t cx, int16_t cy, int16_t r) {
+    static const int8_t sign_x[] = {1, 1, -1, -1, 1, 1, -1, -1};
+    static const int8_t sign_y[] = {1, -1, 1, -1, 1, -1, 1, -1};
+    int32_t low = ((int32_t)r * 181 >> 8) - 1; // 181 / 256 = 1 / raiz(2), redondeado hacia abajo
+    int32_t high = ((int32_t)r * 181 >> 8) + 1;
+    uint8_t visible = 0;
+
+    for (uint8_t k = 0; k < 8; k++) {
+        // Octantes 0 a 3: (x, y), octantes 4 a 7: (y, x), con x >= y.
+        int32_t a0 = (k < 4) ? low : 0, a1 = (k < 4) ? r : high;
+        int32_t b0 = (k < 4) ? 0 : low, b1 = (k < 4) ? high : r;
+        int32_t x0 = (sign_x[k] > 0) ? cx + a0 : cx - a1;
+        int32_t x1 = (sign_x[k] > 0) ? cx + a1 : cx - a0;
+        int32_t y0 = (sign_y[k] > 0) ? cy + b0 : cy - b1;
+        int32_t y1 = (sign_y[k] > 0) ? cy + b1 : cy - b0;
+        if (x1 >= 0 && x0 < sh1106_DevWidth(dev) && y1 >= 0 && y0 < sh1106_DevHeight(dev)) {
+            visible |= 1 << k;
+        }
+    }
+    return visible;
+}
+
+/**
+ * @brief Escribe los puntos simetricos de la circunferencia de los octantes visibles. Si la
+ * circunferencia entra completa en la pantalla no se verifican los limites de cada punto.
+ */
+static void sh1106_CirclePoints(sh1106_t * dev, int16_t cx, int16_t cy, int16_t x, int16_t y,
+                                uint8_t octants, bool inside, uint8_t fill) {
+    void (*plot)(sh1106_t *, int16_t, int16_t, uint8_t) = inside ? sh1106_Plot : sh1106_PlotClip;
+    if (octants & 0x01) {
+        plot(dev, cx + x, cy + y, fill);
+    }
+    if (octants & 0x02) {
+        plot(dev, cx + x, cy - y, fill);
+    }
+    if (octants & 0x04) {
+        plot(dev, cx - x, cy + y, fill);
+    }
+    if (octants & 0x08) {
+        plot(dev, cx - x, cy - y, fill);
+    }
+    if (octants & 0x10) {
+        plot(dev, cx + y, cy + x, fill);
+    }
+    if (octants & 0x20) {
+        plot(dev, cx + y, cy - x, fill);
+    }
+    if (octants & 0x40) {
+        plot(dev, cx - y, cy + x, fill);
+    }
+    if (octants & 0x80) {
+        plot(dev, cx - y, cy - x, fill);
+    }
+}
+
+/**
+ * @brief Recorta a la pantalla el rectangulo que contiene a una circunferencia y lo marca como
+ * modificado.
+ */
+static void sh1106_MarkCircle(sh1106_t * dev, int16_t cx, int16_t cy, int16_t r) {
+    int16_t x0 = (cx - r < 0) ? 0 : cx - r;
+    int16_t y0 = (cy - r < 0) ? 0 : cy - r;
+    int16_t x1 = (cx + r + 1 > sh1106_DevWidth(dev)) ? sh1106_DevWidth(dev) : cx + r + 1;
+    int16_t y1 = (cy + r + 1 > sh1106_DevHeight(dev)) ? sh1106_DevHeight(dev) : cy + r + 1;
+    if (x0 < x1 && y0 < y1) {
+        sh1106_MarkRect(dev, x0, y0, x1, y1);
+    }
+}
+
+/**
+ * @brief Seno de un angulo en grados, en formato Q14.
+ */
+static int32_t sh1106_Sine(int16_t degrees) {
+    degrees %= 360;
+    if (degrees < 0) {
+        degrees += 360;
+    }
+    if (degrees <= 90) {
+        return sine_table[degrees];
+    } else if (degrees <= 180) {
+        return sine_table[180 - degrees];
+    } else if (degrees <= 270) {
+        return -sine_table[degrees - 180];
+    }
+    return -sine_table[360 - degrees];
+}
+
+/**
+ * @brief Indica si el punto (x, y), relativo al centro y con "y" hacia arriba, esta en el arco.
+ *
+ * Se usa el signo del producto vectorial contra las direcciones de los extremos, sin calcular
+ * angulos.
+ */
+static bool sh1106_InArc(const sh1106_arc_t * arc, int32_t x, int32_t y) {
+    int32_t after_start = arc->start_x * y - arc->start_y * x; // >= 0: antihorario desde el inicio
+    int32_t before_end = x * arc->end_y - y * arc->end_x;      // >= 0: horario desde el final
+    if (arc->full) {
+        return true;
+    }
+    if (arc->large) {
+        return !(after_start < 0 && before_end < 0);
+    }
+    return after_start >= 0 && before_end >= 0;
+}
+
+/**
+ * @brief Aplica una mascara a las columnas [x0, x1) de una fila de pagina.
+ */
+static void sh1106_MaskRow(uint8_t * row, int16_t x0, int16_t x1, uint8_t mask,
+                           sh1106_color_t color) {
+    if (color == WHITE) {
+        for (int16_t x = x0; x < x1; x++) {
+            row[x] |= mask;
+        }
+    } else {
+        for (int16_t x = x0; x < x1; x++) {
+            row[x] &= ~mask;
+        }
+    }
+}
+
+/**
+ * @brief Rellena el rectangulo [x0, x1) x [y0, y1), recortandolo a la pantalla. Los limites van en
+ * 32 bits para que ni el ancho ni el borde final de la figura puedan desbordar.
+ */
+static void sh1106_FillClip(sh1106_t * dev, int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+                            sh1106_color_t color) {
+    // Recorte, una sola vez para toda la figura.
+    x0 = (x0 < 0) ? 0 : x0;
+    y0 = (y0 < 0) ? 0 : y0;
+    x1 = (x1 > sh1106_DevWidth(dev)) ? sh1106_DevWidth(dev) : x1;
+    y1 = (y1 > sh1106_DevHeight(dev)) ? sh1106_DevHeight(dev) : y1;
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+
+    uint8_t first_page = y0 >> 3;
+    uint8_t last_page = (y1 - 1) >> 3;
+    uint8_t top_mask = 0xFF << (y0 & 7);
+    uint8_t bottom_mask = 0xFF >> (7 - ((y1 - 1) & 7));
+    uint8_t * row = &dev->buffer[first_page * sh1106_DevWidth(dev)];
+
+    if (first_page == last_page) {
+        sh1106_MaskRow(row, x0, x1, top_mask & bottom_mask, color);
+    } else {
+        sh1106_MaskRow(row, x0, x1, top_mask, color);
+        for (uint8_t page = first_page + 1; page < last_page; page++) {
+            row += sh1106_DevWidth(dev);
+            memset(&row[x0], (color == WHITE) ? 0xFF : 0x00, x1 - x0);
+        }
+        row += sh1106_DevWidth(dev);
+        sh1106_MaskRow(row, x0, x1, bottom_mask, color);
+    }
+
+    sh1106_MarkRect(dev, x0, y0, x1, y1);
+}
+
+/* === Public function declarations ============================================================ */
+sh1106_status_t sh1106_DrawLine(sh1106_t * dev, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                sh1106_color_t color) {
+#if SH1106_STRIP
+    if (sh1106_DevRecording(dev)) {
+        return sh1106_StripLine(dev, x0, y0, x1, y1, color);
+    }
+#endif
+    if (y0 == y1 || x0 == x1) {
+        sh1106_FillClip(dev, (x0 < x1) ? x0 : x1, (y0 < y1) ? y0 : y1,
+                        (int32_t)((x0 < x1) ? x1 : x0) + 1, (int32_t)((y0 < y1) ? y1 : y0) + 1,
+                        color);
+        return SH1106_OK;
+    }
+
+    // El paso k de la linea avanza k pixeles sobre el eje mayor y round(k * minor / major) sobre
+    // el menor. El resto de esa division es el error de Bresenham, por lo que se puede calcular
+    // en forma cerrada para cualquier paso y recortar la linea sin alterar su trazado.
+    int8_t step_x = (x0 < x1) ? 1 : -1, step_y = (y0 < y1) ? 1 : -1;
+    int32_t dx = abs(x1 - x0), dy = abs(y1 - y0);
+    bool x_major = dx >= dy;
+    int32_t major = x_major ? dx : dy, minor = x_major ? dy : dx;
+    int32_t first, last, low, high;
+
+    // Pasos en los que el eje mayor esta dentro de la pantalla
+    if (!sh1106_AxisRange(x_major ? x0 : y0, x_major ? step_x : step_y,
+                          x_major ? sh1106_DevWidth(dev) : sh1106_DevHeight(dev), &first, &last)) {
+        return SH1106_OK;
+    }
+    // Pasos en los que el eje menor esta dentro de la pantalla: m(k) >= low y m(k) <= high
+    if (!sh1106_AxisRange(x_major ? y0 : x0, x_major ? step_y : step_x,
+                          x_major ? sh1106_DevHeight(dev) : sh1106_DevWidth(dev), &low, &high)) {
+        return SH1106_OK;
+    }
+    if (low > 0) {
+        int64_t k = ((int64_t)2 * major * low - major + 2 * minor - 1) / (2 * minor);
+        first = (k > first) ? k : first;
+    }
+    int64_t k = ((int64_t)2 * major * (high + 1) - major - 1) / (2 * minor);
+    last = (k < last) ? k : last;
+    if (last > major) {
+        last = major;
+    }
+    if (first > last) {
+        return SH1106_OK;
+    }
+
+    int64_t position = (int64_t)2 * first * minor + major;
+    int32_t offset = position / (2 * major), remainder = position % (2 * major);
+    int16_t x = x0 + step_x * (x_major ? first : offset);
+    int16_t y = y0 + step_y * (x_major ? offset : first);
+    uint8_t fill = (color == WHITE) ? 0xFF : 0x00;
+    uint8_t * byte = &dev->buffer[(y >> 3) * sh1106_DevWidth(dev) + x];
+    uint8_t mask = 1 << (y & 7);
+
+    for (int32_t i = first; i <= last; i++) {
+        *byte = (*byte & ~mask) | (fill & mask);
+        remainder += 2 * minor;
+        bool carry = remainder >= 2 * major;
+        if (carry) {
+            remainder -= 2 * major;
+        }
+        if (x_major) {
+            byte += step_x;
+            if (carry) {
+                sh1106_StepRow(&byte, &mask, step_y, sh1106_DevWidth(dev));
+            }
+        } else {
+            sh1106_StepRow(&byte, &mask, step_y, sh1106_DevWidth(dev));
+            if (carry) {
+                byte += step_x;
+            }
+        }
+    }
+
+    int32_t end = ((int64_t)2 * last * minor + major) / (2 * major);
+    int16_t end_x = x0 + step_x * (x_major ? last : end);
+    int16_t end_y = y0 + step_y * (x_major ? end : last);
+    sh1106_MarkRect(dev, (x < end_x) ? x : end_x, (y < end_y) ? y : end_y,
+                    ((x < end_x) ? end_x : x) + 1, ((y < end_y) ? end_y : y) + 1);
+    return SH1106_OK;
+}
+
+sh1106_status_t sh1106_DrawCircle(sh1106_t * dev, int16_t cx, int16_t cy, int16_t radius,
+                                  sh1106_color_t color) {
+#if SH1106_STRIP
+    if (sh1106_DevRecording(dev)) {
+        return sh1106_StripCircle(dev, cx, cy, radius, color, false);
+    }
+#endif
+    if (radius < 0) {
+        return SH1106_OK;
+    }
+    uint8_t octants = sh1106_CircleOctants(dev, cx, cy, radius);
+    bool inside = (cx - radius >= 0 && cy - radius >= 0 && cx + radius < sh1106_DevWidth(dev) &&
+                   cy + radius < sh1106_DevHeight(dev));
+    uint8_t fill = (color == WHITE) ? 0xFF : 0x00;
+    if (octants == 0) {
+        return SH1106_OK;
+    }
+
+    int16_t x = radius, y = 0, error = 1 - radius;
+    while (x >= y) {
+        sh1106_CirclePoints(dev, cx, cy, x, y, octants, inside, fill);
+        y++;
+        if (error < 0) {
+            error += 2 * y + 1;
+        } else {
+            x--;
+            error += 2 * (y - x) + 1;
+        }
+    }
+
+    sh1106_MarkCircle(dev, cx, cy, radius);
+    return SH1106_OK;
+}
+
+sh1106_status_t sh1106_FillCircle(sh1106_t * dev, int16_t cx, int16_t cy, int16_t radius,
+                                  sh1106_color_t color) {
+#if SH1106_STRIP
+    if (sh1106_DevRecording(dev)) {
+        return sh1106_StripCircle(dev, cx, cy, radius, color, true);
+    }
+#endif
+    // A diferencia de la circunferencia, un disco puede cubrir la pantalla sin que su borde la
+    // toque, por lo que solo se descarta cuando su rectangulo contenedor queda afuera.
+    if (radius < 0 || (int32_t)cx + radius < 0 || (int32_t)cy + radius < 0 ||
+        (int32_t)cx - radius >= sh1106_DevWidth(dev) ||
+        (int32_t)cy - radius >= sh1106_DevHeight(dev)) {
+        return SH1106_OK;
+    }
+
+    // El relleno se hace con segmentos verticales, que en el buffer por paginas se escriben con
+    // una mascara por pagina. Las columnas cx +/- y se dibujan en cada paso; las columnas
+    // cx +/- x solo en el ultimo paso antes de que cambie x, cuando su altura es la maxima.
+    int32_t x = radius, y = 0, error = 1 - radius;
+    while (x >= y) {
+        sh1106_FillClip(dev, cx + y, cy - x, cx + y + 1, cy + x + 1, color);
+        if (y != 0) {
+            sh1106_FillClip(dev, cx - y, cy - x, cx - y + 1, cy + x + 1, color);
+        }
+        if (error >= 0 && x != y) {
+            sh1106_FillClip(dev, cx + x, cy - y, cx + x + 1, cy + y + 1, color);
+            sh1106_FillClip(dev, cx - x, cy - y, cx - x + 1, cy + y + 1, color);
+        }
+        y++;
+        if (error < 0) {
+            error += 2 * y + 1;
+        } else {
+            x--;
+            error += 2 * (y - x) + 1;
+        }
+    }
+    return SH1106_OK;
+}
+
+sh1106_status_t sh1106_DrawArc(sh1106_t * dev, int16_t cx, int16_t cy, int16_t radius,
+                               int16_t start_angle, int16_t end_angle, sh1106_color_t color) {
+#if SH1106_STRIP
+    if (sh1106_DevRecording(dev)) {
+        return sh1106_StripArc(dev, cx, cy, radius, start_angle, end_angle, color);
+    }
+#endif
+    int16_t sweep = (end_angle - start_angle) % 360;
+    sh1106_arc_t arc = {.start_x = sh1106_Sine(start_angle + 90),
+                        .start_y = sh1106_Sine(start_angle),
+                        .end_x = sh1106_Sine(end_angle + 90),
+                        .end_y = sh1106_Sine(end_angle)};
+    uint8_t fill = (color == WHITE) ? 0xFF : 0x00;
+
+    if (sweep < 0) {
+        sweep += 360;
+    }
+    arc.full = (sweep == 0 && start_angle != end_angle);
+    arc.large = (sweep > 180);
+    if (radius < 0 || (sweep == 0 && !arc.full) ||
+        sh1106_CircleOctants(dev, cx, cy, radius) == 0) {
+        return SH1106_OK;
+    }
+
+    // Mismo recorrido que sh1106_DrawCircle, descartando los puntos fuera del arco. En el arco la
+    // "y" crece hacia arriba, al reves que en la pantalla.
+    int16_t x = radius, y = 0, error = 1 - radius;
+    while (x >= y) {
+        const int16_t points[8][2] = {{x, y},  {x, -y},  {-x, y},  {-x, -y},
+                                      {y, x},  {y, -x},  {-y, x},  {-y, -x}};
+        for (uint8_t k = 0; k < 8; k++) {
+            if (sh1106_InArc(&arc, points[k][0], -points[k][1])) {
+                sh1106_PlotClip(dev, cx + points[k][0], cy + points[k][1], fill);
+            }
+        }
+        y++;
+        if (error < 0) {
+            error += 2 * y + 1;
+        } else {
+            x--;
+            error += 2 * (y - x) + 1;
+        }
+    }
+
+    sh1106_MarkCircle(dev, cx, cy, radius);
+    return SH1106_OK;
+}
+
+sh1106_status_t sh1106_FillRect(sh1106_t * dev, int16_t x, int16_t y, int16_t width,
+                                int16_t height, sh1106_color_t color) {
+#if SH1106_STRIP
+    if (sh1106_DevRecording(dev)) {
+        return sh1106_StripRect(dev, x, y, width, height, color, true);
+    }
+#endif
+    if (width <= 0 || height <= 0) {
+        return SH1106_OK;
+    }
+    sh1106_FillClip(dev, x, y, (int32_t)x + width, (int32_t)y + height, color);
+    return SH1106_OK;
+}
+
+sh1106_status_t sh1106_DrawHLine(sh1106_t * dev, int16_t x, int16_t y, int16_t width,
+                                 sh1106_color_t color) {
+    return sh1106_FillRect(dev, x, y, width, 1, color);
+}
+
+sh1106_status_t sh1106_DrawVLine(sh1106_t * dev, int16_t x, int16_t y, int16_t height,
+                                 sh1106_color_t color) {
+    return sh1106_FillRect(dev, x, y, 1, height, color);
+}
+
+sh1106_status_t sh1106_DrawRect(sh1106_t * dev, int16_t x, int16_t y, int16_t width,
+                                int16_t height, sh1106_color_t color) {
+#if SH1106_STRIP
+    if (sh1106_DevRecording(dev)) {
+        return sh1106_StripRect(dev, x, y, width, height, color, false);
+    }
+#endif
+    if (width <= 0 || height <= 0) {
+        return SH1106_OK;
+    }
+    sh1106_FillRect(dev, x, y, width, 1, color);
+    sh1106_FillRect(dev, x, y + height - 1, width, 1, color);
+    if (height > 2) {
+        sh1106_FillRect(dev, x, y + 1, 1, height - 2, color);
+        sh1106_FillRect(dev, x + width - 1, y + 1, 1, height - 2, color);
+    }
+    return SH1106_OK;
+}
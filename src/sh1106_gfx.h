@@ -0,0 +1,152 @@
+/**
+ * @file sh1106_gfx.h
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Header File - Primitivas de dibujo para el driver SH1106
+ *
+ * Las primitivas escriben directamente sobre el buffer del display, que esta organizado en
+ * paginas: cada byte es una columna de 8 pixeles verticales (bit 0 arriba). En lugar de dibujar
+ * pixel por pixel, cada primitiva recorta sus limites contra la pantalla una sola vez, calcula las
+ * mascaras de la primera y ultima pagina que toca y escribe las paginas intermedias completas con
+ * memset. Al terminar marca como modificadas las regiones escritas.
+ *
+ * Las coordenadas son con signo, por lo que una figura puede quedar parcialmente fuera de la
+ * pantalla. Lo que queda afuera no se dibuja y no es un error.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#ifndef INC_SH1106_GFX_H_
+#define INC_SH1106_GFX_H_
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106.h"
+
+/* === Public function declarations ============================================================ */
+/**
+ * @brief Dibuja una linea entre dos puntos con el algoritmo de Bresenham.
+ *
+ * Antes de recorrerla se calculan el primer y ultimo paso visibles, y el error de Bresenham en el
+ * primer paso, por lo que el recorrido no verifica limites en cada pixel y la parte visible de una
+ * linea recortada coincide con la de la linea completa. Las lineas horizontales y verticales se
+ * dibujan con sh1106_FillRect.
+ *
+ * @param dev: Display sobre el que se dibuja.
+ * @param x0: Coordenada en "x" del primer extremo.
+ * @param y0: Coordenada en "y" del primer extremo.
+ * @param x1: Coordenada en "x" del segundo extremo.
+ * @param y1: Coordenada en "y" del segundo extremo.
+ * @param color: Color de la linea.
+ * @return sh1106_status_t: Estado de la operacion.
+ */
+sh1106_status_t sh1106_DrawLine(sh1106_t * dev, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                sh1106_color_t color);
+
+/**
+ * @brief Dibuja una circunferencia con el algoritmo del punto medio.
+ *
+ * Antes de recorrerla se descartan los octantes que quedan fuera de la pantalla. Si la
+ * circunferencia entra completa en la pantalla los pixeles se escriben sin verificar limites.
+ *
+ * @param dev: Display sobre el que se dibuja.
+ * @param cx: Coordenada en "x" del centro.
+ * @param cy: Coordenada en "y" del centro.
+ * @param radius: Radio en pixeles.
+ * @param color: Color de la circunferencia.
+ * @return sh1106_status_t: Estado de la operacion.
+ */
+sh1106_status_t sh1106_DrawCircle(sh1106_t * dev, int16_t cx, int16_t cy, int16_t radius,
+                                  sh1106_color_t color);
+
+/**
+ * @brief Dibuja un circulo relleno.
+ *
+ * Se recorre la circunferencia con el algoritmo del punto medio y se rellena con lineas verticales
+ * (sh1106_FillRect), que en el buffer por paginas se escriben de a un byte por pagina.
+ *
+ * @param dev: Display sobre el que se dibuja.
+ * @param cx: Coordenada en "x" del centro.
+ * @param cy: Coordenada en "y" del centro.
+ * @param radius: Radio en pixeles.
+ * @param color: Color del circulo.
+ * @return sh1106_status_t: Estado de la operacion.
+ */
+sh1106_status_t sh1106_FillCircle(sh1106_t * dev, int16_t cx, int16_t cy, int16_t radius,
+                                  sh1106_color_t color);
+
+/**
+ * @brief Dibuja un arco de circunferencia.
+ *
+ * Los angulos se miden en grados desde el eje "x" positivo (las 3 en punto de un reloj) en sentido
+ * antihorario, y el arco va de start_angle a end_angle en ese sentido. Si la diferencia es un
+ * multiplo de 360 distinto de 0 se dibuja la circunferencia completa. Solo usa aritmetica entera.
+ *
+ * @param dev: Display sobre el que se dibuja.
+ * @param cx: Coordenada en "x" del centro.
+ * @param cy: Coordenada en "y" del centro.
+ * @param radius: Radio en pixeles.
+ * @param start_angle: Angulo inicial en grados.
+ * @param end_angle: Angulo final en grados.
+ * @param color: Color del arco.
+ * @return sh1106_status_t: Estado de la operacion.
+ */
+sh1106_status_t sh1106_DrawArc(sh1106_t * dev, int16_t cx, int16_t cy, int16_t radius,
+                               int16_t start_angle, int16_t end_angle, sh1106_color_t color);
+
+/**
+ * @brief Dibuja una linea horizontal.
+ *
+ * @param dev: Display sobre el que se dibuja.
+ * @param x: Coordenada en "x" del extremo izquierdo.
+ * @param y: Coordenada en "y" de la linea.
+ * @param width: Largo de la linea en pixeles.
+ * @param color: Color de la linea.
+ * @return sh1106_status_t: Estado de la operacion.
+ */
+sh1106_status_t sh1106_DrawHLine(sh1106_t * dev, int16_t x, int16_t y, int16_t width,
+                                 sh1106_color_t color);
+
+/**
+ * @brief Dibuja una linea vertical.
+ *
+ * @param dev: Display sobre el que se dibuja.
+ * @param x: Coordenada en "x" de la linea.
+ * @param y: Coordenada en "y" del extremo superior.
+ * @param height: Largo de la linea en pixeles.
+ * @param color: Color de la linea.
+ * @return sh1106_status_t: Estado de la operacion.
+ */
+sh1106_status_t sh1106_DrawVLine(sh1106_t * dev, int16_t x, int16_t y, int16_t height,
+                                 sh1106_color_t color);
+
+/**
+ * @brief Dibuja un rectangulo relleno.
+ *
+ * @param dev: Display sobre el que se dibuja.
+ * @param x: Coordenada en "x" de la esquina superior izquierda.
+ * @param y: Coordenada en "y" de la esquina superior izquierda.
+ * @param width: Ancho en pixeles.
+ * @param height: Alto en pixeles.
+ * @param color: Color del relleno.
+ * @return sh1106_status_t: Estado de la operacion.
+ */
+sh1106_status_t sh1106_FillRect(sh1106_t * dev, int16_t x, int16_t y, int16_t width,
+                                int16_t height, sh1106_color_t color);
+
+/**
+ * @brief Dibuja el contorno de un rectangulo, de 1 pixel de ancho.
+ *
+ * @param dev: Display sobre el que se dibuja.
+ * @param x: Coordenada en "x" de la esquina superior izquierda.
+ * @param y: Coordenada en "y" de la esquina superior izquierda.
+ * @param width: Ancho en pixeles.
+ * @param height: Alto en pixeles.
+ * @param color: Color del contorno.
+ * @return sh1106_status_t: Estado de la operacion.
+ */
+sh1106_status_t sh1106_DrawRect(sh1106_t * dev, int16_t x, int16_t y, int16_t width,
+                                int16_t height, sh1106_color_t color);
+
+#endif /* INC_SH1106_GFX_H_ */
@@ -0,0 +1,218 @@
+/**
+ * @file sh1106_gray.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Source File - Escala de grises por modulacion temporal para el driver SH1106
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106_gray.h"
+
+/* === Private function declarations =========================================================== */
+/**
+ * @brief Cuadros de un ciclo completo.
+ */
+static uint8_t sh1106_GrayCycleLength(const sh1106_gray_t * gray) {
+    return (gray->mode == SH1106_GRAY_PWM) ? SH1106_GRAY_LEVELS(gray->bits) - 1 : gray->bits;
+}
+
+/**
+ * @brief Plano que se muestra en el proximo cuadro.
+ *
+ * En modo PWM el cuadro n del ciclo (contando desde 1) muestra el plano bits - 1 - z, con z la
+ * cantidad de ceros al final de n: el plano mas significativo sale uno de cada dos cuadros, el
+ * siguiente uno de cada cuatro, y asi hasta el plano 0, que sale una vez por ciclo.
+ */
+static uint8_t sh1106_GrayPlane(const sh1106_gray_t * gray) {
+    if (gray->mode == SH1106_GRAY_CONTRAST) {
+        return gray->frame;
+    }
+
+    uint8_t number = gray->frame + 1, zeros = 0;
+    while ((number & 1) == 0) {
+        number >>= 1;
+        zeros++;
+    }
+    return gray->bits - 1 - zeros;
+}
+
+/**
+ * @brief Copia un plano al buffer de dibujo del display y marca, en cada pagina, el tramo de
+ * columnas que difiere del cuadro anterior.
+ */
+static void sh1106_GrayShow(sh1106_gray_t * gray, const uint8_t * plane) {
+    sh1106_t * dev = gray->dev;
+    uint8_t width = sh1106_DevWidth(dev);
+
+    for (uint8_t page = 0; page < sh1106_DevPages(dev); page++) {
+        sh1106_DevCopyPage(dev, page, 0, &plane[width * page], width);
+    }
+}
+
+/* === Public function declarations ============================================================ */
+sh1106_status_t sh1106_GrayCreate(sh1106_gray_t * gray, sh1106_t * dev, uint8_t * planes,
+                                  uint8_t bits, sh1106_gray_mode_t mode) {
+    if (planes == NULL || bits < SH1106_GRAY_MIN_BITS || bits > SH1106_GRAY_MAX_BITS ||
+        mode > SH1106_GRAY_CONTRAST) {
+        return SH1106_ERROR;
+    }
+#if SH1106_STRIP
+    // Los planos se copian a un buffer de pantalla completa.
+    if (dev->list != NULL) {
+        return SH1106_ERROR;
+    }
+#endif
+
+    memset(gray, 0, sizeof(*gray));
+    gray->dev = dev;
+    gray->planes = planes;
+    gray->plane_size = sh1106_DevWidth(dev) * sh1106_DevPages(dev);
+    gray->bits = bits;
+    gray->mode = mode;
+    gray->contrast = dev->contrast;
+    memset(planes, 0, bits * gray->plane_size);
+    return SH1106_OK;
+}
+
+void sh1106_GraySetContrast(sh1106_gray_t * gray, uint8_t contrast) {
+    gray->contrast = contrast;
+}
+
+void sh1106_GrayDrawPixel(sh1106_gray_t * gray, uint8_t x, uint8_t y, uint8_t level) {
+    if (x >= sh1106_DevWidth(gray->dev) || y >= sh1106_DevHeight(gray->dev)) {
+        return;
+    }
+
+    uint8_t * byte = &gray->planes[sh1106_DevWidth(gray->dev) * (y / 8) + x];
+    uint8_t mask = 1 << (y % 8);
+    for (uint8_t bit = 0; bit < gray->bits; bit++) {
+        if (level & (1 << bit)) {
+            *byte |= mask;
+        } else {
+            *byte &= ~mask;
+        }
+        byte += gray->plane_size;
+    }
+}
+
+uint8_t sh1106_GrayGetPixel(const sh1106_gray_t * gray, uint8_t x, uint8_t y) {
+    if (x >= sh1106_DevWidth(gray->dev) || y >= sh1106_DevHeight(gray->dev)) {
+        return 0;
+    }
+
+    const uint8_t * byte = &gray->planes[sh1106_DevWidth(gray->dev) * (y / 8) + x];
+    uint8_t level = 0;
+    for (uint8_t bit = 0; bit < gray->bits; bit++) {
+        if (*byte & (1 << (y % 8))) {
+            level |= 1 << bit;
+        }
+        byte += gray->plane_size;
+    }
+    return level;
+}
+
+void sh1106_GrayFillRect(sh1106_gray_t * gray, uint8_t x, uint8_t y, uint8_t width,
+                         uint8_t height, uint8_t level) {
+    uint8_t dev_width = sh1106_DevWidth(gray->dev), dev_height = sh1106_DevHeight(gray->dev);
+
+    if (x >= dev_width || y >= dev_height || width == 0 || height == 0) {
+        return;
+    }
+    uint8_t end = (width > dev_width - x) ? dev_width : x + width;
+    uint8_t last = (height > dev_height - y) ? dev_height - 1 : y + height - 1;
+
+    for (uint8_t page = y / 8; page <= last / 8; page++) {
+        uint8_t mask = 0xFF;
+        if (page == y / 8) {
+            mask &= 0xFF << (y % 8);
+        }
+        if (page == last / 8) {
+            mask &= 0xFF >> (7 - last % 8);
+        }
+
+        uint8_t * row = &gray->planes[dev_width * page];
+        for (uint8_t bit = 0; bit < gray->bits; bit++) {
+            if (level & (1 << bit)) {
+                for (uint8_t column = x; column < end; column++) {
+                    row[column] |= mask;
+                }
+            } else {
+                for (uint8_t column = x; column < end; column++) {
+                    row[column] &= ~mask;
+                }
+            }
+            row += gray->plane_size;
+        }
+    }
+}
+
+void sh1106_GrayFill(sh1106_gray_t * gray, uint8_t level) {
+    for (uint8_t bit = 0; bit < gray->bits; bit++) {
+        memset(&gray->planes[gray->plane_size * bit], (level & (1 << bit)) ? 0xFF : 0x00,
+               gray->plane_size);
+    }
+}
+
+sh1106_status_t sh1106_GrayTick(sh1106_gray_t * gray, uint32_t now_us) {
+    sh1106_t * dev = gray->dev;
+    sh1106_status_t status;
+
+#if SH1106_ASYNC
+    if (dev->front != NULL && sh1106_DevAsyncStatus(dev) == SH1106_BUSY) {
+        gray->skipped++;
+        return SH1106_BUSY;
+    }
+#endif
+
+    uint8_t plane = sh1106_GrayPlane(gray);
+    sh1106_GrayShow(gray, &gray->planes[gray->plane_size * plane]);
+    if (gray->mode == SH1106_GRAY_CONTRAST) {
+        uint8_t contrast = gray->contrast >> (gray->bits - 1 - plane);
+        contrast = (contrast == 0) ? 1 : contrast;
+        // El contraste viaja con la primera pagina del cuadro que lo usa.
+        if (contrast != dev->contrast) {
+            sh1106_DevContrasSetOnUpdate(dev, contrast);
+        }
+    }
+
+#if SH1106_ASYNC
+    if (dev->front != NULL) {
+        status = sh1106_DevUpdateScreenAsync(dev, NULL);
+    } else
+#endif
+    {
+        status = sh1106_DevUpdateScreen(dev);
+    }
+    if (status != SH1106_OK) {
+        return status;
+    }
+
+    gray->frame = (gray->frame + 1 == sh1106_GrayCycleLength(gray)) ? 0 : gray->frame + 1;
+    if (gray->frames == 0) {
+        gray->first_us = now_us;
+    }
+    gray->last_us = now_us;
+    gray->frames++;
+    return SH1106_OK;
+}
+
+void sh1106_GrayGetStats(const sh1106_gray_t * gray, sh1106_gray_stats_t * stats) {
+    uint32_t elapsed = gray->last_us - gray->first_us;
+
+    stats->frames = gray->frames;
+    stats->skipped = gray->skipped;
+    stats->cycles = gray->frames / sh1106_GrayCycleLength(gray);
+    stats->frame_rate_mhz = 0;
+    if (gray->frames > 1 && elapsed != 0) {
+        stats->frame_rate_mhz = (uint32_t)((uint64_t)(gray->frames - 1) * 1000000000u / elapsed);
+    }
+    stats->cycle_rate_mhz = stats->frame_rate_mhz / sh1106_GrayCycleLength(gray);
+}
+
+void sh1106_GrayResetStats(sh1106_gray_t * gray) {
+    gray->frames = 0;
+    gray->skipped = 0;
+}
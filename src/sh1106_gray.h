@@ -0,0 +1,185 @@
+/**
+ * @file sh1106_gray.h
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Header File - Escala de grises por modulacion temporal para el driver SH1106
+ *
+ * El SH1106 solo enciende o apaga cada pixel. Para mostrar niveles de gris se dibuja sobre un
+ * conjunto de planos de bits (el plano k guarda el bit k del nivel de cada pixel) y un planificador
+ * muestra un plano por cuadro, de forma que el tiempo (o el brillo) que cada pixel pasa encendido
+ * es proporcional a su nivel. La aplicacion llama a sh1106_GrayTick a un ritmo fijo, normalmente
+ * desde un temporizador.
+ *
+ * Hay dos formas de pesar los planos:
+ *
+ * <ul>
+ *   <li>SH1106_GRAY_PWM: el plano k se muestra 2^k cuadros de cada ciclo de 2^bits - 1 cuadros,
+ * intercalados (modulacion por codigo binario) para que el parpadeo sea el de los planos bajos.
+ * No cambia el contraste.</li>
+ *   <li>SH1106_GRAY_CONTRAST: cada plano se muestra un cuadro por ciclo, con el contraste escalado
+ * segun su peso, que viaja en la transaccion de la primera pagina del cuadro. El ciclo dura solo
+ * bits cuadros, pero la respuesta del panel al contraste no es lineal, por lo que los niveles
+ * quedan menos parejos.</li>
+ * </ul>
+ *
+ * Cada cuadro se copia al buffer de dibujo del display (que mientras tanto pertenece al
+ * planificador) comparando contra su contenido, por lo que solo se marcan y se envian las columnas
+ * que difieren del cuadro anterior: las zonas negras o de nivel maximo no generan trafico. Con
+ * SH1106_ASYNC y un display con buffer de transmision el envio es sin bloqueo, y si el cuadro
+ * anterior sigue en curso el tick se descarta.
+ *
+ * Solo es practico si el cuadro se envia bastante mas rapido que el periodo del tick. Los
+ * contadores de sh1106_GrayGetStats informan la frecuencia de cuadros y de ciclos lograda.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#ifndef INC_SH1106_GRAY_H_
+#define INC_SH1106_GRAY_H_
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106.h"
+
+/* === Definicion de los macros publicos ======================================================= */
+#define SH1106_GRAY_MIN_BITS (2) ///< @brief Bits por pixel minimos.
+#define SH1106_GRAY_MAX_BITS (4) ///< @brief Bits por pixel maximos.
+
+/**
+ * @brief Cantidad de niveles de gris con bits por pixel.
+ */
+#define SH1106_GRAY_LEVELS(bits) (1u << (bits))
+
+/**
+ * @brief Bytes de los planos de bits para un display de width x height pixeles.
+ */
+#define SH1106_GRAY_BUFFER_SIZE(width, height, bits) ((bits) * SH1106_BUFFER_SIZE(width, height))
+
+/* === Public data type declarations =========================================================== */
+/**
+ * @brief Forma de pesar los planos de bits.
+ */
+typedef enum {
+    SH1106_GRAY_PWM = 0,  ///< @brief Cada plano se muestra una cantidad de cuadros segun su peso.
+    SH1106_GRAY_CONTRAST, ///< @brief Cada plano se muestra un cuadro, con contraste segun su peso.
+} sh1106_gray_mode_t;
+
+/**
+ * @brief Contadores del planificador.
+ */
+typedef struct {
+    uint32_t frames;         ///< @brief Cuadros enviados.
+    uint32_t skipped;        ///< @brief Ticks descartados porque el cuadro anterior no termino.
+    uint32_t cycles;         ///< @brief Ciclos completos (todos los planos con su peso).
+    uint32_t frame_rate_mhz; ///< @brief Cuadros por segundo logrados, en milihertz.
+    uint32_t cycle_rate_mhz; ///< @brief Ciclos por segundo logrados, en milihertz.
+} sh1106_gray_stats_t;
+
+/**
+ * @brief Display en escala de grises. Los campos son de uso interno, solo deben leerse.
+ */
+typedef struct {
+    sh1106_t * dev;          ///< @brief Display donde se muestran los cuadros.
+    uint8_t * planes;        ///< @brief Planos de bits, uno detras de otro, pagina por pagina.
+    uint16_t plane_size;     ///< @brief Bytes de cada plano.
+    uint8_t bits;            ///< @brief Bits por pixel.
+    sh1106_gray_mode_t mode; ///< @brief Forma de pesar los planos.
+    uint8_t contrast;        ///< @brief Contraste del plano mas significativo (modo contraste).
+    uint8_t frame;           ///< @brief Posicion del proximo cuadro dentro del ciclo.
+    uint32_t frames;         ///< @brief Cuadros enviados.
+    uint32_t skipped;        ///< @brief Ticks descartados.
+    uint32_t first_us;       ///< @brief Instante del primer cuadro contado.
+    uint32_t last_us;        ///< @brief Instante del ultimo cuadro contado.
+} sh1106_gray_t;
+
+/* === Public function declarations ============================================================ */
+/**
+ * @brief Inicializa un display en escala de grises con todos los pixeles en nivel 0.
+ *
+ * @param gray: Display en escala de grises a inicializar.
+ * @param dev: Display donde se muestran los cuadros, ya creado.
+ * @param planes: Memoria de los planos, de SH1106_GRAY_BUFFER_SIZE(ancho, alto, bits) bytes.
+ * @param bits: Bits por pixel, de SH1106_GRAY_MIN_BITS a SH1106_GRAY_MAX_BITS.
+ * @param mode: Forma de pesar los planos. En modo contraste se parte del contraste del display.
+ * @return sh1106_status_t: SH1106_ERROR si falta la memoria, los bits no son validos o el display
+ * esta en modo tira.
+ */
+sh1106_status_t sh1106_GrayCreate(sh1106_gray_t * gray, sh1106_t * dev, uint8_t * planes,
+                                  uint8_t bits, sh1106_gray_mode_t mode);
+
+/**
+ * @brief Cambia el contraste del plano mas significativo en modo contraste. Los demas planos usan
+ * la mitad del contraste del plano siguiente.
+ *
+ * @param gray: Display en escala de grises.
+ * @param contrast: Contraste del plano mas significativo.
+ */
+void sh1106_GraySetContrast(sh1106_gray_t * gray, uint8_t contrast);
+
+/**
+ * @brief Pinta un pixel.
+ *
+ * @param gray: Display en escala de grises.
+ * @param x: Coordenada en "x" del pixel.
+ * @param y: Coordenada en "y" del pixel.
+ * @param level: Nivel de 0 (apagado) a SH1106_GRAY_LEVELS(bits) - 1 (encendido siempre). Se
+ * descartan los bits de mas.
+ */
+void sh1106_GrayDrawPixel(sh1106_gray_t * gray, uint8_t x, uint8_t y, uint8_t level);
+
+/**
+ * @brief Lee el nivel de un pixel.
+ *
+ * @return uint8_t: Nivel del pixel, 0 fuera del display.
+ */
+uint8_t sh1106_GrayGetPixel(const sh1106_gray_t * gray, uint8_t x, uint8_t y);
+
+/**
+ * @brief Pinta un rectangulo relleno de un nivel, recortado al display.
+ *
+ * @param gray: Display en escala de grises.
+ * @param x: Coordenada en "x" de la esquina superior izquierda.
+ * @param y: Coordenada en "y" de la esquina superior izquierda.
+ * @param width: Ancho del rectangulo.
+ * @param height: Alto del rectangulo.
+ * @param level: Nivel del rectangulo.
+ */
+void sh1106_GrayFillRect(sh1106_gray_t * gray, uint8_t x, uint8_t y, uint8_t width,
+                         uint8_t height, uint8_t level);
+
+/**
+ * @brief Pinta todo el display de un nivel.
+ */
+void sh1106_GrayFill(sh1106_gray_t * gray, uint8_t level);
+
+/**
+ * @brief Muestra el proximo cuadro del ciclo.
+ *
+ * Copia el plano que corresponde al buffer de dibujo del display, marcando solo las columnas que
+ * cambiaron, ajusta el contraste en modo contraste y actualiza la pantalla. Si el display tiene
+ * buffer de transmision la actualizacion es asincronica.
+ *
+ * @param gray: Display en escala de grises.
+ * @param now_us: Instante del tick en microsegundos, para medir la frecuencia lograda. Puede dar
+ * la vuelta.
+ * @return sh1106_status_t: SH1106_BUSY si el cuadro anterior sigue en curso (el tick se descarta
+ * y el ciclo no avanza), SH1106_ERROR si fallo el envio.
+ */
+sh1106_status_t sh1106_GrayTick(sh1106_gray_t * gray, uint32_t now_us);
+
+/**
+ * @brief Copia los contadores del planificador y calcula las frecuencias logradas desde el
+ * primer cuadro contado hasta el ultimo.
+ *
+ * @param gray: Display en escala de grises.
+ * @param stats: Puntero donde se copian los contadores.
+ */
+void sh1106_GrayGetStats(const sh1106_gray_t * gray, sh1106_gray_stats_t * stats);
+
+/**
+ * @brief Pone en cero los contadores del planificador.
+ */
+void sh1106_GrayResetStats(sh1106_gray_t * gray);
+
+#endif /* INC_SH1106_GRAY_H_ */
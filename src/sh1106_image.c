@@ -0,0 +1,119 @@
+/**
+ * @file sh1106_image.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Source File - Imagenes comprimidas para el driver SH1106
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106_image.h"
+#include "sh1106_strip.h"
+
+/* === Private function declarations =========================================================== */
+/**
+ * @brief Descomprime una pagina de la imagen en row, que tiene la pagina anterior (o ceros antes
+ * de la primera): los tramos SH1106_IMAGE_COPY dejan sus columnas sin tocar.
+ *
+ * @param image: Imagen comprimida.
+ * @param in: Primer tramo de la pagina.
+ * @param row: Pagina descomprimida, de image->width bytes.
+ * @return const uint8_t*: Primer tramo de la pagina siguiente, o NULL si los datos estan
+ * corruptos.
+ */
+static const uint8_t * sh1106_ImagePage(const sh1106_image_t * image, const uint8_t * in,
+                                        uint8_t * row) {
+    const uint8_t * end = &image->data[image->size];
+    uint8_t column = 0;
+
+    while (column < image->width) {
+        if (in == end) {
+            return NULL;
+        }
+        uint8_t header = *in++;
+        uint8_t count = (header & (SH1106_IMAGE_RUN_MAX - 1)) + 1;
+        if (count > image->width - column) {
+            return NULL;
+        }
+        switch (header & ~(SH1106_IMAGE_RUN_MAX - 1)) {
+        case SH1106_IMAGE_LITERAL:
+            if (end - in < count) {
+                return NULL;
+            }
+            memcpy(&row[column], in, count);
+            in += count;
+            break;
+        case SH1106_IMAGE_REPEAT:
+            if (in == end) {
+                return NULL;
+            }
+            memset(&row[column], *in++, count);
+            break;
+        case SH1106_IMAGE_COPY:
+            break;
+        default:
+            return NULL;
+        }
+        column += count;
+    }
+    return in;
+}
+
+/* === Public function declarations ============================================================ */
+sh1106_status_t sh1106_DrawImage(sh1106_t * dev, const sh1106_image_t * image, int16_t x,
+                                 int16_t y, sh1106_rop_t rop) {
+    if (rop > SH1106_ROP_AND_NOT || image->width > SH1106_MAX_WIDTH) {
+        return SH1106_ERROR;
+    }
+#if SH1106_STRIP
+    if (sh1106_DevRecording(dev)) {
+        return sh1106_StripImage(dev, image, x, y, rop);
+    }
+#endif
+
+    uint8_t row[SH1106_MAX_WIDTH] = {0};
+    const uint8_t * in = image->data;
+    // Las paginas que quedan debajo de la pantalla no se descomprimen.
+    for (uint8_t page = 0; page < (image->height + 7) / 8 && y + 8 * page < sh1106_DevHeight(dev);
+         page++) {
+        in = sh1106_ImagePage(image, in, row);
+        if (in == NULL) {
+            return SH1106_ERROR;
+        }
+        uint8_t rows = image->height - 8 * page;
+        sh1106_bitmap_t strip = {.data = row, .width = image->width};
+        strip.height = (rows < 8) ? rows : 8;
+        sh1106_DrawBitmap(dev, &strip, x, y + 8 * page, rop);
+    }
+    return SH1106_OK;
+}
+
+sh1106_status_t sh1106_SendImage(sh1106_t * dev, const sh1106_image_t * image, uint8_t column,
+                                 uint8_t page) {
+    uint8_t pages = (image->height + 7) / 8;
+    // Con el display girado un cuarto de vuelta el panel tiene el ancho y el alto intercambiados.
+    bool turned = dev->orientation >= SH1106_ROTATE_90;
+    uint8_t panel_width = turned ? sh1106_DevHeight(dev) : sh1106_DevWidth(dev);
+    uint8_t panel_pages = (turned ? sh1106_DevWidth(dev) : sh1106_DevHeight(dev)) / 8;
+
+    if (image->width == 0 || pages == 0 || column + image->width > panel_width ||
+        page + pages > panel_pages) {
+        return SH1106_ERROR;
+    }
+
+    uint8_t row[SH1106_MAX_WIDTH] = {0};
+    const uint8_t * in = image->data;
+    for (uint8_t i = 0; i < pages; i++) {
+        in = sh1106_ImagePage(image, in, row);
+        if (in == NULL) {
+            return SH1106_ERROR;
+        }
+        sh1106_status_t status = sh1106_DevWritePage(dev, page + i, column, row, image->width);
+        if (status != SH1106_OK) {
+            return status;
+        }
+    }
+    return SH1106_OK;
+}
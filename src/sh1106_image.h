@@ -0,0 +1,89 @@
+/**
+ * @file sh1106_image.h
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Header File - Imagenes comprimidas para el driver SH1106
+ *
+ * Las imagenes se guardan comprimidas con el mismo orden que el buffer del display: pagina por
+ * pagina, una columna de 8 pixeles por byte con el bit 0 arriba. Cada pagina es una secuencia de
+ * tramos que cubre exactamente sus width columnas, sin pasar a la pagina siguiente. Cada tramo
+ * empieza con un byte de cabecera: los 2 bits altos son el tipo y los 6 bajos la cantidad de
+ * columnas menos uno (de 1 a SH1106_IMAGE_RUN_MAX).
+ * <ul>
+ *   <li>SH1106_IMAGE_LITERAL: siguen las columnas, sin comprimir.</li>
+ *   <li>SH1106_IMAGE_REPEAT: sigue un byte, que se repite en todas las columnas.</li>
+ *   <li>SH1106_IMAGE_COPY: no sigue nada, las columnas son iguales a las de la pagina anterior (en
+ * la primera pagina, negras).</li>
+ * </ul>
+ *
+ * Las imagenes se generan a partir de archivos PBM con tools/pbm2img.py. Se dibujan en el buffer
+ * como un mapa de bits (sh1106_DrawImage) o se envian directamente al panel, sin pasar por el
+ * buffer (sh1106_SendImage). En ambos casos se descomprime una pagina por vez, en la pila.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#ifndef INC_SH1106_IMAGE_H_
+#define INC_SH1106_IMAGE_H_
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106.h"
+#include "sh1106_bitmap.h"
+
+/* === Definicion de los macros publicos ======================================================= */
+#define SH1106_IMAGE_LITERAL (0x00) ///< @brief Tramo de columnas sin comprimir
+#define SH1106_IMAGE_REPEAT  (0x40) ///< @brief Tramo de un byte repetido
+#define SH1106_IMAGE_COPY    (0x80) ///< @brief Tramo igual a la pagina anterior
+#define SH1106_IMAGE_RUN_MAX (64)   ///< @brief Columnas maximas de un tramo
+
+/* === Public data type declarations =========================================================== */
+/**
+ * @brief Imagen monocromatica comprimida.
+ */
+typedef struct {
+    const uint8_t * data; ///< @brief Tramos comprimidos de todas las paginas.
+    uint16_t size;        ///< @brief Bytes de data.
+    uint8_t width;        ///< @brief Ancho en pixeles, hasta SH1106_MAX_WIDTH.
+    uint8_t height;       ///< @brief Alto en pixeles.
+} sh1106_image_t;
+
+/* === Public function declarations ============================================================ */
+/**
+ * @brief Dibuja una imagen comprimida en el buffer, como sh1106_DrawBitmap.
+ *
+ * Cada pagina de la imagen se descomprime en la pila y se dibuja como un mapa de bits de una
+ * pagina, por lo que admite cualquier posicion, recorte y operacion de raster.
+ *
+ * @param dev: Display sobre el que se dibuja.
+ * @param image: Imagen comprimida.
+ * @param x: Coordenada en "x" de la esquina superior izquierda.
+ * @param y: Coordenada en "y" de la esquina superior izquierda.
+ * @param rop: Operacion de raster.
+ * @return sh1106_status_t: SH1106_ERROR si la operacion de raster no es valida, la imagen es mas
+ * ancha que la DDRAM o sus datos estan corruptos (las paginas anteriores quedan dibujadas).
+ */
+sh1106_status_t sh1106_DrawImage(sh1106_t * dev, const sh1106_image_t * image, int16_t x,
+                                 int16_t y, sh1106_rop_t rop);
+
+/**
+ * @brief Envia una imagen comprimida directamente al panel, sin pasar por el buffer de dibujo.
+ *
+ * Cada pagina se descomprime en la pila y se envia en una transaccion con sh1106_DevWritePage, por
+ * lo que una pantalla completa se muestra sin ocupar ni modificar el buffer. Pensada para
+ * pantallas de inicio: la proxima actualizacion solo reemplaza las regiones modificadas del
+ * buffer, y sh1106_UpdateScreenFull la reemplaza completa. La ultima pagina se envia completa
+ * aunque la imagen no llegue a su ultima fila.
+ *
+ * @param dev: Display destino.
+ * @param image: Imagen comprimida.
+ * @param column: Columna del panel de la esquina superior izquierda.
+ * @param page: Pagina del panel de la esquina superior izquierda.
+ * @return sh1106_status_t: SH1106_ERROR si la imagen no entra en el panel, sus datos estan
+ * corruptos o fallo el envio, SH1106_BUSY si hay una actualizacion asincronica en curso.
+ */
+sh1106_status_t sh1106_SendImage(sh1106_t * dev, const sh1106_image_t * image, uint8_t column,
+                                 uint8_t page);
+
+#endif /* INC_SH1106_IMAGE_H_ */
@@ -0,0 +1,170 @@
+/**
+ * @file sh1106_layer.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Source File - Capas compuestas para el driver SH1106
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106_layer.h"
+#include "sh1106_word.h"
+
+/* === Private function declarations =========================================================== */
+/**
+ * @brief Combina una palabra de una capa (ya invertida si corresponde) con la de abajo.
+ */
+static inline sh1106_word_t sh1106_Blend(sh1106_blend_t blend, sh1106_word_t below,
+                                         sh1106_word_t layer, sh1106_word_t mask) {
+    switch (blend) {
+    case SH1106_BLEND_XOR:
+        return below ^ layer;
+    case SH1106_BLEND_OVERWRITE:
+        return (below & ~mask) | (layer & mask);
+    default:
+        return below | layer;
+    }
+}
+
+/**
+ * @brief Combina una capa sobre las columnas [0, size) de row, que empiezan en offset del buffer.
+ * Avanza de a una palabra y termina byte a byte.
+ */
+static void sh1106_LayerRow(const sh1106_layer_t * layer, uint8_t * row, size_t offset,
+                            uint8_t size) {
+    const uint8_t * pixels = &layer->canvas.buffer[offset];
+    const uint8_t * mask = (layer->mask != NULL) ? &layer->mask[offset] : NULL;
+    sh1106_word_t invert = layer->inverted ? ~(sh1106_word_t)0 : 0;
+    sh1106_word_t below, src, opaque = ~(sh1106_word_t)0;
+    uint8_t i = 0;
+
+    for (; i + sizeof(sh1106_word_t) <= size; i += sizeof(sh1106_word_t)) {
+        memcpy(&below, &row[i], sizeof(below));
+        memcpy(&src, &pixels[i], sizeof(src));
+        if (mask != NULL) {
+            memcpy(&opaque, &mask[i], sizeof(opaque));
+        }
+        below = sh1106_Blend(layer->blend, below, src ^ invert, opaque);
+        memcpy(&row[i], &below, sizeof(below));
+    }
+    for (; i < size; i++) {
+        opaque = (mask != NULL) ? mask[i] : 0xFF;
+        row[i] = sh1106_Blend(layer->blend, row[i], pixels[i] ^ invert, opaque);
+    }
+}
+
+/**
+ * @brief Columnas [first, end) de una pagina modificadas en alguna capa desde la composicion
+ * anterior. Las deja sin modificar en las capas. Devuelve false si no hay.
+ */
+static bool sh1106_LayersDirty(sh1106_compositor_t * compositor, uint8_t page, uint8_t * first,
+                               uint8_t * end) {
+    *first = sh1106_DevWidth(compositor->dev);
+    *end = 0;
+    for (uint8_t i = 0; i < compositor->count; i++) {
+        sh1106_t * canvas = &compositor->layers[i]->canvas;
+        if (canvas->dirty_all) {
+            *first = 0;
+            *end = sh1106_DevWidth(compositor->dev);
+        } else if (canvas->dirty_end[page] != 0) {
+            *first = (canvas->dirty_first[page] < *first) ? canvas->dirty_first[page] : *first;
+            *end = (canvas->dirty_end[page] > *end) ? canvas->dirty_end[page] : *end;
+        }
+        canvas->dirty_end[page] = 0;
+    }
+    return *end != 0;
+}
+
+/* === Public function declarations ============================================================ */
+sh1106_status_t sh1106_CompositorCreate(sh1106_compositor_t * compositor, sh1106_t * dev) {
+#if SH1106_STRIP
+    if (dev->list != NULL) {
+        return SH1106_ERROR;
+    }
+#endif
+    compositor->dev = dev;
+    compositor->count = 0;
+    return SH1106_OK;
+}
+
+sh1106_status_t sh1106_LayerCreate(sh1106_compositor_t * compositor, sh1106_layer_t * layer,
+                                   uint8_t * buffer, sh1106_blend_t blend) {
+    sh1106_t * dev = compositor->dev;
+    // Con la misma orientacion, el buffer de la capa tiene el formato del buffer del display.
+    bool turned = dev->orientation >= SH1106_ROTATE_90;
+    sh1106_config_t config = {.buffer = buffer,
+                              .width = turned ? sh1106_DevHeight(dev) : sh1106_DevWidth(dev),
+                              .height = turned ? sh1106_DevWidth(dev) : sh1106_DevHeight(dev),
+                              .orientation = dev->orientation,
+                              .column_offset = sh1106_DevColumnOffset(dev),
+                              .address = dev->address,
+                              .transport = dev->transport};
+
+    if (blend > SH1106_BLEND_OVERWRITE || compositor->count == SH1106_LAYER_MAX ||
+        sh1106_DevCreate(&layer->canvas, &config) != SH1106_OK) {
+        return SH1106_ERROR;
+    }
+    memset(buffer, 0, sh1106_DevWidth(dev) * sh1106_DevPages(dev));
+    sh1106_DevInvalidateAll(&layer->canvas);
+    layer->mask = NULL;
+    layer->blend = blend;
+    layer->enabled = true;
+    layer->inverted = false;
+    compositor->layers[compositor->count++] = layer;
+    return SH1106_OK;
+}
+
+void sh1106_LayerSetEnabled(sh1106_layer_t * layer, bool enabled) {
+    if (layer->enabled != enabled) {
+        layer->enabled = enabled;
+        sh1106_DevInvalidateAll(&layer->canvas);
+    }
+}
+
+void sh1106_LayerSetInverted(sh1106_layer_t * layer, bool inverted) {
+    if (layer->inverted != inverted) {
+        layer->inverted = inverted;
+        sh1106_DevInvalidateAll(&layer->canvas);
+    }
+}
+
+sh1106_status_t sh1106_LayerSetBlend(sh1106_layer_t * layer, sh1106_blend_t blend,
+                                     const uint8_t * mask) {
+    if (blend > SH1106_BLEND_OVERWRITE) {
+        return SH1106_ERROR;
+    }
+    layer->blend = blend;
+    layer->mask = mask;
+    sh1106_DevInvalidateAll(&layer->canvas);
+    return SH1106_OK;
+}
+
+uint16_t sh1106_Composite(sh1106_compositor_t * compositor) {
+    sh1106_t * dev = compositor->dev;
+    uint8_t width = sh1106_DevWidth(dev);
+    uint16_t composed = 0;
+    uint8_t first, end;
+
+    for (uint8_t page = 0; page < sh1106_DevPages(dev); page++) {
+        if (!sh1106_LayersDirty(compositor, page, &first, &end)) {
+            continue;
+        }
+        uint8_t row[SH1106_MAX_WIDTH] = {0};
+        size_t offset = page * width + first;
+        uint8_t size = end - first;
+        for (uint8_t i = 0; i < compositor->count; i++) {
+            if (compositor->layers[i]->enabled) {
+                sh1106_LayerRow(compositor->layers[i], row, offset, size);
+            }
+        }
+        composed += size;
+        // Solo se marcan las columnas que cambiaron respecto de lo que ya tiene el display.
+        sh1106_DevCopyPage(dev, page, first, row, size);
+    }
+    for (uint8_t i = 0; i < compositor->count; i++) {
+        compositor->layers[i]->canvas.dirty_all = false;
+    }
+    return composed;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file sh1106_layer.h
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Header File - Capas compuestas para el driver SH1106
+ *
+ * Para pantallas con partes que cambian a distinto ritmo, por ejemplo un fondo fijo (grilla,
+ * etiquetas) y valores o un cursor que cambian en cada tick. Cada capa tiene su propio buffer, con
+ * el formato del buffer del display, y se dibuja con las funciones de siempre (sh1106_Dev*,
+ * sh1106_gfx.h, sh1106_font.h, ...) sobre su display de dibujo, layer->canvas. Las capas que no
+ * cambian no se redibujan.
+ *
+ * sh1106_Composite combina las capas habilitadas, de abajo hacia arriba, en el buffer del display
+ * de salida, que desde entonces pertenece al compositor. Solo recompone las columnas modificadas
+ * de alguna capa desde la composicion anterior, de a una palabra del ancho de un puntero, y marca
+ * como modificadas en el display solo las columnas que cambiaron, para que sh1106_UpdateScreen
+ * envie solo eso. Cada capa se puede invertir antes de combinarla, y se combina segun su modo:
+ *
+ * <ul>
+ *   <li>SH1106_BLEND_OR: enciende sus pixeles encendidos.</li>
+ *   <li>SH1106_BLEND_XOR: invierte los pixeles de abajo donde esta encendida.</li>
+ *   <li>SH1106_BLEND_OVERWRITE: reemplaza lo de abajo donde su mascara esta encendida (toda la
+ * capa, sin mascara). La mascara tiene el formato del buffer; si cambia, la capa se invalida con
+ * sh1106_DevInvalidate sobre layer->canvas.</li>
+ * </ul>
+ *
+ * Cada capa incluye un sh1106_t completo, que nunca se envia. No se admite el modo tira.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#ifndef INC_SH1106_LAYER_H_
+#define INC_SH1106_LAYER_H_
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106.h"
+
+/* === Definicion de los macros publicos ======================================================= */
+/**
+ * @brief Cantidad maxima de capas de un compositor.
+ */
+#ifndef SH1106_LAYER_MAX
+#define SH1106_LAYER_MAX (4)
+#endif
+
+/* === Public data type declarations =========================================================== */
+/**
+ * @brief Forma de combinar una capa con las de abajo.
+ */
+typedef enum {
+    SH1106_BLEND_OR = 0,    ///< @brief Enciende sus pixeles encendidos.
+    SH1106_BLEND_XOR,       ///< @brief Invierte los pixeles donde esta encendida.
+    SH1106_BLEND_OVERWRITE, ///< @brief Reemplaza lo de abajo donde la mascara esta encendida.
+} sh1106_blend_t;
+
+/**
+ * @brief Capa. Se dibuja sobre canvas; los demas campos se cambian con las funciones
+ * sh1106_Layer*.
+ */
+typedef struct {
+    sh1106_t canvas;      ///< @brief Display de dibujo de la capa, nunca se envia.
+    const uint8_t * mask; ///< @brief Mascara de SH1106_BLEND_OVERWRITE, o NULL (capa opaca).
+    sh1106_blend_t blend; ///< @brief Forma de combinar la capa.
+    bool enabled;         ///< @brief La capa se combina.
+    bool inverted;        ///< @brief La capa se invierte antes de combinarla.
+} sh1106_layer_t;
+
+/**
+ * @brief Compositor: capas de un display, de abajo hacia arriba.
+ */
+typedef struct {
+    sh1106_t * dev;                            ///< @brief Display de salida.
+    sh1106_layer_t * layers[SH1106_LAYER_MAX]; ///< @brief Capas, la primera es la de abajo.
+    uint8_t count;                             ///< @brief Cantidad de capas.
+} sh1106_compositor_t;
+
+/* === Public function declarations ============================================================ */
+/**
+ * @brief Crea un compositor sin capas sobre un display ya creado.
+ *
+ * @param compositor: Compositor a crear.
+ * @param dev: Display de salida.
+ * @return sh1106_status_t: SH1106_ERROR si el display esta en modo tira.
+ */
+sh1106_status_t sh1106_CompositorCreate(sh1106_compositor_t * compositor, sh1106_t * dev);
+
+/**
+ * @brief Crea una capa negra, habilitada y sin invertir, y la agrega arriba de las demas. La
+ * proxima composicion recompone la pantalla completa.
+ *
+ * @param compositor: Compositor.
+ * @param layer: Capa a crear.
+ * @param buffer: Buffer de la capa, del tamano del buffer del display.
+ * @param blend: Forma de combinar la capa.
+ * @return sh1106_status_t: SH1106_ERROR si falta el buffer, el modo no es valido o el compositor
+ * ya tiene SH1106_LAYER_MAX capas.
+ */
+sh1106_status_t sh1106_LayerCreate(sh1106_compositor_t * compositor, sh1106_layer_t * layer,
+                                   uint8_t * buffer, sh1106_blend_t blend);
+
+/**
+ * @brief Habilita o deshabilita una capa. Si cambia, se recompone la pantalla completa.
+ */
+void sh1106_LayerSetEnabled(sh1106_layer_t * layer, bool enabled);
+
+/**
+ * @brief Invierte o no una capa antes de combinarla. Si cambia, se recompone la pantalla completa.
+ */
+void sh1106_LayerSetInverted(sh1106_layer_t * layer, bool inverted);
+
+/**
+ * @brief Cambia la forma de combinar una capa y su mascara. Se recompone la pantalla completa.
+ *
+ * @param layer: Capa.
+ * @param blend: Forma de combinar la capa.
+ * @param mask: Mascara de SH1106_BLEND_OVERWRITE, o NULL.
+ * @return sh1106_status_t: SH1106_ERROR si el modo no es valido.
+ */
+sh1106_status_t sh1106_LayerSetBlend(sh1106_layer_t * layer, sh1106_blend_t blend,
+                                     const uint8_t * mask);
+
+/**
+ * @brief Combina en el buffer del display las columnas modificadas de las capas y marca como
+ * modificadas las que cambiaron. Despues se envia con sh1106_DevUpdateScreen.
+ *
+ * @param compositor: Compositor.
+ * @return uint16_t: Columnas (de 8 pixeles) recompuestas.
+ */
+uint16_t sh1106_Composite(sh1106_compositor_t * compositor);
+
+#endif /* INC_SH1106_LAYER_H_ */
@@ -0,0 +1,70 @@
+/**
+ * @file sh1106_panel.h
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Header File - Perfiles de panel para el driver SH1106
+ *
+ * El sh1106 maneja una DDRAM de 132x64, pero los paneles conectan solo una parte: un perfil
+ * describe la geometria de un panel (ancho, alto y primera columna de la DDRAM conectada) y la
+ * configuracion que necesita el controlador para manejarlo (relacion de multiplex y pads COM).
+ *
+ * Se elige un perfil en compilacion, por ejemplo con -DSH1106_PANEL=SH1106_PANEL_128X32. Con un
+ * perfil elegido, todos los displays de la compilacion tienen esa geometria: SH1106_WHIDTH,
+ * SH1106_HEIGHT y SH1106_COLUMN_OFFSET salen del perfil, sh1106_DevWidth y las demas funciones de
+ * geometria devuelven constantes, y el compilador pliega los calculos de direcciones y la
+ * secuencia de inicializacion. Sin SH1106_PANEL la geometria de cada display se indica en su
+ * sh1106_config_t.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#ifndef INC_SH1106_PANEL_H_
+#define INC_SH1106_PANEL_H_
+
+/* === Definicion de los macros publicos ======================================================= */
+/**
+ * @brief Panel de 128x32 centrado en las columnas de la DDRAM, COM secuenciales.
+ */
+#define SH1106_PANEL_128X32_WIDTH         (128)
+#define SH1106_PANEL_128X32_HEIGHT        (32)
+#define SH1106_PANEL_128X32_COLUMN_OFFSET (2)
+#define SH1106_PANEL_128X32_MUX_RATIO     (0x1F)
+#define SH1106_PANEL_128X32_COM_PADS      (0x02)
+
+/**
+ * @brief Panel de 128x64 centrado en las columnas de la DDRAM (el modulo de 1.3" habitual), COM
+ * alternativos.
+ */
+#define SH1106_PANEL_128X64_WIDTH         (128)
+#define SH1106_PANEL_128X64_HEIGHT        (64)
+#define SH1106_PANEL_128X64_COLUMN_OFFSET (2)
+#define SH1106_PANEL_128X64_MUX_RATIO     (0x3F)
+#define SH1106_PANEL_128X64_COM_PADS      (0x12)
+
+/**
+ * @brief Panel que usa las 132 columnas de la DDRAM, COM alternativos.
+ */
+#define SH1106_PANEL_132X64_WIDTH         (132)
+#define SH1106_PANEL_132X64_HEIGHT        (64)
+#define SH1106_PANEL_132X64_COLUMN_OFFSET (0)
+#define SH1106_PANEL_132X64_MUX_RATIO     (0x3F)
+#define SH1106_PANEL_132X64_COM_PADS      (0x12)
+
+/**
+ * @brief Valor de un perfil: SH1106_PANEL_FIELD(SH1106_PANEL_128X32, WIDTH) es
+ * SH1106_PANEL_128X32_WIDTH. El perfil puede venir de otro macro, como SH1106_PANEL.
+ */
+#define SH1106_PANEL_FIELD(panel, field)  SH1106_PANEL_FIELD_(panel, field)
+#define SH1106_PANEL_FIELD_(panel, field) panel##_##field
+
+/**
+ * @brief Campos de geometria de sh1106_config_t para un perfil, para usar en la inicializacion:
+ * sh1106_config_t config = {.buffer = buffer, SH1106_PANEL_CONFIG(SH1106_PANEL_128X32), ...};
+ */
+#define SH1106_PANEL_CONFIG(panel)                                                                 \
+    .width = SH1106_PANEL_FIELD(panel, WIDTH), .height = SH1106_PANEL_FIELD(panel, HEIGHT),        \
+    .column_offset = SH1106_PANEL_FIELD(panel, COLUMN_OFFSET)
+
+#endif /* INC_SH1106_PANEL_H_ */
@@ -0,0 +1,209 @@
+/**
+ * @file sh1106_queue.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Source File - Cola de envios sin bloqueo para el driver SH1106
+ *
+ * Los cuadros libres son un mapa de bits que se toma con compare-and-swap, y el ultimo cuadro
+ * entregado un indice que se intercambia atomicamente: entregar reemplaza al anterior y tomarlo lo
+ * deja vacio, sin ventanas en las que un cuadro quede en dos lugares. El anillo de comandos es una
+ * cola acotada con un numero de secuencia por lugar: las productoras reservan la posicion con
+ * compare-and-swap y publican el lugar al escribir su secuencia, de modo que la consumidora nunca
+ * lee un comando a medio copiar.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106_queue.h"
+
+/* === Private function declarations =========================================================== */
+/**
+ * @brief Marca un cuadro como libre.
+ */
+static void sh1106_QueueFree(sh1106_queue_t * queue, int frame) {
+    atomic_fetch_or(&queue->free, 1u << frame);
+}
+
+/**
+ * @brief Indice del cuadro, a partir de su direccion.
+ */
+static int sh1106_QueueIndex(const sh1106_queue_t * queue, const uint8_t * frame) {
+    return (frame - queue->frames) / queue->frame_size;
+}
+
+/**
+ * @brief Avisa a la tarea de envio.
+ */
+static void sh1106_QueueNotify(sh1106_queue_t * queue) {
+    if (queue->notify != NULL) {
+        queue->notify(queue->context);
+    }
+}
+
+/**
+ * @brief Copia un cuadro al buffer del display y marca como modificadas, en cada pagina, las
+ * columnas entre la primera y la ultima que difieren.
+ */
+static void sh1106_QueueApply(sh1106_queue_t * queue, const uint8_t * frame) {
+    sh1106_t * dev = queue->dev;
+    uint8_t width = sh1106_DevWidth(dev);
+
+    for (uint8_t page = 0; page < sh1106_DevPages(dev); page++) {
+        sh1106_DevCopyPage(dev, page, 0, &frame[page * width], width);
+    }
+}
+
+/**
+ * @brief Ejecuta el proximo comando del anillo, si hay uno publicado.
+ */
+static bool sh1106_QueueRunCommand(sh1106_queue_t * queue) {
+    sh1106_queue_slot_t * slot = &queue->slots[queue->head & queue->slot_mask];
+    unsigned sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+
+    if (sequence != queue->head + 1) {
+        return false;
+    }
+    slot->command(queue->dev, slot->args);
+    // El lugar queda libre para la vuelta siguiente del anillo.
+    atomic_store_explicit(&slot->sequence, queue->head + queue->slot_mask + 1,
+                          memory_order_release);
+    queue->head++;
+    return true;
+}
+
+/* === Public function declarations ============================================================ */
+sh1106_status_t sh1106_QueueCreate(sh1106_queue_t * queue, const sh1106_queue_config_t * config) {
+    if (config->dev == NULL || config->frames == NULL || config->frame_count < 2 ||
+        config->frame_count > SH1106_QUEUE_MAX_FRAMES ||
+        (config->slots != NULL &&
+         (config->slot_count == 0 || (config->slot_count & (config->slot_count - 1)) != 0))) {
+        return SH1106_ERROR;
+    }
+#if SH1106_STRIP
+    // En modo tira el buffer del display es de una sola pagina.
+    if (config->dev->list != NULL) {
+        return SH1106_ERROR;
+    }
+#endif
+
+    queue->dev = config->dev;
+    queue->frames = config->frames;
+    queue->frame_size = sh1106_DevWidth(config->dev) * sh1106_DevPages(config->dev);
+    queue->frame_count = config->frame_count;
+    atomic_init(&queue->free, (uint32_t)(((uint64_t)1 << config->frame_count) - 1));
+    atomic_init(&queue->latest, -1);
+    queue->slots = config->slots;
+    queue->slot_mask = (config->slots != NULL) ? config->slot_count - 1 : 0;
+    for (uint16_t i = 0; config->slots != NULL && i < config->slot_count; i++) {
+        atomic_init(&config->slots[i].sequence, i);
+    }
+    atomic_init(&queue->tail, 0);
+    queue->head = 0;
+    queue->notify = config->notify;
+    queue->context = config->context;
+    atomic_init(&queue->frames_count, 0);
+    atomic_init(&queue->coalesced, 0);
+    atomic_init(&queue->commands, 0);
+    atomic_init(&queue->rejected, 0);
+    atomic_init(&queue->flushes, 0);
+    return SH1106_OK;
+}
+
+uint8_t * sh1106_QueueAcquire(sh1106_queue_t * queue) {
+    unsigned free = atomic_load(&queue->free);
+    unsigned bit;
+    int frame = 0;
+
+    do {
+        if (free == 0) {
+            return NULL;
+        }
+        bit = free & -free;
+    } while (!atomic_compare_exchange_weak(&queue->free, &free, free & ~bit));
+
+    while (bit >>= 1) {
+        frame++;
+    }
+    return &queue->frames[frame * queue->frame_size];
+}
+
+void sh1106_QueueSubmit(sh1106_queue_t * queue, uint8_t * frame) {
+    atomic_fetch_add(&queue->frames_count, 1);
+    int previous = atomic_exchange(&queue->latest, sh1106_QueueIndex(queue, frame));
+    if (previous >= 0) {
+        // La tarea de envio no llego a tomar el anterior: se descarta.
+        sh1106_QueueFree(queue, previous);
+        atomic_fetch_add(&queue->coalesced, 1);
+    }
+    sh1106_QueueNotify(queue);
+}
+
+void sh1106_QueueRelease(sh1106_queue_t * queue, uint8_t * frame) {
+    sh1106_QueueFree(queue, sh1106_QueueIndex(queue, frame));
+}
+
+sh1106_status_t sh1106_QueuePost(sh1106_queue_t * queue, sh1106_command_t command,
+                                 const void * args, size_t size) {
+    if (queue->slots == NULL || size > SH1106_QUEUE_ARGS_SIZE) {
+        return SH1106_ERROR;
+    }
+
+    unsigned position = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    sh1106_queue_slot_t * slot;
+    for (;;) {
+        slot = &queue->slots[position & queue->slot_mask];
+        unsigned sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        int difference = (int)(sequence - position);
+        if (difference == 0) {
+            // Libre en esta vuelta: se reserva avanzando tail.
+            if (atomic_compare_exchange_weak_explicit(&queue->tail, &position, position + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // Todavia ocupado por la vuelta anterior: el anillo esta lleno.
+            atomic_fetch_add(&queue->rejected, 1);
+            return SH1106_BUSY;
+        } else {
+            position = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+        }
+    }
+
+    slot->command = command;
+    memcpy(slot->args, args, size);
+    atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+    atomic_fetch_add(&queue->commands, 1);
+    sh1106_QueueNotify(queue);
+    return SH1106_OK;
+}
+
+sh1106_status_t sh1106_QueueFlush(sh1106_queue_t * queue) {
+    bool changed = false;
+
+    int frame = atomic_exchange(&queue->latest, -1);
+    if (frame >= 0) {
+        sh1106_QueueApply(queue, &queue->frames[frame * queue->frame_size]);
+        sh1106_QueueFree(queue, frame);
+        changed = true;
+    }
+    while (queue->slots != NULL && sh1106_QueueRunCommand(queue)) {
+        changed = true;
+    }
+    if (changed) {
+        atomic_fetch_add(&queue->flushes, 1);
+    }
+    // Sin nada nuevo, reintenta lo que haya quedado pendiente de un envio fallido.
+    return sh1106_DevUpdateScreen(queue->dev);
+}
+
+void sh1106_QueueGetStats(sh1106_queue_t * queue, sh1106_queue_stats_t * stats) {
+    stats->frames = atomic_load(&queue->frames_count);
+    stats->coalesced = atomic_load(&queue->coalesced);
+    stats->commands = atomic_load(&queue->commands);
+    stats->rejected = atomic_load(&queue->rejected);
+    stats->flushes = atomic_load(&queue->flushes);
+}
@@ -0,0 +1,204 @@
+/**
+ * @file sh1106_queue.h
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Header File - Cola de envios sin bloqueo para el driver SH1106
+ *
+ * Para aplicaciones con varias tareas que actualizan el mismo display. Las funciones del driver no
+ * son reentrantes: el display (su buffer y el bus) pertenece a una sola tarea, la de envio, que
+ * llama a sh1106_QueueFlush. Las demas tareas (productoras) no tocan el display: le entregan
+ * cuadros completos o comandos de dibujo a traves de la cola, desde cualquier tarea o
+ * interrupcion y sin bloquearse ni tomar locks.
+ *
+ * <ul>
+ *   <li>Cuadros: la productora toma un cuadro libre (sh1106_QueueAcquire), lo dibuja completo y lo
+ * entrega (sh1106_QueueSubmit). Solo se envia el ultimo cuadro entregado: si llega otro antes de
+ * que la tarea de envio tome el anterior, el anterior se descarta sin enviarse y vuelve a quedar
+ * libre. La tarea de envio copia al buffer del display solo las columnas que difieren, por lo que
+ * la actualizacion envia solo lo que cambio.</li>
+ *   <li>Comandos: una funcion de dibujo y hasta SH1106_QUEUE_ARGS_SIZE bytes de argumentos, que se
+ * copian a un anillo acotado con varias productoras y una consumidora. La tarea de envio ejecuta
+ * todos los pendientes, en el orden en que se encolaron, sobre el buffer del display. Los de una
+ * misma productora mantienen su orden.</li>
+ * </ul>
+ *
+ * Cada llamada a sh1106_QueueFlush aplica el ultimo cuadro, luego los comandos pendientes, y hace
+ * una sola actualizacion si algo cambio. La cola avisa a la tarea de envio con la funcion notify
+ * de su configuracion (por ejemplo xTaskNotifyGive en FreeRTOS, o sh1106_FlusherNotify de
+ * sh1106_flusher.h en Linux).
+ *
+ * La cola no usa memoria dinamica: la aplicacion reserva los cuadros y el anillo. Necesita C11
+ * con <stdatomic.h>, con operaciones atomicas sin lock sobre enteros de 32 bits.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#ifndef INC_SH1106_QUEUE_H_
+#define INC_SH1106_QUEUE_H_
+
+#if !defined(__STDC_VERSION__) || __STDC_VERSION__ < 201112L || defined(__STDC_NO_ATOMICS__)
+#error "sh1106_queue.h necesita C11 con <stdatomic.h>"
+#endif
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include <stdatomic.h>
+#include "sh1106.h"
+
+/* === Definicion de los macros publicos ======================================================= */
+/**
+ * @brief Bytes maximos de los argumentos de un comando.
+ */
+#ifndef SH1106_QUEUE_ARGS_SIZE
+#define SH1106_QUEUE_ARGS_SIZE (16)
+#endif
+
+#define SH1106_QUEUE_MAX_FRAMES (32) ///< @brief Cuadros maximos de una cola
+
+/* === Public data type declarations =========================================================== */
+/**
+ * @brief Comando de dibujo, la tarea de envio lo ejecuta sobre el display.
+ *
+ * @param dev: Display de la cola.
+ * @param args: Copia de los argumentos encolados.
+ */
+typedef void (*sh1106_command_t)(sh1106_t * dev, const void * args);
+
+/**
+ * @brief Aviso a la tarea de envio de que hay algo nuevo en la cola.
+ *
+ * @param context: Contexto de la configuracion.
+ */
+typedef void (*sh1106_notify_t)(void * context);
+
+/**
+ * @brief Lugar del anillo de comandos. La aplicacion reserva el anillo, sin inicializar.
+ */
+typedef struct {
+    atomic_uint sequence;                 ///< @brief Vuelta del anillo en la que esta ocupado.
+    sh1106_command_t command;             ///< @brief Funcion de dibujo.
+    uint8_t args[SH1106_QUEUE_ARGS_SIZE]; ///< @brief Copia de los argumentos.
+} sh1106_queue_slot_t;
+
+/**
+ * @brief Contadores de la cola.
+ */
+typedef struct {
+    uint32_t frames;    ///< @brief Cuadros entregados.
+    uint32_t coalesced; ///< @brief Cuadros descartados por otro mas nuevo, sin enviarse.
+    uint32_t commands;  ///< @brief Comandos encolados.
+    uint32_t rejected;  ///< @brief Comandos rechazados con el anillo lleno.
+    uint32_t flushes;   ///< @brief Actualizaciones de la tarea de envio.
+} sh1106_queue_stats_t;
+
+/**
+ * @brief Parametros para crear una cola con sh1106_QueueCreate.
+ */
+typedef struct {
+    sh1106_t * dev; ///< @brief Display, solo lo usa la tarea de envio.
+    /**
+     * @brief Cuadros, frame_count buffers contiguos del tamano del buffer del display. Cada
+     * productora tiene a lo sumo uno mientras dibuja, la cola uno y la tarea de envio uno, por lo
+     * que con frame_count igual a las productoras mas 2 nunca falta un cuadro libre.
+     */
+    uint8_t * frames;
+    uint8_t frame_count;         ///< @brief Cantidad de cuadros, de 2 a SH1106_QUEUE_MAX_FRAMES.
+    sh1106_queue_slot_t * slots; ///< @brief Anillo de comandos o NULL (sin comandos).
+    uint16_t slot_count;         ///< @brief Lugares del anillo, potencia de 2.
+    sh1106_notify_t notify;      ///< @brief Aviso a la tarea de envio o NULL.
+    void * context;              ///< @brief Contexto de notify.
+} sh1106_queue_config_t;
+
+/**
+ * @brief Cola de envios de un display.
+ */
+typedef struct {
+    sh1106_t * dev;              ///< @brief Display, solo lo usa la tarea de envio.
+    uint8_t * frames;            ///< @brief Cuadros.
+    size_t frame_size;           ///< @brief Bytes de un cuadro.
+    uint8_t frame_count;         ///< @brief Cantidad de cuadros.
+    atomic_uint free;            ///< @brief Un bit en 1 por cada cuadro libre.
+    atomic_int latest;           ///< @brief Ultimo cuadro entregado y no tomado, o -1.
+    sh1106_queue_slot_t * slots; ///< @brief Anillo de comandos.
+    uint16_t slot_mask;          ///< @brief Lugares del anillo menos uno.
+    atomic_uint tail;            ///< @brief Posicion del proximo comando a encolar.
+    unsigned head;               ///< @brief Posicion del proximo comando a ejecutar.
+    sh1106_notify_t notify;      ///< @brief Aviso a la tarea de envio.
+    void * context;              ///< @brief Contexto de notify.
+    atomic_uint frames_count;    ///< @brief Cuadros entregados.
+    atomic_uint coalesced;       ///< @brief Cuadros descartados.
+    atomic_uint commands;        ///< @brief Comandos encolados.
+    atomic_uint rejected;        ///< @brief Comandos rechazados.
+    atomic_uint flushes;         ///< @brief Actualizaciones.
+} sh1106_queue_t;
+
+/* === Public function declarations ============================================================ */
+/**
+ * @brief Crea una cola de envios. Todos los cuadros quedan libres y el anillo vacio.
+ *
+ * @param queue: Cola a crear.
+ * @param config: Parametros de la cola.
+ * @return sh1106_status_t: SH1106_ERROR si falta el display o los cuadros, la cantidad de cuadros
+ * esta fuera de rango o la de lugares del anillo no es potencia de 2.
+ */
+sh1106_status_t sh1106_QueueCreate(sh1106_queue_t * queue, const sh1106_queue_config_t * config);
+
+/**
+ * @brief Toma un cuadro libre para dibujarlo. Su contenido es el de algun cuadro anterior: la
+ * productora lo dibuja completo.
+ *
+ * @param queue: Cola.
+ * @return uint8_t*: Cuadro, con el formato del buffer del display, o NULL si no hay libres.
+ */
+uint8_t * sh1106_QueueAcquire(sh1106_queue_t * queue);
+
+/**
+ * @brief Entrega un cuadro tomado con sh1106_QueueAcquire, que reemplaza al entregado antes si la
+ * tarea de envio todavia no lo tomo. La productora no debe volver a usar el cuadro.
+ *
+ * @param queue: Cola.
+ * @param frame: Cuadro.
+ */
+void sh1106_QueueSubmit(sh1106_queue_t * queue, uint8_t * frame);
+
+/**
+ * @brief Devuelve sin entregar un cuadro tomado con sh1106_QueueAcquire.
+ *
+ * @param queue: Cola.
+ * @param frame: Cuadro.
+ */
+void sh1106_QueueRelease(sh1106_queue_t * queue, uint8_t * frame);
+
+/**
+ * @brief Encola un comando de dibujo, copiando sus argumentos.
+ *
+ * @param queue: Cola.
+ * @param command: Funcion de dibujo.
+ * @param args: Argumentos, se copian.
+ * @param size: Bytes de los argumentos, hasta SH1106_QUEUE_ARGS_SIZE.
+ * @return sh1106_status_t: SH1106_BUSY si el anillo esta lleno (el comando no se encola),
+ * SH1106_ERROR si la cola no tiene anillo o los argumentos son demasiado grandes.
+ */
+sh1106_status_t sh1106_QueuePost(sh1106_queue_t * queue, sh1106_command_t command,
+                                 const void * args, size_t size);
+
+/**
+ * @brief Tarea de envio: aplica el ultimo cuadro entregado y los comandos pendientes al display y
+ * lo actualiza. Solo la puede llamar una tarea.
+ *
+ * @param queue: Cola.
+ * @return sh1106_status_t: Resultado de la actualizacion, o SH1106_OK si no habia nada nuevo. Si
+ * falla, las regiones quedan modificadas y se envian en la proxima llamada.
+ */
+sh1106_status_t sh1106_QueueFlush(sh1106_queue_t * queue);
+
+/**
+ * @brief Obtiene los contadores de la cola.
+ *
+ * @param queue: Cola.
+ * @param stats: Destino de los contadores.
+ */
+void sh1106_QueueGetStats(sh1106_queue_t * queue, sh1106_queue_stats_t * stats);
+
+#endif /* INC_SH1106_QUEUE_H_ */
@@ -0,0 +1,194 @@
+/**
+ * @file sh1106_spi.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Source File - Transporte SPI de 4 hilos para el driver SH1106
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106_spi.h"
+
+/* === Private macros definitions ============================================================== */
+/**
+ * @brief Escrituras que se arman antes de enviarlas. Las transacciones del driver tienen a lo sumo
+ * dos: los comandos y los datos.
+ */
+#define SH1106_SPI_RUNS (4)
+
+/* === Private data type declarations ========================================================== */
+/**
+ * @brief Escrituras en que se divide una transaccion: tramos de comandos o datos.
+ */
+typedef struct {
+    sh1106_iovec_t runs[SH1106_SPI_RUNS];    ///< @brief Bytes de cada escritura.
+    bool data_mode[SH1106_SPI_RUNS];         ///< @brief Nivel del pin D/C de cada escritura.
+    uint8_t count;                           ///< @brief Cantidad de escrituras.
+    uint8_t commands[SH1106_BATCH_SIZE / 2]; ///< @brief Comandos sueltos (Co=1), sin control.
+    uint16_t command_size;                   ///< @brief Bytes cargados en commands.
+} sh1106_spi_split_t;
+
+/* === Private function prototypes ============================================================= */
+static sh1106_status_t sh1106_SpiSend(sh1106_t * dev, const sh1106_iovec_t * iov, uint8_t count);
+#if SH1106_ASYNC
+static sh1106_status_t sh1106_SpiSendAsync(sh1106_t * dev, const sh1106_iovec_t * iov,
+                                           uint8_t count);
+#endif
+
+/* === Public variable declarations ============================================================ */
+const sh1106_transport_t sh1106_spi_transport = {
+    .send = sh1106_SpiSend,
+#if SH1106_ASYNC
+    .send_async = sh1106_SpiSendAsync,
+#endif
+    .max_transfer = 0,
+};
+
+/* === Private function declarations =========================================================== */
+/**
+ * @brief Escribe un tramo de comandos o datos y espera a que termine.
+ */
+static sh1106_status_t sh1106_SpiWrite(sh1106_t * dev, bool data_mode, const uint8_t * data,
+                                       size_t size) {
+    HAL_SPI_set_dc(dev->address, data_mode);
+    return sh1106_FromHal(HAL_SPI_write(dev->address, data, size));
+}
+
+/**
+ * @brief Agrega bytes a las escrituras, extendiendo la ultima si son contiguos y del mismo tipo.
+ */
+static void sh1106_SpiAppend(sh1106_spi_split_t * split, bool data_mode, const uint8_t * data,
+                             size_t size) {
+    if (split->count > 0) {
+        sh1106_iovec_t * last = &split->runs[split->count - 1];
+        if (split->data_mode[split->count - 1] == data_mode && last->data + last->size == data) {
+            last->size += size;
+            return;
+        }
+    }
+    split->runs[split->count].data = data;
+    split->runs[split->count].size = size;
+    split->data_mode[split->count] = data_mode;
+    split->count++;
+}
+
+/**
+ * @brief Envia todas las escrituras salvo la ultima, que queda como primera.
+ */
+static sh1106_status_t sh1106_SpiWriteRuns(sh1106_t * dev, sh1106_spi_split_t * split) {
+    for (uint8_t run = 0; run + 1 < split->count; run++) {
+        sh1106_status_t status = sh1106_SpiWrite(dev, split->data_mode[run], split->runs[run].data,
+                                                 split->runs[run].size);
+        if (status != SH1106_OK) {
+            return status;
+        }
+    }
+    if (split->count > 1) {
+        split->runs[0] = split->runs[split->count - 1];
+        split->data_mode[0] = split->data_mode[split->count - 1];
+        split->count = 1;
+    }
+    return SH1106_OK;
+}
+
+/**
+ * @brief Divide una transaccion en escrituras sin bytes de control.
+ *
+ * Los streams (Co=0) se escriben desde donde estan, los comandos sueltos (Co=1) se juntan en
+ * split->commands. Todas las escrituras salvo la ultima se envian; la ultima queda en split.
+ */
+static sh1106_status_t sh1106_SpiSplit(sh1106_t * dev, const sh1106_iovec_t * iov, uint8_t count,
+                                       sh1106_spi_split_t * split) {
+    enum { EXPECT_CONTROL, EXPECT_SINGLE, IN_STREAM } state = EXPECT_CONTROL;
+    bool data_mode = false;
+
+    split->count = 0;
+    split->command_size = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        size_t position = 0;
+        while (position < iov[i].size) {
+            if (split->count == SH1106_SPI_RUNS) {
+                sh1106_status_t status = sh1106_SpiWriteRuns(dev, split);
+                if (status != SH1106_OK) {
+                    return status;
+                }
+            }
+            const uint8_t * byte = &iov[i].data[position];
+            if (state == IN_STREAM) {
+                sh1106_SpiAppend(split, data_mode, byte, iov[i].size - position);
+                break;
+            } else if (state == EXPECT_SINGLE) {
+                if (!data_mode && split->command_size < sizeof(split->commands)) {
+                    split->commands[split->command_size] = *byte;
+                    byte = &split->commands[split->command_size++];
+                }
+                sh1106_SpiAppend(split, data_mode, byte, 1);
+                state = EXPECT_CONTROL;
+            } else {
+                data_mode = (*byte & CONTROL_DATA_STREAM) != 0;
+                state = (*byte & CONTROL_CMD_SINGLE) ? EXPECT_SINGLE : IN_STREAM;
+            }
+            position++;
+        }
+    }
+    return sh1106_SpiWriteRuns(dev, split);
+}
+
+/**
+ * @brief Envio SPI: toda la transaccion dentro de una activacion de CS.
+ */
+static sh1106_status_t sh1106_SpiSend(sh1106_t * dev, const sh1106_iovec_t * iov, uint8_t count) {
+    sh1106_spi_split_t split;
+
+    HAL_SPI_select(dev->address, true);
+    sh1106_status_t status = sh1106_SpiSplit(dev, iov, count, &split);
+    if (status == SH1106_OK && split.count > 0) {
+        status = sh1106_SpiWrite(dev, split.data_mode[0], split.runs[0].data, split.runs[0].size);
+    }
+    HAL_SPI_select(dev->address, false);
+    return status;
+}
+
+#if SH1106_ASYNC
+/**
+ * @brief Fin de transmision SPI, la HAL la llama desde su interrupcion. Libera CS.
+ */
+static void sh1106_SpiDone(void * context, status_t status) {
+    sh1106_t * dev = (sh1106_t *)context;
+
+    HAL_SPI_select(dev->address, false);
+    sh1106_TransferDone(dev, sh1106_FromHal(status));
+}
+
+/**
+ * @brief Envio SPI sin bloqueo. Los comandos de direccion son pocos bytes y se envian esperando;
+ * los datos de la pagina, que siempre van al final, se envian sin esperar directamente desde el
+ * buffer de transmision. Una transaccion sin datos se envia completa esperando.
+ */
+static sh1106_status_t sh1106_SpiSendAsync(sh1106_t * dev, const sh1106_iovec_t * iov,
+                                           uint8_t count) {
+    sh1106_spi_split_t split;
+
+    HAL_SPI_select(dev->address, true);
+    sh1106_status_t status = sh1106_SpiSplit(dev, iov, count, &split);
+    if (status == SH1106_OK && split.count > 0 && split.data_mode[0]) {
+        HAL_SPI_set_dc(dev->address, true);
+        status = sh1106_FromHal(HAL_SPI_write_async(dev->address, split.runs[0].data,
+                                                       split.runs[0].size, sh1106_SpiDone, dev));
+        if (status != SH1106_OK) {
+            HAL_SPI_select(dev->address, false);
+        }
+        return status;
+    }
+    if (status == SH1106_OK && split.count > 0) {
+        status = sh1106_SpiWrite(dev, false, split.runs[0].data, split.runs[0].size);
+    }
+    HAL_SPI_select(dev->address, false);
+    if (status == SH1106_OK) {
+        sh1106_TransferDone(dev, SH1106_OK);
+    }
+    return status;
+}
+#endif
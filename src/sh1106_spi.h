@@ -0,0 +1,34 @@
+/**
+ * @file sh1106_spi.h
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Header File - Transporte SPI de 4 hilos para el driver SH1106
+ *
+ * En SPI de 4 hilos el controlador no usa bytes de control: si un byte es comando o dato lo indica
+ * el pin D/C. El transporte recibe las mismas transacciones que el transporte I2C, les quita los
+ * bytes de control y envia cada tramo de comandos o datos con D/C en el nivel correspondiente,
+ * todo dentro de una sola activacion de CS. Los datos de una pagina se envian en una unica
+ * escritura, directamente desde el buffer de la transaccion.
+ *
+ * Para usarlo se crea el display con .transport = &sh1106_spi_transport; el campo address del
+ * display es el numero de dispositivo que recibe la HAL de SPI (hal_spi.h).
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#ifndef INC_SH1106_SPI_H_
+#define INC_SH1106_SPI_H_
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106.h"
+#include "hal_spi.h"
+
+/* === Public variable declarations ============================================================ */
+/**
+ * @brief Transporte SPI de 4 hilos sobre HAL_SPI_write y HAL_SPI_write_async.
+ */
+extern const sh1106_transport_t sh1106_spi_transport;
+
+#endif /* INC_SH1106_SPI_H_ */
@@ -0,0 +1,271 @@
+/**
+ * @file sh1106_strip.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Source File - Modo tira (lista de dibujo) para el driver SH1106
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106_strip.h"
+#include "sh1106_gfx.h"
+
+#if SH1106_STRIP
+/* === Private data type declarations ========================================================== */
+/**
+ * @brief Funciones de dibujo que se guardan en la lista. Cada entrada es el codigo (un byte)
+ * seguido de los parametros de la funcion.
+ */
+typedef enum {
+    SH1106_STRIP_PIXEL = 0,
+    SH1106_STRIP_LINE,
+    SH1106_STRIP_CIRCLE,
+    SH1106_STRIP_FILL_CIRCLE,
+    SH1106_STRIP_ARC,
+    SH1106_STRIP_RECT,
+    SH1106_STRIP_FILL_RECT,
+    SH1106_STRIP_CHAR,
+    SH1106_STRIP_STRING, ///< @brief Seguido del texto, con su '\0'.
+    SH1106_STRIP_BITMAP,
+    SH1106_STRIP_IMAGE,
+} sh1106_strip_op_t;
+
+/**
+ * @brief Parametros de cada funcion de dibujo. Se copian a la lista byte a byte, por lo que no
+ * necesitan alineacion.
+ */
+typedef struct {
+    uint8_t x, y, color;
+} sh1106_strip_pixel_t;
+
+typedef struct {
+    int16_t x0, y0, x1, y1;
+    uint8_t color;
+} sh1106_strip_line_t;
+
+typedef struct {
+    int16_t cx, cy, radius, start_angle, end_angle;
+    uint8_t color;
+} sh1106_strip_arc_t;
+
+typedef struct {
+    int16_t x, y, width, height;
+    uint8_t color;
+} sh1106_strip_rect_t;
+
+typedef struct {
+    const sh1106_font_t * font;
+    int16_t x, y;
+    uint8_t color;
+    char c;
+} sh1106_strip_text_t;
+
+typedef struct {
+    const sh1106_bitmap_t * bitmap;
+    int16_t src_x, src_y, width, height, x, y;
+    uint8_t rop;
+} sh1106_strip_bitmap_t;
+
+typedef struct {
+    const sh1106_image_t * image;
+    int16_t x, y;
+    uint8_t rop;
+} sh1106_strip_image_t;
+
+/* === Private function declarations =========================================================== */
+/**
+ * @brief Agrega una entrada a la lista: el codigo, los parametros y, si text no es NULL, el texto
+ * con su '\0'.
+ */
+static sh1106_status_t sh1106_StripAppend(sh1106_t * dev, sh1106_strip_op_t op, const void * args,
+                                          size_t size, const char * text) {
+    size_t text_size = (text != NULL) ? strlen(text) + 1 : 0;
+
+    if (1 + size + text_size > (size_t)(dev->list_size - dev->list_used)) {
+        return SH1106_ERROR;
+    }
+    dev->list[dev->list_used++] = op;
+    memcpy(&dev->list[dev->list_used], args, size);
+    dev->list_used += size;
+    if (text != NULL) {
+        memcpy(&dev->list[dev->list_used], text, text_size);
+        dev->list_used += text_size;
+    }
+    return SH1106_OK;
+}
+
+/**
+ * @brief Dibuja una entrada de la lista en la pagina que empieza en la fila top, restando top a
+ * las coordenadas en "y".
+ *
+ * @return uint16_t: Bytes de parametros (y texto) de la entrada.
+ */
+static uint16_t sh1106_StripReplay(sh1106_t * dev, uint8_t op, const uint8_t * args, int16_t top) {
+    switch (op) {
+    case SH1106_STRIP_PIXEL: {
+        sh1106_strip_pixel_t pixel;
+        memcpy(&pixel, args, sizeof(pixel));
+        if (pixel.y >= top && pixel.y < top + 8) {
+            sh1106_DevDrawPixel(dev, pixel.x, pixel.y - top, pixel.color);
+        }
+        return sizeof(pixel);
+    }
+    case SH1106_STRIP_LINE: {
+        sh1106_strip_line_t line;
+        memcpy(&line, args, sizeof(line));
+        sh1106_DrawLine(dev, line.x0, line.y0 - top, line.x1, line.y1 - top, line.color);
+        return sizeof(line);
+    }
+    case SH1106_STRIP_CIRCLE:
+    case SH1106_STRIP_FILL_CIRCLE:
+    case SH1106_STRIP_ARC: {
+        sh1106_strip_arc_t arc;
+        memcpy(&arc, args, sizeof(arc));
+        if (op == SH1106_STRIP_ARC) {
+            sh1106_DrawArc(dev, arc.cx, arc.cy - top, arc.radius, arc.start_angle, arc.end_angle,
+                           arc.color);
+        } else if (op == SH1106_STRIP_CIRCLE) {
+            sh1106_DrawCircle(dev, arc.cx, arc.cy - top, arc.radius, arc.color);
+        } else {
+            sh1106_FillCircle(dev, arc.cx, arc.cy - top, arc.radius, arc.color);
+        }
+        return sizeof(arc);
+    }
+    case SH1106_STRIP_RECT:
+    case SH1106_STRIP_FILL_RECT: {
+        sh1106_strip_rect_t rect;
+        memcpy(&rect, args, sizeof(rect));
+        if (op == SH1106_STRIP_RECT) {
+            sh1106_DrawRect(dev, rect.x, rect.y - top, rect.width, rect.height, rect.color);
+        } else {
+            sh1106_FillRect(dev, rect.x, rect.y - top, rect.width, rect.height, rect.color);
+        }
+        return sizeof(rect);
+    }
+    case SH1106_STRIP_CHAR:
+    case SH1106_STRIP_STRING: {
+        sh1106_strip_text_t text;
+        memcpy(&text, args, sizeof(text));
+        if (op == SH1106_STRIP_CHAR) {
+            sh1106_DrawChar(dev, text.font, text.x, text.y - top, text.c, text.color);
+            return sizeof(text);
+        }
+        const char * str = (const char *)&args[sizeof(text)];
+        sh1106_DrawString(dev, text.font, text.x, text.y - top, str, text.color);
+        return sizeof(text) + strlen(str) + 1;
+    }
+    case SH1106_STRIP_BITMAP: {
+        sh1106_strip_bitmap_t blit;
+        memcpy(&blit, args, sizeof(blit));
+        sh1106_DrawBitmapRegion(dev, blit.bitmap, blit.src_x, blit.src_y, blit.width, blit.height,
+                                blit.x, blit.y - top, blit.rop);
+        return sizeof(blit);
+    }
+    default: {
+        sh1106_strip_image_t image;
+        memcpy(&image, args, sizeof(image));
+        sh1106_DrawImage(dev, image.image, image.x, image.y - top, image.rop);
+        return sizeof(image);
+    }
+    }
+}
+
+/* === Public function declarations ============================================================ */
+void sh1106_StripClear(sh1106_t * dev, sh1106_color_t color) {
+    dev->list_used = 0;
+    dev->background = color;
+}
+
+void sh1106_StripRender(sh1106_t * dev, uint8_t page) {
+    uint8_t height = dev->height, pages = dev->pages;
+    uint16_t offset = 0;
+
+    // Durante la reproduccion el display mide una pagina de alto: las funciones de dibujo recortan
+    // todo lo que cae fuera de la pagina, ya desplazada a la fila 0.
+    memset(dev->buffer, (dev->background == BLACK) ? 0x00 : 0xFF, sh1106_DevWidth(dev));
+    dev->height = 8;
+    dev->pages = 1;
+    dev->replaying = true;
+    while (offset < dev->list_used) {
+        uint8_t op = dev->list[offset++];
+        offset += sh1106_StripReplay(dev, op, &dev->list[offset], 8 * page);
+    }
+    dev->height = height;
+    dev->pages = pages;
+    dev->replaying = false;
+}
+
+uint16_t sh1106_StripUsed(const sh1106_t * dev) {
+    return dev->list_used;
+}
+
+sh1106_status_t sh1106_StripPixel(sh1106_t * dev, uint8_t x, uint8_t y, sh1106_color_t color) {
+    sh1106_strip_pixel_t pixel = {.x = x, .y = y, .color = color};
+    return sh1106_StripAppend(dev, SH1106_STRIP_PIXEL, &pixel, sizeof(pixel), NULL);
+}
+
+sh1106_status_t sh1106_StripLine(sh1106_t * dev, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                 sh1106_color_t color) {
+    sh1106_strip_line_t line = {.x0 = x0, .y0 = y0, .x1 = x1, .y1 = y1, .color = color};
+    return sh1106_StripAppend(dev, SH1106_STRIP_LINE, &line, sizeof(line), NULL);
+}
+
+sh1106_status_t sh1106_StripCircle(sh1106_t * dev, int16_t cx, int16_t cy, int16_t radius,
+                                   sh1106_color_t color, bool fill) {
+    sh1106_strip_arc_t arc = {.cx = cx, .cy = cy, .radius = radius, .color = color};
+    return sh1106_StripAppend(dev, fill ? SH1106_STRIP_FILL_CIRCLE : SH1106_STRIP_CIRCLE, &arc,
+                              sizeof(arc), NULL);
+}
+
+sh1106_status_t sh1106_StripArc(sh1106_t * dev, int16_t cx, int16_t cy, int16_t radius,
+                                int16_t start_angle, int16_t end_angle, sh1106_color_t color) {
+    sh1106_strip_arc_t arc = {.cx = cx,
+                              .cy = cy,
+                              .radius = radius,
+                              .start_angle = start_angle,
+                              .end_angle = end_angle,
+                              .color = color};
+    return sh1106_StripAppend(dev, SH1106_STRIP_ARC, &arc, sizeof(arc), NULL);
+}
+
+sh1106_status_t sh1106_StripRect(sh1106_t * dev, int16_t x, int16_t y, int16_t width,
+                                 int16_t height, sh1106_color_t color, bool fill) {
+    sh1106_strip_rect_t rect = {.x = x, .y = y, .width = width, .height = height, .color = color};
+    return sh1106_StripAppend(dev, fill ? SH1106_STRIP_FILL_RECT : SH1106_STRIP_RECT, &rect,
+                              sizeof(rect), NULL);
+}
+
+sh1106_status_t sh1106_StripChar(sh1106_t * dev, const sh1106_font_t * font, int16_t x,
+                                 int16_t y, char c, sh1106_color_t color) {
+    sh1106_strip_text_t text = {.font = font, .x = x, .y = y, .color = color, .c = c};
+    return sh1106_StripAppend(dev, SH1106_STRIP_CHAR, &text, sizeof(text), NULL);
+}
+
+sh1106_status_t sh1106_StripString(sh1106_t * dev, const sh1106_font_t * font, int16_t x,
+                                   int16_t y, const char * str, sh1106_color_t color) {
+    sh1106_strip_text_t text = {.font = font, .x = x, .y = y, .color = color};
+    return sh1106_StripAppend(dev, SH1106_STRIP_STRING, &text, sizeof(text), str);
+}
+
+sh1106_status_t sh1106_StripBitmap(sh1106_t * dev, const sh1106_bitmap_t * bitmap, int16_t src_x,
+                                   int16_t src_y, int16_t width, int16_t height, int16_t x,
+                                   int16_t y, sh1106_rop_t rop) {
+    sh1106_strip_bitmap_t blit = {.bitmap = bitmap,
+                                  .src_x = src_x,
+                                  .src_y = src_y,
+                                  .width = width,
+                                  .height = height,
+                                  .x = x,
+                                  .y = y,
+                                  .rop = rop};
+    return sh1106_StripAppend(dev, SH1106_STRIP_BITMAP, &blit, sizeof(blit), NULL);
+}
+
+sh1106_status_t sh1106_StripImage(sh1106_t * dev, const sh1106_image_t * image, int16_t x,
+                                  int16_t y, sh1106_rop_t rop) {
+    sh1106_strip_image_t entry = {.image = image, .x = x, .y = y, .rop = rop};
+    return sh1106_StripAppend(dev, SH1106_STRIP_IMAGE, &entry, sizeof(entry), NULL);
+}
+#endif
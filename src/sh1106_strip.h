@@ -0,0 +1,88 @@
+/**
+ * @file sh1106_strip.h
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Header File - Modo tira (lista de dibujo) para el driver SH1106
+ *
+ * Para micros con poca RAM. Con SH1106_STRIP, un display creado con lista de dibujo
+ * (sh1106_config_t.list) no tiene buffer de pantalla completa sino uno de una sola pagina: 128
+ * bytes en lugar de 1024 para un panel de 128x64. Las funciones de dibujo (sh1106_DrawPixel y las
+ * de sh1106_gfx.h, sh1106_font.h, sh1106_bitmap.h y sh1106_image.h) no dibujan: guardan la llamada
+ * en la lista. sh1106_UpdateScreen dibuja cada pagina en el buffer, reproduciendo la lista en
+ * orden y recortada a esa pagina, la envia y pasa a la siguiente. El resultado es identico, byte a
+ * byte, al de dibujar en un buffer completo y enviar la pantalla completa.
+ *
+ * sh1106_Fill vacia la lista, por lo que cada cuadro comienza con sh1106_Fill y se redibuja
+ * completo. Las fuentes, los mapas de bits y las imagenes se guardan por referencia y deben seguir
+ * existiendo hasta la actualizacion; el texto se copia a la lista. Si la lista se llena, las
+ * funciones de dibujo devuelven SH1106_ERROR y la llamada se pierde.
+ *
+ * El modo tira no admite SH1106_PANEL (cada pagina se dibuja con el alto del display reducido a
+ * una pagina), ni actualizacion asincronica, sombra, desplazamiento o giros de un cuarto de
+ * vuelta, que necesitan la pantalla completa en memoria.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#ifndef INC_SH1106_STRIP_H_
+#define INC_SH1106_STRIP_H_
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106.h"
+#include "sh1106_bitmap.h"
+#include "sh1106_font.h"
+#include "sh1106_image.h"
+
+/* === Public function declarations ============================================================ */
+#if SH1106_STRIP
+/**
+ * @brief Vacia la lista de dibujo. El color queda como fondo de todas las paginas.
+ *
+ * La llama sh1106_DevFill, no la aplicacion.
+ */
+void sh1106_StripClear(sh1106_t * dev, sh1106_color_t color);
+
+/**
+ * @brief Dibuja una pagina en el buffer del display a partir de la lista de dibujo.
+ *
+ * La llama sh1106_DevUpdateScreen, no la aplicacion.
+ *
+ * @param dev: Display en modo tira.
+ * @param page: Pagina a dibujar.
+ */
+void sh1106_StripRender(sh1106_t * dev, uint8_t page);
+
+/**
+ * @brief Bytes ocupados de la lista de dibujo, para dimensionarla.
+ */
+uint16_t sh1106_StripUsed(const sh1106_t * dev);
+
+/**
+ * @brief Funciones que guardan cada funcion de dibujo en la lista, con sus mismos parametros. Las
+ * llaman las funciones de dibujo cuando sh1106_DevRecording es verdadero.
+ *
+ * @return sh1106_status_t: SH1106_ERROR si la llamada no entra en la lista.
+ */
+sh1106_status_t sh1106_StripPixel(sh1106_t * dev, uint8_t x, uint8_t y, sh1106_color_t color);
+sh1106_status_t sh1106_StripLine(sh1106_t * dev, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                 sh1106_color_t color);
+sh1106_status_t sh1106_StripCircle(sh1106_t * dev, int16_t cx, int16_t cy, int16_t radius,
+                                   sh1106_color_t color, bool fill);
+sh1106_status_t sh1106_StripArc(sh1106_t * dev, int16_t cx, int16_t cy, int16_t radius,
+                                int16_t start_angle, int16_t end_angle, sh1106_color_t color);
+sh1106_status_t sh1106_StripRect(sh1106_t * dev, int16_t x, int16_t y, int16_t width,
+                                 int16_t height, sh1106_color_t color, bool fill);
+sh1106_status_t sh1106_StripChar(sh1106_t * dev, const sh1106_font_t * font, int16_t x,
+                                 int16_t y, char c, sh1106_color_t color);
+sh1106_status_t sh1106_StripString(sh1106_t * dev, const sh1106_font_t * font, int16_t x,
+                                   int16_t y, const char * str, sh1106_color_t color);
+sh1106_status_t sh1106_StripBitmap(sh1106_t * dev, const sh1106_bitmap_t * bitmap, int16_t src_x,
+                                   int16_t src_y, int16_t width, int16_t height, int16_t x,
+                                   int16_t y, sh1106_rop_t rop);
+sh1106_status_t sh1106_StripImage(sh1106_t * dev, const sh1106_image_t * image, int16_t x,
+                                  int16_t y, sh1106_rop_t rop);
+#endif
+
+#endif /* INC_SH1106_STRIP_H_ */
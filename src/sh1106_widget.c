@@ -0,0 +1,314 @@
+/**
+ * @file sh1106_widget.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Source File - Widgets retenidos para el driver SH1106
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106_widget.h"
+#include "sh1106_gfx.h"
+
+/* === Private function declarations =========================================================== */
+/**
+ * @brief Agrega un widget a la pantalla, si hay lugar y el rectangulo entra en el display.
+ */
+static sh1106_widget_t * sh1106_WidgetAdd(sh1106_screen_t * screen, sh1106_widget_type_t type,
+                                          uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+    if (screen->count >= SH1106_WIDGET_CAPACITY || width == 0 || height == 0 ||
+        x + width > sh1106_DevWidth(screen->dev) || y + height > sh1106_DevHeight(screen->dev)) {
+        return NULL;
+    }
+
+    sh1106_widget_t * widget = &screen->widgets[screen->count++];
+    memset(widget, 0, sizeof(*widget));
+    widget->type = type;
+    widget->x = x;
+    widget->y = y;
+    widget->width = width;
+    widget->height = height;
+    widget->visible = true;
+    widget->dirty = true;
+    return widget;
+}
+
+/**
+ * @brief Copia un texto al widget, truncado al tamaño del widget. Devuelve si cambio.
+ */
+static bool sh1106_CopyText(sh1106_widget_t * widget, const char * text) {
+    char * dst = widget->state.text.text;
+    size_t i = 0;
+    bool changed = false;
+
+    for (; i < SH1106_WIDGET_TEXT_SIZE - 1 && text[i] != '\0'; i++) {
+        changed |= (dst[i] != text[i]);
+        dst[i] = text[i];
+    }
+    changed |= (dst[i] != '\0');
+    dst[i] = '\0';
+    return changed;
+}
+
+/**
+ * @brief Escribe un numero en decimal.
+ */
+static void sh1106_FormatNumber(int32_t value, char * text) {
+    char digits[11];
+    uint32_t magnitude = (value < 0) ? 0u - (uint32_t)value : (uint32_t)value;
+    uint8_t count = 0;
+
+    do {
+        digits[count++] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) {
+        *text++ = '-';
+    }
+    while (count > 0) {
+        *text++ = digits[--count];
+    }
+    *text = '\0';
+}
+
+/**
+ * @brief Limita un valor a [min, max] y lo escala a [0, range].
+ */
+static uint8_t sh1106_Scale(int32_t value, int32_t min, int32_t max, uint8_t range) {
+    if (value <= min) {
+        return 0;
+    }
+    if (value >= max) {
+        return range;
+    }
+    return (uint8_t)(((int64_t)value - min) * range / ((int64_t)max - min));
+}
+
+/**
+ * @brief Dibuja el texto de un widget, sin los caracteres que no entran en su ancho. Los numeros se
+ * alinean a la derecha.
+ */
+static void sh1106_RenderText(sh1106_t * dev, const sh1106_widget_t * widget,
+                              sh1106_color_t color) {
+    char text[SH1106_WIDGET_TEXT_SIZE];
+    const sh1106_font_t * font = widget->state.text.font;
+    size_t length = strlen(widget->state.text.text);
+    int16_t width;
+
+    memcpy(text, widget->state.text.text, length + 1);
+    while ((width = sh1106_MeasureString(font, text)) > widget->width) {
+        text[--length] = '\0';
+    }
+
+    int16_t x = widget->x;
+    if (widget->type == SH1106_WIDGET_NUMBER) {
+        x += widget->width - width;
+    }
+    sh1106_DrawString(dev, font, x, widget->y, text, color);
+}
+
+/**
+ * @brief Dibuja las muestras de un grafico de tendencia, alineadas a la derecha y unidas por
+ * lineas.
+ */
+static void sh1106_RenderSparkline(sh1106_t * dev, const sh1106_widget_t * widget,
+                                   sh1106_color_t color) {
+    uint8_t count = widget->state.sparkline.count;
+    uint8_t index = (widget->state.sparkline.next + widget->width - count) % widget->width;
+    int16_t x = widget->x + widget->width - count;
+    int16_t previous = widget->y + widget->state.sparkline.rows[index];
+
+    for (uint8_t i = 0; i < count; i++) {
+        int16_t row = widget->y + widget->state.sparkline.rows[index];
+        sh1106_DrawLine(dev, (i == 0) ? x : x - 1, previous, x, row, color);
+        previous = row;
+        x++;
+        index = (index + 1 == widget->width) ? 0 : index + 1;
+    }
+}
+
+/**
+ * @brief Borra el rectangulo de un widget y dibuja su contenido.
+ */
+static void sh1106_RenderWidget(const sh1106_screen_t * screen, const sh1106_widget_t * widget) {
+    sh1106_t * dev = screen->dev;
+    sh1106_color_t color = (screen->background == BLACK) ? WHITE : BLACK;
+
+    sh1106_FillRect(dev, widget->x, widget->y, widget->width, widget->height, screen->background);
+    if (!widget->visible) {
+        return;
+    }
+
+    switch (widget->type) {
+    case SH1106_WIDGET_LABEL:
+    case SH1106_WIDGET_NUMBER:
+        sh1106_RenderText(dev, widget, color);
+        break;
+    case SH1106_WIDGET_BAR:
+        sh1106_DrawRect(dev, widget->x, widget->y, widget->width, widget->height, color);
+        sh1106_FillRect(dev, widget->x + 1, widget->y + 1, widget->state.bar.fill,
+                        widget->height - 2, color);
+        break;
+    case SH1106_WIDGET_ICON:
+        if (widget->state.icon.bitmap != NULL) {
+            sh1106_DrawBitmapRegion(dev, widget->state.icon.bitmap, 0, 0, widget->width,
+                                    widget->height, widget->x, widget->y,
+                                    (color == WHITE) ? SH1106_ROP_OR : SH1106_ROP_AND_NOT);
+        }
+        break;
+    default:
+        sh1106_RenderSparkline(dev, widget, color);
+        break;
+    }
+}
+
+/* === Public function declarations ============================================================ */
+void sh1106_ScreenCreate(sh1106_screen_t * screen, sh1106_t * dev, sh1106_color_t background) {
+    screen->dev = dev;
+    screen->background = background;
+    screen->count = 0;
+}
+
+uint8_t sh1106_ScreenRender(sh1106_screen_t * screen) {
+    uint8_t rendered = 0;
+
+    for (uint8_t i = 0; i < screen->count; i++) {
+        sh1106_widget_t * widget = &screen->widgets[i];
+        if (widget->dirty) {
+            sh1106_RenderWidget(screen, widget);
+            widget->dirty = false;
+            rendered++;
+        }
+    }
+    return rendered;
+}
+
+void sh1106_ScreenInvalidate(sh1106_screen_t * screen) {
+    for (uint8_t i = 0; i < screen->count; i++) {
+        screen->widgets[i].dirty = true;
+    }
+}
+
+sh1106_widget_t * sh1106_LabelCreate(sh1106_screen_t * screen, uint8_t x, uint8_t y,
+                                     uint8_t width, uint8_t height, const sh1106_font_t * font,
+                                     const char * text) {
+    if (font->height > height) {
+        return NULL;
+    }
+    sh1106_widget_t * widget = sh1106_WidgetAdd(screen, SH1106_WIDGET_LABEL, x, y, width, height);
+    if (widget != NULL) {
+        widget->state.text.font = font;
+        sh1106_CopyText(widget, text);
+    }
+    return widget;
+}
+
+void sh1106_LabelSet(sh1106_widget_t * widget, const char * text) {
+    if (sh1106_CopyText(widget, text)) {
+        widget->dirty = true;
+    }
+}
+
+sh1106_widget_t * sh1106_NumberCreate(sh1106_screen_t * screen, uint8_t x, uint8_t y,
+                                      uint8_t width, uint8_t height, const sh1106_font_t * font,
+                                      int32_t value) {
+    if (font->height > height) {
+        return NULL;
+    }
+    sh1106_widget_t * widget = sh1106_WidgetAdd(screen, SH1106_WIDGET_NUMBER, x, y, width, height);
+    if (widget != NULL) {
+        widget->state.text.font = font;
+        widget->state.text.value = value;
+        sh1106_FormatNumber(value, widget->state.text.text);
+    }
+    return widget;
+}
+
+void sh1106_NumberSet(sh1106_widget_t * widget, int32_t value) {
+    if (widget->state.text.value != value) {
+        widget->state.text.value = value;
+        sh1106_FormatNumber(value, widget->state.text.text);
+        widget->dirty = true;
+    }
+}
+
+sh1106_widget_t * sh1106_BarCreate(sh1106_screen_t * screen, uint8_t x, uint8_t y, uint8_t width,
+                                   uint8_t height, int32_t min, int32_t max, int32_t value) {
+    if (width < 3 || height < 3 || max <= min) {
+        return NULL;
+    }
+    sh1106_widget_t * widget = sh1106_WidgetAdd(screen, SH1106_WIDGET_BAR, x, y, width, height);
+    if (widget != NULL) {
+        widget->state.bar.min = min;
+        widget->state.bar.max = max;
+        sh1106_BarSet(widget, value);
+    }
+    return widget;
+}
+
+void sh1106_BarSet(sh1106_widget_t * widget, int32_t value) {
+    uint8_t fill = sh1106_Scale(value, widget->state.bar.min, widget->state.bar.max,
+                                widget->width - 2);
+    widget->state.bar.value = value;
+    if (widget->state.bar.fill != fill) {
+        widget->state.bar.fill = fill;
+        widget->dirty = true;
+    }
+}
+
+sh1106_widget_t * sh1106_IconCreate(sh1106_screen_t * screen, uint8_t x, uint8_t y,
+                                    const sh1106_bitmap_t * bitmap) {
+    sh1106_widget_t * widget =
+        sh1106_WidgetAdd(screen, SH1106_WIDGET_ICON, x, y, bitmap->width, bitmap->height);
+    if (widget != NULL) {
+        widget->state.icon.bitmap = bitmap;
+    }
+    return widget;
+}
+
+void sh1106_IconSet(sh1106_widget_t * widget, const sh1106_bitmap_t * bitmap) {
+    if (widget->state.icon.bitmap != bitmap) {
+        widget->state.icon.bitmap = bitmap;
+        widget->dirty = true;
+    }
+}
+
+sh1106_widget_t * sh1106_SparklineCreate(sh1106_screen_t * screen, uint8_t x, uint8_t y,
+                                         uint8_t width, uint8_t height, int32_t min, int32_t max) {
+    if (width > SH1106_WIDGET_SPARKLINE_SIZE || max <= min) {
+        return NULL;
+    }
+    sh1106_widget_t * widget =
+        sh1106_WidgetAdd(screen, SH1106_WIDGET_SPARKLINE, x, y, width, height);
+    if (widget != NULL) {
+        widget->state.sparkline.min = min;
+        widget->state.sparkline.max = max;
+    }
+    return widget;
+}
+
+void sh1106_SparklinePush(sh1106_widget_t * widget, int32_t value) {
+    uint8_t range = widget->height - 1;
+    uint8_t row = range - sh1106_Scale(value, widget->state.sparkline.min,
+                                       widget->state.sparkline.max, range);
+
+    widget->state.sparkline.rows[widget->state.sparkline.next] = row;
+    widget->state.sparkline.next = (widget->state.sparkline.next + 1) % widget->width;
+    if (widget->state.sparkline.count < widget->width) {
+        widget->state.sparkline.count++;
+    }
+    widget->dirty = true;
+}
+
+void sh1106_WidgetSetVisible(sh1106_widget_t * widget, bool visible) {
+    if (widget->visible != visible) {
+        widget->visible = visible;
+        widget->dirty = true;
+    }
+}
+
+void sh1106_WidgetInvalidate(sh1106_widget_t * widget) {
+    widget->dirty = true;
+}
@@ -0,0 +1,285 @@
+/**
+ * @file sh1106_widget.h
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Header File - Widgets retenidos para el driver SH1106
+ *
+ * Una pantalla guarda un conjunto de widgets (etiquetas, numeros, barras, iconos y graficos de
+ * tendencia), cada uno con su rectangulo y su estado. La aplicacion cambia el estado de los
+ * widgets y sh1106_ScreenRender redibuja en el buffer solo los que cambiaron: borra su rectangulo
+ * con el color de fondo y dibuja el contenido. Las primitivas de dibujo marcan esos rectangulos
+ * como modificados, por lo que la siguiente actualizacion de pantalla envia solo esas columnas.
+ *
+ * Cambiar un widget a un estado que se ve igual (el mismo texto, el mismo numero, una barra con el
+ * mismo largo) no lo invalida. Los widgets no deben superponerse, y el contenido se recorta al
+ * rectangulo del widget.
+ *
+ * No se usa memoria dinamica: cada pantalla tiene lugar para SH1106_WIDGET_CAPACITY widgets,
+ * y la aplicacion reserva la pantalla (estatica o en la pila).
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#ifndef INC_SH1106_WIDGET_H_
+#define INC_SH1106_WIDGET_H_
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106.h"
+#include "sh1106_bitmap.h"
+#include "sh1106_font.h"
+
+/* === Definicion de los macros publicos ======================================================= */
+/**
+ * @brief Cantidad maxima de widgets de una pantalla.
+ */
+#ifndef SH1106_WIDGET_CAPACITY
+#define SH1106_WIDGET_CAPACITY (16)
+#endif
+
+/**
+ * @brief Caracteres maximos del texto de una etiqueta, incluyendo el '\0'. Los numeros usan el
+ * mismo texto, por lo que debe entrar "-2147483648".
+ */
+#ifndef SH1106_WIDGET_TEXT_SIZE
+#define SH1106_WIDGET_TEXT_SIZE (22)
+#endif
+#if SH1106_WIDGET_TEXT_SIZE < 12
+#error "SH1106_WIDGET_TEXT_SIZE debe ser al menos 12 para los widgets numericos"
+#endif
+
+/**
+ * @brief Muestras maximas de un grafico de tendencia, una por columna.
+ */
+#ifndef SH1106_WIDGET_SPARKLINE_SIZE
+#define SH1106_WIDGET_SPARKLINE_SIZE (64)
+#endif
+
+/* === Public data type declarations =========================================================== */
+/**
+ * @brief Tipos de widget.
+ */
+typedef enum {
+    SH1106_WIDGET_LABEL = 0, ///< @brief Texto.
+    SH1106_WIDGET_NUMBER,    ///< @brief Numero entero, en decimal.
+    SH1106_WIDGET_BAR,       ///< @brief Barra de progreso horizontal con contorno.
+    SH1106_WIDGET_ICON,      ///< @brief Mapa de bits.
+    SH1106_WIDGET_SPARKLINE, ///< @brief Grafico de las ultimas muestras, la mas nueva a la derecha.
+} sh1106_widget_type_t;
+
+/**
+ * @brief Widget. Los campos son de uso interno, se modifican con las funciones de cada tipo.
+ */
+typedef struct {
+    sh1106_widget_type_t type; ///< @brief Tipo de widget.
+    uint8_t x;                 ///< @brief Coordenada en "x" de la esquina superior izquierda.
+    uint8_t y;                 ///< @brief Coordenada en "y" de la esquina superior izquierda.
+    uint8_t width;             ///< @brief Ancho del rectangulo del widget.
+    uint8_t height;            ///< @brief Alto del rectangulo del widget.
+    bool visible;              ///< @brief Si es falso, el rectangulo se dibuja vacio.
+    bool dirty;                ///< @brief La proxima llamada a sh1106_ScreenRender lo redibuja.
+
+    /**
+     * @brief Estado de cada tipo de widget.
+     */
+    union {
+        struct {
+            const sh1106_font_t * font;         ///< @brief Fuente del texto.
+            int32_t value;                      ///< @brief Valor de un widget numerico.
+            char text[SH1106_WIDGET_TEXT_SIZE]; ///< @brief Texto a dibujar.
+        } text;
+        struct {
+            int32_t min;   ///< @brief Valor con la barra vacia.
+            int32_t max;   ///< @brief Valor con la barra llena.
+            int32_t value; ///< @brief Valor actual.
+            uint8_t fill;  ///< @brief Columnas rellenas dentro del contorno.
+        } bar;
+        struct {
+            const sh1106_bitmap_t * bitmap; ///< @brief Mapa de bits, o NULL para no dibujar nada.
+        } icon;
+        struct {
+            int32_t min;   ///< @brief Valor que se dibuja en la fila de abajo.
+            int32_t max;   ///< @brief Valor que se dibuja en la fila de arriba.
+            uint8_t count; ///< @brief Muestras guardadas.
+            uint8_t next;  ///< @brief Posicion de la proxima muestra en el buffer circular.
+            uint8_t rows[SH1106_WIDGET_SPARKLINE_SIZE]; ///< @brief Fila de cada muestra.
+        } sparkline;
+    } state;
+} sh1106_widget_t;
+
+/**
+ * @brief Pantalla: conjunto de widgets dibujados sobre un display.
+ */
+typedef struct {
+    sh1106_t * dev;                                   ///< @brief Display donde se dibuja.
+    sh1106_color_t background;                        ///< @brief Color de fondo de los widgets.
+    uint8_t count;                                    ///< @brief Widgets creados.
+    sh1106_widget_t widgets[SH1106_WIDGET_CAPACITY]; ///< @brief Widgets de la pantalla.
+} sh1106_screen_t;
+
+/* === Public function declarations ============================================================ */
+/**
+ * @brief Inicializa una pantalla vacia.
+ *
+ * @param screen: Pantalla a inicializar.
+ * @param dev: Display sobre el que se dibuja.
+ * @param background: Color de fondo; los widgets se dibujan con el otro color.
+ */
+void sh1106_ScreenCreate(sh1106_screen_t * screen, sh1106_t * dev, sh1106_color_t background);
+
+/**
+ * @brief Redibuja en el buffer los widgets que cambiaron desde la ultima llamada.
+ *
+ * Solo modifica el buffer y marca las regiones modificadas; la aplicacion envia los cambios con
+ * sh1106_DevUpdateScreen.
+ *
+ * @param screen: Pantalla a dibujar.
+ * @return uint8_t: Cantidad de widgets redibujados.
+ */
+uint8_t sh1106_ScreenRender(sh1106_screen_t * screen);
+
+/**
+ * @brief Marca todos los widgets para redibujar, por ejemplo luego de borrar el buffer.
+ *
+ * @param screen: Pantalla a invalidar.
+ */
+void sh1106_ScreenInvalidate(sh1106_screen_t * screen);
+
+/**
+ * @brief Crea una etiqueta de texto.
+ *
+ * @param screen: Pantalla donde se agrega.
+ * @param x: Coordenada en "x" de la esquina superior izquierda.
+ * @param y: Coordenada en "y" de la esquina superior izquierda.
+ * @param width: Ancho del rectangulo; el texto que no entra no se dibuja.
+ * @param height: Alto del rectangulo, al menos el alto de la fuente.
+ * @param font: Fuente del texto.
+ * @param text: Texto inicial, se copia (hasta SH1106_WIDGET_TEXT_SIZE - 1 caracteres).
+ * @return sh1106_widget_t *: El widget, o NULL si la pantalla esta llena o el rectangulo no entra
+ * en el display.
+ */
+sh1106_widget_t * sh1106_LabelCreate(sh1106_screen_t * screen, uint8_t x, uint8_t y,
+                                     uint8_t width, uint8_t height, const sh1106_font_t * font,
+                                     const char * text);
+
+/**
+ * @brief Cambia el texto de una etiqueta. Si es el mismo texto, no se redibuja.
+ *
+ * @param widget: Etiqueta.
+ * @param text: Texto nuevo, se copia.
+ */
+void sh1106_LabelSet(sh1106_widget_t * widget, const char * text);
+
+/**
+ * @brief Crea un numero entero, que se dibuja en decimal alineado a la derecha.
+ *
+ * @param screen: Pantalla donde se agrega.
+ * @param x: Coordenada en "x" de la esquina superior izquierda.
+ * @param y: Coordenada en "y" de la esquina superior izquierda.
+ * @param width: Ancho del rectangulo.
+ * @param height: Alto del rectangulo, al menos el alto de la fuente.
+ * @param font: Fuente del numero.
+ * @param value: Valor inicial.
+ * @return sh1106_widget_t *: El widget, o NULL si la pantalla esta llena o el rectangulo no entra
+ * en el display.
+ */
+sh1106_widget_t * sh1106_NumberCreate(sh1106_screen_t * screen, uint8_t x, uint8_t y,
+                                      uint8_t width, uint8_t height, const sh1106_font_t * font,
+                                      int32_t value);
+
+/**
+ * @brief Cambia el valor de un numero. Si es el mismo valor, no se redibuja.
+ *
+ * @param widget: Numero.
+ * @param value: Valor nuevo.
+ */
+void sh1106_NumberSet(sh1106_widget_t * widget, int32_t value);
+
+/**
+ * @brief Crea una barra de progreso horizontal.
+ *
+ * @param screen: Pantalla donde se agrega.
+ * @param x: Coordenada en "x" de la esquina superior izquierda.
+ * @param y: Coordenada en "y" de la esquina superior izquierda.
+ * @param width: Ancho de la barra, incluyendo el contorno (al menos 3).
+ * @param height: Alto de la barra, incluyendo el contorno (al menos 3).
+ * @param min: Valor con la barra vacia.
+ * @param max: Valor con la barra llena, mayor a min.
+ * @param value: Valor inicial, se limita a [min, max].
+ * @return sh1106_widget_t *: El widget, o NULL si la pantalla esta llena o los parametros no son
+ * validos.
+ */
+sh1106_widget_t * sh1106_BarCreate(sh1106_screen_t * screen, uint8_t x, uint8_t y, uint8_t width,
+                                   uint8_t height, int32_t min, int32_t max, int32_t value);
+
+/**
+ * @brief Cambia el valor de una barra. Solo se redibuja si cambia el largo de la barra.
+ *
+ * @param widget: Barra.
+ * @param value: Valor nuevo, se limita a [min, max].
+ */
+void sh1106_BarSet(sh1106_widget_t * widget, int32_t value);
+
+/**
+ * @brief Crea un icono con el tamaño del mapa de bits.
+ *
+ * @param screen: Pantalla donde se agrega.
+ * @param x: Coordenada en "x" de la esquina superior izquierda.
+ * @param y: Coordenada en "y" de la esquina superior izquierda.
+ * @param bitmap: Mapa de bits, se guarda por referencia.
+ * @return sh1106_widget_t *: El widget, o NULL si la pantalla esta llena o el icono no entra en el
+ * display.
+ */
+sh1106_widget_t * sh1106_IconCreate(sh1106_screen_t * screen, uint8_t x, uint8_t y,
+                                    const sh1106_bitmap_t * bitmap);
+
+/**
+ * @brief Cambia el mapa de bits de un icono, que se recorta al tamaño del icono. Si es el mismo
+ * mapa de bits, no se redibuja.
+ *
+ * @param widget: Icono.
+ * @param bitmap: Mapa de bits, o NULL para dejar el icono vacio.
+ */
+void sh1106_IconSet(sh1106_widget_t * widget, const sh1106_bitmap_t * bitmap);
+
+/**
+ * @brief Crea un grafico de tendencia de las ultimas "width" muestras, unidas con lineas.
+ *
+ * @param screen: Pantalla donde se agrega.
+ * @param x: Coordenada en "x" de la esquina superior izquierda.
+ * @param y: Coordenada en "y" de la esquina superior izquierda.
+ * @param width: Ancho del grafico, hasta SH1106_WIDGET_SPARKLINE_SIZE columnas.
+ * @param height: Alto del grafico.
+ * @param min: Valor que se dibuja en la fila de abajo.
+ * @param max: Valor que se dibuja en la fila de arriba, mayor a min.
+ * @return sh1106_widget_t *: El widget, o NULL si la pantalla esta llena o los parametros no son
+ * validos.
+ */
+sh1106_widget_t * sh1106_SparklineCreate(sh1106_screen_t * screen, uint8_t x, uint8_t y,
+                                         uint8_t width, uint8_t height, int32_t min, int32_t max);
+
+/**
+ * @brief Agrega una muestra a un grafico de tendencia, descartando la mas vieja si esta lleno.
+ *
+ * @param widget: Grafico de tendencia.
+ * @param value: Muestra, se limita a [min, max].
+ */
+void sh1106_SparklinePush(sh1106_widget_t * widget, int32_t value);
+
+/**
+ * @brief Muestra u oculta un widget. Un widget oculto deja su rectangulo con el color de fondo.
+ *
+ * @param widget: Widget.
+ * @param visible: true para mostrarlo.
+ */
+void sh1106_WidgetSetVisible(sh1106_widget_t * widget, bool visible);
+
+/**
+ * @brief Marca un widget para redibujar.
+ *
+ * @param widget: Widget.
+ */
+void sh1106_WidgetInvalidate(sh1106_widget_t * widget);
+
+#endif /* INC_SH1106_WIDGET_H_ */
@@ -0,0 +1,33 @@
+/**
+ * @file sh1106_word.h
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Header File - Palabra de las operaciones sobre buffers del driver SH1106
+ *
+ * De uso interno del driver: las comparaciones contra la sombra y la combinacion de capas recorren
+ * los buffers de a una palabra del ancho de un puntero. Las palabras se leen y escriben con memcpy,
+ * sin requisitos de alineacion.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#ifndef INC_SH1106_WORD_H_
+#define INC_SH1106_WORD_H_
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include <stdint.h>
+
+/* === Public data type declarations =========================================================== */
+/**
+ * @brief Palabra del ancho de un puntero: 32 bits en un Cortex-M, 64 en un host (donde el
+ * compilador puede ademas vectorizar los ciclos).
+ */
+#if UINTPTR_MAX > 0xFFFFFFFFu
+typedef uint64_t sh1106_word_t;
+#else
+typedef uint32_t sh1106_word_t;
+#endif
+
+#endif /* INC_SH1106_WORD_H_ */
@@ -0,0 +1,369 @@
+/**
+ * @file sh1106_emu.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Source File - Controlador SH1106 emulado para las pruebas
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include <stdio.h>
+#include <string.h>
+#include "sh1106_emu.h"
+
+/* === Definicion de los macros privados ======================================================= */
+#define EMU_LINES (8 * SH1106_MAX_PAGES) ///< @brief Lineas de la DDRAM
+
+/* === Private variable declarations =========================================================== */
+/**
+ * @brief Emuladores conectados, buscados por direccion.
+ */
+static sh1106_emu_t * sh1106_emu_attached[SH1106_EMU_MAX];
+
+/* === Private function declarations =========================================================== */
+/**
+ * @brief Emulador conectado a la direccion, o NULL.
+ */
+static sh1106_emu_t * sh1106_EmuFind(uint8_t address) {
+    for (uint8_t i = 0; i < SH1106_EMU_MAX; i++) {
+        if (sh1106_emu_attached[i] != NULL && sh1106_emu_attached[i]->address == address) {
+            return sh1106_emu_attached[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Guarda la funcion de fin de una transmision asincronica ya interpretada.
+ */
+static void sh1106_EmuPending(sh1106_emu_t * emu, hal_i2c_callback_t callback, void * context) {
+    emu->callback = callback;
+    emu->context = context;
+}
+
+/**
+ * @brief Comandos de dos bytes: el siguiente byte de comando es su parametro.
+ */
+static bool sh1106_EmuHasParam(uint8_t cmd) {
+    switch (cmd) {
+    case SET_CONSTRAS:
+    case MUX_RATIO_CONFIG:
+    case SET_DC_DC_CONTROL:
+    case 0xD3:
+    case RAT_OSC_FREQ_CONF:
+    case CHARG_DISCHAR_PERI:
+    case PADS_HARD_CONFIG:
+    case SET_VCOM_DESEL_LEV:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Ejecuta el parametro del comando de dos bytes pendiente.
+ */
+static void sh1106_EmuParam(sh1106_emu_t * emu, uint8_t param) {
+    switch (emu->command) {
+    case SET_CONSTRAS:
+        emu->contrast = param;
+        break;
+    case MUX_RATIO_CONFIG:
+        emu->multiplex = param & (EMU_LINES - 1);
+        break;
+    case 0xD3:
+        emu->offset = param & (EMU_LINES - 1);
+        break;
+    default:
+        // Oscilador, precarga, VCOM, pads y DC-DC no cambian la imagen.
+        break;
+    }
+    emu->param_pending = false;
+}
+
+/* === Public function declarations ============================================================ */
+void sh1106_EmuInit(sh1106_emu_t * emu, uint8_t address, uint8_t width, uint8_t height,
+                    uint8_t column_offset) {
+    memset(emu, 0, sizeof(*emu));
+    memset(emu->ddram, 0x55, sizeof(emu->ddram));
+    emu->address = address;
+    emu->width = width;
+    emu->height = height;
+    emu->column_offset = column_offset;
+    emu->multiplex = EMU_LINES - 1;
+    emu->contrast = 0x80;
+}
+
+void sh1106_EmuAttach(sh1106_emu_t * emu) {
+    for (uint8_t i = 0; i < SH1106_EMU_MAX; i++) {
+        if (sh1106_emu_attached[i] != NULL && sh1106_emu_attached[i]->address == emu->address) {
+            sh1106_emu_attached[i] = emu;
+            return;
+        }
+    }
+    for (uint8_t i = 0; i < SH1106_EMU_MAX; i++) {
+        if (sh1106_emu_attached[i] == NULL) {
+            sh1106_emu_attached[i] = emu;
+            return;
+        }
+    }
+}
+
+void sh1106_EmuDetachAll(void) {
+    memset(sh1106_emu_attached, 0, sizeof(sh1106_emu_attached));
+}
+
+void sh1106_EmuCommand(sh1106_emu_t * emu, uint8_t cmd) {
+    emu->stats.commands++;
+    if (emu->param_pending) {
+        sh1106_EmuParam(emu, cmd);
+    } else if (sh1106_EmuHasParam(cmd)) {
+        emu->command = cmd;
+        emu->param_pending = true;
+    } else if (cmd <= 0x0F) {
+        emu->column = (emu->column & 0xF0) | cmd;
+    } else if (cmd <= 0x1F) {
+        emu->column = (emu->column & 0x0F) | ((cmd & 0x0F) << 4);
+    } else if (cmd >= SET_START_LINE && cmd < SET_START_LINE + EMU_LINES) {
+        emu->start_line = cmd - SET_START_LINE;
+    } else if ((cmd & 0xF8) == FIRT_PAGE_ADD) {
+        emu->page = cmd & (SH1106_MAX_PAGES - 1);
+    } else if ((cmd & 0xF0) == COM_OUT_SCAN_NORMA) {
+        emu->com_reverse = (cmd & 0x08) != 0;
+    } else if (cmd == RE_MAP_SEG_NORMAL || cmd == RE_MAP_SEG_INVERT) {
+        emu->segment_remap = (cmd == RE_MAP_SEG_INVERT);
+    } else if (cmd == 0xA4 || cmd == 0xA5) {
+        emu->entire_on = (cmd == 0xA5);
+    } else if (cmd == DISPLAY_NORMAL || cmd == DISPLAY_INVERTED) {
+        emu->inverted = (cmd == DISPLAY_INVERTED);
+    } else if (cmd == DISPLAY_OFF || cmd == DISPLAY_ON) {
+        emu->display_on = (cmd == DISPLAY_ON);
+    }
+}
+
+void sh1106_EmuData(sh1106_emu_t * emu, uint8_t data) {
+    if (emu->column >= SH1106_MAX_WIDTH) {
+        emu->stats.errors++;
+        return;
+    }
+    emu->ddram[emu->page][emu->column++] = data;
+    emu->stats.data_bytes++;
+}
+
+void sh1106_EmuI2c(sh1106_emu_t * emu, const hal_iovec_t * iov, uint8_t count) {
+    enum { EXPECT_CONTROL, EXPECT_SINGLE, IN_STREAM } state = EXPECT_CONTROL;
+    bool data_mode = false;
+
+    emu->stats.transactions++;
+    for (uint8_t i = 0; i < count; i++) {
+        emu->stats.bus_bytes += iov[i].size;
+        for (size_t j = 0; j < iov[i].size; j++) {
+            uint8_t byte = iov[i].data[j];
+            if (state == EXPECT_CONTROL) {
+                data_mode = (byte & CONTROL_DATA_STREAM) != 0;
+                state = (byte & CONTROL_CMD_SINGLE) ? EXPECT_SINGLE : IN_STREAM;
+                continue;
+            }
+            if (data_mode) {
+                sh1106_EmuData(emu, byte);
+            } else {
+                sh1106_EmuCommand(emu, byte);
+            }
+            if (state == EXPECT_SINGLE) {
+                state = EXPECT_CONTROL;
+            }
+        }
+    }
+    if (state == EXPECT_SINGLE) {
+        emu->stats.errors++;
+    }
+}
+
+status_t sh1106_EmuI2cSend(uint8_t address, uint8_t * data, size_t size) {
+    hal_iovec_t iov = {.data = data, .size = size};
+    return sh1106_EmuI2cSendv(address, &iov, 1);
+}
+
+status_t sh1106_EmuI2cSendv(uint8_t address, const hal_iovec_t * iov, uint8_t count) {
+    sh1106_emu_t * emu = sh1106_EmuFind(address);
+    if (emu == NULL) {
+        return HAL_ERROR;
+    }
+    if (emu->callback != NULL) {
+        return HAL_BUSY;
+    }
+    sh1106_EmuI2c(emu, iov, count);
+    return HAL_OK;
+}
+
+status_t sh1106_EmuI2cSendAsync(uint8_t address, uint8_t * data, size_t size,
+                                hal_i2c_callback_t callback, void * context) {
+    hal_iovec_t iov = {.data = data, .size = size};
+    return sh1106_EmuI2cSendvAsync(address, &iov, 1, callback, context);
+}
+
+status_t sh1106_EmuI2cSendvAsync(uint8_t address, const hal_iovec_t * iov, uint8_t count,
+                                 hal_i2c_callback_t callback, void * context) {
+    status_t status = sh1106_EmuI2cSendv(address, iov, count);
+    if (status == HAL_OK) {
+        sh1106_EmuPending(sh1106_EmuFind(address), callback, context);
+    }
+    return status;
+}
+
+void sh1106_EmuSpiSelect(uint8_t device, bool selected) {
+    sh1106_emu_t * emu = sh1106_EmuFind(device);
+    if (emu != NULL) {
+        if (selected && !emu->selected) {
+            emu->stats.transactions++;
+        }
+        emu->selected = selected;
+    }
+}
+
+void sh1106_EmuSpiSetDc(uint8_t device, bool data) {
+    sh1106_emu_t * emu = sh1106_EmuFind(device);
+    if (emu != NULL) {
+        emu->data_mode = data;
+    }
+}
+
+status_t sh1106_EmuSpiWrite(uint8_t device, const uint8_t * data, size_t size) {
+    sh1106_emu_t * emu = sh1106_EmuFind(device);
+    if (emu == NULL) {
+        return HAL_ERROR;
+    }
+    if (emu->callback != NULL) {
+        return HAL_BUSY;
+    }
+    if (!emu->selected) {
+        emu->stats.errors++;
+        return HAL_OK;
+    }
+    emu->stats.bus_bytes += size;
+    for (size_t i = 0; i < size; i++) {
+        if (emu->data_mode) {
+            sh1106_EmuData(emu, data[i]);
+        } else {
+            sh1106_EmuCommand(emu, data[i]);
+        }
+    }
+    return HAL_OK;
+}
+
+status_t sh1106_EmuSpiWriteAsync(uint8_t device, const uint8_t * data, size_t size,
+                                 hal_spi_callback_t callback, void * context) {
+    status_t status = sh1106_EmuSpiWrite(device, data, size);
+    if (status == HAL_OK) {
+        sh1106_EmuPending(sh1106_EmuFind(device), callback, context);
+    }
+    return status;
+}
+
+uint16_t sh1106_EmuComplete(void) {
+    uint16_t completed = 0;
+    bool pending = true;
+
+    while (pending) {
+        pending = false;
+        for (uint8_t i = 0; i < SH1106_EMU_MAX; i++) {
+            sh1106_emu_t * emu = sh1106_emu_attached[i];
+            if (emu != NULL && emu->callback != NULL) {
+                // La funcion de fin puede iniciar la transmision siguiente.
+                hal_i2c_callback_t callback = emu->callback;
+                emu->callback = NULL;
+                callback(emu->context, HAL_OK);
+                completed++;
+                pending = true;
+            }
+        }
+    }
+    return completed;
+}
+
+bool sh1106_EmuPixel(const sh1106_emu_t * emu, uint8_t x, uint8_t y) {
+    if (!emu->display_on || y > emu->multiplex) {
+        return false;
+    }
+    if (emu->entire_on) {
+        return true;
+    }
+    uint8_t segment = x + emu->column_offset;
+    uint8_t column = emu->segment_remap ? SH1106_MAX_WIDTH - 1 - segment : segment;
+    // El panel esta montado al reves: con COM invertidos la fila y es COMy.
+    uint8_t com = emu->com_reverse ? y : emu->multiplex - y;
+    uint8_t line = (com + emu->start_line + emu->offset) % EMU_LINES;
+    bool on = (emu->ddram[line / 8][column] >> (line % 8)) & 1;
+    return on != emu->inverted;
+}
+
+void sh1106_EmuPanel(const sh1106_emu_t * emu, uint8_t * buffer) {
+    memset(buffer, 0, SH1106_BUFFER_SIZE(emu->width, emu->height));
+    for (uint8_t y = 0; y < emu->height; y++) {
+        for (uint8_t x = 0; x < emu->width; x++) {
+            if (sh1106_EmuPixel(emu, x, y)) {
+                buffer[(y / 8) * emu->width + x] |= 1 << (y % 8);
+            }
+        }
+    }
+}
+
+bool sh1106_EmuWritePbm(const sh1106_emu_t * emu, const char * path) {
+    FILE * pbm = fopen(path, "wb");
+    if (pbm == NULL) {
+        return false;
+    }
+    fprintf(pbm, "P4\n%u %u\n", emu->width, emu->height);
+    for (uint8_t y = 0; y < emu->height; y++) {
+        uint8_t row[(SH1106_MAX_WIDTH + 7) / 8] = {0};
+        for (uint8_t x = 0; x < emu->width; x++) {
+            if (sh1106_EmuPixel(emu, x, y)) {
+                row[x / 8] |= 0x80 >> (x % 8);
+            }
+        }
+        fwrite(row, 1, (emu->width + 7) / 8, pbm);
+    }
+    return fclose(pbm) == 0;
+}
+
+int32_t sh1106_EmuComparePbm(const sh1106_emu_t * emu, const char * path) {
+    FILE * pbm = fopen(path, "rb");
+    char magic[3] = {0};
+    unsigned width, height;
+    int32_t differences = 0;
+
+    if (pbm == NULL) {
+        return -1;
+    }
+    if (fscanf(pbm, "%2s %u %u", magic, &width, &height) != 3 || width != emu->width ||
+        height != emu->height || (strcmp(magic, "P1") != 0 && strcmp(magic, "P4") != 0)) {
+        fclose(pbm);
+        return -1;
+    }
+    bool binary = (magic[1] == '4');
+    // En P4 un unico blanco separa la cabecera de los datos.
+    fgetc(pbm);
+    for (uint8_t y = 0; y < emu->height && differences >= 0; y++) {
+        int byte = 0;
+        for (uint8_t x = 0; x < emu->width; x++) {
+            int bit;
+            if (binary) {
+                if (x % 8 == 0) {
+                    byte = fgetc(pbm);
+                }
+                bit = (byte == EOF) ? EOF : (byte >> (7 - x % 8)) & 1;
+            } else if (fscanf(pbm, " %1d", &bit) != 1) {
+                bit = EOF;
+            }
+            if (bit == EOF) {
+                differences = -1;
+                break;
+            }
+            differences += (bit != 0) != sh1106_EmuPixel(emu, x, y);
+        }
+    }
+    fclose(pbm);
+    return differences;
+}
@@ -0,0 +1,206 @@
+/**
+ * @file sh1106_emu.h
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Header File - Controlador SH1106 emulado para las pruebas
+ *
+ * Modelo en software del controlador que consume los bytes que el driver entrega a la HAL, como
+ * lo haria el SH1106: bytes de control I2C (Co y D/C) o el pin D/C de SPI, los comandos de pagina
+ * y columna con autoincremento de la columna, la start line, el offset, el multiplex, el sentido
+ * de segmentos y de COM, la inversion y el encendido, sobre una DDRAM de 8 paginas de 132
+ * columnas. Los comandos de dos bytes esperan su parametro aunque llegue en otra transaccion.
+ *
+ * Cada emulador se conecta a una direccion I2C (o dispositivo SPI) con sh1106_EmuAttach. Las
+ * funciones sh1106_EmuI2c* y sh1106_EmuSpi* tienen la firma de la HAL y se usan como custom_fake
+ * de sus mocks: entregan cada transaccion al emulador conectado a su direccion. Las versiones
+ * asincronicas interpretan la transaccion al recibirla y dejan pendiente la funcion de fin, que
+ * se llama con sh1106_EmuComplete, como lo haria la interrupcion.
+ *
+ * La imagen del panel se obtiene pixel a pixel (sh1106_EmuPixel), con el formato del buffer del
+ * driver (sh1106_EmuPanel) o como archivo PBM, para compararla con una imagen de referencia
+ * (sh1106_EmuWritePbm, sh1106_EmuComparePbm). El panel se considera montado como lo espera el
+ * driver: con segmentos normales y COM invertidos, el pixel (x, y) es el bit y de la columna
+ * x + column_offset de la DDRAM. Los contadores registran lo que llega al bus, para medir el
+ * costo de cada forma de actualizar la pantalla.
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2024
+ */
+
+#ifndef INC_SH1106_EMU_H_
+#define INC_SH1106_EMU_H_
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "hal_i2c.h"
+#include "hal_spi.h"
+#include "sh1106.h"
+
+/* === Definicion de los macros publicos ======================================================= */
+#define SH1106_EMU_MAX (4) ///< @brief Emuladores conectados a la vez
+
+/* === Public data type declarations =========================================================== */
+/**
+ * @brief Contadores de lo recibido por el emulador.
+ */
+typedef struct {
+    uint32_t transactions; ///< @brief Transacciones I2C o activaciones de CS.
+    uint32_t bus_bytes;    ///< @brief Bytes recibidos, con los de control y sin los de direccion.
+    uint32_t commands;     ///< @brief Bytes de comando, con sus parametros.
+    uint32_t data_bytes;   ///< @brief Bytes escritos en la DDRAM.
+    uint32_t errors; ///< @brief Escrituras fuera de la DDRAM, sin CS o sin el byte de un Co=1.
+} sh1106_emu_stats_t;
+
+/**
+ * @brief Controlador emulado y panel montado sobre el.
+ */
+typedef struct {
+    uint8_t ddram[SH1106_MAX_PAGES][SH1106_MAX_WIDTH]; ///< @brief Memoria de la pantalla.
+    uint8_t address;       ///< @brief Direccion I2C o dispositivo SPI.
+    uint8_t width;         ///< @brief Ancho del panel en pixeles.
+    uint8_t height;        ///< @brief Alto del panel en pixeles.
+    uint8_t column_offset; ///< @brief Columna de la DDRAM del primer segmento del panel.
+    uint8_t page;          ///< @brief Pagina de la proxima escritura.
+    uint8_t column;        ///< @brief Columna de la proxima escritura.
+    uint8_t start_line;    ///< @brief Linea de la DDRAM que se muestra en COM0.
+    uint8_t offset;        ///< @brief Desplazamiento de los COM (comando 0xD3).
+    uint8_t multiplex;     ///< @brief COM activos menos uno.
+    uint8_t contrast;      ///< @brief Contraste.
+    bool segment_remap;    ///< @brief Segmentos invertidos (0xA1).
+    bool com_reverse;      ///< @brief COM recorridos de mayor a menor (0xC8).
+    bool inverted;         ///< @brief Pixeles invertidos (0xA7).
+    bool entire_on;        ///< @brief Todos los pixeles encendidos (0xA5).
+    bool display_on;       ///< @brief Panel encendido (0xAF).
+    bool param_pending;    ///< @brief El proximo comando es el parametro de command.
+    uint8_t command;       ///< @brief Comando de dos bytes que espera su parametro.
+    bool selected;         ///< @brief Nivel activo del CS de SPI.
+    bool data_mode;        ///< @brief Nivel del pin D/C de SPI.
+    hal_i2c_callback_t callback; ///< @brief Funcion de fin de la transmision pendiente.
+    void * context;              ///< @brief Contexto de callback.
+    sh1106_emu_stats_t stats;    ///< @brief Contadores.
+} sh1106_emu_t;
+
+/* === Public function declarations ============================================================ */
+/**
+ * @brief Inicializa el emulador como el controlador al encenderse: panel apagado, pagina,
+ * columna, start line y offset en 0, multiplex de 64 filas, segmentos y COM normales. La DDRAM,
+ * que en el controlador queda indefinida, se llena con 0x55 para que se note lo que no se envia.
+ *
+ * @param emu: Emulador.
+ * @param address: Direccion I2C o dispositivo SPI.
+ * @param width: Ancho del panel.
+ * @param height: Alto del panel.
+ * @param column_offset: Columna de la DDRAM del primer segmento del panel.
+ */
+void sh1106_EmuInit(sh1106_emu_t * emu, uint8_t address, uint8_t width, uint8_t height,
+                    uint8_t column_offset);
+
+/**
+ * @brief Conecta el emulador a su direccion, para que reciba las transacciones de la HAL
+ * emulada. Reemplaza al que estuviera conectado en la misma direccion.
+ *
+ * @param emu: Emulador.
+ */
+void sh1106_EmuAttach(sh1106_emu_t * emu);
+
+/**
+ * @brief Desconecta todos los emuladores y descarta las transmisiones pendientes.
+ */
+void sh1106_EmuDetachAll(void);
+
+/**
+ * @brief Ejecuta un byte de comando, o lo toma como parametro del comando anterior.
+ *
+ * @param emu: Emulador.
+ * @param cmd: Byte recibido con D/C=0.
+ */
+void sh1106_EmuCommand(sh1106_emu_t * emu, uint8_t cmd);
+
+/**
+ * @brief Escribe un byte en la DDRAM y avanza la columna. Mas alla de la columna 131 la escritura
+ * se descarta y se cuenta como error.
+ *
+ * @param emu: Emulador.
+ * @param data: Byte recibido con D/C=1.
+ */
+void sh1106_EmuData(sh1106_emu_t * emu, uint8_t data);
+
+/**
+ * @brief Interpreta una transaccion I2C completa, sin el byte de direccion: pares (control, byte)
+ * con Co=1, o un byte de control con Co=0 seguido de un stream de comandos o de datos.
+ *
+ * @param emu: Emulador.
+ * @param iov: Tramos de la transaccion.
+ * @param count: Cantidad de tramos.
+ */
+void sh1106_EmuI2c(sh1106_emu_t * emu, const hal_iovec_t * iov, uint8_t count);
+
+/**
+ * @brief Reemplazos de la HAL I2C: entregan la transaccion al emulador de la direccion. Sin
+ * emulador conectado devuelven HAL_ERROR (nadie responde), y con una transmision pendiente,
+ * HAL_BUSY.
+ */
+status_t sh1106_EmuI2cSend(uint8_t address, uint8_t * data, size_t size);
+status_t sh1106_EmuI2cSendv(uint8_t address, const hal_iovec_t * iov, uint8_t count);
+status_t sh1106_EmuI2cSendAsync(uint8_t address, uint8_t * data, size_t size,
+                                hal_i2c_callback_t callback, void * context);
+status_t sh1106_EmuI2cSendvAsync(uint8_t address, const hal_iovec_t * iov, uint8_t count,
+                                 hal_i2c_callback_t callback, void * context);
+
+/**
+ * @brief Reemplazos de la HAL SPI de 4 hilos. Cada activacion de CS es una transaccion; las
+ * escrituras sin CS se descartan y se cuentan como error.
+ */
+void sh1106_EmuSpiSelect(uint8_t device, bool selected);
+void sh1106_EmuSpiSetDc(uint8_t device, bool data);
+status_t sh1106_EmuSpiWrite(uint8_t device, const uint8_t * data, size_t size);
+status_t sh1106_EmuSpiWriteAsync(uint8_t device, const uint8_t * data, size_t size,
+                                 hal_spi_callback_t callback, void * context);
+
+/**
+ * @brief Termina las transmisiones asincronicas pendientes con HAL_OK, incluidas las que se
+ * inician desde las funciones de fin, hasta que no quede ninguna.
+ *
+ * @return uint16_t: Cantidad de funciones de fin llamadas.
+ */
+uint16_t sh1106_EmuComplete(void);
+
+/**
+ * @brief Pixel encendido del panel, segun la DDRAM y la configuracion del controlador.
+ *
+ * @param emu: Emulador.
+ * @param x: Columna del panel.
+ * @param y: Fila del panel.
+ * @return bool: true si el pixel esta encendido.
+ */
+bool sh1106_EmuPixel(const sh1106_emu_t * emu, uint8_t x, uint8_t y);
+
+/**
+ * @brief Imagen del panel con el formato del buffer del driver: width * height / 8 bytes, pagina
+ * por pagina, con el bit 0 arriba.
+ *
+ * @param emu: Emulador.
+ * @param buffer: Destino de la imagen.
+ */
+void sh1106_EmuPanel(const sh1106_emu_t * emu, uint8_t * buffer);
+
+/**
+ * @brief Guarda la imagen del panel como PBM binario (P4), con los pixeles encendidos en negro.
+ *
+ * @param emu: Emulador.
+ * @param path: Archivo destino.
+ * @return bool: false si no se pudo escribir.
+ */
+bool sh1106_EmuWritePbm(const sh1106_emu_t * emu, const char * path);
+
+/**
+ * @brief Compara la imagen del panel con un archivo PBM (P1 o P4).
+ *
+ * @param emu: Emulador.
+ * @param path: Imagen de referencia.
+ * @return int32_t: Cantidad de pixeles distintos, o -1 si el archivo no se puede leer o no tiene
+ * las dimensiones del panel.
+ */
+int32_t sh1106_EmuComparePbm(const sh1106_emu_t * emu, const char * path);
+
+#endif /* INC_SH1106_EMU_H_ */
@@ -25,6 +25,37 @@
  * incorrecta (status devuelve ERROR).</li>
  *   <li>Test 10: Probar la funcion para modificar 1 pixel "valido" en el buffer.</li>
  *   <li>Test 11: Probar la funcion para modificar 1 pixel "NO valido" en el buffer.</li>
+ *   <li>Test 12: Modificar 1 pixel y verificar que la actualizacion solo envie ese byte.</li>
+ *   <li>Test 13: Actualizar la pantalla sin cambios y verificar que no se envie nada.</li>
+ *   <li>Test 14: Verificar los contadores de bytes enviados y ahorrados.</li>
+ *   <li>Test 15: Agrupar varios comandos en una transaccion con un solo byte de control.</li>
+ *   <li>Test 16: Agrupar comandos y datos en una transaccion con los bytes de control
+ * correspondientes.</li>
+ *   <li>Test 17: Verificar que la inicializacion reduce la cantidad de transacciones.</li>
+ *   <li>Test 18: Iniciar una actualizacion asincronica y verificar que el driver informe BUSY hasta
+ * que termine.</li>
+ *   <li>Test 19: Completar una actualizacion asincronica desde la interrupcion simulada y verificar
+ * que se llame a la funcion de fin con OK.</li>
+ *   <li>Test 20: Dibujar durante una actualizacion asincronica no modifica lo que se envia.</li>
+ *   <li>Test 21: Manejar dos displays con buffers y direcciones propias.</li>
+ *   <li>Test 22: Rechazar un display que no entra en la DDRAM del controlador.</li>
+ *   <li>Test 23: Aplicar el offset de columna del display en la actualizacion.</li>
+ *   <li>Test 24: Desplazar una pagina envia la start line y solo la pagina expuesta.</li>
+ *   <li>Test 25: Despues de desplazar, cada pagina logica se envia a su pagina de la DDRAM.</li>
+ *   <li>Test 26: Dividir los datos de una pagina segun el maximo de bytes por transaccion.</li>
+ *   <li>Test 27: Enviar comandos y datos como tramos sin copiarlos, sin limite de tamaño.</li>
+ *   <li>Test 28: Continuar desde la interrupcion los datos de una pagina dividida.</li>
+ *   <li>Test 29: Con sombra de la DDRAM, borrar y redibujar envia solo los tramos que
+ * cambiaron.</li>
+ *   <li>Test 30: Unir los tramos separados por pocas columnas sin cambios.</li>
+ *   <li>Test 31: La actualizacion asincronica con sombra recorta cada pagina a sus cambios.</li>
+ *   <li>Test 32: El reinicio en caliente reconfigura el controlador en una transaccion, con el
+ * contraste del display, y no vuelve a enviar la pantalla.</li>
+ *   <li>Test 33: Suspender y despertar el display envian una transaccion cada uno.</li>
+ *   <li>Test 34: Despues del reinicio en caliente se envia la pantalla completa si se habia
+ * invalidado.</li>
+ *   <li>Test 35: Despues del reinicio en caliente se envia la pantalla completa si fallo la
+ * actualizacion asincronica anterior.</li>
  * </ul>
  *
  * <b>PRUEBAS PENDIENTES</b>
@@ -39,6 +70,7 @@
 #include "unity.h"
 #include "mock_hal_i2c.h"
 #include "sh1106.h"
+#include "sh1106_gather.h"
 
 /**
  * @brief Buffer de la librea a probar (variable extern).
@@ -52,6 +84,71 @@ extern uint8_t SH1106_Buffer[];
  */
 sh1106_status_t status;
 
+/**
+ * @brief Transaccion agrupada usada en las pruebas de agrupamiento.
+ *
+ */
+sh1106_batch_t batch;
+
+/**
+ * @brief Funcion de fin de transmision que el driver entrega a la HAL asincronica (mock).
+ *
+ */
+hal_i2c_callback_t hal_callback;
+
+/**
+ * @brief Contexto que el driver entrega a la HAL asincronica junto con la funcion de fin.
+ *
+ */
+void * hal_context;
+
+/**
+ * @brief Resultado recibido por la funcion de fin de la actualizacion asincronica.
+ *
+ */
+sh1106_status_t async_resultado;
+
+/**
+ * @brief Cantidad de veces que se llamo a la funcion de fin de la actualizacion asincronica.
+ *
+ */
+int async_llamadas;
+
+/**
+ * @brief Reemplazo de HAL_I2C_send_async, guarda la funcion de fin para llamarla luego desde la
+ * interrupcion simulada.
+ */
+status_t HAL_I2C_send_async_iniciar(uint8_t address, uint8_t * data, size_t size,
+                                    hal_i2c_callback_t callback, void * context) {
+    hal_callback = callback;
+    hal_context = context;
+    return HAL_OK;
+}
+
+/**
+ * @brief Simula la interrupcion de fin de transmision de la HAL.
+ */
+void simular_interrupcion_fin_transmision(void) {
+    hal_i2c_callback_t callback = hal_callback;
+    hal_callback = NULL;
+    callback(hal_context, HAL_OK);
+}
+
+/**
+ * @brief Funcion de fin de la actualizacion asincronica usada en las pruebas.
+ */
+void fin_actualizacion(sh1106_t * dev, sh1106_status_t resultado) {
+    async_resultado = resultado;
+    async_llamadas++;
+}
+
+/**
+ * @brief Displays y buffers de 128x32 usados en las pruebas de varios displays.
+ *
+ */
+sh1106_t display_a, display_b;
+uint8_t buffer_a[SH1106_BUFFER_SIZE(128, 32)], buffer_b[SH1106_BUFFER_SIZE(128, 32)];
+
 /**
  * @brief Buffer de comparacion para el test 10.
  *
@@ -65,6 +162,13 @@ uint8_t buffer_test10[BUFFER_SIZE];
 void setUp(void) {
     status = 0x03;                         // ponemos el estatus en un valor fuera de lo definido
     memset(SH1106_Buffer, 0, BUFFER_SIZE); // Inicializa el buffer a ceros antes de cada prueba
+    sh1106_InvalidateAll();                // el buffer se modifico sin pasar por el driver
+    sh1106_ResetFlushStats();
+
+    HAL_I2C_send_async_fake.custom_fake = HAL_I2C_send_async_iniciar;
+    hal_callback = NULL;
+    async_resultado = SH1106_BUSY;
+    async_llamadas = 0;
 
     memset(buffer_test10, 0, BUFFER_SIZE);
     buffer_test10[4] = 0x10;
@@ -213,3 +317,680 @@ void test_probar_la_funcion_para_modificar_un_pixel_NO_valido_del_buffer(void) {
     status = sh1106_DrawPixel(129, 4, WHITE);
     TEST_ASSERT_EQUAL(SH1106_ERROR, status);
 }
+
+/**
+ * @brief Test 12: Modificar 1 pixel y verificar que la actualizacion solo envie ese byte.
+ *
+ * Luego de una actualizacion completa se dibuja un pixel, la siguiente actualizacion debe enviar
+ * en una transaccion los 3 comandos de direccion (pagina, columna baja, columna alta) y un unico
+ * byte de datos, cada uno con su byte de control.
+ */
+void test_actualizar_la_pantalla_luego_de_modificar_un_pixel_envia_solo_ese_byte(void) {
+    HAL_I2C_send_fake.return_val = 0;
+    sh1106_UpdateScreen();
+    RESET_FAKE(HAL_I2C_send);
+
+    sh1106_DrawPixel(20, 12, WHITE);
+    status = sh1106_UpdateScreen();
+    TEST_ASSERT_EQUAL(SH1106_OK, status);
+    TEST_ASSERT_EQUAL(1, HAL_I2C_send_fake.call_count);
+    TEST_ASSERT_EQUAL(2 * 3 + 2, HAL_I2C_send_fake.arg2_val);
+}
+
+/**
+ * @brief Test 13: Actualizar la pantalla sin cambios y verificar que no se envie nada.
+ */
+void test_actualizar_la_pantalla_sin_cambios_no_envia_datos(void) {
+    HAL_I2C_send_fake.return_val = 0;
+    sh1106_UpdateScreen();
+    RESET_FAKE(HAL_I2C_send);
+
+    status = sh1106_UpdateScreen();
+    TEST_ASSERT_EQUAL(SH1106_OK, status);
+    TEST_ASSERT_EQUAL(0, HAL_I2C_send_fake.call_count);
+}
+
+/**
+ * @brief Test 14: Verificar los contadores de bytes enviados y ahorrados.
+ *
+ * Una actualizacion completa envia 8 paginas de 3 comandos y 128 datos, la segunda actualizacion
+ * solo envia los 2 bytes de una linea horizontal de 2 pixeles, mas los 3 comandos de la pagina.
+ */
+void test_los_contadores_reflejan_los_bytes_ahorrados(void) {
+    sh1106_flush_stats_t stats;
+    HAL_I2C_send_fake.return_val = 0;
+    sh1106_UpdateScreen();
+    sh1106_DrawPixel(0, 0, WHITE);
+    sh1106_DrawPixel(1, 0, WHITE);
+    sh1106_UpdateScreen();
+
+    sh1106_GetFlushStats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.flushes);
+    TEST_ASSERT_EQUAL(1, stats.full_flushes);
+    TEST_ASSERT_EQUAL(SH1106_PAGES * (3 + SH1106_WHIDTH) + 5, stats.bytes_sent);
+    TEST_ASSERT_EQUAL(SH1106_PAGES * (3 + SH1106_WHIDTH) - 5, stats.bytes_saved);
+}
+
+/**
+ * @brief Test 15: Agrupar varios comandos en una transaccion con un solo byte de control.
+ */
+void test_agrupar_comandos_en_una_sola_transaccion(void) {
+    uint8_t esperado[] = {CONTROL_CMD_STREAM, DISPLAY_OFF, SET_CONSTRAS, 0x10};
+    HAL_I2C_send_fake.return_val = 0;
+
+    sh1106_BatchInit(&batch, sh1106_Default());
+    sh1106_BatchCmd(&batch, DISPLAY_OFF);
+    sh1106_BatchCmd(&batch, SET_CONSTRAS);
+    sh1106_BatchCmd(&batch, 0x10);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(esperado, batch.buffer, sizeof(esperado));
+
+    status = sh1106_BatchFlush(&batch);
+    TEST_ASSERT_EQUAL(SH1106_OK, status);
+    TEST_ASSERT_EQUAL(1, HAL_I2C_send_fake.call_count);
+    TEST_ASSERT_EQUAL(sizeof(esperado), HAL_I2C_send_fake.arg2_val);
+}
+
+/**
+ * @brief Test 16: Agrupar comandos y datos en una transaccion con los bytes de control
+ * correspondientes.
+ *
+ * Al agregar datos, los comandos previos pasan a llevar cada uno su byte de control con Co=1 y los
+ * datos quedan al final con un unico byte de control. Los datos no se copian a la transaccion, se
+ * guardan por referencia hasta enviarla.
+ */
+void test_agrupar_comandos_y_datos_en_una_sola_transaccion(void) {
+    uint8_t datos[] = {0xAA, 0x55};
+    uint8_t esperado[] = {CONTROL_CMD_SINGLE, FIRT_PAGE_ADD + 2, CONTROL_CMD_SINGLE,
+                          FIRT_COLUM_ADD_L,   CONTROL_DATA_STREAM, 0xAA, 0x55};
+    HAL_I2C_send_fake.return_val = 0;
+
+    sh1106_BatchInit(&batch, sh1106_Default());
+    sh1106_BatchCmd(&batch, FIRT_PAGE_ADD + 2);
+    sh1106_BatchCmd(&batch, FIRT_COLUM_ADD_L);
+    sh1106_BatchData(&batch, datos, sizeof(datos));
+    TEST_ASSERT_EQUAL(sizeof(esperado) - sizeof(datos), batch.size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(esperado, batch.buffer, sizeof(esperado) - sizeof(datos));
+    TEST_ASSERT_EQUAL_PTR(datos, batch.data);
+
+    status = sh1106_BatchFlush(&batch);
+    TEST_ASSERT_EQUAL(SH1106_OK, status);
+    TEST_ASSERT_EQUAL(1, HAL_I2C_send_fake.call_count);
+    TEST_ASSERT_EQUAL(sizeof(esperado), HAL_I2C_send_fake.arg2_val);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(esperado, HAL_I2C_send_fake.arg1_val, sizeof(esperado));
+}
+
+/**
+ * @brief Test 17: Verificar que la inicializacion reduce la cantidad de transacciones.
+ *
+ * Enviando un byte por transaccion la inicializacion necesitaba 21 transacciones de configuracion
+ * mas 4 por cada pagina. Agrupada, necesita una para la configuracion y una por pagina.
+ */
+void test_la_inicializacion_agrupa_las_transacciones(void) {
+    HAL_I2C_send_fake.return_val = 0;
+    status = sh1106_Init();
+    TEST_ASSERT_EQUAL(SH1106_OK, status);
+    TEST_ASSERT_EQUAL(1 + SH1106_PAGES, HAL_I2C_send_fake.call_count);
+}
+
+/**
+ * @brief Test 18: Iniciar una actualizacion asincronica y verificar que el driver informe BUSY
+ * hasta que termine.
+ *
+ * Mientras la transmision esta en curso no se puede iniciar otra actualizacion, ni sincronica ni
+ * asincronica, ya que el bus esta ocupado.
+ */
+void test_la_actualizacion_asincronica_informa_busy_mientras_transmite(void) {
+    status = sh1106_UpdateScreenAsync(fin_actualizacion);
+    TEST_ASSERT_EQUAL(SH1106_OK, status);
+    TEST_ASSERT_EQUAL(SH1106_BUSY, sh1106_AsyncStatus());
+    TEST_ASSERT_EQUAL(SH1106_BUSY, sh1106_UpdateScreenAsync(fin_actualizacion));
+    TEST_ASSERT_EQUAL(SH1106_BUSY, sh1106_UpdateScreen());
+    TEST_ASSERT_EQUAL(0, HAL_I2C_send_fake.call_count);
+
+    while (hal_callback != NULL) {
+        simular_interrupcion_fin_transmision();
+    }
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_AsyncStatus());
+}
+
+/**
+ * @brief Test 19: Completar una actualizacion asincronica desde la interrupcion simulada y
+ * verificar que se llame a la funcion de fin con OK.
+ *
+ * La primera actualizacion envia la pantalla completa, una transaccion por pagina.
+ */
+void test_la_actualizacion_asincronica_termina_desde_la_interrupcion(void) {
+    sh1106_UpdateScreenAsync(fin_actualizacion);
+    while (hal_callback != NULL) {
+        TEST_ASSERT_EQUAL(0, async_llamadas);
+        simular_interrupcion_fin_transmision();
+    }
+    TEST_ASSERT_EQUAL(SH1106_PAGES, HAL_I2C_send_async_fake.call_count);
+    TEST_ASSERT_EQUAL(1, async_llamadas);
+    TEST_ASSERT_EQUAL(SH1106_OK, async_resultado);
+}
+
+/**
+ * @brief Test 20: Dibujar durante una actualizacion asincronica no modifica lo que se envia.
+ *
+ * Se dibuja un pixel mientras se envia el cuadro, los datos de la ultima pagina (que se envia al
+ * final) deben seguir en cero. El pixel se envia en la siguiente actualizacion.
+ */
+void test_dibujar_durante_la_actualizacion_asincronica_no_modifica_lo_enviado(void) {
+    sh1106_UpdateScreenAsync(fin_actualizacion);
+    sh1106_DrawPixel(0, SH1106_HEIGHT - 1, WHITE);
+    while (hal_callback != NULL) {
+        simular_interrupcion_fin_transmision();
+    }
+    uint8_t * enviado = HAL_I2C_send_async_fake.arg1_val;
+    TEST_ASSERT_EQUAL(2 * 3 + 1 + SH1106_WHIDTH, HAL_I2C_send_async_fake.arg2_val);
+    TEST_ASSERT_EQUAL(0x00, enviado[2 * 3 + 1]);
+
+    sh1106_UpdateScreenAsync(fin_actualizacion);
+    TEST_ASSERT_EQUAL(2 * 3 + 2, HAL_I2C_send_async_fake.arg2_val);
+    TEST_ASSERT_EQUAL(0x80, HAL_I2C_send_async_fake.arg1_val[2 * 3 + 1]);
+    simular_interrupcion_fin_transmision();
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_AsyncStatus());
+}
+
+/**
+ * @brief Test 21: Manejar dos displays con buffers y direcciones propias.
+ *
+ * Se llena de blanco el primer display, el buffer del segundo no cambia y su actualizacion envia
+ * sus 4 paginas a su propia direccion.
+ */
+void test_manejar_dos_displays_con_buffers_y_direcciones_propias(void) {
+    sh1106_config_t config = {.buffer = buffer_a,
+                              .width = 128,
+                              .height = 32,
+                              .address = 0x3C,
+                              .transport = &sh1106_i2c_transport};
+    uint8_t esperado[SH1106_BUFFER_SIZE(128, 32)] = {0};
+    memset(buffer_b, 0, sizeof(buffer_b));
+    HAL_I2C_send_fake.return_val = 0;
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevCreate(&display_a, &config));
+    config.buffer = buffer_b;
+    config.address = 0x3D;
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevCreate(&display_b, &config));
+
+    sh1106_DevFill(&display_a, WHITE);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(esperado, buffer_b, sizeof(buffer_b));
+
+    status = sh1106_DevUpdateScreen(&display_b);
+    TEST_ASSERT_EQUAL(SH1106_OK, status);
+    TEST_ASSERT_EQUAL(4, HAL_I2C_send_fake.call_count);
+    TEST_ASSERT_EQUAL(0x3D, HAL_I2C_send_fake.arg0_val);
+}
+
+/**
+ * @brief Test 22: Rechazar un display que no entra en la DDRAM del controlador.
+ */
+void test_rechazar_un_display_que_no_entra_en_la_ddram(void) {
+    sh1106_config_t config = {.buffer = buffer_a,
+                              .width = 130,
+                              .height = 32,
+                              .column_offset = 4,
+                              .transport = &sh1106_i2c_transport};
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DevCreate(&display_a, &config));
+
+    config.width = 128;
+    config.column_offset = 0;
+    config.height = 36;
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DevCreate(&display_a, &config));
+}
+
+/**
+ * @brief Test 23: Aplicar el offset de columna del display en la actualizacion.
+ *
+ * En un panel de 128 columnas conectado desde la columna 2 de la DDRAM, el pixel de la columna 10
+ * se escribe en la columna 12 de la DDRAM: columna baja 0x0C y alta 0x10.
+ */
+void test_aplicar_el_offset_de_columna_del_display(void) {
+    sh1106_config_t config = {.buffer = buffer_a,
+                              .width = 128,
+                              .height = 32,
+                              .column_offset = 2,
+                              .transport = &sh1106_i2c_transport};
+    HAL_I2C_send_fake.return_val = 0;
+    sh1106_DevCreate(&display_a, &config);
+    sh1106_DevUpdateScreen(&display_a);
+
+    sh1106_DevDrawPixel(&display_a, 10, 0, WHITE);
+    sh1106_DevUpdateScreen(&display_a);
+    uint8_t * enviado = HAL_I2C_send_fake.arg1_val;
+    TEST_ASSERT_EQUAL(FIRT_COLUM_ADD_L | 0x0C, enviado[3]);
+    TEST_ASSERT_EQUAL(FIRT_COLUM_ADD_H, enviado[5]);
+}
+
+/**
+ * @brief Crea el display de 128x32 de las pruebas de desplazamiento, con una pagina distinta en
+ * cada pagina del buffer, y lo envia completo.
+ */
+void crear_display_desplazable(void) {
+    sh1106_config_t config = {
+        .buffer = buffer_a, .width = 128, .height = 32, .transport = &sh1106_i2c_transport};
+    HAL_I2C_send_fake.return_val = 0;
+    sh1106_DevCreate(&display_a, &config);
+    for (uint8_t page = 0; page < 4; page++) {
+        memset(&buffer_a[page * 128], page + 1, 128);
+    }
+    sh1106_DevUpdateScreen(&display_a);
+    RESET_FAKE(HAL_I2C_send);
+}
+
+/**
+ * @brief Test 24: Desplazar una pagina envia la start line y solo la pagina expuesta.
+ *
+ * El contenido sube una pagina en el buffer y la DDRAM no se reenvia. La pagina logica 3, que
+ * quedo expuesta en negro, corresponde a la pagina 4 de la DDRAM, y viaja en la misma transaccion
+ * que la nueva start line (fila 8).
+ */
+void test_desplazar_una_pagina_envia_solo_la_pagina_expuesta(void) {
+    static const uint8_t comandos[] = {CONTROL_CMD_SINGLE, SET_START_LINE | 8,
+                                       CONTROL_CMD_SINGLE, FIRT_PAGE_ADD + 4,
+                                       CONTROL_CMD_SINGLE, FIRT_COLUM_ADD_L,
+                                       CONTROL_CMD_SINGLE, FIRT_COLUM_ADD_H,
+                                       CONTROL_DATA_STREAM};
+    sh1106_flush_stats_t stats;
+    crear_display_desplazable();
+    sh1106_DevResetFlushStats(&display_a);
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevScroll(&display_a, 1));
+    TEST_ASSERT_EQUAL(0, HAL_I2C_send_fake.call_count);
+    TEST_ASSERT_EQUAL(2, buffer_a[0]);
+    TEST_ASSERT_EQUAL(4, buffer_a[2 * 128 + 127]);
+    TEST_ASSERT_EQUAL(0, buffer_a[3 * 128]);
+
+    sh1106_DevUpdateScreen(&display_a);
+    TEST_ASSERT_EQUAL(1, HAL_I2C_send_fake.call_count);
+    TEST_ASSERT_EQUAL(sizeof(comandos) + 128, HAL_I2C_send_fake.arg2_val);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(comandos, HAL_I2C_send_fake.arg1_val, sizeof(comandos));
+    sh1106_DevGetFlushStats(&display_a, &stats);
+    TEST_ASSERT_EQUAL(1 + 3 + 128, stats.bytes_sent);
+    TEST_ASSERT_EQUAL(3 * (3 + 128), stats.bytes_saved);
+}
+
+/**
+ * @brief Test 25: Despues de desplazar, cada pagina logica se envia a su pagina de la DDRAM.
+ *
+ * Al bajar el contenido dos paginas la pagina de la DDRAM que se ve arriba es la 6, por lo que las
+ * paginas logicas 0 y 1 expuestas se envian a las paginas 6 y 7. La start line solo viaja con la
+ * primera. Desplazar toda la pantalla la envia completa, junto con la start line, sin contar bytes
+ * ahorrados.
+ */
+void test_las_paginas_se_envian_a_su_pagina_de_la_ddram(void) {
+    sh1106_flush_stats_t stats;
+    crear_display_desplazable();
+    sh1106_DevResetFlushStats(&display_a);
+
+    sh1106_DevScroll(&display_a, -2);
+    sh1106_DevDrawPixel(&display_a, 5, 9, WHITE);
+    TEST_ASSERT_EQUAL(1, buffer_a[2 * 128]);
+    TEST_ASSERT_EQUAL(2, buffer_a[3 * 128]);
+
+    sh1106_DevUpdateScreen(&display_a);
+    TEST_ASSERT_EQUAL(2, HAL_I2C_send_fake.call_count);
+    TEST_ASSERT_EQUAL(9 + 128, HAL_I2C_send_fake.arg2_history[0]);
+    TEST_ASSERT_EQUAL(7 + 128, HAL_I2C_send_fake.arg2_history[1]);
+    uint8_t * enviado = HAL_I2C_send_fake.arg1_val;
+    TEST_ASSERT_EQUAL(FIRT_PAGE_ADD + 7, enviado[1]);
+    TEST_ASSERT_EQUAL(0x02, enviado[7 + 5]);
+    sh1106_DevGetFlushStats(&display_a, &stats);
+    TEST_ASSERT_EQUAL(1 + 2 * (3 + 128), stats.bytes_sent);
+    TEST_ASSERT_EQUAL(2 * (3 + 128), stats.bytes_saved);
+
+    sh1106_DevScroll(&display_a, 4);
+    sh1106_DevUpdateScreen(&display_a);
+    sh1106_DevGetFlushStats(&display_a, &stats);
+    TEST_ASSERT_EQUAL(1 + 2 * (3 + 128) + 1 + 4 * (3 + 128), stats.bytes_sent);
+    TEST_ASSERT_EQUAL(2 * (3 + 128), stats.bytes_saved);
+}
+
+/**
+ * @brief Tramos recibidos por el reemplazo de HAL_I2C_sendv en cada transaccion.
+ *
+ */
+sh1106_iovec_t tramos[16][2];
+uint8_t cantidad_tramos[16];
+
+/**
+ * @brief Guarda los tramos de una transaccion.
+ */
+void registrar_tramos(unsigned transaccion, const hal_iovec_t * iov, uint8_t count) {
+    TEST_ASSERT_LESS_OR_EQUAL(2, count);
+    cantidad_tramos[transaccion] = count;
+    memcpy(tramos[transaccion], iov, count * sizeof(*iov));
+}
+
+/**
+ * @brief Reemplazo de HAL_I2C_sendv, guarda los tramos de cada transaccion.
+ */
+status_t HAL_I2C_sendv_registrar(uint8_t address, const hal_iovec_t * iov, uint8_t count) {
+    registrar_tramos(HAL_I2C_sendv_fake.call_count - 1, iov, count);
+    return HAL_OK;
+}
+
+/**
+ * @brief Reemplazo de HAL_I2C_sendv_async, guarda los tramos y la funcion de fin.
+ */
+status_t HAL_I2C_sendv_async_iniciar(uint8_t address, const hal_iovec_t * iov, uint8_t count,
+                                     hal_i2c_callback_t callback, void * context) {
+    hal_callback = callback;
+    hal_context = context;
+    registrar_tramos(HAL_I2C_sendv_async_fake.call_count - 1, iov, count);
+    return HAL_OK;
+}
+
+/**
+ * @brief Test 26: Dividir los datos de una pagina segun el maximo de bytes por transaccion.
+ *
+ * Con un maximo de 64 bytes, la pagina completa (7 bytes de comandos y control, y 128 de datos)
+ * se envia en tres transacciones. Las dos ultimas continuan los datos con su propio byte de
+ * control, el controlador los escribe a continuacion. Un maximo que no alcanza para los comandos
+ * de una pagina se rechaza.
+ */
+void test_dividir_los_datos_segun_el_maximo_por_transaccion(void) {
+    sh1106_config_t config = {.buffer = buffer_a,
+                              .width = 128,
+                              .height = 8,
+                              .transport = &sh1106_i2c_transport,
+                              .max_transfer = SH1106_MIN_TRANSFER - 1};
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DevCreate(&display_a, &config));
+
+    config.max_transfer = 64;
+    HAL_I2C_send_fake.return_val = 0;
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevCreate(&display_a, &config));
+    for (uint8_t i = 0; i < 128; i++) {
+        buffer_a[i] = i;
+    }
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreen(&display_a));
+
+    TEST_ASSERT_EQUAL(3, HAL_I2C_send_fake.call_count);
+    TEST_ASSERT_EQUAL(64, HAL_I2C_send_fake.arg2_history[0]);
+    TEST_ASSERT_EQUAL(64, HAL_I2C_send_fake.arg2_history[1]);
+    TEST_ASSERT_EQUAL(1 + 128 - 57 - 63, HAL_I2C_send_fake.arg2_history[2]);
+    uint8_t * enviado = HAL_I2C_send_fake.arg1_val;
+    TEST_ASSERT_EQUAL(CONTROL_DATA_STREAM, enviado[0]);
+    TEST_ASSERT_EQUAL(57 + 63, enviado[1]);
+}
+
+/**
+ * @brief Test 27: Enviar comandos y datos como tramos sin copiarlos, sin limite de tamaño.
+ *
+ * Con sh1106_i2c_gather_transport la pagina viaja como dos tramos de una transaccion: los comandos
+ * y los datos, que apuntan directamente al buffer del display. Un envio de 1000 bytes de datos
+ * tambien sale en una sola transaccion.
+ */
+void test_enviar_tramos_sin_copiar(void) {
+    static uint8_t datos[1000];
+    sh1106_config_t config = {
+        .buffer = buffer_a, .width = 128, .height = 32, .transport = &sh1106_i2c_gather_transport};
+    HAL_I2C_sendv_fake.custom_fake = HAL_I2C_sendv_registrar;
+    sh1106_DevCreate(&display_a, &config);
+    sh1106_DevUpdateScreen(&display_a);
+    HAL_I2C_sendv_fake.call_count = 0;
+
+    sh1106_DevDrawPixel(&display_a, 100, 20, WHITE);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreen(&display_a));
+    TEST_ASSERT_EQUAL(1, HAL_I2C_sendv_fake.call_count);
+    TEST_ASSERT_EQUAL(2, cantidad_tramos[0]);
+    TEST_ASSERT_EQUAL(2 * 3 + 1, tramos[0][0].size);
+    TEST_ASSERT_EQUAL_PTR(&buffer_a[2 * 128 + 100], tramos[0][1].data);
+    TEST_ASSERT_EQUAL(1, tramos[0][1].size);
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevSendData(&display_a, datos, sizeof(datos)));
+    TEST_ASSERT_EQUAL(2, HAL_I2C_sendv_fake.call_count);
+    TEST_ASSERT_EQUAL_PTR(datos, tramos[1][1].data);
+    TEST_ASSERT_EQUAL(sizeof(datos), tramos[1][1].size);
+    TEST_ASSERT_EQUAL(0, HAL_I2C_send_fake.call_count);
+}
+
+/**
+ * @brief Test 28: Continuar desde la interrupcion los datos de una pagina dividida.
+ *
+ * Con un maximo de 100 bytes cada pagina se envia en dos transacciones asincronicas: la segunda
+ * empieza desde la interrupcion de fin de la primera, con los datos siguientes del buffer de
+ * transmision.
+ */
+void test_continuar_desde_la_interrupcion_los_datos_de_una_pagina(void) {
+    sh1106_config_t config = {.buffer = buffer_a,
+                              .front = buffer_b,
+                              .width = 128,
+                              .height = 16,
+                              .transport = &sh1106_i2c_gather_transport,
+                              .max_transfer = 100};
+    HAL_I2C_sendv_async_fake.custom_fake = HAL_I2C_sendv_async_iniciar;
+    sh1106_DevCreate(&display_a, &config);
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreenAsync(&display_a, fin_actualizacion));
+    while (hal_callback != NULL) {
+        simular_interrupcion_fin_transmision();
+    }
+    TEST_ASSERT_EQUAL(4, HAL_I2C_sendv_async_fake.call_count);
+    TEST_ASSERT_EQUAL(100 - 7, tramos[0][1].size);
+    TEST_ASSERT_EQUAL_PTR(&buffer_b[100 - 7], tramos[1][1].data);
+    TEST_ASSERT_EQUAL(128 - 93, tramos[1][1].size);
+    TEST_ASSERT_EQUAL(1, tramos[1][0].size);
+    TEST_ASSERT_EQUAL_PTR(&buffer_b[128], tramos[2][1].data);
+    TEST_ASSERT_EQUAL(1, async_llamadas);
+    TEST_ASSERT_EQUAL(SH1106_OK, async_resultado);
+}
+
+/**
+ * @brief Sombra de la DDRAM de las pruebas de comparacion.
+ *
+ */
+uint8_t sombra[SH1106_BUFFER_SIZE(128, 32)];
+
+/**
+ * @brief Borra la pantalla y vuelve a dibujar el patron, como una aplicacion que redibuja todo
+ * en cada cuadro.
+ */
+void redibujar_patron(uint8_t height) {
+    sh1106_DevFill(&display_a, BLACK);
+    for (uint16_t i = 0; i < 128 * height / 8; i++) {
+        buffer_a[i] = i;
+    }
+}
+
+/**
+ * @brief Crea un display de 128 columnas y las paginas indicadas con sombra de la DDRAM, dibuja
+ * un patron distinto en cada columna y lo envia completo.
+ */
+void crear_display_con_sombra(uint8_t height, uint8_t * front) {
+    sh1106_config_t config = {.buffer = buffer_a,
+                              .front = front,
+                              .shadow = sombra,
+                              .width = 128,
+                              .height = height,
+                              .transport = &sh1106_i2c_gather_transport};
+    HAL_I2C_sendv_fake.custom_fake = HAL_I2C_sendv_registrar;
+    HAL_I2C_sendv_async_fake.custom_fake = HAL_I2C_sendv_async_iniciar;
+    sh1106_DevCreate(&display_a, &config);
+    redibujar_patron(height);
+    sh1106_DevUpdateScreen(&display_a);
+    HAL_I2C_sendv_fake.call_count = 0;
+    sh1106_DevResetFlushStats(&display_a);
+}
+
+/**
+ * @brief Test 29: Con sombra de la DDRAM, borrar y redibujar envia solo los tramos que cambiaron.
+ *
+ * Los cambios en la columna 10 y en las columnas 40 y 41 estan separados por mas columnas que el
+ * maximo para unirlos, por lo que viajan en dos transacciones con los datos tomados del buffer.
+ * Redibujar el mismo cuadro no envia nada.
+ */
+void test_con_sombra_solo_se_envian_los_tramos_que_cambiaron(void) {
+    sh1106_flush_stats_t stats;
+    crear_display_con_sombra(8, NULL);
+
+    redibujar_patron(8);
+    buffer_a[10] = 0xAA;
+    buffer_a[40] = 0xBB;
+    buffer_a[41] = 0xCC;
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreen(&display_a));
+    TEST_ASSERT_EQUAL(2, HAL_I2C_sendv_fake.call_count);
+    TEST_ASSERT_EQUAL_PTR(&buffer_a[10], tramos[0][1].data);
+    TEST_ASSERT_EQUAL(1, tramos[0][1].size);
+    TEST_ASSERT_EQUAL_PTR(&buffer_a[40], tramos[1][1].data);
+    TEST_ASSERT_EQUAL(2, tramos[1][1].size);
+    sh1106_DevGetFlushStats(&display_a, &stats);
+    TEST_ASSERT_EQUAL(3 + 1 + 3 + 2, stats.bytes_sent);
+
+    redibujar_patron(8);
+    buffer_a[10] = 0xAA;
+    buffer_a[40] = 0xBB;
+    buffer_a[41] = 0xCC;
+    sh1106_DevUpdateScreen(&display_a);
+    TEST_ASSERT_EQUAL(2, HAL_I2C_sendv_fake.call_count);
+}
+
+/**
+ * @brief Test 30: Unir los tramos separados por pocas columnas sin cambios.
+ *
+ * Con el maximo por defecto, los cambios en las columnas 10 y 15 se envian como un tramo de 6
+ * columnas. Con un maximo de 3 columnas, los cambios en las columnas 20 y 25 viajan separados.
+ */
+void test_unir_los_tramos_separados_por_pocas_columnas(void) {
+    crear_display_con_sombra(8, NULL);
+
+    buffer_a[10] = 0xAA;
+    buffer_a[15] = 0xBB;
+    sh1106_DevInvalidate(&display_a, 0, 0, 128, 8);
+    sh1106_DevUpdateScreen(&display_a);
+    TEST_ASSERT_EQUAL(1, HAL_I2C_sendv_fake.call_count);
+    TEST_ASSERT_EQUAL_PTR(&buffer_a[10], tramos[0][1].data);
+    TEST_ASSERT_EQUAL(6, tramos[0][1].size);
+
+    sh1106_DevSetMergeGap(&display_a, 3);
+    buffer_a[20] = 0xAA;
+    buffer_a[25] = 0xBB;
+    sh1106_DevInvalidate(&display_a, 0, 0, 128, 8);
+    sh1106_DevUpdateScreen(&display_a);
+    TEST_ASSERT_EQUAL(3, HAL_I2C_sendv_fake.call_count);
+    TEST_ASSERT_EQUAL_PTR(&buffer_a[20], tramos[1][1].data);
+    TEST_ASSERT_EQUAL(1, tramos[1][1].size);
+    TEST_ASSERT_EQUAL_PTR(&buffer_a[25], tramos[2][1].data);
+}
+
+/**
+ * @brief Test 31: La actualizacion asincronica con sombra recorta cada pagina a sus cambios.
+ *
+ * La transmision envia un tramo por pagina: los cambios en las columnas 5 y 50 de la primera
+ * pagina viajan juntos, desde el buffer de transmision, y la segunda pagina no se envia.
+ */
+void test_la_actualizacion_asincronica_con_sombra_recorta_las_paginas(void) {
+    crear_display_con_sombra(16, buffer_b);
+    HAL_I2C_sendv_async_fake.call_count = 0;
+
+    redibujar_patron(16);
+    buffer_a[5] = 0xAA;
+    buffer_a[50] = 0xBB;
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreenAsync(&display_a, fin_actualizacion));
+    while (hal_callback != NULL) {
+        simular_interrupcion_fin_transmision();
+    }
+    TEST_ASSERT_EQUAL(1, HAL_I2C_sendv_async_fake.call_count);
+    TEST_ASSERT_EQUAL_PTR(&buffer_b[5], tramos[0][1].data);
+    TEST_ASSERT_EQUAL(46, tramos[0][1].size);
+    TEST_ASSERT_EQUAL(SH1106_OK, async_resultado);
+}
+
+/**
+ * @brief Test 32: El reinicio en caliente reconfigura el controlador en una transaccion, con el
+ * contraste del display, y no vuelve a enviar la pantalla.
+ *
+ * Luego del reset del microcontrolador el display se vuelve a crear sobre el buffer retenido. La
+ * DDRAM conserva lo ultimo enviado, por lo que solo se envian los cambios posteriores.
+ */
+void test_el_reinicio_en_caliente_no_vuelve_a_enviar_la_pantalla(void) {
+    uint8_t final[] = {SET_CONSTRAS, 0x30, SET_START_LINE, DISPLAY_ON};
+    sh1106_config_t config = {
+        .buffer = buffer_a, .width = 128, .height = 32, .transport = &sh1106_i2c_transport};
+    HAL_I2C_send_fake.return_val = 0;
+
+    sh1106_DevCreate(&display_a, &config);
+    sh1106_DevContrasSet(&display_a, 0x30);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevWarmInit(&display_a));
+    TEST_ASSERT_EQUAL(2, HAL_I2C_send_fake.call_count);
+    TEST_ASSERT_EQUAL(CONTROL_CMD_STREAM, HAL_I2C_send_fake.arg1_val[0]);
+    TEST_ASSERT_EQUAL(DISPLAY_OFF, HAL_I2C_send_fake.arg1_val[1]);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(final,
+                                  &HAL_I2C_send_fake.arg1_val[HAL_I2C_send_fake.arg2_val - 4], 4);
+
+    sh1106_DevUpdateScreen(&display_a);
+    TEST_ASSERT_EQUAL(2, HAL_I2C_send_fake.call_count);
+    sh1106_DevDrawPixel(&display_a, 4, 4, WHITE);
+    sh1106_DevUpdateScreen(&display_a);
+    TEST_ASSERT_EQUAL(3, HAL_I2C_send_fake.call_count);
+}
+
+/**
+ * @brief Test 33: Suspender y despertar el display envian una transaccion cada uno.
+ *
+ * Al suspender se apaga el panel y luego el convertidor DC-DC; al despertar, en orden inverso.
+ */
+void test_suspender_y_despertar_el_display(void) {
+    uint8_t suspender[] = {CONTROL_CMD_STREAM, DISPLAY_OFF, SET_DC_DC_CONTROL, DC_DC_DISABLE};
+    uint8_t despertar[] = {CONTROL_CMD_STREAM, SET_DC_DC_CONTROL, DC_DC_ENABLE, DISPLAY_ON};
+    HAL_I2C_send_fake.return_val = 0;
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_Sleep());
+    TEST_ASSERT_EQUAL(sizeof(suspender), HAL_I2C_send_fake.arg2_val);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(suspender, HAL_I2C_send_fake.arg1_val, sizeof(suspender));
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_Wake());
+    TEST_ASSERT_EQUAL(2, HAL_I2C_send_fake.call_count);
+    TEST_ASSERT_EQUAL(sizeof(despertar), HAL_I2C_send_fake.arg2_val);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(despertar, HAL_I2C_send_fake.arg1_val, sizeof(despertar));
+}
+
+/**
+ * @brief Test 34: Despues del reinicio en caliente se envia la pantalla completa si se habia
+ * invalidado.
+ *
+ * Llenar la pantalla la invalida completa; el reinicio en caliente no descarta ese cambio.
+ */
+void test_el_reinicio_en_caliente_conserva_la_pantalla_invalidada(void) {
+    sh1106_config_t config = {
+        .buffer = buffer_a, .width = 128, .height = 32, .transport = &sh1106_i2c_transport};
+    HAL_I2C_send_fake.return_val = 0;
+    sh1106_DevCreate(&display_a, &config);
+    sh1106_DevUpdateScreen(&display_a);
+
+    sh1106_DevFill(&display_a, WHITE);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevWarmInit(&display_a));
+    RESET_FAKE(HAL_I2C_send);
+    sh1106_DevUpdateScreen(&display_a);
+    TEST_ASSERT_EQUAL(4, HAL_I2C_send_fake.call_count);
+    TEST_ASSERT_EQUAL(0xFF, HAL_I2C_send_fake.arg1_val[HAL_I2C_send_fake.arg2_val - 1]);
+}
+
+/**
+ * @brief Test 35: Despues del reinicio en caliente se envia la pantalla completa si fallo la
+ * actualizacion asincronica anterior.
+ *
+ * No se sabe que llego a la DDRAM, por lo que la actualizacion siguiente la envia completa aunque
+ * el reinicio en caliente la tome como intacta.
+ */
+void test_el_reinicio_en_caliente_conserva_la_actualizacion_fallida(void) {
+    sh1106_config_t config = {.buffer = buffer_a,
+                              .front = buffer_b,
+                              .width = 128,
+                              .height = 32,
+                              .transport = &sh1106_i2c_transport};
+    HAL_I2C_send_fake.return_val = 0;
+    sh1106_DevCreate(&display_a, &config);
+    sh1106_DevUpdateScreen(&display_a);
+
+    sh1106_DevDrawPixel(&display_a, 4, 4, WHITE);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreenAsync(&display_a, NULL));
+    hal_callback(hal_context, HAL_ERROR);
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DevAsyncStatus(&display_a));
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevWarmInit(&display_a));
+    RESET_FAKE(HAL_I2C_send);
+    sh1106_DevUpdateScreen(&display_a);
+    TEST_ASSERT_EQUAL(4, HAL_I2C_send_fake.call_count);
+}
@@ -0,0 +1,191 @@
+/**
+ * @file test_sh1106_bitmap.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Pruebas Formales sobre el dibujo de mapas de bits del driver sh1106
+ *
+ * Los mapas de bits se copian al buffer por bytes, por lo que se comparan contra una referencia
+ * que aplica la operacion de raster pixel por pixel con sh1106_DevDrawPixel. El destino tiene un
+ * patron de fondo para que todas las operaciones tengan efecto.
+ *
+ * <b>PRUEBAS REALIZADAS</b>
+ * <ul>
+ *   <li>Test 1: Un mapa de bits alineado a una pagina se copia byte por byte.</li>
+ *   <li>Test 2: Todas las operaciones de raster coinciden con la referencia en "y" no alineado.</li>
+ *   <li>Test 3: Un sprite con mascara solo modifica los pixeles de la mascara.</li>
+ *   <li>Test 4: Un mapa de bits parcialmente fuera de la pantalla se recorta.</li>
+ *   <li>Test 5: Una region de un mapa de bits se recorta contra el mapa y la pantalla.</li>
+ *   <li>Test 6: Una operacion de raster invalida devuelve error.</li>
+ * </ul>
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2024
+ */
+
+#include "unity.h"
+#include "mock_hal_i2c.h"
+#include "sh1106.h"
+#include "sh1106_bitmap.h"
+
+/**
+ * @brief Mapa de bits de 13x11 pixeles (2 paginas), sin simetrias para detectar desplazamientos.
+ *
+ */
+static const uint8_t imagen_datos[] = {
+    0x3C, 0x42, 0x81, 0xA5, 0x81, 0x99, 0x42, 0x3C, 0xFF, 0x00, 0x55, 0xAA, 0x0F,
+    0x01, 0x02, 0x04, 0x07, 0x00, 0x05, 0x03, 0x06, 0x07, 0x01, 0x00, 0x04, 0x02,
+};
+
+/**
+ * @brief Mascara del sprite: un rombo dentro de la caja de 13x11.
+ *
+ */
+static const uint8_t imagen_mascara[] = {
+    0x20, 0x70, 0xF8, 0xFC, 0xFE, 0xFF, 0xFF, 0xFF, 0xFE, 0xFC, 0xF8, 0x70, 0x20,
+    0x00, 0x00, 0x00, 0x01, 0x03, 0x07, 0x07, 0x07, 0x03, 0x01, 0x00, 0x00, 0x00,
+};
+
+static const sh1106_bitmap_t imagen = {.data = imagen_datos, .width = 13, .height = 11};
+
+static const sh1106_bitmap_t sprite = {
+    .data = imagen_datos, .mask = imagen_mascara, .width = 13, .height = 11};
+
+/**
+ * @brief Display sobre el que se dibuja con el blitter.
+ *
+ */
+sh1106_t display;
+
+/**
+ * @brief Display sobre el que se dibuja la referencia pixel por pixel.
+ *
+ */
+sh1106_t referencia;
+
+/**
+ * @brief Buffers de ambos displays.
+ *
+ */
+uint8_t buffer[BUFFER_SIZE], buffer_referencia[BUFFER_SIZE];
+
+/**
+ * @brief Lee un bit de una imagen por paginas.
+ */
+bool bit_imagen(const uint8_t * data, uint8_t width, int16_t x, int16_t y) {
+    return data[(y / 8) * width + x] & (1 << (y % 8));
+}
+
+/**
+ * @brief Dibuja en la referencia una region de un mapa de bits pixel por pixel.
+ */
+void region_referencia(const sh1106_bitmap_t * bitmap, int16_t src_x, int16_t src_y,
+                       int16_t width, int16_t height, int16_t x, int16_t y, sh1106_rop_t rop) {
+    for (int16_t i = 0; i < width; i++) {
+        for (int16_t j = 0; j < height; j++) {
+            int16_t sx = src_x + i, sy = src_y + j, px = x + i, py = y + j;
+            if (sx < 0 || sy < 0 || sx >= bitmap->width || sy >= bitmap->height || px < 0 ||
+                py < 0 || px >= SH1106_WHIDTH || py >= SH1106_HEIGHT) {
+                continue;
+            }
+            if (bitmap->mask != NULL && !bit_imagen(bitmap->mask, bitmap->width, sx, sy)) {
+                continue;
+            }
+            bool s = bit_imagen(bitmap->data, bitmap->width, sx, sy);
+            bool d = bit_imagen(buffer_referencia, SH1106_WHIDTH, px, py);
+            bool resultado[] = {s, d || s, d && s, d != s, d && !s};
+            sh1106_DevDrawPixel(&referencia, px, py, resultado[rop] ? WHITE : BLACK);
+        }
+    }
+}
+
+/**
+ * @brief Funcion que se ejecuta antes de cada prueba.
+ *
+ */
+void setUp(void) {
+    sh1106_config_t config = {.buffer = buffer,
+                              .width = SH1106_WHIDTH,
+                              .height = SH1106_HEIGHT,
+                              .address = SH1106_I2C_ADDRESS,
+                              .transport = &sh1106_i2c_transport};
+    sh1106_DevCreate(&display, &config);
+    config.buffer = buffer_referencia;
+    sh1106_DevCreate(&referencia, &config);
+    for (uint16_t i = 0; i < BUFFER_SIZE; i++) {
+        buffer[i] = (i & 1) ? 0x5A : 0xC3;
+    }
+    memcpy(buffer_referencia, buffer, sizeof(buffer));
+}
+
+/**
+ * @brief Test 1: Un mapa de bits alineado a una pagina se copia byte por byte.
+ */
+void test_mapa_de_bits_alineado(void) {
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DrawBitmap(&display, &imagen, 30, 16, SH1106_ROP_COPY));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(imagen_datos, &buffer[2 * SH1106_WHIDTH + 30], 13);
+    TEST_ASSERT_EQUAL_HEX8(0x07, buffer[3 * SH1106_WHIDTH + 33] & 0x07);
+    TEST_ASSERT_EQUAL_HEX8(0x58, buffer[3 * SH1106_WHIDTH + 33] & 0xF8);
+}
+
+/**
+ * @brief Test 2: Todas las operaciones de raster coinciden con la referencia en "y" no alineado.
+ *
+ * El mapa de bits de 11 filas empezando en la fila 5 de una pagina ocupa tres paginas destino.
+ */
+void test_operaciones_de_raster(void) {
+    for (sh1106_rop_t rop = SH1106_ROP_COPY; rop <= SH1106_ROP_AND_NOT; rop++) {
+        int16_t x = 3 + rop * 20, y = 5 + rop * 9;
+        TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DrawBitmap(&display, &imagen, x, y, rop));
+        region_referencia(&imagen, 0, 0, imagen.width, imagen.height, x, y, rop);
+    }
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 3: Un sprite con mascara solo modifica los pixeles de la mascara.
+ */
+void test_sprite_con_mascara(void) {
+    sh1106_DrawBitmap(&display, &sprite, 50, 21, SH1106_ROP_COPY);
+    sh1106_DrawBitmap(&display, &sprite, 70, 40, SH1106_ROP_XOR);
+    region_referencia(&sprite, 0, 0, sprite.width, sprite.height, 50, 21, SH1106_ROP_COPY);
+    region_referencia(&sprite, 0, 0, sprite.width, sprite.height, 70, 40, SH1106_ROP_XOR);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 4: Un mapa de bits parcialmente fuera de la pantalla se recorta.
+ *
+ * Tambien se prueba un mapa de bits completamente fuera, que no modifica el buffer.
+ */
+void test_mapa_de_bits_recortado(void) {
+    sh1106_DrawBitmap(&display, &imagen, -6, -3, SH1106_ROP_COPY);
+    sh1106_DrawBitmap(&display, &sprite, 121, 58, SH1106_ROP_OR);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DrawBitmap(&display, &imagen, 10, -11, SH1106_ROP_COPY));
+    region_referencia(&imagen, 0, 0, imagen.width, imagen.height, -6, -3, SH1106_ROP_COPY);
+    region_referencia(&sprite, 0, 0, sprite.width, sprite.height, 121, 58, SH1106_ROP_OR);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 5: Una region de un mapa de bits se recorta contra el mapa y la pantalla.
+ *
+ * La region empieza a mitad de la primera pagina del origen y se dibuja en otra fila de la pagina
+ * destino, por lo que origen y destino tienen desplazamientos distintos.
+ */
+void test_region_de_un_mapa_de_bits(void) {
+    sh1106_DrawBitmapRegion(&display, &imagen, 2, 3, 6, 7, 40, 30, SH1106_ROP_COPY);
+    sh1106_DrawBitmapRegion(&display, &imagen, -2, 6, 40, 40, 90, 10, SH1106_ROP_XOR);
+    sh1106_DrawBitmapRegion(&display, &sprite, 4, 2, 9, 9, -3, 60, SH1106_ROP_AND_NOT);
+    region_referencia(&imagen, 2, 3, 6, 7, 40, 30, SH1106_ROP_COPY);
+    region_referencia(&imagen, -2, 6, 40, 40, 90, 10, SH1106_ROP_XOR);
+    region_referencia(&sprite, 4, 2, 9, 9, -3, 60, SH1106_ROP_AND_NOT);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 6: Una operacion de raster invalida devuelve error.
+ */
+void test_operacion_de_raster_invalida(void) {
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DrawBitmap(&display, &imagen, 0, 0, 7));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
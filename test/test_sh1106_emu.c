@@ -0,0 +1,284 @@
+/**
+ * @file test_sh1106_emu.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Pruebas Formales sobre la imagen que muestra el panel, con el controlador emulado
+ *
+ * Las HAL de I2C y SPI entregan cada transaccion a un controlador emulado (test/support), que
+ * mantiene la DDRAM y su configuracion. Se compara lo que mostraria el panel con el buffer de
+ * dibujo, con otro display actualizado de otra forma o con una imagen de referencia en
+ * test/golden. Cuando la imagen de referencia no coincide, la obtenida se guarda en build/ para
+ * revisarla.
+ *
+ * <b>PRUEBAS REALIZADAS</b>
+ * <ul>
+ *   <li>Test 1: El emulador interpreta comandos sueltos, parametros, datos e inversion.</li>
+ *   <li>Test 2: La inicializacion enciende el panel y lo deja negro.</li>
+ *   <li>Test 3: Una escena de texto y figuras coincide con su imagen de referencia.</li>
+ *   <li>Test 4: La actualizacion parcial muestra lo mismo que la completa, con menos bytes.</li>
+ *   <li>Test 5: Las actualizaciones asincronicas, por SPI y con desplazamiento muestran el
+ * buffer.</li>
+ * </ul>
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2024
+ */
+
+#include "unity.h"
+#include "mock_hal_i2c.h"
+#include "mock_hal_spi.h"
+#include "sh1106.h"
+#include "sh1106_gather.h"
+#include "sh1106_spi.h"
+#include "sh1106_gfx.h"
+#include "sh1106_font.h"
+#include "sh1106_font_5x7.h"
+#include "sh1106_emu.h"
+
+/**
+ * @brief Cuadros de las pruebas aleatorias.
+ */
+#define CUADROS (1000)
+
+/**
+ * @brief Imagen de referencia de la escena y copia de la obtenida cuando no coincide.
+ */
+#define ESCENA_REFERENCIA "test/golden/sh1106_escena.pbm"
+#define ESCENA_OBTENIDA   "build/sh1106_escena.pbm"
+
+/**
+ * @brief Displays de las pruebas, con sus buffers y controladores emulados.
+ */
+sh1106_t display_a, display_b;
+uint8_t buffer_a[BUFFER_SIZE], buffer_b[BUFFER_SIZE], front_a[BUFFER_SIZE];
+sh1106_emu_t emu_a, emu_b;
+
+/**
+ * @brief Imagen de un panel emulado.
+ */
+uint8_t panel[BUFFER_SIZE];
+
+/**
+ * @brief Estado del generador de numeros pseudoaleatorios, para repetir los mismos cuadros.
+ */
+uint32_t semilla;
+
+/**
+ * @brief Numero pseudoaleatorio entre 0 y limite - 1 (xorshift de 32 bits).
+ */
+int16_t aleatorio(int16_t limite) {
+    semilla ^= semilla << 13;
+    semilla ^= semilla >> 17;
+    semilla ^= semilla << 5;
+    return semilla % limite;
+}
+
+/**
+ * @brief Dibuja en el display un cuadro aleatorio: pocos cambios pequenos, como una interfaz.
+ */
+void dibujar_cuadro(sh1106_t * dev) {
+    for (uint8_t i = aleatorio(4); i > 0; i--) {
+        int16_t x = aleatorio(SH1106_WHIDTH), y = aleatorio(SH1106_HEIGHT);
+        sh1106_color_t color = aleatorio(2) ? WHITE : BLACK;
+        switch (aleatorio(3)) {
+        case 0:
+            sh1106_DevDrawPixel(dev, x, y, color);
+            break;
+        case 1:
+            sh1106_FillRect(dev, x, y, 1 + aleatorio(12), 1 + aleatorio(12), color);
+            break;
+        default:
+            sh1106_DrawLine(dev, x, y, x + aleatorio(24) - 12, y + aleatorio(24) - 12, color);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Verifica que el panel emulado muestre el buffer de dibujo.
+ */
+void verificar_panel(const sh1106_emu_t * emu, const uint8_t * buffer) {
+    sh1106_EmuPanel(emu, panel);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(buffer, panel, BUFFER_SIZE);
+}
+
+/**
+ * @brief Crea un display de 128x64 en la direccion indicada, con su controlador emulado, y lo
+ * inicializa.
+ */
+void crear_display(sh1106_t * dev, sh1106_emu_t * emu, uint8_t * buffer, uint8_t * front,
+                   uint8_t address, const sh1106_transport_t * transport) {
+    sh1106_config_t config = {.buffer = buffer,
+                              .front = front,
+                              .width = SH1106_WHIDTH,
+                              .height = SH1106_HEIGHT,
+                              .column_offset = 2,
+                              .address = address,
+                              .transport = transport};
+    sh1106_EmuInit(emu, address, SH1106_WHIDTH, SH1106_HEIGHT, 2);
+    sh1106_EmuAttach(emu);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevCreate(dev, &config));
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevInit(dev));
+}
+
+/**
+ * @brief Funcion que se ejecuta antes de cada prueba. Conecta las HAL al emulador.
+ *
+ */
+void setUp(void) {
+    sh1106_EmuDetachAll();
+    HAL_I2C_send_fake.custom_fake = sh1106_EmuI2cSend;
+    HAL_I2C_sendv_fake.custom_fake = sh1106_EmuI2cSendv;
+    HAL_I2C_send_async_fake.custom_fake = sh1106_EmuI2cSendAsync;
+    HAL_I2C_sendv_async_fake.custom_fake = sh1106_EmuI2cSendvAsync;
+    HAL_SPI_select_fake.custom_fake = sh1106_EmuSpiSelect;
+    HAL_SPI_set_dc_fake.custom_fake = sh1106_EmuSpiSetDc;
+    HAL_SPI_write_fake.custom_fake = sh1106_EmuSpiWrite;
+    HAL_SPI_write_async_fake.custom_fake = sh1106_EmuSpiWriteAsync;
+    semilla = 0x1106;
+}
+
+/**
+ * @brief Test 1: El emulador interpreta comandos sueltos, parametros, datos e inversion.
+ *
+ * El multiplex se configura con un comando suelto (Co=1) y su parametro en otra transaccion. Los
+ * datos escritos despues de la columna 131 se descartan como error.
+ */
+void test_el_emulador_interpreta_los_comandos(void) {
+    uint8_t multiplex[] = {CONTROL_CMD_SINGLE, MUX_RATIO_CONFIG};
+    uint8_t parametro[] = {CONTROL_CMD_SINGLE, 0x1F, CONTROL_CMD_SINGLE, DISPLAY_ON,
+                           CONTROL_CMD_STREAM, COM_OUT_SCAN_INVER, FIRT_PAGE_ADD | 1, 0x03, 0x18};
+    uint8_t datos[] = {CONTROL_DATA_STREAM, 0x01, 0x80, 0xFF, 0xFF};
+    sh1106_emu_t emu;
+
+    sh1106_EmuInit(&emu, SH1106_I2C_ADDRESS, 128, 32, 2);
+    sh1106_EmuAttach(&emu);
+    TEST_ASSERT_EQUAL(HAL_OK, sh1106_EmuI2cSend(SH1106_I2C_ADDRESS, multiplex, sizeof(multiplex)));
+    TEST_ASSERT_EQUAL(HAL_OK, sh1106_EmuI2cSend(SH1106_I2C_ADDRESS, parametro, sizeof(parametro)));
+    TEST_ASSERT_EQUAL(HAL_OK, sh1106_EmuI2cSend(SH1106_I2C_ADDRESS, datos, sizeof(datos)));
+    TEST_ASSERT_EQUAL(HAL_ERROR, sh1106_EmuI2cSend(0x3D, datos, sizeof(datos)));
+
+    TEST_ASSERT_EQUAL(0x1F, emu.multiplex);
+    TEST_ASSERT_EQUAL(0x01, emu.ddram[1][131]);
+    TEST_ASSERT_TRUE(sh1106_EmuPixel(&emu, 129, 8));
+    TEST_ASSERT_FALSE(sh1106_EmuPixel(&emu, 129, 9));
+    TEST_ASSERT_EQUAL(3, emu.stats.transactions);
+    TEST_ASSERT_EQUAL(sizeof(multiplex) + sizeof(parametro) + sizeof(datos), emu.stats.bus_bytes);
+    TEST_ASSERT_EQUAL(1, emu.stats.data_bytes);
+    TEST_ASSERT_EQUAL(3, emu.stats.errors);
+
+    sh1106_EmuCommand(&emu, DISPLAY_INVERTED);
+    TEST_ASSERT_FALSE(sh1106_EmuPixel(&emu, 129, 8));
+    TEST_ASSERT_TRUE(sh1106_EmuPixel(&emu, 129, 9));
+    sh1106_EmuCommand(&emu, DISPLAY_OFF);
+    TEST_ASSERT_FALSE(sh1106_EmuPixel(&emu, 129, 9));
+}
+
+/**
+ * @brief Test 2: La inicializacion enciende el panel y lo deja negro.
+ *
+ * El emulador arranca con la DDRAM llena de un patron, que la inicializacion debe borrar.
+ */
+void test_la_inicializacion_deja_el_panel_negro(void) {
+    crear_display(&display_a, &emu_a, buffer_a, NULL, SH1106_I2C_ADDRESS, &sh1106_i2c_transport);
+
+    TEST_ASSERT_TRUE(emu_a.display_on);
+    TEST_ASSERT_EQUAL(SH1106_HEIGHT - 1, emu_a.multiplex);
+    TEST_ASSERT_EQUAL(0, emu_a.stats.errors);
+    TEST_ASSERT_EACH_EQUAL_HEX8(0x00, buffer_a, BUFFER_SIZE);
+    verificar_panel(&emu_a, buffer_a);
+}
+
+/**
+ * @brief Test 3: Una escena de texto y figuras coincide con su imagen de referencia.
+ */
+void test_la_escena_coincide_con_la_referencia(void) {
+    crear_display(&display_a, &emu_a, buffer_a, NULL, SH1106_I2C_ADDRESS,
+                  &sh1106_i2c_gather_transport);
+
+    sh1106_DrawRect(&display_a, 0, 0, SH1106_WHIDTH, SH1106_HEIGHT, WHITE);
+    sh1106_DrawString(&display_a, &sh1106_font_5x7, 4, 4, "SH1106 EMU", WHITE);
+    sh1106_DrawLine(&display_a, 4, 14, 123, 14, WHITE);
+    sh1106_DrawCircle(&display_a, 24, 38, 16, WHITE);
+    sh1106_FillCircle(&display_a, 24, 38, 8, WHITE);
+    sh1106_FillRect(&display_a, 52, 24, 30, 30, WHITE);
+    sh1106_FillRect(&display_a, 58, 30, 18, 18, BLACK);
+    sh1106_DrawLine(&display_a, 90, 56, 122, 20, WHITE);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreen(&display_a));
+
+    verificar_panel(&emu_a, buffer_a);
+    int32_t diferencias = sh1106_EmuComparePbm(&emu_a, ESCENA_REFERENCIA);
+    if (diferencias != 0) {
+        sh1106_EmuWritePbm(&emu_a, ESCENA_OBTENIDA);
+    }
+    TEST_ASSERT_EQUAL_MESSAGE(0, diferencias, "ver " ESCENA_OBTENIDA);
+}
+
+/**
+ * @brief Test 4: La actualizacion parcial muestra lo mismo que la completa, con menos bytes.
+ *
+ * Los dos displays reciben los mismos cuadros aleatorios. Uno envia solo las regiones
+ * modificadas y el otro la pantalla completa; despues de cada cuadro los dos paneles muestran su
+ * buffer. Como cambia poco por cuadro, la actualizacion parcial envia menos de la decima parte.
+ */
+void test_la_actualizacion_parcial_muestra_lo_mismo_que_la_completa(void) {
+    crear_display(&display_a, &emu_a, buffer_a, NULL, SH1106_I2C_ADDRESS, &sh1106_i2c_transport);
+    crear_display(&display_b, &emu_b, buffer_b, NULL, SH1106_I2C_ADDRESS + 1,
+                  &sh1106_i2c_transport);
+    emu_a.stats = emu_b.stats = (sh1106_emu_stats_t){0};
+
+    for (uint16_t cuadro = 0; cuadro < CUADROS; cuadro++) {
+        uint32_t inicio = semilla;
+        dibujar_cuadro(&display_a);
+        semilla = inicio;
+        dibujar_cuadro(&display_b);
+        TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreen(&display_a));
+        TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreenFull(&display_b));
+
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(buffer_b, buffer_a, BUFFER_SIZE);
+        verificar_panel(&emu_a, buffer_a);
+        verificar_panel(&emu_b, buffer_b);
+    }
+    TEST_ASSERT_EQUAL(0, emu_a.stats.errors + emu_b.stats.errors);
+    TEST_ASSERT_EQUAL(CUADROS * BUFFER_SIZE, emu_b.stats.data_bytes);
+    TEST_ASSERT_LESS_THAN(emu_b.stats.bus_bytes / 10, emu_a.stats.bus_bytes);
+}
+
+/**
+ * @brief Test 5: Las actualizaciones asincronicas, por SPI y con desplazamiento muestran el
+ * buffer.
+ *
+ * Un display I2C se actualiza sin bloqueo, terminando cada transmision como lo haria la
+ * interrupcion, y otro por SPI, que no tiene bytes de control. Cada tanto los dos se desplazan,
+ * lo que mueve la start line en lugar de reenviar la pantalla.
+ */
+void test_asincronica_spi_y_desplazamiento_muestran_el_buffer(void) {
+    crear_display(&display_a, &emu_a, buffer_a, front_a, SH1106_I2C_ADDRESS,
+                  &sh1106_i2c_gather_transport);
+    crear_display(&display_b, &emu_b, buffer_b, NULL, 0, &sh1106_spi_transport);
+    emu_a.stats = emu_b.stats = (sh1106_emu_stats_t){0};
+
+    for (uint16_t cuadro = 0; cuadro < CUADROS; cuadro++) {
+        uint32_t inicio = semilla;
+        dibujar_cuadro(&display_a);
+        semilla = inicio;
+        dibujar_cuadro(&display_b);
+        if (cuadro % 50 == 49) {
+            int8_t paginas = aleatorio(5) - 2;
+            TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevScroll(&display_a, paginas));
+            TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevScroll(&display_b, paginas));
+        }
+        TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreenAsync(&display_a, NULL));
+        sh1106_EmuComplete();
+        TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevAsyncStatus(&display_a));
+        TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreen(&display_b));
+
+        verificar_panel(&emu_a, buffer_a);
+        verificar_panel(&emu_b, buffer_b);
+    }
+    TEST_ASSERT_NOT_EQUAL(0, emu_a.start_line);
+    TEST_ASSERT_EQUAL(emu_a.start_line, emu_b.start_line);
+    TEST_ASSERT_EQUAL(0, emu_a.stats.errors + emu_b.stats.errors);
+    TEST_ASSERT_EQUAL(emu_a.stats.data_bytes, emu_b.stats.data_bytes);
+    TEST_ASSERT_LESS_THAN(emu_a.stats.bus_bytes, emu_b.stats.bus_bytes);
+}
@@ -0,0 +1,194 @@
+/**
+ * @file test_sh1106_font.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Pruebas Formales sobre el dibujo de texto del driver sh1106
+ *
+ * Los glifos se copian al buffer por columnas, por lo que se comparan contra una referencia que
+ * recorre el glifo bit por bit y lo dibuja con sh1106_DevDrawPixel.
+ *
+ * <b>PRUEBAS REALIZADAS</b>
+ * <ul>
+ *   <li>Test 1: Un caracter alineado a una pagina copia las columnas del glifo al buffer.</li>
+ *   <li>Test 2: Un caracter no alineado se reparte entre dos paginas.</li>
+ *   <li>Test 3: El texto en negro solo apaga los pixeles de los glifos.</li>
+ *   <li>Test 4: Los caracteres parcialmente fuera de la pantalla se recortan.</li>
+ *   <li>Test 5: Una fuente proporcional de dos paginas con kerning se mide y dibuja.</li>
+ *   <li>Test 6: Un caracter que no esta en la fuente devuelve error y no avanza el cursor.</li>
+ * </ul>
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2024
+ */
+
+#include "unity.h"
+#include "mock_hal_i2c.h"
+#include "sh1106.h"
+#include "sh1106_font.h"
+#include "sh1106_font_5x7.h"
+
+/**
+ * @brief Glifos 'A', 'B' y 'C' de una fuente proporcional de 10 pixeles de alto.
+ *
+ */
+static const uint8_t prueba_bitmap[] = {
+    0xFE, 0x11, 0xFE, 0x03, 0x00, 0x03, // 'A'
+    0xFF, 0x49, 0x03, 0x02,             // 'B'
+    0x01, 0x02,                         // 'C'
+};
+
+static const sh1106_glyph_t prueba_glyphs[] = {{0, 3, 0, 4}, {6, 2, 1, 4}, {10, 1, -1, 2}};
+
+static const sh1106_kerning_t prueba_kerning[] = {{'A', 'B', -1}, {'B', 'C', 2}};
+
+static const sh1106_font_t prueba = {.bitmap = prueba_bitmap,
+                                     .glyphs = prueba_glyphs,
+                                     .kerning = prueba_kerning,
+                                     .kerning_count = 2,
+                                     .first = 'A',
+                                     .last = 'C',
+                                     .height = 10,
+                                     .spacing = 1};
+
+/**
+ * @brief Display sobre el que se dibuja el texto.
+ *
+ */
+sh1106_t display;
+
+/**
+ * @brief Display sobre el que se dibuja la referencia pixel por pixel.
+ *
+ */
+sh1106_t referencia;
+
+/**
+ * @brief Buffers de ambos displays.
+ *
+ */
+uint8_t buffer[BUFFER_SIZE], buffer_referencia[BUFFER_SIZE];
+
+/**
+ * @brief Dibuja en la referencia un glifo bit por bit, descartando lo que queda fuera de la
+ * pantalla.
+ */
+void glifo_referencia(const uint8_t * data, uint8_t width, uint8_t height, int16_t x, int16_t y,
+                      sh1106_color_t color) {
+    for (int16_t column = 0; column < width; column++) {
+        for (int16_t row = 0; row < height; row++) {
+            int16_t px = x + column, py = y + row;
+            bool set = data[(row / 8) * width + column] & (1 << (row % 8));
+            if (set && px >= 0 && py >= 0 && px < SH1106_WHIDTH && py < SH1106_HEIGHT) {
+                sh1106_DevDrawPixel(&referencia, px, py, color);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Dibuja en la referencia un caracter de la fuente de 5x7.
+ */
+void caracter_referencia(char c, int16_t x, int16_t y, sh1106_color_t color) {
+    glifo_referencia(&sh1106_font_5x7.bitmap[(c - ' ') * 5], 5, 8, x, y, color);
+}
+
+/**
+ * @brief Funcion que se ejecuta antes de cada prueba.
+ *
+ */
+void setUp(void) {
+    sh1106_config_t config = {.buffer = buffer,
+                              .width = SH1106_WHIDTH,
+                              .height = SH1106_HEIGHT,
+                              .address = SH1106_I2C_ADDRESS,
+                              .transport = &sh1106_i2c_transport};
+    sh1106_DevCreate(&display, &config);
+    config.buffer = buffer_referencia;
+    sh1106_DevCreate(&referencia, &config);
+    memset(buffer, 0, sizeof(buffer));
+    memset(buffer_referencia, 0, sizeof(buffer_referencia));
+}
+
+/**
+ * @brief Test 1: Un caracter alineado a una pagina copia las columnas del glifo al buffer.
+ */
+void test_caracter_alineado_a_una_pagina(void) {
+    static const uint8_t letra_a[] = {0x7E, 0x09, 0x09, 0x09, 0x7E};
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DrawChar(&display, &sh1106_font_5x7, 20, 16, 'A', WHITE));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(letra_a, &buffer[2 * SH1106_WHIDTH + 20], sizeof(letra_a));
+    TEST_ASSERT_EQUAL(0, buffer[2 * SH1106_WHIDTH + 25]);
+}
+
+/**
+ * @brief Test 2: Un caracter no alineado se reparte entre dos paginas.
+ */
+void test_caracter_no_alineado(void) {
+    sh1106_DrawString(&display, &sh1106_font_5x7, 3, 13, "Hola!", WHITE);
+    caracter_referencia('H', 3, 13, WHITE);
+    caracter_referencia('o', 9, 13, WHITE);
+    caracter_referencia('l', 15, 13, WHITE);
+    caracter_referencia('a', 21, 13, WHITE);
+    caracter_referencia('!', 27, 13, WHITE);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 3: El texto en negro solo apaga los pixeles de los glifos.
+ */
+void test_texto_negro_sobre_fondo_blanco(void) {
+    sh1106_DevFill(&display, WHITE);
+    sh1106_DevFill(&referencia, WHITE);
+    sh1106_DrawString(&display, &sh1106_font_5x7, 40, 30, "#8", BLACK);
+    caracter_referencia('#', 40, 30, BLACK);
+    caracter_referencia('8', 46, 30, BLACK);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 4: Los caracteres parcialmente fuera de la pantalla se recortan.
+ *
+ * Tambien se prueba un string completamente fuera, que no modifica el buffer.
+ */
+void test_caracteres_recortados(void) {
+    sh1106_DrawString(&display, &sh1106_font_5x7, -8, -3, "WXYZ", WHITE);
+    sh1106_DrawString(&display, &sh1106_font_5x7, 120, 60, "MN", WHITE);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DrawString(&display, &sh1106_font_5x7, 0, 64, "M", WHITE));
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DrawString(&display, &sh1106_font_5x7, 0, -8, "M", WHITE));
+    caracter_referencia('X', -2, -3, WHITE);
+    caracter_referencia('Y', 4, -3, WHITE);
+    caracter_referencia('Z', 10, -3, WHITE);
+    caracter_referencia('M', 120, 60, WHITE);
+    caracter_referencia('N', 126, 60, WHITE);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 5: Una fuente proporcional de dos paginas con kerning se mide y dibuja.
+ *
+ * El avance de cada glifo es su avance mas el espaciado de la fuente. El par "AB" acerca la 'B'
+ * un pixel, el par "BC" aleja la 'C' dos, y la 'B' y la 'C' tienen desplazamientos de +1 y -1.
+ */
+void test_fuente_proporcional_con_kerning(void) {
+    TEST_ASSERT_EQUAL(13, sh1106_MeasureString(&prueba, "ABC"));
+    TEST_ASSERT_EQUAL(4, sh1106_MeasureString(&prueba, "B"));
+
+    sh1106_DrawString(&display, &prueba, 10, 20, "ABC", WHITE);
+    glifo_referencia(&prueba_bitmap[0], 3, 10, 10, 20, WHITE);
+    glifo_referencia(&prueba_bitmap[6], 2, 10, 15, 20, WHITE);
+    glifo_referencia(&prueba_bitmap[10], 1, 10, 20, 20, WHITE);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 6: Un caracter que no esta en la fuente devuelve error y no avanza el cursor.
+ */
+void test_caracter_fuera_de_la_fuente(void) {
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DrawChar(&display, &prueba, 0, 0, 'D', WHITE));
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DrawString(&display, &prueba, 10, 20, "AxBC", WHITE));
+    TEST_ASSERT_EQUAL(13, sh1106_MeasureString(&prueba, "AxBC"));
+    glifo_referencia(&prueba_bitmap[0], 3, 10, 10, 20, WHITE);
+    glifo_referencia(&prueba_bitmap[6], 2, 10, 15, 20, WHITE);
+    glifo_referencia(&prueba_bitmap[10], 1, 10, 20, 20, WHITE);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
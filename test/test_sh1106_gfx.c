@@ -0,0 +1,380 @@
+/**
+ * @file test_sh1106_gfx.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Pruebas Formales sobre las primitivas de dibujo del driver sh1106
+ *
+ * Las primitivas escriben el buffer por paginas completas, por lo que se comparan contra una
+ * referencia dibujada pixel por pixel con sh1106_DevDrawPixel.
+ *
+ * <b>PRUEBAS REALIZADAS</b>
+ * <ul>
+ *   <li>Test 1: Un rectangulo relleno que ocupa varias paginas coincide con la referencia.</li>
+ *   <li>Test 2: Un rectangulo relleno dentro de una pagina coincide con la referencia.</li>
+ *   <li>Test 3: Un rectangulo negro sobre fondo blanco coincide con la referencia.</li>
+ *   <li>Test 4: Un rectangulo parcialmente fuera de la pantalla se recorta.</li>
+ *   <li>Test 5: Las lineas horizontal y vertical coinciden con la referencia.</li>
+ *   <li>Test 6: El contorno de un rectangulo coincide con la referencia.</li>
+ *   <li>Test 7: La actualizacion solo envia las columnas del rectangulo dibujado.</li>
+ *   <li>Test 8: Las lineas oblicuas coinciden con un Bresenham pixel por pixel.</li>
+ *   <li>Test 9: Una linea que sale de la pantalla se recorta sin cambiar su trazado.</li>
+ *   <li>Test 10: La circunferencia coincide con el punto medio pixel por pixel, aun recortada.</li>
+ *   <li>Test 11: El circulo relleno cubre cada columna entre los bordes de la circunferencia.</li>
+ *   <li>Test 12: Un arco de 360 grados es la circunferencia y uno de 90 es un cuadrante.</li>
+ *   <li>Test 13: Un rectangulo con coordenadas extremas se recorta sin salir del buffer.</li>
+ *   <li>Test 14: Las lineas horizontal y vertical mas largas que 32767 pixeles se recortan.</li>
+ *   <li>Test 15: Un circulo relleno que contiene la pantalla la cubre, aun con radio enorme.</li>
+ * </ul>
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2024
+ */
+
+#include <stdlib.h>
+#include "unity.h"
+#include "mock_hal_i2c.h"
+#include "sh1106.h"
+#include "sh1106_gfx.h"
+
+/**
+ * @brief Display sobre el que se dibuja con las primitivas.
+ *
+ */
+sh1106_t display;
+
+/**
+ * @brief Display sobre el que se dibuja la referencia pixel por pixel.
+ *
+ */
+sh1106_t referencia;
+
+/**
+ * @brief Buffers de ambos displays.
+ *
+ */
+uint8_t buffer[BUFFER_SIZE], buffer_referencia[BUFFER_SIZE];
+
+/**
+ * @brief Dibuja en la referencia un rectangulo relleno pixel por pixel, descartando lo que queda
+ * fuera de la pantalla.
+ */
+void rectangulo_referencia(int16_t x, int16_t y, int16_t width, int16_t height,
+                           sh1106_color_t color) {
+    for (int16_t i = x; i < x + width; i++) {
+        for (int16_t j = y; j < y + height; j++) {
+            if (i >= 0 && j >= 0) {
+                sh1106_DevDrawPixel(&referencia, i, j, color);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Dibuja un pixel en la referencia, descartando lo que queda fuera de la pantalla.
+ */
+void pixel_referencia(int16_t x, int16_t y, sh1106_color_t color) {
+    if (x >= 0 && y >= 0 && x < SH1106_WHIDTH && y < SH1106_HEIGHT) {
+        sh1106_DevDrawPixel(&referencia, x, y, color);
+    }
+}
+
+/**
+ * @brief Dibuja en la referencia una linea pixel por pixel. En el paso k se avanzan k pixeles
+ * sobre el eje mayor y round(k * menor / mayor) sobre el menor, redondeando los empates hacia el
+ * segundo extremo.
+ */
+void linea_referencia(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    int32_t dx = abs(x1 - x0), dy = abs(y1 - y0);
+    int32_t major = dx > dy ? dx : dy, minor = dx > dy ? dy : dx;
+
+    for (int32_t k = 0; k <= major; k++) {
+        int32_t m = (2 * k * minor + major) / (2 * major);
+        int32_t x = dx > dy ? k : m, y = dx > dy ? m : k;
+        pixel_referencia(x0 + (x1 > x0 ? x : -x), y0 + (y1 > y0 ? y : -y), WHITE);
+    }
+}
+
+/**
+ * @brief Dibuja en la referencia una circunferencia con el punto medio, pixel por pixel.
+ */
+void circunferencia_referencia(int16_t cx, int16_t cy, int16_t r) {
+    int16_t x = r, y = 0, err = 1 - r;
+
+    while (x >= y) {
+        pixel_referencia(cx + x, cy + y, WHITE);
+        pixel_referencia(cx + y, cy + x, WHITE);
+        pixel_referencia(cx - y, cy + x, WHITE);
+        pixel_referencia(cx - x, cy + y, WHITE);
+        pixel_referencia(cx - x, cy - y, WHITE);
+        pixel_referencia(cx - y, cy - x, WHITE);
+        pixel_referencia(cx + y, cy - x, WHITE);
+        pixel_referencia(cx + x, cy - y, WHITE);
+        y++;
+        if (err < 0) {
+            err += 2 * y + 1;
+        } else {
+            x--;
+            err += 2 * (y - x) + 1;
+        }
+    }
+}
+
+/**
+ * @brief Indica si el pixel (x, y) esta encendido en un buffer.
+ */
+bool pixel_encendido(const uint8_t * data, int16_t x, int16_t y) {
+    return data[x + (y / 8) * SH1106_WHIDTH] & (1 << (y % 8));
+}
+
+/**
+ * @brief Funcion que se ejecuta antes de cada prueba.
+ *
+ */
+void setUp(void) {
+    sh1106_config_t config = {.buffer = buffer,
+                              .width = SH1106_WHIDTH,
+                              .height = SH1106_HEIGHT,
+                              .address = SH1106_I2C_ADDRESS,
+                              .transport = &sh1106_i2c_transport};
+    sh1106_DevCreate(&display, &config);
+    config.buffer = buffer_referencia;
+    sh1106_DevCreate(&referencia, &config);
+    memset(buffer, 0, sizeof(buffer));
+    memset(buffer_referencia, 0, sizeof(buffer_referencia));
+}
+
+/**
+ * @brief Test 1: Un rectangulo relleno que ocupa varias paginas coincide con la referencia.
+ *
+ * El rectangulo empieza y termina a mitad de pagina, por lo que usa las mascaras de la primera y
+ * ultima pagina y escribe completas las paginas intermedias.
+ */
+void test_rectangulo_relleno_de_varias_paginas(void) {
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_FillRect(&display, 10, 5, 100, 40, WHITE));
+    rectangulo_referencia(10, 5, 100, 40, WHITE);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 2: Un rectangulo relleno dentro de una pagina coincide con la referencia.
+ */
+void test_rectangulo_relleno_dentro_de_una_pagina(void) {
+    sh1106_FillRect(&display, 3, 17, 9, 5, WHITE);
+    rectangulo_referencia(3, 17, 9, 5, WHITE);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 3: Un rectangulo negro sobre fondo blanco coincide con la referencia.
+ */
+void test_rectangulo_negro_sobre_fondo_blanco(void) {
+    sh1106_DevFill(&display, WHITE);
+    sh1106_DevFill(&referencia, WHITE);
+    sh1106_FillRect(&display, 0, 7, 128, 18, BLACK);
+    rectangulo_referencia(0, 7, 128, 18, BLACK);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 4: Un rectangulo parcialmente fuera de la pantalla se recorta.
+ *
+ * Tambien se prueba un rectangulo completamente fuera, que no modifica el buffer.
+ */
+void test_rectangulo_parcialmente_fuera_de_la_pantalla(void) {
+    sh1106_FillRect(&display, -20, -3, 30, 12, WHITE);
+    sh1106_FillRect(&display, 120, 60, 50, 50, WHITE);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_FillRect(&display, 200, 0, 10, 10, WHITE));
+    rectangulo_referencia(-20, -3, 30, 12, WHITE);
+    rectangulo_referencia(120, 60, 8, 4, WHITE);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 5: Las lineas horizontal y vertical coinciden con la referencia.
+ */
+void test_lineas_horizontal_y_vertical(void) {
+    sh1106_DrawHLine(&display, 5, 33, 70, WHITE);
+    sh1106_DrawVLine(&display, 90, 3, 50, WHITE);
+    rectangulo_referencia(5, 33, 70, 1, WHITE);
+    rectangulo_referencia(90, 3, 1, 50, WHITE);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 6: El contorno de un rectangulo coincide con la referencia.
+ */
+void test_contorno_de_un_rectangulo(void) {
+    sh1106_DrawRect(&display, 20, 10, 40, 30, WHITE);
+    rectangulo_referencia(20, 10, 40, 1, WHITE);
+    rectangulo_referencia(20, 39, 40, 1, WHITE);
+    rectangulo_referencia(20, 10, 1, 30, WHITE);
+    rectangulo_referencia(59, 10, 1, 30, WHITE);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 7: La actualizacion solo envia las columnas del rectangulo dibujado.
+ *
+ * Un rectangulo de 10 columnas que ocupa las paginas 1 y 2 genera dos transacciones de 10 bytes de
+ * datos cada una (mas los 3 comandos de direccion con sus bytes de control).
+ */
+void test_la_actualizacion_envia_solo_el_rectangulo(void) {
+    HAL_I2C_send_fake.return_val = 0;
+    sh1106_DevUpdateScreen(&display);
+    RESET_FAKE(HAL_I2C_send);
+
+    sh1106_FillRect(&display, 30, 10, 10, 10, WHITE);
+    sh1106_DevUpdateScreen(&display);
+    TEST_ASSERT_EQUAL(2, HAL_I2C_send_fake.call_count);
+    TEST_ASSERT_EQUAL(2 * 3 + 1 + 10, HAL_I2C_send_fake.arg2_val);
+}
+
+/**
+ * @brief Test 8: Las lineas oblicuas coinciden con un Bresenham pixel por pixel.
+ *
+ * Se dibujan lineas en los ocho octantes, de modo que el recorrido cruce paginas hacia arriba y
+ * hacia abajo.
+ */
+void test_lineas_oblicuas(void) {
+    static const int16_t lineas[][4] = {{64, 32, 120, 40}, {64, 32, 70, 63}, {64, 32, 58, 0},
+                                        {64, 32, 3, 20},   {10, 60, 120, 2}, {100, 5, 20, 50},
+                                        {5, 5, 5 + 50, 5 + 50}};
+
+    for (unsigned i = 0; i < sizeof(lineas) / sizeof(lineas[0]); i++) {
+        sh1106_DrawLine(&display, lineas[i][0], lineas[i][1], lineas[i][2], lineas[i][3], WHITE);
+        linea_referencia(lineas[i][0], lineas[i][1], lineas[i][2], lineas[i][3]);
+    }
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 9: Una linea que sale de la pantalla se recorta sin cambiar su trazado.
+ *
+ * El recorte calcula el punto de entrada con aritmetica entera y retoma el Bresenham desde ahi,
+ * por lo que los pixeles visibles son los mismos que si se dibujara la linea completa.
+ */
+void test_linea_recortada(void) {
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DrawLine(&display, -30, -7, 150, 80, WHITE));
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DrawLine(&display, -10, 70, 200, 70, WHITE));
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DrawLine(&display, 140, -5, 100, 30, WHITE));
+    linea_referencia(-30, -7, 150, 80);
+    linea_referencia(140, -5, 100, 30);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 10: La circunferencia coincide con el punto medio pixel por pixel, aun recortada.
+ */
+void test_circunferencia(void) {
+    sh1106_DrawCircle(&display, 64, 32, 20, WHITE);
+    sh1106_DrawCircle(&display, 5, 60, 12, WHITE);
+    sh1106_DrawCircle(&display, 130, 10, 30, WHITE);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DrawCircle(&display, -50, -50, 10, WHITE));
+    circunferencia_referencia(64, 32, 20);
+    circunferencia_referencia(5, 60, 12);
+    circunferencia_referencia(130, 10, 30);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 11: El circulo relleno cubre cada columna entre los bordes de la circunferencia.
+ */
+void test_circulo_relleno(void) {
+    sh1106_FillCircle(&display, 60, 30, 25, WHITE);
+    circunferencia_referencia(60, 30, 25);
+
+    for (int16_t x = 0; x < SH1106_WHIDTH; x++) {
+        int16_t top = -1, bottom = -1;
+        for (int16_t y = 0; y < SH1106_HEIGHT; y++) {
+            if (pixel_encendido(buffer_referencia, x, y)) {
+                top = top < 0 ? y : top;
+                bottom = y;
+            }
+        }
+        if (top >= 0) {
+            rectangulo_referencia(x, top, 1, bottom - top + 1, WHITE);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 12: Un arco de 360 grados es la circunferencia y uno de 90 es un cuadrante.
+ *
+ * El arco de 0 a 90 grados solo contiene pixeles de la circunferencia ubicados arriba a la derecha
+ * del centro, y tiene encendidos los extremos sobre los ejes.
+ */
+void test_arcos(void) {
+    sh1106_DrawArc(&display, 64, 32, 20, 0, 360, WHITE);
+    circunferencia_referencia(64, 32, 20);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+
+    memset(buffer, 0, sizeof(buffer));
+    sh1106_DrawArc(&display, 64, 32, 20, 0, 90, WHITE);
+    for (int16_t x = 0; x < SH1106_WHIDTH; x++) {
+        for (int16_t y = 0; y < SH1106_HEIGHT; y++) {
+            if (pixel_encendido(buffer, x, y)) {
+                TEST_ASSERT_TRUE(pixel_encendido(buffer_referencia, x, y));
+                TEST_ASSERT_TRUE(x >= 64 && y <= 32);
+            }
+        }
+    }
+    TEST_ASSERT_TRUE(pixel_encendido(buffer, 84, 32));
+    TEST_ASSERT_TRUE(pixel_encendido(buffer, 64, 12));
+    TEST_ASSERT_TRUE(pixel_encendido(buffer, 78, 18));
+}
+
+/**
+ * @brief Test 13: Un rectangulo con coordenadas extremas se recorta sin salir del buffer.
+ *
+ * Los bordes finales de estos rectangulos no entran en 16 bits. Los que no tienen area no dibujan
+ * nada y el resto se recorta a la pantalla; la referencia sin tocar muestra que no se escribio
+ * fuera del buffer.
+ */
+void test_rectangulo_con_coordenadas_extremas(void) {
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_FillRect(&display, -30000, 0, -10000, 8, WHITE));
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_FillRect(&display, 10, 10, 20, -32768, WHITE));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_FillRect(&display, 100, 60, 32767, 32767, WHITE));
+    rectangulo_referencia(100, 60, SH1106_WHIDTH - 100, SH1106_HEIGHT - 60, WHITE);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_FillRect(&display, -32768, -32768, 32767, 32767, WHITE));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_FillRect(&display, -30000, -30000, 32767, 32767, WHITE));
+    TEST_ASSERT_EACH_EQUAL_UINT8(0xFF, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 14: Las lineas horizontal y vertical mas largas que 32767 pixeles se recortan.
+ */
+void test_lineas_rectas_mas_largas_que_16_bits(void) {
+    sh1106_DrawLine(&display, -20000, 10, 20000, 10, WHITE);
+    sh1106_DrawLine(&display, 32767, 40, -32768, 40, WHITE);
+    sh1106_DrawLine(&display, 5, 20000, 5, -20000, WHITE);
+    rectangulo_referencia(0, 10, SH1106_WHIDTH, 1, WHITE);
+    rectangulo_referencia(0, 40, SH1106_WHIDTH, 1, WHITE);
+    rectangulo_referencia(5, 0, 1, SH1106_HEIGHT, WHITE);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 15: Un circulo relleno que contiene la pantalla la cubre, aun con radio enorme.
+ *
+ * En ambos casos la circunferencia queda toda fuera de la pantalla. En el segundo, la altura de
+ * las columnas del disco no entra en 16 bits.
+ */
+void test_circulo_relleno_que_contiene_la_pantalla(void) {
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_FillCircle(&display, 64, 32, 100, WHITE));
+    TEST_ASSERT_EACH_EQUAL_UINT8(0xFF, buffer, BUFFER_SIZE);
+
+    memset(buffer, 0, sizeof(buffer));
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_FillCircle(&display, 64, 14000, 17000, WHITE));
+    TEST_ASSERT_EACH_EQUAL_UINT8(0xFF, buffer, BUFFER_SIZE);
+    TEST_ASSERT_EACH_EQUAL_UINT8(0x00, buffer_referencia, BUFFER_SIZE);
+
+    memset(buffer, 0, sizeof(buffer));
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_FillCircle(&display, 64, 200, 100, WHITE));
+    TEST_ASSERT_EACH_EQUAL_UINT8(0x00, buffer, BUFFER_SIZE);
+}
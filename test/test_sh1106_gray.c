@@ -0,0 +1,217 @@
+/**
+ * @file test_sh1106_gray.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Pruebas Formales sobre la escala de grises del driver sh1106
+ *
+ * Las pruebas verifican que cada nivel de gris quede encendido la fraccion de cuadros que le
+ * corresponde, que el contraste siga el peso de cada plano y que cada cuadro envie solo las
+ * columnas que cambiaron respecto del anterior.
+ *
+ * <b>PRUEBAS REALIZADAS</b>
+ * <ul>
+ *   <li>Test 1: Los niveles se guardan bit a bit en los planos, tambien en rectangulos que cruzan
+ * paginas.</li>
+ *   <li>Test 2: En modo PWM cada nivel queda encendido tantos cuadros del ciclo como su valor.</li>
+ *   <li>Test 3: Cada cuadro envia solo las columnas que difieren del anterior.</li>
+ *   <li>Test 4: En modo contraste cada plano se muestra un cuadro con el contraste de su peso.</li>
+ *   <li>Test 5: Con envio asincronico un tick con el cuadro anterior en curso se descarta, y se
+ * informa la frecuencia lograda.</li>
+ *   <li>Test 6: No se crea un display en escala de grises con parametros invalidos.</li>
+ * </ul>
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2024
+ */
+
+#include "unity.h"
+#include "mock_hal_i2c.h"
+#include "sh1106.h"
+#include "sh1106_gray.h"
+
+/**
+ * @brief Display, buffers y display en escala de grises de las pruebas.
+ *
+ */
+sh1106_t display;
+uint8_t buffer[BUFFER_SIZE], front[BUFFER_SIZE];
+uint8_t planos[SH1106_GRAY_BUFFER_SIZE(SH1106_WHIDTH, SH1106_HEIGHT, SH1106_GRAY_MAX_BITS)];
+sh1106_gray_t gris;
+
+/**
+ * @brief Crea el display sobre el que se muestran los cuadros, con la pantalla ya enviada en
+ * negro.
+ *
+ * @param transmision: Buffer de transmision, NULL para actualizar la pantalla sin asincronismo.
+ */
+static void crear_display(uint8_t * transmision) {
+    sh1106_config_t config = {.buffer = buffer,
+                              .front = transmision,
+                              .width = SH1106_WHIDTH,
+                              .height = SH1106_HEIGHT,
+                              .address = SH1106_I2C_ADDRESS,
+                              .transport = &sh1106_i2c_transport};
+    sh1106_DevCreate(&display, &config);
+    memset(buffer, 0, sizeof(buffer));
+    sh1106_DevUpdateScreen(&display);
+    RESET_FAKE(HAL_I2C_send);
+}
+
+/**
+ * @brief Funcion que se ejecuta antes de cada prueba.
+ *
+ */
+void setUp(void) {
+    crear_display(NULL);
+}
+
+/**
+ * @brief Test 1: Los niveles se guardan bit a bit en los planos, tambien en rectangulos que
+ * cruzan paginas.
+ *
+ * El rectangulo de nivel 2 ocupa las filas 5 a 12: solo el plano 1 queda encendido, con las filas
+ * 5 a 7 de la pagina 0 y las 8 a 12 de la pagina 1.
+ */
+void test_los_niveles_se_guardan_bit_a_bit_en_los_planos(void) {
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_GrayCreate(&gris, &display, planos, 2, SH1106_GRAY_PWM));
+
+    sh1106_GrayDrawPixel(&gris, 3, 20, 3);
+    sh1106_GrayDrawPixel(&gris, 4, 20, 1);
+    sh1106_GrayDrawPixel(&gris, 4, 20, 2);
+    TEST_ASSERT_EQUAL(3, sh1106_GrayGetPixel(&gris, 3, 20));
+    TEST_ASSERT_EQUAL(2, sh1106_GrayGetPixel(&gris, 4, 20));
+    TEST_ASSERT_EQUAL(0, sh1106_GrayGetPixel(&gris, SH1106_WHIDTH, 20));
+
+    sh1106_GrayFillRect(&gris, 10, 5, 2, 8, 2);
+    TEST_ASSERT_EQUAL_HEX8(0x00, planos[10]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, planos[SH1106_WHIDTH + 10]);
+    TEST_ASSERT_EQUAL_HEX8(0xE0, planos[BUFFER_SIZE + 10]);
+    TEST_ASSERT_EQUAL_HEX8(0x1F, planos[BUFFER_SIZE + SH1106_WHIDTH + 11]);
+    TEST_ASSERT_EQUAL(2, sh1106_GrayGetPixel(&gris, 11, 12));
+    TEST_ASSERT_EQUAL(0, sh1106_GrayGetPixel(&gris, 11, 13));
+}
+
+/**
+ * @brief Test 2: En modo PWM cada nivel queda encendido tantos cuadros del ciclo como su valor.
+ *
+ * Con 4 bits el ciclo es de 15 cuadros y el pixel de la columna n tiene nivel n. El primer cuadro
+ * muestra el plano mas significativo, y el contraste no cambia.
+ */
+void test_en_modo_pwm_cada_nivel_se_enciende_segun_su_valor(void) {
+    uint8_t encendidos[16] = {0};
+
+    sh1106_GrayCreate(&gris, &display, planos, 4, SH1106_GRAY_PWM);
+    for (uint8_t nivel = 0; nivel < 16; nivel++) {
+        sh1106_GrayDrawPixel(&gris, nivel, 0, nivel);
+    }
+
+    for (uint8_t cuadro = 0; cuadro < 15; cuadro++) {
+        TEST_ASSERT_EQUAL(SH1106_OK, sh1106_GrayTick(&gris, 0));
+        if (cuadro == 0) {
+            TEST_ASSERT_EQUAL_HEX8(0x01, buffer[8]);
+            TEST_ASSERT_EQUAL_HEX8(0x00, buffer[7]);
+        }
+        for (uint8_t nivel = 0; nivel < 16; nivel++) {
+            encendidos[nivel] += buffer[nivel] & 0x01;
+        }
+    }
+    for (uint8_t nivel = 0; nivel < 16; nivel++) {
+        TEST_ASSERT_EQUAL(nivel, encendidos[nivel]);
+    }
+    TEST_ASSERT_EQUAL_HEX8(SH1106_CONTRAST, display.contrast);
+}
+
+/**
+ * @brief Test 3: Cada cuadro envia solo las columnas que difieren del anterior.
+ *
+ * La pagina 0 tiene nivel 3 salvo las columnas 10 a 13, de nivel 1. Los cuadros muestran los
+ * planos 1, 0 y 1: el primero envia la pagina completa y los otros dos solo las 4 columnas de
+ * nivel 1, ya que el nivel 3 esta encendido en ambos planos.
+ */
+void test_cada_cuadro_envia_solo_las_columnas_que_cambiaron(void) {
+    sh1106_GrayCreate(&gris, &display, planos, 2, SH1106_GRAY_PWM);
+    sh1106_GrayFillRect(&gris, 0, 0, SH1106_WHIDTH, 8, 3);
+    sh1106_GrayFillRect(&gris, 10, 0, 4, 8, 1);
+
+    sh1106_GrayTick(&gris, 0);
+    TEST_ASSERT_EQUAL(1, HAL_I2C_send_fake.call_count);
+    TEST_ASSERT_EQUAL(2 * 3 + 1 + SH1106_WHIDTH, HAL_I2C_send_fake.arg2_val);
+
+    for (uint8_t cuadro = 2; cuadro <= 3; cuadro++) {
+        sh1106_GrayTick(&gris, 0);
+        TEST_ASSERT_EQUAL(cuadro, HAL_I2C_send_fake.call_count);
+        TEST_ASSERT_EQUAL(2 * 3 + 1 + 4, HAL_I2C_send_fake.arg2_val);
+        TEST_ASSERT_EQUAL_HEX8((cuadro == 2) ? 0xFF : 0x00, buffer[10]);
+    }
+}
+
+/**
+ * @brief Test 4: En modo contraste cada plano se muestra un cuadro con el contraste de su peso.
+ *
+ * Con 2 bits el plano 0 se muestra con la mitad del contraste del plano 1, y el ciclo es de 2
+ * cuadros. El contraste viaja en la misma transaccion que la pagina del cuadro.
+ */
+void test_en_modo_contraste_cada_plano_usa_el_contraste_de_su_peso(void) {
+    sh1106_GrayCreate(&gris, &display, planos, 2, SH1106_GRAY_CONTRAST);
+    sh1106_GraySetContrast(&gris, 0xC0);
+    sh1106_GrayDrawPixel(&gris, 0, 0, 1);
+    sh1106_GrayDrawPixel(&gris, 1, 0, 2);
+
+    uint8_t contraste[] = {0x60, 0xC0, 0x60};
+    for (uint8_t cuadro = 0; cuadro < sizeof(contraste); cuadro++) {
+        uint8_t comandos[] = {CONTROL_CMD_SINGLE, SET_CONSTRAS,  CONTROL_CMD_SINGLE,
+                              contraste[cuadro],  CONTROL_CMD_SINGLE, FIRT_PAGE_ADD};
+        TEST_ASSERT_EQUAL(SH1106_OK, sh1106_GrayTick(&gris, 0));
+        TEST_ASSERT_EQUAL(cuadro + 1, HAL_I2C_send_fake.call_count);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(comandos, HAL_I2C_send_fake.arg1_val, sizeof(comandos));
+        TEST_ASSERT_EQUAL_HEX8(contraste[cuadro], display.contrast);
+        TEST_ASSERT_EQUAL_HEX8((cuadro % 2 == 0) ? 0x01 : 0x00, buffer[0]);
+        TEST_ASSERT_EQUAL_HEX8((cuadro % 2 == 0) ? 0x00 : 0x01, buffer[1]);
+    }
+}
+
+/**
+ * @brief Test 5: Con envio asincronico un tick con el cuadro anterior en curso se descarta, y se
+ * informa la frecuencia lograda.
+ *
+ * Se envian 3 cuadros en 20 ms: 100 Hz de cuadros y, con 3 cuadros por ciclo, 33,333 Hz de ciclos.
+ */
+void test_un_tick_con_el_cuadro_anterior_en_curso_se_descarta(void) {
+    sh1106_gray_stats_t stats;
+
+    crear_display(front);
+    sh1106_GrayCreate(&gris, &display, planos, 2, SH1106_GRAY_PWM);
+    sh1106_GrayFill(&gris, 2);
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_GrayTick(&gris, 0));
+    TEST_ASSERT_EQUAL(SH1106_BUSY, sh1106_GrayTick(&gris, 5000));
+    while (sh1106_DevAsyncStatus(&display) == SH1106_BUSY) {
+        sh1106_TransferDone(&display, SH1106_OK);
+    }
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_GrayTick(&gris, 10000));
+    while (sh1106_DevAsyncStatus(&display) == SH1106_BUSY) {
+        sh1106_TransferDone(&display, SH1106_OK);
+    }
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_GrayTick(&gris, 20000));
+
+    sh1106_GrayGetStats(&gris, &stats);
+    TEST_ASSERT_EQUAL(3, stats.frames);
+    TEST_ASSERT_EQUAL(1, stats.skipped);
+    TEST_ASSERT_EQUAL(1, stats.cycles);
+    TEST_ASSERT_EQUAL(100000, stats.frame_rate_mhz);
+    TEST_ASSERT_EQUAL(33333, stats.cycle_rate_mhz);
+
+    sh1106_GrayResetStats(&gris);
+    sh1106_GrayGetStats(&gris, &stats);
+    TEST_ASSERT_EQUAL(0, stats.frames);
+    TEST_ASSERT_EQUAL(0, stats.frame_rate_mhz);
+}
+
+/**
+ * @brief Test 6: No se crea un display en escala de grises con parametros invalidos.
+ */
+void test_no_se_crea_con_parametros_invalidos(void) {
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_GrayCreate(&gris, &display, NULL, 2, SH1106_GRAY_PWM));
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_GrayCreate(&gris, &display, planos, 1, SH1106_GRAY_PWM));
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_GrayCreate(&gris, &display, planos, 5, SH1106_GRAY_PWM));
+}
@@ -0,0 +1,228 @@
+/**
+ * @file test_sh1106_image.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Pruebas Formales sobre las imagenes comprimidas del driver sh1106
+ *
+ * Las imagenes de prueba se arman a mano con cada tipo de tramo. Dibujadas en el buffer se
+ * comparan contra el mismo mapa de bits sin comprimir dibujado con sh1106_DrawBitmap; enviadas al
+ * panel se comparan contra las transacciones que recibe la HAL.
+ *
+ * <b>PRUEBAS REALIZADAS</b>
+ * <ul>
+ *   <li>Test 1: Cada tipo de tramo se descomprime en su pagina.</li>
+ *   <li>Test 2: Una imagen en cualquier posicion y con cualquier operacion de raster queda igual
+ * que su mapa de bits sin comprimir.</li>
+ *   <li>Test 3: Enviar una imagen escribe cada pagina en una transaccion sin modificar el
+ * buffer.</li>
+ *   <li>Test 4: Con sombra, la proxima actualizacion reemplaza la imagen solo donde el buffer
+ * cambio.</li>
+ *   <li>Test 5: Una imagen corrupta o que no entra en el panel devuelve error.</li>
+ * </ul>
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2024
+ */
+
+#include "unity.h"
+#include "mock_hal_i2c.h"
+#include "sh1106.h"
+#include "sh1106_bitmap.h"
+#include "sh1106_image.h"
+
+/**
+ * @brief Imagen de 10x13 pixeles (2 paginas) con todos los tipos de tramo. Los COPY de la primera
+ * pagina dejan columnas negras y los de la segunda repiten la primera.
+ */
+static const uint8_t imagen_datos[] = {
+    SH1106_IMAGE_LITERAL | 2, 0x01, 0x02, 0x03, SH1106_IMAGE_REPEAT | 3, 0xF0, SH1106_IMAGE_COPY | 2,
+    SH1106_IMAGE_COPY | 2,    SH1106_IMAGE_LITERAL | 1, 0x0A, 0x15, SH1106_IMAGE_REPEAT | 4, 0x1F,
+};
+static const sh1106_image_t imagen = {
+    .data = imagen_datos, .size = sizeof(imagen_datos), .width = 10, .height = 13};
+
+/**
+ * @brief La misma imagen sin comprimir.
+ */
+static const uint8_t imagen_paginas[] = {
+    0x01, 0x02, 0x03, 0xF0, 0xF0, 0xF0, 0xF0, 0x00, 0x00, 0x00,
+    0x01, 0x02, 0x03, 0x0A, 0x15, 0x1F, 0x1F, 0x1F, 0x1F, 0x1F,
+};
+static const sh1106_bitmap_t imagen_bitmap = {.data = imagen_paginas, .width = 10, .height = 13};
+
+/**
+ * @brief Display sobre el que se dibujan las imagenes y display de referencia para los mapas de
+ * bits.
+ */
+sh1106_t display, referencia;
+uint8_t buffer[BUFFER_SIZE], buffer_referencia[BUFFER_SIZE], sombra[BUFFER_SIZE];
+
+/**
+ * @brief Bytes enviados a la HAL, en orden.
+ */
+uint8_t registro[4 * (2 * 3 + 1 + SH1106_WHIDTH)];
+size_t registro_size;
+
+/**
+ * @brief Reemplazo de HAL_I2C_send, agrega la transaccion al registro.
+ */
+status_t HAL_I2C_send_registrar(uint8_t address, uint8_t * data, size_t size) {
+    TEST_ASSERT_TRUE(registro_size + size <= sizeof(registro));
+    memcpy(&registro[registro_size], data, size);
+    registro_size += size;
+    return HAL_OK;
+}
+
+/**
+ * @brief Crea el display, con la pantalla ya enviada con un patron de fondo.
+ *
+ * @param shadow: Sombra de la DDRAM, o NULL.
+ */
+static void crear_display(uint8_t * shadow) {
+    sh1106_config_t config = {.buffer = buffer,
+                              .shadow = shadow,
+                              .width = SH1106_WHIDTH,
+                              .height = SH1106_HEIGHT,
+                              .address = SH1106_I2C_ADDRESS,
+                              .transport = &sh1106_i2c_transport};
+    RESET_FAKE(HAL_I2C_send);
+    sh1106_DevCreate(&display, &config);
+    for (uint16_t i = 0; i < BUFFER_SIZE; i++) {
+        buffer[i] = (uint8_t)(i * 37 + 11);
+    }
+    sh1106_DevUpdateScreen(&display);
+    RESET_FAKE(HAL_I2C_send);
+    HAL_I2C_send_fake.custom_fake = HAL_I2C_send_registrar;
+    registro_size = 0;
+}
+
+/**
+ * @brief Funcion que se ejecuta antes de cada prueba.
+ *
+ */
+void setUp(void) {
+    crear_display(NULL);
+}
+
+/**
+ * @brief Test 1: Cada tipo de tramo se descomprime en su pagina.
+ */
+void test_cada_tipo_de_tramo_se_descomprime_en_su_pagina(void) {
+    memset(buffer, 0, BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DrawImage(&display, &imagen, 0, 0, SH1106_ROP_COPY));
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(imagen_paginas, buffer, 10);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(imagen_paginas + 10, &buffer[SH1106_WHIDTH], 10);
+    TEST_ASSERT_EQUAL(10, display.dirty_end[0]);
+    TEST_ASSERT_EQUAL(10, display.dirty_end[1]);
+    TEST_ASSERT_EQUAL(0, display.dirty_end[2]);
+}
+
+/**
+ * @brief Test 2: Una imagen en cualquier posicion y con cualquier operacion de raster queda igual
+ * que su mapa de bits sin comprimir.
+ *
+ * Las posiciones incluyen filas no alineadas a una pagina y recortes por los cuatro bordes.
+ */
+void test_una_imagen_queda_igual_que_su_mapa_de_bits(void) {
+    int16_t posiciones[][2] = {{0, 0}, {5, 3}, {-4, 20}, {123, 58}, {60, -7}, {30, 63}};
+    sh1106_config_t config = {.buffer = buffer_referencia,
+                              .width = SH1106_WHIDTH,
+                              .height = SH1106_HEIGHT,
+                              .transport = &sh1106_i2c_transport};
+    sh1106_DevCreate(&referencia, &config);
+
+    for (uint8_t i = 0; i < sizeof(posiciones) / sizeof(posiciones[0]); i++) {
+        for (sh1106_rop_t rop = SH1106_ROP_COPY; rop <= SH1106_ROP_AND_NOT; rop++) {
+            memcpy(buffer_referencia, buffer, BUFFER_SIZE);
+            sh1106_DrawBitmap(&referencia, &imagen_bitmap, posiciones[i][0], posiciones[i][1], rop);
+            TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DrawImage(&display, &imagen, posiciones[i][0],
+                                                          posiciones[i][1], rop));
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+        }
+    }
+}
+
+/**
+ * @brief Test 3: Enviar una imagen escribe cada pagina en una transaccion sin modificar el buffer.
+ *
+ * La imagen va a la columna 100 de la pagina 6: cada transaccion lleva los 3 comandos de direccion
+ * y las 10 columnas de la pagina, la ultima completa aunque la imagen tenga 13 filas. La proxima
+ * actualizacion no envia nada.
+ */
+void test_enviar_una_imagen_no_modifica_el_buffer(void) {
+    uint8_t copia[BUFFER_SIZE];
+    uint8_t esperado[2][2 * 3 + 1] = {
+        {CONTROL_CMD_SINGLE, FIRT_PAGE_ADD + 6, CONTROL_CMD_SINGLE, FIRT_COLUM_ADD_L | 4,
+         CONTROL_CMD_SINGLE, FIRT_COLUM_ADD_H | 6, CONTROL_DATA_STREAM},
+        {CONTROL_CMD_SINGLE, FIRT_PAGE_ADD + 7, CONTROL_CMD_SINGLE, FIRT_COLUM_ADD_L | 4,
+         CONTROL_CMD_SINGLE, FIRT_COLUM_ADD_H | 6, CONTROL_DATA_STREAM},
+    };
+    memcpy(copia, buffer, BUFFER_SIZE);
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_SendImage(&display, &imagen, 100, 6));
+    TEST_ASSERT_EQUAL(2, HAL_I2C_send_fake.call_count);
+    TEST_ASSERT_EQUAL(2 * (sizeof(esperado[0]) + 10), registro_size);
+    for (uint8_t page = 0; page < 2; page++) {
+        const uint8_t * transaccion = &registro[page * (sizeof(esperado[0]) + 10)];
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(esperado[page], transaccion, sizeof(esperado[0]));
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(&imagen_paginas[10 * page], transaccion + 7, 10);
+    }
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(copia, buffer, BUFFER_SIZE);
+    sh1106_DevUpdateScreen(&display);
+    TEST_ASSERT_EQUAL(2, HAL_I2C_send_fake.call_count);
+}
+
+/**
+ * @brief Test 4: Con sombra, la proxima actualizacion reemplaza la imagen solo donde el buffer
+ * cambio.
+ *
+ * La imagen tapa las columnas 0 a 9 de las paginas 0 y 1, y las columnas 3 a 6 de la pagina 0
+ * coinciden con el buffer. Al invalidar la pagina 0 completa solo se envian las columnas 0 a 2 y 7
+ * a 9; la pagina 1 sigue mostrando la imagen.
+ */
+void test_con_sombra_se_reemplaza_solo_lo_que_cambio(void) {
+    crear_display(sombra);
+    sh1106_DevSetMergeGap(&display, 1);
+    buffer[3] = 0xF0; // coincide con la imagen
+    buffer[4] = 0xF0;
+    buffer[5] = 0xF0;
+    buffer[6] = 0xF0;
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_SendImage(&display, &imagen, 0, 0));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(imagen_paginas, sombra, 10);
+
+    registro_size = 0;
+    sh1106_DevInvalidate(&display, 0, 0, SH1106_WHIDTH, 8);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreen(&display));
+    TEST_ASSERT_EQUAL(2 + 2, HAL_I2C_send_fake.call_count);
+    TEST_ASSERT_EQUAL(2 * (2 * 3 + 1) + 3 + 3, registro_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer, sombra, SH1106_WHIDTH);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&imagen_paginas[10], &sombra[SH1106_WHIDTH], 10);
+}
+
+/**
+ * @brief Test 5: Una imagen corrupta o que no entra en el panel devuelve error.
+ */
+void test_una_imagen_corrupta_o_fuera_del_panel_devuelve_error(void) {
+    uint8_t truncada[] = {SH1106_IMAGE_LITERAL | 2, 0x01, 0x02};
+    uint8_t larga[] = {SH1106_IMAGE_REPEAT | 10, 0xFF};
+    uint8_t invalida[] = {0xC0 | 9};
+    const uint8_t * datos[] = {truncada, larga, invalida};
+    uint16_t sizes[] = {sizeof(truncada), sizeof(larga), sizeof(invalida)};
+    sh1106_image_t corrupta = {.width = 10, .height = 8};
+
+    for (uint8_t i = 0; i < 3; i++) {
+        corrupta.data = datos[i];
+        corrupta.size = sizes[i];
+        TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DrawImage(&display, &corrupta, 0, 0, SH1106_ROP_OR));
+        TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_SendImage(&display, &corrupta, 0, 0));
+    }
+    TEST_ASSERT_EQUAL(0, HAL_I2C_send_fake.call_count);
+
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_SendImage(&display, &imagen, SH1106_WHIDTH - 9, 0));
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_SendImage(&display, &imagen, 0, SH1106_PAGES - 1));
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DrawImage(&display, &imagen, 0, 0, 7));
+    TEST_ASSERT_EQUAL(0, HAL_I2C_send_fake.call_count);
+}
@@ -0,0 +1,270 @@
+/**
+ * @file test_sh1106_layer.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Pruebas Formales sobre las capas compuestas del driver sh1106
+ *
+ * El display envia a un controlador emulado (test/support). El resultado de la composicion se
+ * compara con una composicion de referencia, byte a byte, de todas las capas.
+ *
+ * <b>PRUEBAS REALIZADAS</b>
+ * <ul>
+ *   <li>Test 1: Cada modo combina la capa con las de abajo, y la inversion se aplica antes.</li>
+ *   <li>Test 2: Solo se recomponen y se envian las columnas modificadas de alguna capa.</li>
+ *   <li>Test 3: Habilitar, deshabilitar o invertir una capa recompone la pantalla completa.</li>
+ *   <li>Test 4: Con cambios aleatorios en las capas, el panel muestra la composicion de
+ * referencia.</li>
+ *   <li>Test 5: No se crean capas de mas ni con un modo invalido.</li>
+ * </ul>
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2024
+ */
+
+#include "unity.h"
+#include "mock_hal_i2c.h"
+#include "sh1106.h"
+#include "sh1106_gfx.h"
+#include "sh1106_layer.h"
+#include "sh1106_emu.h"
+
+/**
+ * @brief Capas de las pruebas: fondo (OR), valores (XOR) y cursor (OVERWRITE con mascara).
+ */
+#define CAPAS (3)
+
+/**
+ * @brief Display, controlador emulado, compositor y capas de las pruebas.
+ */
+sh1106_t display;
+uint8_t buffer[BUFFER_SIZE];
+sh1106_emu_t emu;
+sh1106_compositor_t compositor;
+sh1106_layer_t capas[CAPAS];
+uint8_t buffers[CAPAS][BUFFER_SIZE];
+uint8_t mascara[BUFFER_SIZE];
+uint8_t referencia[BUFFER_SIZE], panel[BUFFER_SIZE];
+
+/**
+ * @brief Estado del generador de numeros pseudoaleatorios.
+ */
+uint32_t semilla;
+
+/**
+ * @brief Numero pseudoaleatorio entre 0 y limite - 1 (xorshift de 32 bits).
+ */
+int16_t aleatorio(int16_t limite) {
+    semilla ^= semilla << 13;
+    semilla ^= semilla >> 17;
+    semilla ^= semilla << 5;
+    return semilla % limite;
+}
+
+/**
+ * @brief Composicion de referencia, byte a byte y sin regiones modificadas.
+ */
+void componer_referencia(void) {
+    for (uint16_t i = 0; i < BUFFER_SIZE; i++) {
+        uint8_t byte = 0;
+        for (uint8_t c = 0; c < CAPAS; c++) {
+            if (!capas[c].enabled) {
+                continue;
+            }
+            uint8_t capa = capas[c].inverted ? ~buffers[c][i] : buffers[c][i];
+            uint8_t opaco = (capas[c].mask != NULL) ? capas[c].mask[i] : 0xFF;
+            switch (capas[c].blend) {
+            case SH1106_BLEND_OR:
+                byte |= capa;
+                break;
+            case SH1106_BLEND_XOR:
+                byte ^= capa;
+                break;
+            default:
+                byte = (byte & ~opaco) | (capa & opaco);
+                break;
+            }
+        }
+        referencia[i] = byte;
+    }
+}
+
+/**
+ * @brief Compone, envia y verifica que el buffer y el panel muestren la composicion de
+ * referencia.
+ */
+void componer_y_verificar(void) {
+    sh1106_Composite(&compositor);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreen(&display));
+    componer_referencia();
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(referencia, buffer, BUFFER_SIZE);
+    sh1106_EmuPanel(&emu, panel);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(referencia, panel, BUFFER_SIZE);
+}
+
+/**
+ * @brief Funcion que se ejecuta antes de cada prueba. Crea el display sobre el controlador
+ * emulado, el compositor y las tres capas, con una mascara que cubre las filas 8 a 15 del cursor.
+ *
+ */
+void setUp(void) {
+    sh1106_config_t config = {.buffer = buffer,
+                              .width = SH1106_WHIDTH,
+                              .height = SH1106_HEIGHT,
+                              .address = SH1106_I2C_ADDRESS,
+                              .transport = &sh1106_i2c_transport};
+    sh1106_blend_t modos[CAPAS] = {SH1106_BLEND_OR, SH1106_BLEND_XOR, SH1106_BLEND_OVERWRITE};
+
+    sh1106_EmuDetachAll();
+    sh1106_EmuInit(&emu, SH1106_I2C_ADDRESS, SH1106_WHIDTH, SH1106_HEIGHT, 0);
+    sh1106_EmuAttach(&emu);
+    HAL_I2C_send_fake.custom_fake = sh1106_EmuI2cSend;
+    sh1106_DevCreate(&display, &config);
+    sh1106_DevInit(&display);
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_CompositorCreate(&compositor, &display));
+    for (uint8_t c = 0; c < CAPAS; c++) {
+        TEST_ASSERT_EQUAL(SH1106_OK,
+                          sh1106_LayerCreate(&compositor, &capas[c], buffers[c], modos[c]));
+    }
+    memset(mascara, 0, sizeof(mascara));
+    memset(&mascara[SH1106_WHIDTH], 0xFF, SH1106_WHIDTH);
+    TEST_ASSERT_EQUAL(SH1106_OK,
+                      sh1106_LayerSetBlend(&capas[2], SH1106_BLEND_OVERWRITE, mascara));
+    semilla = 0x1106;
+}
+
+/**
+ * @brief Test 1: Cada modo combina la capa con las de abajo, y la inversion se aplica antes.
+ *
+ * El fondo enciende las filas 0 a 15 de las columnas 0 a 19. Los valores invierten las columnas
+ * 10 a 29 de las mismas filas. El cursor, invertido y con la mascara de la pagina 1, deja
+ * encendida esa pagina en las columnas sin dibujar y apagada en la columna 5, donde tiene un
+ * pixel.
+ */
+void test_cada_modo_combina_la_capa(void) {
+    sh1106_FillRect(&capas[0].canvas, 0, 0, 20, 16, WHITE);
+    sh1106_FillRect(&capas[1].canvas, 10, 0, 20, 16, WHITE);
+    sh1106_DevDrawPixel(&capas[2].canvas, 5, 8, WHITE);
+    sh1106_DevDrawPixel(&capas[2].canvas, 6, 0, WHITE);
+    sh1106_LayerSetInverted(&capas[2], true);
+    componer_y_verificar();
+
+    TEST_ASSERT_EQUAL_HEX8(0xFF, buffer[5]);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, buffer[6]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, buffer[15]);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, buffer[25]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, buffer[30]);
+    TEST_ASSERT_EQUAL_HEX8(0xFE, buffer[SH1106_WHIDTH + 5]);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, buffer[SH1106_WHIDTH + 60]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, buffer[2 * SH1106_WHIDTH]);
+}
+
+/**
+ * @brief Test 2: Solo se recomponen y se envian las columnas modificadas de alguna capa.
+ *
+ * Despues de la primera composicion, un numero nuevo en la capa de valores (3 columnas) solo
+ * recompone esas columnas, aunque el fondo tenga una grilla. Redibujar el mismo numero recompone
+ * las columnas pero no envia nada.
+ */
+void test_solo_se_recomponen_las_columnas_modificadas(void) {
+    for (uint8_t x = 0; x < SH1106_WHIDTH; x += 16) {
+        sh1106_DrawVLine(&capas[0].canvas, x, 0, SH1106_HEIGHT, WHITE);
+    }
+    TEST_ASSERT_EQUAL(SH1106_PAGES * SH1106_WHIDTH, sh1106_Composite(&compositor));
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreen(&display));
+
+    emu.stats = (sh1106_emu_stats_t){0};
+    sh1106_FillRect(&capas[1].canvas, 40, 17, 3, 5, WHITE);
+    TEST_ASSERT_EQUAL(3, sh1106_Composite(&compositor));
+    TEST_ASSERT_EQUAL(0, sh1106_Composite(&compositor));
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreen(&display));
+    TEST_ASSERT_EQUAL(3, emu.stats.data_bytes);
+
+    sh1106_FillRect(&capas[1].canvas, 40, 17, 3, 5, BLACK);
+    sh1106_FillRect(&capas[1].canvas, 40, 17, 3, 5, WHITE);
+    TEST_ASSERT_EQUAL(3, sh1106_Composite(&compositor));
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreen(&display));
+    TEST_ASSERT_EQUAL(3, emu.stats.data_bytes);
+    componer_referencia();
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 3: Habilitar, deshabilitar o invertir una capa recompone la pantalla completa.
+ *
+ * Volver al estado anterior muestra exactamente lo mismo que antes.
+ */
+void test_habilitar_o_invertir_recompone_la_pantalla(void) {
+    sh1106_FillRect(&capas[0].canvas, 0, 0, 64, 64, WHITE);
+    sh1106_FillCircle(&capas[1].canvas, 64, 32, 20, WHITE);
+    componer_y_verificar();
+    uint8_t antes[BUFFER_SIZE];
+    memcpy(antes, buffer, BUFFER_SIZE);
+
+    sh1106_LayerSetEnabled(&capas[1], false);
+    TEST_ASSERT_EQUAL(SH1106_PAGES * SH1106_WHIDTH, sh1106_Composite(&compositor));
+    componer_y_verificar();
+    sh1106_LayerSetInverted(&capas[0], true);
+    componer_y_verificar();
+    sh1106_LayerSetEnabled(&capas[1], true);
+    sh1106_LayerSetInverted(&capas[0], false);
+    componer_y_verificar();
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(antes, buffer, BUFFER_SIZE);
+
+    sh1106_LayerSetEnabled(&capas[1], true);
+    TEST_ASSERT_EQUAL(0, sh1106_Composite(&compositor));
+}
+
+/**
+ * @brief Test 4: Con cambios aleatorios en las capas, el panel muestra la composicion de
+ * referencia.
+ *
+ * En cada cuadro se dibujan rectangulos y lineas en capas al azar y cada tanto se habilita,
+ * deshabilita o invierte alguna. Los rectangulos empiezan en cualquier columna, para que las
+ * regiones modificadas no coincidan con las palabras.
+ */
+void test_cambios_aleatorios_muestran_la_referencia(void) {
+    for (uint16_t cuadro = 0; cuadro < 500; cuadro++) {
+        sh1106_t * canvas = &capas[aleatorio(CAPAS)].canvas;
+        int16_t x = aleatorio(SH1106_WHIDTH), y = aleatorio(SH1106_HEIGHT);
+        sh1106_color_t color = aleatorio(2) ? WHITE : BLACK;
+        if (aleatorio(2)) {
+            sh1106_FillRect(canvas, x, y, 1 + aleatorio(30), 1 + aleatorio(20), color);
+        } else {
+            sh1106_DrawLine(canvas, x, y, aleatorio(SH1106_WHIDTH), aleatorio(SH1106_HEIGHT),
+                            color);
+        }
+        if (aleatorio(20) == 0) {
+            sh1106_layer_t * capa = &capas[aleatorio(CAPAS)];
+            if (aleatorio(2)) {
+                sh1106_LayerSetEnabled(capa, !capa->enabled);
+            } else {
+                sh1106_LayerSetInverted(capa, !capa->inverted);
+            }
+        }
+        componer_y_verificar();
+    }
+    TEST_ASSERT_EQUAL(0, emu.stats.errors);
+}
+
+/**
+ * @brief Test 5: No se crean capas de mas ni con un modo invalido.
+ */
+void test_no_se_crean_capas_invalidas(void) {
+    sh1106_layer_t extra[SH1106_LAYER_MAX];
+    uint8_t extra_buffer[SH1106_LAYER_MAX][BUFFER_SIZE];
+
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_LayerCreate(&compositor, &extra[0], extra_buffer[0],
+                                                       SH1106_BLEND_OVERWRITE + 1));
+    TEST_ASSERT_EQUAL(SH1106_ERROR,
+                      sh1106_LayerCreate(&compositor, &extra[0], NULL, SH1106_BLEND_OR));
+    TEST_ASSERT_EQUAL(SH1106_ERROR,
+                      sh1106_LayerSetBlend(&capas[0], SH1106_BLEND_OVERWRITE + 1, NULL));
+    for (uint8_t c = CAPAS; c < SH1106_LAYER_MAX; c++) {
+        TEST_ASSERT_EQUAL(SH1106_OK, sh1106_LayerCreate(&compositor, &extra[c], extra_buffer[c],
+                                                        SH1106_BLEND_OR));
+    }
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_LayerCreate(&compositor, &extra[0], extra_buffer[0],
+                                                       SH1106_BLEND_OR));
+    TEST_ASSERT_EQUAL(SH1106_LAYER_MAX, compositor.count);
+}
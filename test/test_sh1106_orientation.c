@@ -0,0 +1,298 @@
+/**
+ * @file test_sh1106_orientation.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Pruebas Formales sobre la orientacion del driver sh1106
+ *
+ * Las transacciones enviadas se interpretan como lo haria el controlador: los comandos de
+ * direccion, de sentido de segmentos y de COM, y los datos que se escriben en la DDRAM. A partir
+ * de la DDRAM se obtiene cada pixel del panel montado y se compara con el pixel del buffer de
+ * dibujo que le corresponde segun la orientacion.
+ *
+ * <b>PRUEBAS REALIZADAS</b>
+ * <ul>
+ *   <li>Test 1: Cada orientacion muestra cada pixel del buffer en su lugar del panel.</li>
+ *   <li>Test 2: La actualizacion asincronica de un display girado envia lo mismo.</li>
+ *   <li>Test 3: Un pixel en un display girado envia un bloque de 8 columnas.</li>
+ *   <li>Test 4: El giro de 180 grados se aplica en el controlador sin reenviar la pantalla.</li>
+ *   <li>Test 5: No se cambian las dimensiones del buffer ni se gira un display con sombra.</li>
+ * </ul>
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2024
+ */
+
+#include <stdio.h>
+#include "unity.h"
+#include "mock_hal_i2c.h"
+#include "sh1106.h"
+#include "sh1106_gather.h"
+
+/**
+ * @brief Panel usado en las pruebas: 128x64 en las columnas 4 a 131 de la DDRAM, para que la
+ * primera columna cambie al invertir los segmentos.
+ */
+#define PANEL_WIDTH  (128)
+#define PANEL_HEIGHT (64)
+#define PANEL_OFFSET (4)
+
+/**
+ * @brief Estado del controlador emulado.
+ *
+ */
+uint8_t ddram[SH1106_MAX_PAGES][SH1106_MAX_WIDTH];
+uint8_t pagina, columna;
+bool segmentos_invertidos, com_normal;
+
+/**
+ * @brief Display, buffers y funcion de fin de la HAL asincronica.
+ *
+ */
+sh1106_t display;
+uint8_t buffer[BUFFER_SIZE], front[BUFFER_SIZE];
+hal_i2c_callback_t hal_callback;
+void * hal_context;
+
+/**
+ * @brief Ejecuta un comando en el controlador emulado.
+ */
+void ejecutar_comando(uint8_t cmd) {
+    if (cmd <= 0x0F) {
+        columna = (columna & 0xF0) | cmd;
+    } else if (cmd <= 0x1F) {
+        columna = (columna & 0x0F) | ((cmd & 0x0F) << 4);
+    } else if ((cmd & 0xF8) == FIRT_PAGE_ADD) {
+        pagina = cmd & 0x07;
+    } else if (cmd == RE_MAP_SEG_NORMAL || cmd == RE_MAP_SEG_INVERT) {
+        segmentos_invertidos = (cmd == RE_MAP_SEG_INVERT);
+    } else if (cmd == COM_OUT_SCAN_NORMA || cmd == COM_OUT_SCAN_INVER) {
+        com_normal = (cmd == COM_OUT_SCAN_NORMA);
+    }
+}
+
+/**
+ * @brief Interpreta una transaccion I2C: pares (control, byte) con Co=1, o un byte de control con
+ * Co=0 seguido de un stream de comandos o de datos.
+ */
+void interpretar(const uint8_t * bytes, size_t size) {
+    size_t i = 0;
+    while (i < size) {
+        uint8_t control = bytes[i++];
+        bool datos = control & CONTROL_DATA_STREAM;
+        size_t fin = (control & CONTROL_CMD_SINGLE) ? i + 1 : size;
+        for (; i < fin; i++) {
+            if (datos) {
+                ddram[pagina][columna++] = bytes[i];
+            } else {
+                ejecutar_comando(bytes[i]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Reemplazo de HAL_I2C_sendv: junta los tramos y los interpreta.
+ */
+status_t HAL_I2C_sendv_emular(uint8_t address, const hal_iovec_t * iov, uint8_t count) {
+    uint8_t bytes[2 * SH1106_BATCH_SIZE];
+    size_t size = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        memcpy(&bytes[size], iov[i].data, iov[i].size);
+        size += iov[i].size;
+    }
+    interpretar(bytes, size);
+    return HAL_OK;
+}
+
+/**
+ * @brief Reemplazo de HAL_I2C_sendv_async: interpreta la transaccion y guarda la funcion de fin.
+ */
+status_t HAL_I2C_sendv_async_emular(uint8_t address, const hal_iovec_t * iov, uint8_t count,
+                                    hal_i2c_callback_t callback, void * context) {
+    hal_callback = callback;
+    hal_context = context;
+    return HAL_I2C_sendv_emular(address, iov, count);
+}
+
+/**
+ * @brief Pixel del panel montado, segun la DDRAM y el sentido de segmentos y COM.
+ *
+ * Sin orientacion el driver usa segmentos normales y COM invertidos: el pixel (x, y) del panel
+ * es el bit y de la columna x + offset de la DDRAM.
+ */
+bool pixel_panel(uint8_t x, uint8_t y) {
+    uint8_t segmento = x + PANEL_OFFSET;
+    uint8_t col = segmentos_invertidos ? SH1106_MAX_WIDTH - 1 - segmento : segmento;
+    uint8_t fila = com_normal ? PANEL_HEIGHT - 1 - y : y;
+    return ddram[fila / 8][col] & (1 << (fila % 8));
+}
+
+/**
+ * @brief Crea el display con la orientacion indicada y sus comandos de orientacion en el
+ * controlador emulado.
+ */
+sh1106_status_t crear_display(sh1106_orientation_t orientation, uint8_t * buffer_front) {
+    sh1106_config_t config = {.buffer = buffer,
+                              .front = buffer_front,
+                              .width = PANEL_WIDTH,
+                              .height = PANEL_HEIGHT,
+                              .column_offset = PANEL_OFFSET,
+                              .orientation = orientation,
+                              .transport = &sh1106_i2c_gather_transport};
+    sh1106_status_t status = sh1106_DevCreate(&display, &config);
+    if (status == SH1106_OK) {
+        status = sh1106_DevSetOrientation(&display, orientation);
+        HAL_I2C_sendv_fake.call_count = 0;
+    }
+    return status;
+}
+
+/**
+ * @brief Llena el buffer con un patron sin simetrias.
+ */
+void dibujar_patron(void) {
+    for (uint16_t i = 0; i < BUFFER_SIZE; i++) {
+        buffer[i] = (uint8_t)(i * 37 + (i >> 5) * 11 + 5);
+    }
+    sh1106_DevInvalidateAll(&display);
+}
+
+/**
+ * @brief Verifica que cada pixel del buffer se vea en el lugar del panel que indica la
+ * orientacion.
+ */
+void verificar_orientacion(sh1106_orientation_t orientation) {
+    uint8_t width = sh1106_DevWidth(&display), height = sh1106_DevHeight(&display);
+    for (uint8_t y = 0; y < height; y++) {
+        for (uint8_t x = 0; x < width; x++) {
+            uint8_t px[] = {x, width - 1 - x, width - 1 - x, x, height - 1 - y, y};
+            uint8_t py[] = {y, height - 1 - y, y, height - 1 - y, x, width - 1 - x};
+            bool esperado = buffer[(y / 8) * width + x] & (1 << (y % 8));
+            if (pixel_panel(px[orientation], py[orientation]) != esperado) {
+                char mensaje[64];
+                sprintf(mensaje, "orientacion %d, pixel (%d, %d)", orientation, x, y);
+                TEST_FAIL_MESSAGE(mensaje);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Funcion que se ejecuta antes de cada prueba.
+ *
+ */
+void setUp(void) {
+    memset(ddram, 0, sizeof(ddram));
+    pagina = columna = 0;
+    segmentos_invertidos = com_normal = false;
+    HAL_I2C_sendv_fake.custom_fake = HAL_I2C_sendv_emular;
+    HAL_I2C_sendv_async_fake.custom_fake = HAL_I2C_sendv_async_emular;
+    hal_callback = NULL;
+}
+
+/**
+ * @brief Test 1: Cada orientacion muestra cada pixel del buffer en su lugar del panel.
+ *
+ * En los giros de un cuarto de vuelta el buffer de dibujo es de 64x128.
+ */
+void test_cada_orientacion_muestra_cada_pixel_en_su_lugar(void) {
+    for (sh1106_orientation_t o = SH1106_ROTATE_0; o <= SH1106_ROTATE_270; o++) {
+        TEST_ASSERT_EQUAL(SH1106_OK, crear_display(o, NULL));
+        TEST_ASSERT_EQUAL((o >= SH1106_ROTATE_90) ? 64 : 128, sh1106_DevWidth(&display));
+        dibujar_patron();
+        TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreen(&display));
+        verificar_orientacion(o);
+    }
+}
+
+/**
+ * @brief Test 2: La actualizacion asincronica de un display girado envia lo mismo.
+ *
+ * El buffer de transmision se arma girado, con el formato del panel.
+ */
+void test_la_actualizacion_asincronica_de_un_display_girado(void) {
+    TEST_ASSERT_EQUAL(SH1106_OK, crear_display(SH1106_ROTATE_90, front));
+    dibujar_patron();
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreenAsync(&display, NULL));
+    while (hal_callback != NULL) {
+        hal_i2c_callback_t callback = hal_callback;
+        hal_callback = NULL;
+        callback(hal_context, HAL_OK);
+    }
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevAsyncStatus(&display));
+    TEST_ASSERT_EQUAL(PANEL_HEIGHT / 8, HAL_I2C_sendv_async_fake.call_count);
+    verificar_orientacion(SH1106_ROTATE_90);
+}
+
+/**
+ * @brief Test 3: Un pixel en un display girado envia un bloque de 8 columnas.
+ *
+ * El pixel (10, 20) del buffer de 64x128 esta en la pagina 1 del panel, en el bloque de columnas
+ * 104 a 111 (la pagina 2 del buffer ocupa las columnas que terminan en 128 - 16).
+ */
+void test_un_pixel_en_un_display_girado_envia_un_bloque(void) {
+    crear_display(SH1106_ROTATE_90, NULL);
+    sh1106_DevUpdateScreen(&display);
+    HAL_I2C_sendv_fake.call_count = 0;
+
+    sh1106_DevDrawPixel(&display, 10, 20, WHITE);
+    sh1106_DevUpdateScreen(&display);
+    TEST_ASSERT_EQUAL(1, HAL_I2C_sendv_fake.call_count);
+    TEST_ASSERT_EQUAL(8, HAL_I2C_sendv_fake.arg1_val[1].size);
+    TEST_ASSERT_EQUAL(1, pagina);
+    TEST_ASSERT_EQUAL(PANEL_OFFSET + 112, columna);
+    TEST_ASSERT_TRUE(pixel_panel(PANEL_WIDTH - 1 - 20, 10));
+}
+
+/**
+ * @brief Test 4: El giro de 180 grados se aplica en el controlador sin reenviar la pantalla.
+ *
+ * Con un panel centrado en la DDRAM, cambiar la orientacion envia solo los comandos de segmentos
+ * y COM. Con el panel de las pruebas, que cambia de columnas, la pantalla se reenvia.
+ */
+void test_el_giro_de_180_grados_se_aplica_en_el_controlador(void) {
+    uint8_t esperado[] = {CONTROL_CMD_STREAM, RE_MAP_SEG_INVERT, COM_OUT_SCAN_NORMA};
+    sh1106_config_t config = {.buffer = buffer,
+                              .width = 128,
+                              .height = 64,
+                              .column_offset = 2,
+                              .transport = &sh1106_i2c_gather_transport};
+    HAL_I2C_sendv_fake.custom_fake = NULL;
+    HAL_I2C_sendv_fake.return_val = HAL_OK;
+    sh1106_DevCreate(&display, &config);
+    sh1106_DevUpdateScreen(&display);
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevSetOrientation(&display, SH1106_ROTATE_180));
+    TEST_ASSERT_EQUAL(9, HAL_I2C_sendv_fake.call_count);
+    TEST_ASSERT_EQUAL(sizeof(esperado), HAL_I2C_sendv_fake.arg1_val[0].size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(esperado, HAL_I2C_sendv_fake.arg1_val[0].data, sizeof(esperado));
+    TEST_ASSERT_FALSE(display.dirty_all);
+
+    crear_display(SH1106_ROTATE_0, NULL);
+    sh1106_DevUpdateScreen(&display);
+    sh1106_DevSetOrientation(&display, SH1106_MIRROR_X);
+    TEST_ASSERT_TRUE(display.dirty_all);
+}
+
+/**
+ * @brief Test 5: No se cambian las dimensiones del buffer ni se gira un display con sombra.
+ */
+void test_no_se_cambian_las_dimensiones_del_buffer(void) {
+    static uint8_t sombra[BUFFER_SIZE];
+    sh1106_config_t config = {.buffer = buffer,
+                              .shadow = sombra,
+                              .width = 128,
+                              .height = 64,
+                              .orientation = SH1106_ROTATE_270,
+                              .transport = &sh1106_i2c_gather_transport};
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DevCreate(&display, &config));
+
+    crear_display(SH1106_ROTATE_0, NULL);
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DevSetOrientation(&display, SH1106_ROTATE_90));
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DevSetOrientation(&display, SH1106_ROTATE_270 + 1));
+    TEST_ASSERT_EQUAL(0, HAL_I2C_sendv_fake.call_count);
+
+    crear_display(SH1106_ROTATE_90, NULL);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevSetOrientation(&display, SH1106_ROTATE_270));
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DevScroll(&display, 1));
+}
@@ -0,0 +1,123 @@
+/**
+ * @file test_sh1106_panel.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Pruebas Formales sobre los perfiles de panel del driver sh1106
+ *
+ * Este archivo se compila con SH1106_PANEL=SH1106_PANEL_128X32 (ver project.yml), por lo que la
+ * geometria de todos los displays es la del perfil: 128x32 desde la columna 2 de la DDRAM.
+ *
+ * <b>PRUEBAS REALIZADAS</b>
+ * <ul>
+ *   <li>Test 1: El display por defecto toma la geometria del perfil.</li>
+ *   <li>Test 2: La inicializacion envia la relacion de multiplex y los pads COM del perfil.</li>
+ *   <li>Test 3: La actualizacion aplica el offset de columna del perfil.</li>
+ *   <li>Test 4: Solo se pueden crear displays con la geometria del perfil.</li>
+ * </ul>
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2024
+ */
+
+#include "unity.h"
+#include "mock_hal_i2c.h"
+#include "sh1106.h"
+
+/**
+ * @brief Buffer del display por defecto (variable extern).
+ *
+ */
+extern uint8_t SH1106_Buffer[];
+
+/**
+ * @brief Primera transaccion recibida por el reemplazo de HAL_I2C_send.
+ *
+ */
+uint8_t transaccion[SH1106_BATCH_SIZE];
+size_t transaccion_size;
+
+/**
+ * @brief Reemplazo de HAL_I2C_send, guarda la primera transaccion.
+ */
+status_t HAL_I2C_send_registrar(uint8_t address, uint8_t * data, size_t size) {
+    if (HAL_I2C_send_fake.call_count == 1) {
+        memcpy(transaccion, data, size);
+        transaccion_size = size;
+    }
+    return HAL_OK;
+}
+
+/**
+ * @brief Funcion que se ejecuta antes de cada prueba.
+ *
+ */
+void setUp(void) {
+    HAL_I2C_send_fake.custom_fake = HAL_I2C_send_registrar;
+    transaccion_size = 0;
+}
+
+/**
+ * @brief Test 1: El display por defecto toma la geometria del perfil.
+ */
+void test_el_display_por_defecto_toma_la_geometria_del_perfil(void) {
+    TEST_ASSERT_EQUAL(128 * 32 / 8, BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(2, SH1106_COLUMN_OFFSET);
+    TEST_ASSERT_EQUAL(128, sh1106_DevWidth(sh1106_Default()));
+    TEST_ASSERT_EQUAL(4, sh1106_DevPages(sh1106_Default()));
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DrawPixel(127, 31, WHITE));
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DrawPixel(127, 32, WHITE));
+    TEST_ASSERT_EQUAL(0x80, SH1106_Buffer[3 * 128 + 127]);
+}
+
+/**
+ * @brief Test 2: La inicializacion envia la relacion de multiplex y los pads COM del perfil.
+ *
+ * Toda la configuracion viaja en la primera transaccion, como un stream de comandos.
+ */
+void test_la_inicializacion_usa_la_configuracion_del_perfil(void) {
+    static const uint8_t com[] = {MUX_RATIO_CONFIG, 0x1F, PADS_HARD_CONFIG, PADS_HARD_SEQUEN};
+    bool encontrado = false;
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_Init());
+    TEST_ASSERT_EQUAL(CONTROL_CMD_STREAM, transaccion[0]);
+    for (size_t i = 1; i + sizeof(com) <= transaccion_size; i++) {
+        encontrado |= memcmp(&transaccion[i], com, sizeof(com)) == 0;
+    }
+    TEST_ASSERT_TRUE(encontrado);
+}
+
+/**
+ * @brief Test 3: La actualizacion aplica el offset de columna del perfil.
+ *
+ * El pixel de la columna 0 se escribe en la columna 2 de la DDRAM.
+ */
+void test_la_actualizacion_aplica_el_offset_del_perfil(void) {
+    sh1106_UpdateScreenFull();
+    RESET_FAKE(HAL_I2C_send);
+
+    sh1106_DrawPixel(0, 8, WHITE);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_UpdateScreen());
+    TEST_ASSERT_EQUAL(1, HAL_I2C_send_fake.call_count);
+    uint8_t * enviado = HAL_I2C_send_fake.arg1_val;
+    TEST_ASSERT_EQUAL(FIRT_PAGE_ADD + 1, enviado[1]);
+    TEST_ASSERT_EQUAL(FIRT_COLUM_ADD_L | 0x02, enviado[3]);
+    TEST_ASSERT_EQUAL(FIRT_COLUM_ADD_H, enviado[5]);
+}
+
+/**
+ * @brief Test 4: Solo se pueden crear displays con la geometria del perfil.
+ */
+void test_solo_se_crean_displays_con_la_geometria_del_perfil(void) {
+    static uint8_t buffer[BUFFER_SIZE];
+    sh1106_t display;
+    sh1106_config_t config = {.buffer = buffer,
+                              .width = 128,
+                              .height = 64,
+                              .transport = &sh1106_i2c_transport};
+
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DevCreate(&display, &config));
+    config = (sh1106_config_t){.buffer = buffer,
+                               SH1106_PANEL_CONFIG(SH1106_PANEL_128X32),
+                               .transport = &sh1106_i2c_transport};
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevCreate(&display, &config));
+}
@@ -0,0 +1,378 @@
+/**
+ * @file test_sh1106_queue.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Pruebas Formales sobre la cola de envios sin bloqueo del driver sh1106
+ *
+ * El display envia a un controlador emulado (test/support), para verificar que el panel muestre
+ * lo aplicado. Las pruebas de concurrencia usan hilos POSIX: varias productoras entregan cuadros
+ * y comandos mientras la tarea de envio los aplica. Cada cuadro se llena con un patron que
+ * identifica a su productora y su numero, para detectar cuadros mezclados o fuera de orden.
+ *
+ * <b>PRUEBAS REALIZADAS</b>
+ * <ul>
+ *   <li>Test 1: Un cuadro entregado antes del envio reemplaza al anterior, y solo se envian las
+ * columnas que cambiaron.</li>
+ *   <li>Test 2: Los comandos se ejecutan en orden, y con el anillo lleno se rechazan.</li>
+ *   <li>Test 3: Con varias productoras concurrentes no se mezclan cuadros ni se pierden
+ * comandos.</li>
+ *   <li>Test 4: El hilo de envio muestra el ultimo cuadro y ejecuta todos los comandos.</li>
+ * </ul>
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2024
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include "unity.h"
+#include "mock_hal_i2c.h"
+#include "sh1106.h"
+#include "sh1106_queue.h"
+#include "sh1106_flusher.h"
+#include "sh1106_emu.h"
+
+/**
+ * @brief Productoras concurrentes y cuadros que entrega cada una.
+ */
+#define PRODUCTORAS (4)
+#define CUADROS     (5000)
+
+/**
+ * @brief Cuadros de la cola: uno por productora, el ultimo entregado y el que se aplica.
+ */
+#define CUADROS_COLA (PRODUCTORAS + 2)
+
+/**
+ * @brief Lugares del anillo de comandos, pocos para que se llene.
+ */
+#define LUGARES (16)
+
+/**
+ * @brief Display de las pruebas, con su buffer, su controlador emulado y su cola.
+ */
+sh1106_t display;
+uint8_t buffer[BUFFER_SIZE];
+sh1106_emu_t emu;
+sh1106_queue_t cola;
+uint8_t cuadros[CUADROS_COLA][BUFFER_SIZE];
+sh1106_queue_slot_t lugares[LUGARES];
+uint8_t panel[BUFFER_SIZE];
+
+/**
+ * @brief Argumentos de los comandos de prueba.
+ */
+typedef struct {
+    uint8_t productora;
+    uint32_t numero;
+} comando_t;
+
+/**
+ * @brief Proximo comando esperado de cada productora y comandos fuera de orden. Solo los usa la
+ * tarea de envio.
+ */
+uint32_t esperado[PRODUCTORAS];
+uint32_t fuera_de_orden;
+
+/**
+ * @brief Veces que una productora no encontro un cuadro libre.
+ */
+atomic_uint sin_cuadro;
+
+/**
+ * @brief Las productoras terminaron de entregar.
+ */
+atomic_bool terminaron;
+
+/**
+ * @brief Comando de prueba: verifica que llegue en el orden en que lo encolo su productora. No
+ * dibuja, para que el buffer siga mostrando el ultimo cuadro.
+ */
+void contar(sh1106_t * dev, const void * args) {
+    const comando_t * comando = args;
+    if (comando->numero != esperado[comando->productora]) {
+        fuera_de_orden++;
+    }
+    esperado[comando->productora] = comando->numero + 1;
+}
+
+/**
+ * @brief Comando de prueba que dibuja un pixel en la columna indicada.
+ */
+void dibujar(sh1106_t * dev, const void * args) {
+    sh1106_DevDrawPixel(dev, *(const uint8_t *)args, 0, WHITE);
+}
+
+/**
+ * @brief Llena un cuadro con el patron de una productora y un numero de cuadro.
+ */
+void llenar_cuadro(uint8_t * cuadro, uint8_t productora, uint32_t numero) {
+    cuadro[0] = productora;
+    cuadro[1] = numero;
+    cuadro[2] = numero >> 8;
+    for (uint16_t i = 3; i < BUFFER_SIZE; i++) {
+        cuadro[i] = numero * 31 + productora * 7 + i;
+    }
+}
+
+/**
+ * @brief Verifica que el cuadro tenga completo el patron de una productora, y devuelve su
+ * productora y numero.
+ */
+bool leer_cuadro(const uint8_t * cuadro, uint8_t * productora, uint32_t * numero) {
+    *productora = cuadro[0];
+    *numero = cuadro[1] | (cuadro[2] << 8);
+    for (uint16_t i = 3; i < BUFFER_SIZE; i++) {
+        if (cuadro[i] != (uint8_t)(*numero * 31 + *productora * 7 + i)) {
+            return false;
+        }
+    }
+    return *productora < PRODUCTORAS;
+}
+
+/**
+ * @brief Productora: entrega sus cuadros numerados y un comando por cuadro, reintentando si el
+ * anillo esta lleno.
+ */
+void * productora(void * arg) {
+    uint8_t id = (uint8_t)(uintptr_t)arg;
+
+    for (uint32_t numero = 0; numero < CUADROS; numero++) {
+        uint8_t * cuadro = sh1106_QueueAcquire(&cola);
+        if (cuadro == NULL) {
+            atomic_fetch_add(&sin_cuadro, 1);
+        } else {
+            llenar_cuadro(cuadro, id, numero);
+            sh1106_QueueSubmit(&cola, cuadro);
+        }
+        comando_t comando = {.productora = id, .numero = numero};
+        while (sh1106_QueuePost(&cola, contar, &comando, sizeof(comando)) == SH1106_BUSY) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Inicia las productoras.
+ */
+void iniciar_productoras(pthread_t * hilos) {
+    atomic_store(&terminaron, false);
+    for (uintptr_t i = 0; i < PRODUCTORAS; i++) {
+        TEST_ASSERT_EQUAL(0, pthread_create(&hilos[i], NULL, productora, (void *)i));
+    }
+}
+
+/**
+ * @brief Espera a que terminen las productoras.
+ */
+void * esperar_productoras(void * arg) {
+    pthread_t * hilos = arg;
+    for (uint8_t i = 0; i < PRODUCTORAS; i++) {
+        pthread_join(hilos[i], NULL);
+    }
+    atomic_store(&terminaron, true);
+    return NULL;
+}
+
+/**
+ * @brief Crea la cola sobre el display, con el aviso indicado.
+ */
+void crear_cola(sh1106_notify_t notify, void * context) {
+    sh1106_queue_config_t config = {.dev = &display,
+                                    .frames = &cuadros[0][0],
+                                    .frame_count = CUADROS_COLA,
+                                    .slots = lugares,
+                                    .slot_count = LUGARES,
+                                    .notify = notify,
+                                    .context = context};
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_QueueCreate(&cola, &config));
+}
+
+/**
+ * @brief Funcion que se ejecuta antes de cada prueba. Crea el display sobre el controlador
+ * emulado, lo inicializa y crea la cola sin aviso.
+ *
+ */
+void setUp(void) {
+    sh1106_config_t config = {.buffer = buffer,
+                              .width = SH1106_WHIDTH,
+                              .height = SH1106_HEIGHT,
+                              .address = SH1106_I2C_ADDRESS,
+                              .transport = &sh1106_i2c_transport};
+    sh1106_EmuDetachAll();
+    sh1106_EmuInit(&emu, SH1106_I2C_ADDRESS, SH1106_WHIDTH, SH1106_HEIGHT, 0);
+    sh1106_EmuAttach(&emu);
+    HAL_I2C_send_fake.custom_fake = sh1106_EmuI2cSend;
+    sh1106_DevCreate(&display, &config);
+    sh1106_DevInit(&display);
+    emu.stats = (sh1106_emu_stats_t){0};
+
+    crear_cola(NULL, NULL);
+    memset(esperado, 0, sizeof(esperado));
+    fuera_de_orden = 0;
+    atomic_store(&sin_cuadro, 0);
+}
+
+/**
+ * @brief Test 1: Un cuadro entregado antes del envio reemplaza al anterior, y solo se envian las
+ * columnas que cambiaron.
+ *
+ * El segundo cuadro difiere del buffer en las columnas 10 a 19 de la pagina 2, que se envian en
+ * un solo tramo. Mientras una productora tiene todos los cuadros no hay libres.
+ */
+void test_el_ultimo_cuadro_reemplaza_al_anterior(void) {
+    sh1106_queue_stats_t stats;
+    uint8_t * primero = sh1106_QueueAcquire(&cola);
+    uint8_t * segundo = sh1106_QueueAcquire(&cola);
+    memset(primero, 0xFF, BUFFER_SIZE);
+    memset(segundo, 0x00, BUFFER_SIZE);
+    memset(&segundo[2 * SH1106_WHIDTH + 10], 0x3C, 10);
+    sh1106_QueueSubmit(&cola, primero);
+    sh1106_QueueSubmit(&cola, segundo);
+
+    uint8_t * tomados[CUADROS_COLA - 1];
+    for (uint8_t i = 0; i < CUADROS_COLA - 1; i++) {
+        tomados[i] = sh1106_QueueAcquire(&cola);
+        TEST_ASSERT_NOT_NULL(tomados[i]);
+    }
+    TEST_ASSERT_NULL(sh1106_QueueAcquire(&cola));
+    for (uint8_t i = 0; i < CUADROS_COLA - 1; i++) {
+        sh1106_QueueRelease(&cola, tomados[i]);
+    }
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_QueueFlush(&cola));
+    sh1106_EmuPanel(&emu, panel);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(segundo, panel, BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(10, emu.stats.data_bytes);
+    TEST_ASSERT_EQUAL(1, emu.stats.transactions);
+
+    sh1106_QueueGetStats(&cola, &stats);
+    TEST_ASSERT_EQUAL(2, stats.frames);
+    TEST_ASSERT_EQUAL(1, stats.coalesced);
+    TEST_ASSERT_EQUAL(1, stats.flushes);
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_QueueFlush(&cola));
+    TEST_ASSERT_EQUAL(1, emu.stats.transactions);
+}
+
+/**
+ * @brief Test 2: Los comandos se ejecutan en orden, y con el anillo lleno se rechazan.
+ *
+ * Se encolan comandos que dibujan un pixel en columnas sucesivas durante tres vueltas del anillo,
+ * enviando cada vez que se llena.
+ */
+void test_los_comandos_se_ejecutan_en_orden(void) {
+    sh1106_queue_stats_t stats;
+    uint8_t columna = 0;
+
+    for (uint8_t vuelta = 0; vuelta < 3; vuelta++) {
+        for (uint8_t i = 0; i < LUGARES; i++, columna++) {
+            TEST_ASSERT_EQUAL(SH1106_OK, sh1106_QueuePost(&cola, dibujar, &columna, 1));
+        }
+        TEST_ASSERT_EQUAL(SH1106_BUSY, sh1106_QueuePost(&cola, dibujar, &columna, 1));
+        TEST_ASSERT_EQUAL(SH1106_OK, sh1106_QueueFlush(&cola));
+    }
+    TEST_ASSERT_EQUAL(SH1106_ERROR,
+                      sh1106_QueuePost(&cola, dibujar, buffer, SH1106_QUEUE_ARGS_SIZE + 1));
+
+    for (uint8_t x = 0; x < 3 * LUGARES; x++) {
+        TEST_ASSERT_TRUE(sh1106_EmuPixel(&emu, x, 0));
+    }
+    TEST_ASSERT_FALSE(sh1106_EmuPixel(&emu, 3 * LUGARES, 0));
+    sh1106_QueueGetStats(&cola, &stats);
+    TEST_ASSERT_EQUAL(3 * LUGARES, stats.commands);
+    TEST_ASSERT_EQUAL(3, stats.rejected);
+    TEST_ASSERT_EQUAL(3, stats.flushes);
+}
+
+/**
+ * @brief Test 3: Con varias productoras concurrentes no se mezclan cuadros ni se pierden
+ * comandos.
+ *
+ * Esta prueba es la tarea de envio: envia hasta que las productoras terminan y la cola queda
+ * vacia. Despues de cada envio el buffer tiene un cuadro completo, los cuadros de cada productora
+ * aparecen en orden creciente y el panel muestra el buffer. Al final se ejecutaron todos los
+ * comandos, cada uno una vez y en orden, y todos los cuadros estan libres.
+ */
+void test_las_productoras_concurrentes_no_mezclan_cuadros(void) {
+    pthread_t hilos[PRODUCTORAS], espera;
+    int32_t ultimo[PRODUCTORAS] = {-1, -1, -1, -1};
+    uint32_t mezclados = 0, desordenados = 0, envios = 0;
+    sh1106_queue_stats_t stats;
+
+    iniciar_productoras(hilos);
+    TEST_ASSERT_EQUAL(0, pthread_create(&espera, NULL, esperar_productoras, hilos));
+    bool fin = false;
+    while (!fin) {
+        // La ultima vuelta empieza despues de que terminaron, para vaciar la cola.
+        fin = atomic_load(&terminaron);
+        TEST_ASSERT_EQUAL(SH1106_OK, sh1106_QueueFlush(&cola));
+        uint8_t id;
+        uint32_t numero;
+        if (buffer[0] == 0 && buffer[3] == 0) {
+            continue;
+        }
+        if (!leer_cuadro(buffer, &id, &numero)) {
+            mezclados++;
+            continue;
+        }
+        if ((int32_t)numero < ultimo[id]) {
+            desordenados++;
+        }
+        ultimo[id] = numero;
+        if (envios++ % 16 == 0) {
+            sh1106_EmuPanel(&emu, panel);
+            TEST_ASSERT_EQUAL_HEX8_ARRAY(buffer, panel, BUFFER_SIZE);
+        }
+    }
+    pthread_join(espera, NULL);
+
+    TEST_ASSERT_EQUAL(0, mezclados);
+    TEST_ASSERT_EQUAL(0, desordenados);
+    TEST_ASSERT_EQUAL(0, fuera_de_orden);
+    TEST_ASSERT_EQUAL(0, atomic_load(&sin_cuadro));
+    for (uint8_t i = 0; i < PRODUCTORAS; i++) {
+        TEST_ASSERT_EQUAL(CUADROS, esperado[i]);
+    }
+    sh1106_QueueGetStats(&cola, &stats);
+    TEST_ASSERT_EQUAL(PRODUCTORAS * CUADROS, stats.frames);
+    TEST_ASSERT_EQUAL(PRODUCTORAS * CUADROS, stats.commands);
+    TEST_ASSERT_LESS_THAN(stats.frames, stats.coalesced);
+    TEST_ASSERT_EQUAL(0, emu.stats.errors);
+    for (uint8_t i = 0; i < CUADROS_COLA; i++) {
+        TEST_ASSERT_NOT_NULL(sh1106_QueueAcquire(&cola));
+    }
+}
+
+/**
+ * @brief Test 4: El hilo de envio muestra el ultimo cuadro y ejecuta todos los comandos.
+ *
+ * Despues de que terminan las productoras se entrega un cuadro final y se detiene el hilo, que
+ * envia lo pendiente antes de terminar.
+ */
+void test_el_hilo_de_envio_muestra_el_ultimo_cuadro(void) {
+    sh1106_flusher_t flusher;
+    pthread_t hilos[PRODUCTORAS];
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_FlusherInit(&flusher));
+    crear_cola(sh1106_FlusherNotify, &flusher);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_FlusherStart(&flusher, &cola));
+
+    iniciar_productoras(hilos);
+    esperar_productoras(hilos);
+    uint8_t * final = sh1106_QueueAcquire(&cola);
+    TEST_ASSERT_NOT_NULL(final);
+    llenar_cuadro(final, 0, CUADROS);
+    uint8_t esperada[BUFFER_SIZE];
+    memcpy(esperada, final, BUFFER_SIZE);
+    sh1106_QueueSubmit(&cola, final);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_FlusherStop(&flusher));
+
+    sh1106_EmuPanel(&emu, panel);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(esperada, panel, BUFFER_SIZE);
+    TEST_ASSERT_EQUAL(0, fuera_de_orden);
+    for (uint8_t i = 0; i < PRODUCTORAS; i++) {
+        TEST_ASSERT_EQUAL(CUADROS, esperado[i]);
+    }
+}
@@ -0,0 +1,216 @@
+/**
+ * @file test_sh1106_spi.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Pruebas Formales sobre el transporte SPI de 4 hilos del driver sh1106
+ *
+ * La HAL de SPI esta mockeada. Sus reemplazos registran cada escritura con el nivel del pin D/C y
+ * verifican que CS este activo, para comprobar que lo que llega al bus no tiene bytes de control.
+ *
+ * <b>PRUEBAS REALIZADAS</b>
+ * <ul>
+ *   <li>Test 1: Una pagina se envia con los comandos de direccion en D/C=0 y los datos en una sola
+ * escritura con D/C=1, sin bytes de control.</li>
+ *   <li>Test 2: Los comandos sueltos se envian juntos con D/C=0 dentro de una activacion de
+ * CS.</li>
+ *   <li>Test 3: Un error de la HAL se informa y libera CS.</li>
+ *   <li>Test 4: La actualizacion asincronica envia los datos de cada pagina sin esperar y libera
+ * CS en la interrupcion de fin.</li>
+ * </ul>
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2024
+ */
+
+#include "unity.h"
+#include "mock_hal_i2c.h"
+#include "mock_hal_spi.h"
+#include "sh1106.h"
+#include "sh1106_spi.h"
+
+/**
+ * @brief Cantidad maxima de escrituras registradas.
+ *
+ */
+#define MAX_ESCRITURAS (32)
+
+/**
+ * @brief Escritura registrada por la HAL de SPI simulada.
+ *
+ */
+typedef struct {
+    bool dato;        ///< @brief Nivel del pin D/C durante la escritura.
+    size_t size;      ///< @brief Bytes escritos.
+    uint8_t bytes[8]; ///< @brief Primeros bytes escritos.
+} escritura_t;
+
+escritura_t escrituras[MAX_ESCRITURAS];
+int cantidad_escrituras;
+
+/**
+ * @brief Estado de los pines CS y D/C simulados.
+ *
+ */
+bool cs_activo, dc_dato;
+
+/**
+ * @brief Funcion de fin de transmision entregada a la HAL asincronica y su contexto.
+ *
+ */
+hal_spi_callback_t hal_callback;
+void * hal_context;
+
+/**
+ * @brief Resultado y cantidad de llamadas de la funcion de fin de la actualizacion asincronica.
+ *
+ */
+sh1106_status_t async_resultado;
+int async_llamadas;
+
+/**
+ * @brief Display SPI de 128x16 y sus buffers.
+ *
+ */
+sh1106_t display;
+uint8_t buffer[SH1106_BUFFER_SIZE(128, 16)], front[SH1106_BUFFER_SIZE(128, 16)];
+
+void HAL_SPI_select_registrar(uint8_t device, bool selected) {
+    TEST_ASSERT_TRUE(selected != cs_activo);
+    cs_activo = selected;
+}
+
+void HAL_SPI_set_dc_registrar(uint8_t device, bool data) {
+    dc_dato = data;
+}
+
+status_t HAL_SPI_write_registrar(uint8_t device, const uint8_t * data, size_t size) {
+    escritura_t * escritura = &escrituras[cantidad_escrituras++];
+
+    TEST_ASSERT_TRUE(cs_activo);
+    TEST_ASSERT_EQUAL(3, device);
+    escritura->dato = dc_dato;
+    escritura->size = size;
+    memcpy(escritura->bytes, data, size < 8 ? size : 8);
+    return HAL_OK;
+}
+
+status_t HAL_SPI_write_async_iniciar(uint8_t device, const uint8_t * data, size_t size,
+                                     hal_spi_callback_t callback, void * context) {
+    hal_callback = callback;
+    hal_context = context;
+    return HAL_SPI_write_registrar(device, data, size);
+}
+
+/**
+ * @brief Funcion de fin de la actualizacion asincronica usada en las pruebas.
+ */
+void fin_actualizacion(sh1106_t * dev, sh1106_status_t resultado) {
+    async_resultado = resultado;
+    async_llamadas++;
+}
+
+/**
+ * @brief Funcion que se ejecuta antes de cada prueba.
+ *
+ */
+void setUp(void) {
+    sh1106_config_t config = {.buffer = buffer,
+                              .front = front,
+                              .width = 128,
+                              .height = 16,
+                              .address = 3,
+                              .transport = &sh1106_spi_transport};
+    sh1106_DevCreate(&display, &config);
+    memset(buffer, 0, sizeof(buffer));
+
+    HAL_SPI_select_fake.custom_fake = HAL_SPI_select_registrar;
+    HAL_SPI_set_dc_fake.custom_fake = HAL_SPI_set_dc_registrar;
+    HAL_SPI_write_fake.custom_fake = HAL_SPI_write_registrar;
+    HAL_SPI_write_async_fake.custom_fake = HAL_SPI_write_async_iniciar;
+    memset(escrituras, 0, sizeof(escrituras));
+    cantidad_escrituras = 0;
+    cs_activo = false;
+    hal_callback = NULL;
+    async_resultado = SH1106_BUSY;
+    async_llamadas = 0;
+}
+
+/**
+ * @brief Test 1: Una pagina se envia con los comandos de direccion en D/C=0 y los datos en una
+ * sola escritura con D/C=1, sin bytes de control.
+ */
+void test_pagina_en_una_sola_escritura_sin_bytes_de_control(void) {
+    static const uint8_t comandos[] = {FIRT_PAGE_ADD + 1, FIRT_COLUM_ADD_L, FIRT_COLUM_ADD_H};
+
+    sh1106_DevUpdateScreen(&display);
+    cantidad_escrituras = 0;
+    HAL_SPI_select_fake.call_count = 0;
+    buffer[128 + 7] = 0xA5;
+    sh1106_DevMarkDirty(&display, 1, 0, 128);
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreen(&display));
+    TEST_ASSERT_EQUAL(2, cantidad_escrituras);
+    TEST_ASSERT_FALSE(escrituras[0].dato);
+    TEST_ASSERT_EQUAL(sizeof(comandos), escrituras[0].size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(comandos, escrituras[0].bytes, sizeof(comandos));
+    TEST_ASSERT_TRUE(escrituras[1].dato);
+    TEST_ASSERT_EQUAL(128, escrituras[1].size);
+    TEST_ASSERT_EQUAL_HEX8(0xA5, escrituras[1].bytes[7]);
+    TEST_ASSERT_FALSE(cs_activo);
+    TEST_ASSERT_EQUAL(2, HAL_SPI_select_fake.call_count);
+    TEST_ASSERT_EQUAL(0, HAL_I2C_send_fake.call_count);
+}
+
+/**
+ * @brief Test 2: Los comandos sueltos se envian juntos con D/C=0 dentro de una activacion de CS.
+ */
+void test_comandos_con_dc_en_cero(void) {
+    static const uint8_t comandos[] = {SET_CONSTRAS, 0x7F};
+
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevContrasSet(&display, 0x7F));
+    TEST_ASSERT_EQUAL(1, cantidad_escrituras);
+    TEST_ASSERT_FALSE(escrituras[0].dato);
+    TEST_ASSERT_EQUAL(sizeof(comandos), escrituras[0].size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(comandos, escrituras[0].bytes, sizeof(comandos));
+    TEST_ASSERT_EQUAL(2, HAL_SPI_select_fake.call_count);
+    TEST_ASSERT_FALSE(cs_activo);
+}
+
+/**
+ * @brief Test 3: Un error de la HAL se informa y libera CS.
+ *
+ * La escritura de los comandos de direccion falla, por lo que los datos de la pagina no se envian.
+ */
+void test_error_de_la_hal_libera_cs(void) {
+    HAL_SPI_write_fake.custom_fake = NULL;
+    HAL_SPI_write_fake.return_val = HAL_ERROR;
+
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DevUpdateScreen(&display));
+    TEST_ASSERT_EQUAL(1, HAL_SPI_write_fake.call_count);
+    TEST_ASSERT_FALSE(cs_activo);
+}
+
+/**
+ * @brief Test 4: La actualizacion asincronica envia los datos de cada pagina sin esperar y libera
+ * CS en la interrupcion de fin.
+ */
+void test_actualizacion_asincronica_por_spi(void) {
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreenAsync(&display, fin_actualizacion));
+
+    for (int pagina = 0; pagina < 2; pagina++) {
+        TEST_ASSERT_EQUAL(2 * (pagina + 1), cantidad_escrituras);
+        TEST_ASSERT_EQUAL(FIRT_PAGE_ADD + pagina, escrituras[2 * pagina].bytes[0]);
+        TEST_ASSERT_TRUE(escrituras[2 * pagina + 1].dato);
+        TEST_ASSERT_EQUAL(128, escrituras[2 * pagina + 1].size);
+        TEST_ASSERT_TRUE(cs_activo);
+        TEST_ASSERT_EQUAL(SH1106_BUSY, sh1106_DevAsyncStatus(&display));
+
+        hal_spi_callback_t callback = hal_callback;
+        hal_callback = NULL;
+        callback(hal_context, HAL_OK);
+    }
+    TEST_ASSERT_FALSE(cs_activo);
+    TEST_ASSERT_EQUAL(1, async_llamadas);
+    TEST_ASSERT_EQUAL(SH1106_OK, async_resultado);
+    TEST_ASSERT_EQUAL(2, HAL_SPI_write_async_fake.call_count);
+}
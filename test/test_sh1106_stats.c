@@ -0,0 +1,229 @@
+/**
+ * @file test_sh1106_stats.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Pruebas Formales sobre los contadores y la traza del driver sh1106
+ *
+ * Este archivo se compila con SH1106_STATS=1 (ver project.yml). El reloj de las actualizaciones es
+ * una tabla de lecturas, para ubicar cada duracion en un intervalo conocido del histograma.
+ *
+ * <b>PRUEBAS REALIZADAS</b>
+ * <ul>
+ *   <li>Test 1: Se cuentan los comandos, datos, transacciones y columnas dibujadas.</li>
+ *   <li>Test 2: Los errores y los rechazos por bus ocupado se cuentan segun su origen.</li>
+ *   <li>Test 3: La duracion de cada actualizacion se suma a su intervalo del histograma.</li>
+ *   <li>Test 4: La traza recibe el inicio y el fin de las actualizaciones, tambien
+ * asincronicas.</li>
+ * </ul>
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2024
+ */
+
+#include "unity.h"
+#include "mock_hal_i2c.h"
+#include "sh1106.h"
+
+/**
+ * @brief Display de las pruebas, con buffer de transmision.
+ */
+sh1106_t display;
+uint8_t buffer[BUFFER_SIZE], front[BUFFER_SIZE];
+sh1106_counters_t contadores;
+
+/**
+ * @brief Lecturas que devuelve el reloj, en orden.
+ */
+uint32_t lecturas[16];
+uint8_t lectura;
+
+/**
+ * @brief Eventos recibidos por la traza, con su resultado.
+ */
+sh1106_trace_event_t eventos[8];
+sh1106_status_t resultados[8];
+uint8_t eventos_count;
+
+/**
+ * @brief Funcion de fin de la transmision asincronica en curso.
+ */
+hal_i2c_callback_t hal_callback;
+void * hal_context;
+
+/**
+ * @brief Reloj de prueba: devuelve la siguiente lectura de la tabla.
+ */
+uint32_t reloj(void) {
+    return lecturas[lectura++];
+}
+
+/**
+ * @brief Traza de prueba: registra el evento y su resultado.
+ */
+void traza(sh1106_t * dev, sh1106_trace_event_t event, sh1106_status_t status) {
+    TEST_ASSERT_EQUAL_PTR(&display, dev);
+    eventos[eventos_count] = event;
+    resultados[eventos_count++] = status;
+}
+
+/**
+ * @brief Reemplazo de HAL_I2C_send_async, guarda la funcion de fin para llamarla luego.
+ */
+status_t HAL_I2C_send_async_iniciar(uint8_t address, uint8_t * data, size_t size,
+                                    hal_i2c_callback_t callback, void * context) {
+    hal_callback = callback;
+    hal_context = context;
+    return HAL_OK;
+}
+
+/**
+ * @brief Termina la transmision asincronica en curso con el estado indicado.
+ */
+void terminar_transmision(status_t status) {
+    hal_i2c_callback_t callback = hal_callback;
+    hal_callback = NULL;
+    callback(hal_context, status);
+}
+
+/**
+ * @brief Funcion que se ejecuta antes de cada prueba. La pantalla queda enviada y los contadores
+ * en cero.
+ *
+ */
+void setUp(void) {
+    sh1106_config_t config = {.buffer = buffer,
+                              .front = front,
+                              .width = SH1106_WHIDTH,
+                              .height = SH1106_HEIGHT,
+                              .address = SH1106_I2C_ADDRESS,
+                              .transport = &sh1106_i2c_transport};
+    sh1106_DevCreate(&display, &config);
+    sh1106_DevUpdateScreen(&display);
+    sh1106_DevResetCounters(&display);
+    RESET_FAKE(HAL_I2C_send);
+    HAL_I2C_send_async_fake.custom_fake = HAL_I2C_send_async_iniciar;
+    lectura = 0;
+    eventos_count = 0;
+}
+
+/**
+ * @brief Test 1: Se cuentan los comandos, datos, transacciones y columnas dibujadas.
+ *
+ * La actualizacion envia las 2 columnas dibujadas con los 3 comandos de direccion, cada uno con
+ * su byte de control, y el control de los datos.
+ */
+void test_se_cuentan_comandos_datos_y_transacciones(void) {
+    sh1106_DevDrawPixel(&display, 3, 10, WHITE);
+    sh1106_DevDrawPixel(&display, 4, 10, WHITE);
+    sh1106_DevDrawPixel(&display, 4, 11, WHITE);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreen(&display));
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevSendCmd(&display, DISPLAY_ON));
+
+    sh1106_DevGetCounters(&display, &contadores);
+    TEST_ASSERT_EQUAL(3, contadores.drawn_columns);
+    TEST_ASSERT_EQUAL(3 + 1, contadores.commands);
+    TEST_ASSERT_EQUAL(2, contadores.data_bytes);
+    TEST_ASSERT_EQUAL(2, contadores.transactions);
+    TEST_ASSERT_EQUAL((2 * 3 + 1 + 2) + 2, contadores.bus_bytes);
+    TEST_ASSERT_EQUAL(1, contadores.flushes);
+    TEST_ASSERT_EQUAL(0, contadores.errors + contadores.bus_busy + contadores.async_busy);
+
+    sh1106_DevResetCounters(&display);
+    sh1106_DevGetCounters(&display, &contadores);
+    TEST_ASSERT_EQUAL(0, contadores.transactions);
+    TEST_ASSERT_EQUAL(0, contadores.drawn_columns);
+}
+
+/**
+ * @brief Test 2: Los errores y los rechazos por bus ocupado se cuentan segun su origen.
+ *
+ * La HAL devuelve primero error y luego bus ocupado. Durante una actualizacion asincronica el
+ * display rechaza los envios sin llegar a la HAL, y la transmision termina con error.
+ */
+void test_los_errores_se_cuentan_segun_su_origen(void) {
+    HAL_I2C_send_fake.return_val = HAL_ERROR;
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DevUpdateScreenFull(&display));
+    HAL_I2C_send_fake.return_val = HAL_BUSY;
+    TEST_ASSERT_EQUAL(SH1106_BUSY, sh1106_DevSendCmd(&display, DISPLAY_ON));
+
+    HAL_I2C_send_fake.return_val = HAL_OK;
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreenAsync(&display, NULL));
+    TEST_ASSERT_EQUAL(SH1106_BUSY, sh1106_DevSendCmd(&display, DISPLAY_ON));
+    TEST_ASSERT_EQUAL(SH1106_BUSY, sh1106_DevUpdateScreen(&display));
+    terminar_transmision(HAL_ERROR);
+
+    sh1106_DevGetCounters(&display, &contadores);
+    TEST_ASSERT_EQUAL(2, contadores.errors);
+    TEST_ASSERT_EQUAL(1, contadores.bus_busy);
+    TEST_ASSERT_EQUAL(2, contadores.async_busy);
+    TEST_ASSERT_EQUAL(3, contadores.transactions);
+    TEST_ASSERT_EQUAL(2, contadores.flushes);
+    TEST_ASSERT_EQUAL(2, HAL_I2C_send_fake.call_count);
+}
+
+/**
+ * @brief Test 3: La duracion de cada actualizacion se suma a su intervalo del histograma.
+ *
+ * Las duraciones son 0, 1, 5, 1000 y 32 ticks (con el reloj desbordando), y 2^31 ticks, que cae
+ * en el ultimo intervalo.
+ */
+void test_la_duracion_se_suma_a_su_intervalo(void) {
+    uint32_t tabla[] = {100, 100, 200, 201, 300, 305, 400, 1400, 0xFFFFFFF0, 0x10, 0, 0x80000000};
+    memcpy(lecturas, tabla, sizeof(tabla));
+    sh1106_DevSetClock(&display, reloj);
+
+    for (uint8_t i = 0; i < sizeof(tabla) / sizeof(tabla[0]) / 2; i++) {
+        TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreen(&display));
+    }
+
+    sh1106_DevGetCounters(&display, &contadores);
+    TEST_ASSERT_EQUAL(sizeof(tabla) / sizeof(tabla[0]), lectura);
+    TEST_ASSERT_EQUAL(1, contadores.latency[0]);
+    TEST_ASSERT_EQUAL(1, contadores.latency[1]);
+    TEST_ASSERT_EQUAL(1, contadores.latency[3]);
+    TEST_ASSERT_EQUAL(1, contadores.latency[6]);
+    TEST_ASSERT_EQUAL(1, contadores.latency[10]);
+    TEST_ASSERT_EQUAL(1, contadores.latency[SH1106_STATS_BUCKETS - 1]);
+    TEST_ASSERT_EQUAL(0x80000000, contadores.latency_max);
+    TEST_ASSERT_EQUAL(6, contadores.flushes);
+}
+
+/**
+ * @brief Test 4: La traza recibe el inicio y el fin de las actualizaciones, tambien asincronicas.
+ *
+ * La actualizacion asincronica envia 3 paginas (la 0, que fallo antes, la 2 y la 5) y termina en
+ * la ultima interrupcion, por lo que su duracion abarca las 3 transmisiones.
+ */
+void test_la_traza_recibe_inicio_y_fin(void) {
+    uint32_t tabla[] = {10, 12, 20, 90};
+    memcpy(lecturas, tabla, sizeof(tabla));
+    sh1106_DevSetClock(&display, reloj);
+    sh1106_DevSetTrace(&display, traza);
+
+    HAL_I2C_send_fake.return_val = HAL_ERROR;
+    sh1106_DevDrawPixel(&display, 0, 0, WHITE);
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DevUpdateScreen(&display));
+    HAL_I2C_send_fake.return_val = HAL_OK;
+
+    sh1106_DevDrawPixel(&display, 0, 20, WHITE);
+    sh1106_DevDrawPixel(&display, 0, 40, WHITE);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreenAsync(&display, NULL));
+    for (uint8_t pagina = 0; pagina < 3; pagina++) {
+        TEST_ASSERT_EQUAL(3, eventos_count);
+        terminar_transmision(HAL_OK);
+    }
+
+    sh1106_trace_event_t esperados[] = {SH1106_TRACE_FLUSH_START, SH1106_TRACE_FLUSH_END,
+                                        SH1106_TRACE_FLUSH_START, SH1106_TRACE_FLUSH_END};
+    TEST_ASSERT_EQUAL(4, eventos_count);
+    for (uint8_t i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(esperados[i], eventos[i]);
+    }
+    TEST_ASSERT_EQUAL(SH1106_ERROR, resultados[1]);
+    TEST_ASSERT_EQUAL(SH1106_OK, resultados[3]);
+
+    sh1106_DevGetCounters(&display, &contadores);
+    TEST_ASSERT_EQUAL(1, contadores.latency[2]);
+    TEST_ASSERT_EQUAL(1, contadores.latency[7]);
+    TEST_ASSERT_EQUAL(70, contadores.latency_max);
+}
@@ -0,0 +1,276 @@
+/**
+ * @file test_sh1106_strip.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Pruebas Formales sobre el modo tira del driver sh1106
+ *
+ * Este archivo se compila con SH1106_STRIP=1 (ver project.yml). Cada escena se dibuja sobre un
+ * display con buffer completo y sobre otro en modo tira, con direcciones I2C distintas, y se
+ * comparan byte a byte las transacciones que recibe la HAL de cada uno.
+ *
+ * <b>PRUEBAS REALIZADAS</b>
+ * <ul>
+ *   <li>Test 1: Todas las primitivas, recortadas por los bordes y cruzando paginas, envian lo
+ * mismo en modo tira.</li>
+ *   <li>Test 2: Un fondo blanco con dibujos en negro envia lo mismo en modo tira.</li>
+ *   <li>Test 3: Una pantalla de widgets envia lo mismo en modo tira.</li>
+ *   <li>Test 4: sh1106_Fill vacia la lista y una lista llena rechaza las funciones de dibujo.</li>
+ *   <li>Test 5: El display por defecto usa el modo tira.</li>
+ *   <li>Test 6: No se crean displays en modo tira con funciones que necesitan la pantalla
+ * completa.</li>
+ * </ul>
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2024
+ */
+
+#include "unity.h"
+#include "mock_hal_i2c.h"
+#include "sh1106.h"
+#include "sh1106_bitmap.h"
+#include "sh1106_font.h"
+#include "sh1106_font_5x7.h"
+#include "sh1106_gfx.h"
+#include "sh1106_gray.h"
+#include "sh1106_image.h"
+#include "sh1106_strip.h"
+#include "sh1106_widget.h"
+
+/**
+ * @brief Direcciones I2C de cada display, para separar sus transacciones.
+ */
+#define DIRECCION_COMPLETO (0x3C)
+#define DIRECCION_TIRA     (0x3D)
+
+/**
+ * @brief Bytes maximos registrados por display.
+ */
+#define REGISTRO_SIZE (2 * BUFFER_SIZE)
+
+/**
+ * @brief Display con buffer completo y display en modo tira, con su buffer de una pagina y su
+ * lista de dibujo.
+ */
+sh1106_t completo, tira;
+uint8_t buffer_completo[BUFFER_SIZE];
+uint8_t buffer_tira[SH1106_WHIDTH];
+uint8_t lista[512];
+
+/**
+ * @brief Bytes enviados a cada display, en orden.
+ */
+uint8_t registro_completo[REGISTRO_SIZE], registro_tira[REGISTRO_SIZE];
+size_t registro_completo_size, registro_tira_size;
+
+/**
+ * @brief Mapa de bits de 12x12 pixeles.
+ */
+static uint8_t imagen_datos[2 * 12];
+static const sh1106_bitmap_t imagen = {.data = imagen_datos, .width = 12, .height = 12};
+
+/**
+ * @brief Imagen comprimida de 8x12 pixeles.
+ */
+static const uint8_t icono_datos[] = {SH1106_IMAGE_REPEAT | 5, 0x3C, SH1106_IMAGE_LITERAL | 1,
+                                      0x81, 0x42, SH1106_IMAGE_COPY | 7};
+static const sh1106_image_t icono = {
+    .data = icono_datos, .size = sizeof(icono_datos), .width = 8, .height = 12};
+
+/**
+ * @brief Reemplazo de HAL_I2C_send, agrega la transaccion al registro del display.
+ */
+status_t HAL_I2C_send_registrar(uint8_t address, uint8_t * data, size_t size) {
+    uint8_t * registro = (address == DIRECCION_TIRA) ? registro_tira : registro_completo;
+    size_t * registro_size =
+        (address == DIRECCION_TIRA) ? &registro_tira_size : &registro_completo_size;
+
+    TEST_ASSERT_TRUE(*registro_size + size <= REGISTRO_SIZE);
+    memcpy(&registro[*registro_size], data, size);
+    *registro_size += size;
+    return HAL_OK;
+}
+
+/**
+ * @brief Funcion que se ejecuta antes de cada prueba.
+ *
+ */
+void setUp(void) {
+    sh1106_config_t config = {.buffer = buffer_completo,
+                              .width = SH1106_WHIDTH,
+                              .height = SH1106_HEIGHT,
+                              .column_offset = 2,
+                              .address = DIRECCION_COMPLETO,
+                              .transport = &sh1106_i2c_transport};
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevCreate(&completo, &config));
+    config.buffer = buffer_tira;
+    config.address = DIRECCION_TIRA;
+    config.list = lista;
+    config.list_size = sizeof(lista);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevCreate(&tira, &config));
+
+    HAL_I2C_send_fake.custom_fake = HAL_I2C_send_registrar;
+    registro_completo_size = 0;
+    registro_tira_size = 0;
+    for (uint8_t i = 0; i < sizeof(imagen_datos); i++) {
+        imagen_datos[i] = (uint8_t)(i * 53 + 7);
+    }
+}
+
+/**
+ * @brief Dibuja todas las primitivas, con figuras que salen de la pantalla y que empiezan a mitad
+ * de pagina.
+ */
+static void dibujar_primitivas(sh1106_t * dev) {
+    sh1106_DevFill(dev, BLACK);
+    sh1106_DrawLine(dev, -10, -5, 140, 70, WHITE);
+    sh1106_DrawLine(dev, 3, 60, 90, 2, WHITE);
+    sh1106_DrawLine(dev, 5, 13, 5, 50, WHITE);
+    sh1106_DrawHLine(dev, -4, 21, 200, WHITE);
+    sh1106_DrawVLine(dev, 127, 3, 9, WHITE);
+    sh1106_DrawRect(dev, 20, 5, 30, 27, WHITE);
+    sh1106_FillRect(dev, 22, 7, 10, 20, BLACK);
+    sh1106_DrawCircle(dev, 64, 32, 40, WHITE);
+    sh1106_FillCircle(dev, 100, 12, 14, WHITE);
+    sh1106_DrawArc(dev, 40, 45, 15, 30, 250, WHITE);
+    sh1106_DevDrawPixel(dev, 0, 63, WHITE);
+    sh1106_DevDrawPixel(dev, 101, 12, BLACK);
+    sh1106_DrawString(dev, &sh1106_font_5x7, 60, 27, "Tira 19", WHITE);
+    sh1106_DrawString(dev, &sh1106_font_5x7, -3, -2, "arriba", WHITE);
+    sh1106_DrawChar(dev, &sh1106_font_5x7, 120, 59, 'Z', WHITE);
+    sh1106_DrawBitmap(dev, &imagen, 70, 45, SH1106_ROP_XOR);
+    sh1106_DrawBitmapRegion(dev, &imagen, 2, 3, 8, 8, -4, 58, SH1106_ROP_COPY);
+    sh1106_DrawImage(dev, &icono, 30, 36, SH1106_ROP_OR);
+}
+
+/**
+ * @brief Verifica que ambos displays enviaron exactamente lo mismo.
+ */
+static void comparar_registros(void) {
+    TEST_ASSERT_EQUAL(SH1106_PAGES * (2 * 3 + 1 + SH1106_WHIDTH), registro_completo_size);
+    TEST_ASSERT_EQUAL(registro_completo_size, registro_tira_size);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(registro_completo, registro_tira, registro_completo_size);
+}
+
+/**
+ * @brief Test 1: Todas las primitivas, recortadas por los bordes y cruzando paginas, envian lo
+ * mismo en modo tira.
+ */
+void test_todas_las_primitivas_envian_lo_mismo_en_modo_tira(void) {
+    dibujar_primitivas(&completo);
+    dibujar_primitivas(&tira);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreen(&completo));
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_DevUpdateScreen(&tira));
+    comparar_registros();
+
+    // Un segundo cuadro: la tira vuelve a enviar la pantalla completa.
+    registro_completo_size = 0;
+    registro_tira_size = 0;
+    sh1106_DevUpdateScreenFull(&completo);
+    sh1106_DevUpdateScreen(&tira);
+    comparar_registros();
+}
+
+/**
+ * @brief Test 2: Un fondo blanco con dibujos en negro envia lo mismo en modo tira.
+ */
+void test_un_fondo_blanco_envia_lo_mismo_en_modo_tira(void) {
+    sh1106_t * displays[] = {&completo, &tira};
+
+    for (uint8_t i = 0; i < 2; i++) {
+        sh1106_DevFill(displays[i], WHITE);
+        sh1106_FillCircle(displays[i], 64, 32, 20, BLACK);
+        sh1106_DrawString(displays[i], &sh1106_font_5x7, 50, 29, "OK", WHITE);
+        sh1106_DrawBitmap(displays[i], &imagen, 3, 50, SH1106_ROP_AND_NOT);
+        sh1106_DevUpdateScreen(displays[i]);
+    }
+    comparar_registros();
+}
+
+/**
+ * @brief Test 3: Una pantalla de widgets envia lo mismo en modo tira.
+ */
+void test_una_pantalla_de_widgets_envia_lo_mismo_en_modo_tira(void) {
+    sh1106_t * displays[] = {&completo, &tira};
+    static sh1106_screen_t pantalla;
+
+    for (uint8_t i = 0; i < 2; i++) {
+        sh1106_DevFill(displays[i], BLACK);
+        sh1106_ScreenCreate(&pantalla, displays[i], BLACK);
+        sh1106_LabelCreate(&pantalla, 1, 3, 60, 8, &sh1106_font_5x7, "Nivel");
+        sh1106_NumberCreate(&pantalla, 70, 3, 40, 8, &sh1106_font_5x7, -273);
+        sh1106_BarCreate(&pantalla, 4, 20, 120, 11, 0, 100, 62);
+        sh1106_widget_t * grafico = sh1106_SparklineCreate(&pantalla, 10, 36, 30, 20, 0, 9);
+        for (int32_t muestra = 0; muestra < 40; muestra++) {
+            sh1106_SparklinePush(grafico, (muestra * 7) % 10);
+        }
+        sh1106_IconCreate(&pantalla, 100, 44, &imagen);
+        sh1106_ScreenRender(&pantalla);
+        sh1106_DevUpdateScreen(displays[i]);
+    }
+    comparar_registros();
+}
+
+/**
+ * @brief Test 4: sh1106_Fill vacia la lista y una lista llena rechaza las funciones de dibujo.
+ */
+void test_fill_vacia_la_lista_y_una_lista_llena_rechaza_el_dibujo(void) {
+    sh1106_DrawLine(&tira, 0, 0, 10, 10, WHITE);
+    TEST_ASSERT_NOT_EQUAL(0, sh1106_StripUsed(&tira));
+    sh1106_DevFill(&tira, BLACK);
+    TEST_ASSERT_EQUAL(0, sh1106_StripUsed(&tira));
+
+    sh1106_status_t status = SH1106_OK;
+    while (status == SH1106_OK) {
+        status = sh1106_DrawString(&tira, &sh1106_font_5x7, 0, 0, "0123456789", WHITE);
+    }
+    TEST_ASSERT_EQUAL(SH1106_ERROR, status);
+    TEST_ASSERT_TRUE(sh1106_StripUsed(&tira) <= sizeof(lista));
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DevDrawPixel(&tira, 0, SH1106_HEIGHT, WHITE));
+}
+
+/**
+ * @brief Test 5: El display por defecto usa el modo tira.
+ *
+ * Se dibuja en el display por defecto y en el display en modo tira con la misma geometria: cada
+ * pagina envia lo mismo, salvo la direccion I2C.
+ */
+void test_el_display_por_defecto_usa_el_modo_tira(void) {
+    sh1106_t * defecto = sh1106_Default();
+    TEST_ASSERT_NOT_NULL(defecto->list);
+    TEST_ASSERT_EQUAL(SH1106_STRIP_LIST_SIZE, defecto->list_size);
+
+    sh1106_Fill(BLACK);
+    sh1106_DrawPixel(3, 9, WHITE);
+    sh1106_DrawString(defecto, &sh1106_font_5x7, 10, 40, "defecto", WHITE);
+    TEST_ASSERT_EQUAL(SH1106_OK, sh1106_UpdateScreen());
+    TEST_ASSERT_EQUAL(SH1106_PAGES * (2 * 3 + 1 + SH1106_WHIDTH), registro_completo_size);
+    TEST_ASSERT_EQUAL_HEX8(0x02, registro_completo[(2 * 3 + 1 + SH1106_WHIDTH) + 2 * 3 + 1 + 3]);
+}
+
+/**
+ * @brief Test 6: No se crean displays en modo tira con funciones que necesitan la pantalla
+ * completa.
+ */
+void test_no_se_crean_displays_en_modo_tira_incompatibles(void) {
+    sh1106_t display;
+    uint8_t memoria[BUFFER_SIZE];
+    sh1106_config_t config = {.buffer = buffer_tira,
+                              .width = SH1106_WHIDTH,
+                              .height = SH1106_HEIGHT,
+                              .transport = &sh1106_i2c_transport,
+                              .list = lista,
+                              .list_size = sizeof(lista)};
+
+    config.front = memoria;
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DevCreate(&display, &config));
+    config.front = NULL;
+    config.shadow = memoria;
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DevCreate(&display, &config));
+    config.shadow = NULL;
+    config.orientation = SH1106_ROTATE_90;
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DevCreate(&display, &config));
+
+    sh1106_gray_t gris;
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_DevScroll(&tira, 1));
+    TEST_ASSERT_EQUAL(SH1106_ERROR, sh1106_GrayCreate(&gris, &tira, memoria, 2, SH1106_GRAY_PWM));
+}
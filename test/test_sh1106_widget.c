@@ -0,0 +1,224 @@
+/**
+ * @file test_sh1106_widget.c
+ * @author Miguel Manuel Blanco (miguelmanuelblanco@gmail.com)
+ * @brief Pruebas Formales sobre los widgets retenidos del driver sh1106
+ *
+ * Los widgets se dibujan con las primitivas, por lo que se comparan contra una referencia dibujada
+ * directamente con esas primitivas. Las pruebas verifican sobre todo que solo se redibujen los
+ * widgets que cambiaron y que la actualizacion envie solo sus columnas.
+ *
+ * <b>PRUEBAS REALIZADAS</b>
+ * <ul>
+ *   <li>Test 1: La primera vez se dibujan todos los widgets y luego ninguno.</li>
+ *   <li>Test 2: Cambiar un numero redibuja solo ese widget y marca solo sus columnas.</li>
+ *   <li>Test 3: Un estado que se ve igual no invalida el widget.</li>
+ *   <li>Test 4: La barra y el numero coinciden con la referencia.</li>
+ *   <li>Test 5: El grafico de tendencia dibuja las ultimas muestras, la mas nueva a la
+ * derecha.</li>
+ *   <li>Test 6: Un widget oculto deja su rectangulo con el fondo.</li>
+ *   <li>Test 7: No se crean widgets si la pantalla esta llena o si no entran en el display.</li>
+ * </ul>
+ *
+ * @version 0.1
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2024
+ */
+
+#include "unity.h"
+#include "mock_hal_i2c.h"
+#include "sh1106.h"
+#include "sh1106_bitmap.h"
+#include "sh1106_font.h"
+#include "sh1106_font_5x7.h"
+#include "sh1106_gfx.h"
+#include "sh1106_widget.h"
+
+/**
+ * @brief Icono de 8x8 pixeles.
+ *
+ */
+static const uint8_t icono_datos[] = {0x18, 0x3C, 0x7E, 0xFF, 0xFF, 0x7E, 0x3C, 0x18};
+
+static const sh1106_bitmap_t icono = {.data = icono_datos, .width = 8, .height = 8};
+
+/**
+ * @brief Display y pantalla sobre los que se dibujan los widgets.
+ *
+ */
+sh1106_t display;
+sh1106_screen_t pantalla;
+
+/**
+ * @brief Display sobre el que se dibuja la referencia con las primitivas.
+ *
+ */
+sh1106_t referencia;
+
+/**
+ * @brief Buffers de ambos displays.
+ *
+ */
+uint8_t buffer[BUFFER_SIZE], buffer_referencia[BUFFER_SIZE];
+
+/**
+ * @brief Widgets de la pantalla de prueba.
+ *
+ */
+sh1106_widget_t *titulo, *numero, *barra, *imagen;
+
+/**
+ * @brief Funcion que se ejecuta antes de cada prueba.
+ *
+ * Crea una pantalla con un titulo en la pagina 0, un numero en la pagina 2, una barra en las
+ * paginas 4 y 5 y un icono en la pagina 7.
+ */
+void setUp(void) {
+    sh1106_config_t config = {.buffer = buffer,
+                              .width = SH1106_WHIDTH,
+                              .height = SH1106_HEIGHT,
+                              .address = SH1106_I2C_ADDRESS,
+                              .transport = &sh1106_i2c_transport};
+    sh1106_DevCreate(&display, &config);
+    config.buffer = buffer_referencia;
+    sh1106_DevCreate(&referencia, &config);
+    memset(buffer, 0, sizeof(buffer));
+    memset(buffer_referencia, 0, sizeof(buffer_referencia));
+
+    sh1106_ScreenCreate(&pantalla, &display, BLACK);
+    titulo = sh1106_LabelCreate(&pantalla, 0, 0, 128, 8, &sh1106_font_5x7, "TEMP");
+    numero = sh1106_NumberCreate(&pantalla, 40, 16, 40, 8, &sh1106_font_5x7, 123);
+    barra = sh1106_BarCreate(&pantalla, 10, 32, 102, 10, 0, 1000, 500);
+    imagen = sh1106_IconCreate(&pantalla, 120, 56, &icono);
+}
+
+/**
+ * @brief Test 1: La primera vez se dibujan todos los widgets y luego ninguno.
+ */
+void test_la_primera_vez_se_dibujan_todos_los_widgets(void) {
+    TEST_ASSERT_EQUAL(4, pantalla.count);
+    TEST_ASSERT_EQUAL(4, sh1106_ScreenRender(&pantalla));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(icono_datos, &buffer[7 * SH1106_WHIDTH + 120], 8);
+
+    TEST_ASSERT_EQUAL(0, sh1106_ScreenRender(&pantalla));
+}
+
+/**
+ * @brief Test 2: Cambiar un numero redibuja solo ese widget y marca solo sus columnas.
+ *
+ * La actualizacion envia una sola transaccion, con las 40 columnas del numero en la pagina 2.
+ */
+void test_cambiar_un_numero_redibuja_solo_ese_widget(void) {
+    sh1106_ScreenRender(&pantalla);
+    HAL_I2C_send_fake.return_val = 0;
+    sh1106_DevUpdateScreen(&display);
+    RESET_FAKE(HAL_I2C_send);
+    memcpy(buffer_referencia, buffer, sizeof(buffer));
+
+    sh1106_NumberSet(numero, 7);
+    TEST_ASSERT_EQUAL(1, sh1106_ScreenRender(&pantalla));
+    TEST_ASSERT_EQUAL(40, display.dirty_first[2]);
+    TEST_ASSERT_EQUAL(80, display.dirty_end[2]);
+
+    sh1106_DevUpdateScreen(&display);
+    TEST_ASSERT_EQUAL(1, HAL_I2C_send_fake.call_count);
+    TEST_ASSERT_EQUAL(2 * 3 + 1 + 40, HAL_I2C_send_fake.arg2_val);
+
+    memset(&buffer_referencia[2 * SH1106_WHIDTH + 40], 0, 40);
+    sh1106_DrawString(&referencia, &sh1106_font_5x7, 75, 16, "7", WHITE);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 3: Un estado que se ve igual no invalida el widget.
+ *
+ * Con una barra de 100 columnas utiles para 1000 unidades, 500 y 509 tienen el mismo largo.
+ */
+void test_un_estado_que_se_ve_igual_no_invalida_el_widget(void) {
+    sh1106_ScreenRender(&pantalla);
+
+    sh1106_LabelSet(titulo, "TEMP");
+    sh1106_NumberSet(numero, 123);
+    sh1106_BarSet(barra, 509);
+    sh1106_IconSet(imagen, &icono);
+    TEST_ASSERT_EQUAL(0, sh1106_ScreenRender(&pantalla));
+
+    sh1106_LabelSet(titulo, "TEM");
+    sh1106_BarSet(barra, 510);
+    TEST_ASSERT_EQUAL(2, sh1106_ScreenRender(&pantalla));
+}
+
+/**
+ * @brief Test 4: La barra y el numero coinciden con la referencia.
+ *
+ * El numero se alinea a la derecha de su rectangulo y la barra llena la mitad de su interior.
+ */
+void test_la_barra_y_el_numero_coinciden_con_la_referencia(void) {
+    sh1106_NumberSet(numero, -45);
+    sh1106_ScreenRender(&pantalla);
+
+    sh1106_DrawString(&referencia, &sh1106_font_5x7, 0, 0, "TEMP", WHITE);
+    sh1106_DrawString(&referencia, &sh1106_font_5x7, 80 - 17, 16, "-45", WHITE);
+    sh1106_DrawRect(&referencia, 10, 32, 102, 10, WHITE);
+    sh1106_FillRect(&referencia, 11, 33, 50, 8, WHITE);
+    sh1106_DrawBitmap(&referencia, &icono, 120, 56, SH1106_ROP_COPY);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 5: El grafico de tendencia dibuja las ultimas muestras, la mas nueva a la derecha.
+ *
+ * El grafico de 4 columnas y 8 filas recibe 5 muestras: la primera se descarta y las demas se unen
+ * con lineas. El valor maximo se dibuja en la fila de arriba, el minimo en la de abajo y 30 en la
+ * fila 4, que es la unica encendida en la ultima columna.
+ */
+void test_el_grafico_de_tendencia_dibuja_las_ultimas_muestras(void) {
+    sh1106_widget_t * grafico = sh1106_SparklineCreate(&pantalla, 100, 16, 4, 8, 0, 70);
+    TEST_ASSERT_NOT_NULL(grafico);
+    sh1106_SparklinePush(grafico, 10);
+    sh1106_SparklinePush(grafico, 70);
+    sh1106_SparklinePush(grafico, 0);
+    sh1106_SparklinePush(grafico, 30);
+    sh1106_SparklinePush(grafico, 30);
+    sh1106_ScreenRender(&pantalla);
+
+    sh1106_DrawString(&referencia, &sh1106_font_5x7, 0, 0, "TEMP", WHITE);
+    sh1106_DrawString(&referencia, &sh1106_font_5x7, 80 - 17, 16, "123", WHITE);
+    sh1106_DrawRect(&referencia, 10, 32, 102, 10, WHITE);
+    sh1106_FillRect(&referencia, 11, 33, 50, 8, WHITE);
+    sh1106_DrawBitmap(&referencia, &icono, 120, 56, SH1106_ROP_COPY);
+    sh1106_DrawLine(&referencia, 100, 16, 100, 16, WHITE);
+    sh1106_DrawLine(&referencia, 100, 16, 101, 23, WHITE);
+    sh1106_DrawLine(&referencia, 101, 23, 102, 20, WHITE);
+    sh1106_DrawLine(&referencia, 102, 20, 103, 20, WHITE);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+    TEST_ASSERT_EQUAL_HEX8(0x10, buffer[2 * SH1106_WHIDTH + 103]);
+}
+
+/**
+ * @brief Test 6: Un widget oculto deja su rectangulo con el fondo.
+ */
+void test_un_widget_oculto_deja_su_rectangulo_con_el_fondo(void) {
+    sh1106_ScreenRender(&pantalla);
+    sh1106_WidgetSetVisible(barra, false);
+    TEST_ASSERT_EQUAL(1, sh1106_ScreenRender(&pantalla));
+
+    sh1106_DrawString(&referencia, &sh1106_font_5x7, 0, 0, "TEMP", WHITE);
+    sh1106_DrawString(&referencia, &sh1106_font_5x7, 80 - 17, 16, "123", WHITE);
+    sh1106_DrawBitmap(&referencia, &icono, 120, 56, SH1106_ROP_COPY);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer_referencia, buffer, BUFFER_SIZE);
+}
+
+/**
+ * @brief Test 7: No se crean widgets si la pantalla esta llena o si no entran en el display.
+ */
+void test_no_se_crean_widgets_fuera_de_la_capacidad_o_del_display(void) {
+    TEST_ASSERT_NULL(sh1106_LabelCreate(&pantalla, 100, 0, 40, 8, &sh1106_font_5x7, ""));
+    TEST_ASSERT_NULL(sh1106_LabelCreate(&pantalla, 0, 60, 40, 7, &sh1106_font_5x7, ""));
+    TEST_ASSERT_NULL(sh1106_SparklineCreate(&pantalla, 0, 0, SH1106_WIDGET_SPARKLINE_SIZE + 1, 8,
+                                            0, 1));
+
+    while (pantalla.count < SH1106_WIDGET_CAPACITY) {
+        TEST_ASSERT_NOT_NULL(sh1106_IconCreate(&pantalla, 0, 48, &icono));
+    }
+    TEST_ASSERT_NULL(sh1106_IconCreate(&pantalla, 0, 48, &icono));
+}
@@ -0,0 +1,227 @@
+#!/usr/bin/env python3
+"""Convierte una fuente BDF en una fuente del driver SH1106 (sh1106_font_t).
+
+Genera un par NOMBRE.h / NOMBRE.c con los glifos ya rotados al formato de la DDRAM: cada glifo se
+guarda por paginas, y en cada pagina una columna es un byte con el bit 0 arriba. Asi el driver
+copia columnas completas al buffer sin rotar bits.
+
+Si todos los glifos tienen el mismo avance y la misma caja, la fuente se genera de ancho fijo y no
+lleva tabla de glifos. Las columnas vacias a la derecha de todos los glifos se recortan y se
+reemplazan por el espaciado entre caracteres.
+
+Uso:
+    python3 tools/bdf2c.py tools/fonts/sh1106_5x7.bdf src/sh1106_font_5x7 \\
+        --first 32 --last 126 --kerning "AV:-1,VA:-1"
+"""
+
+import argparse
+import os
+import sys
+
+
+def parse_bdf(path):
+    """Devuelve (ascent, descent, glifos).
+
+    glifos es {codigo: (dwidth, w, h, xoff, yoff, filas)}, con las filas del BBX como enteros.
+    """
+    ascent = descent = None
+    bbox = None
+    glyphs = {}
+    with open(path, encoding="latin-1") as bdf:
+        lines = iter(bdf.read().splitlines())
+    for line in lines:
+        fields = line.split()
+        if not fields:
+            continue
+        if fields[0] == "FONTBOUNDINGBOX":
+            bbox = [int(v) for v in fields[1:5]]
+        elif fields[0] == "FONT_ASCENT":
+            ascent = int(fields[1])
+        elif fields[0] == "FONT_DESCENT":
+            descent = int(fields[1])
+        elif fields[0] == "STARTCHAR":
+            code = dwidth = box = None
+            rows = []
+            for line in lines:
+                fields = line.split()
+                if fields[0] == "ENCODING":
+                    code = int(fields[1])
+                elif fields[0] == "DWIDTH":
+                    dwidth = int(fields[1])
+                elif fields[0] == "BBX":
+                    box = [int(v) for v in fields[1:5]]
+                elif fields[0] == "BITMAP":
+                    for line in lines:
+                        if line.strip() == "ENDCHAR":
+                            break
+                        rows.append(int(line.strip(), 16) >> (len(line.strip()) * 4 - box[0]))
+                    break
+            if code is not None and code >= 0:
+                glyphs[code] = (dwidth, box[0], box[1], box[2], box[3], rows)
+    if ascent is None:
+        ascent = bbox[1] + bbox[3]
+    if descent is None:
+        descent = -bbox[3]
+    return ascent, descent, glyphs
+
+
+def glyph_columns(glyph, ascent, height):
+    """Columnas de la tinta del glifo, como enteros con el bit 0 en la fila superior de la celda."""
+    _, width, rows_count, _, yoff, rows = glyph
+    top = ascent - (yoff + rows_count)
+    columns = []
+    for x in range(width):
+        column = 0
+        for r, row in enumerate(rows):
+            y = top + r
+            if 0 <= y < height and row & (1 << (width - 1 - x)):
+                column |= 1 << y
+        columns.append(column)
+    return columns
+
+
+def to_pages(columns, pages):
+    """Bytes del glifo: pagina por pagina, una columna por byte."""
+    return [(column >> (8 * page)) & 0xFF for page in range(pages) for column in columns]
+
+
+def parse_kerning(text):
+    pairs = []
+    for item in filter(None, (part.strip() for part in text.split(","))):
+        chars, adjust = item.split(":")
+        if len(chars) != 2:
+            sys.exit("par de kerning invalido: " + item)
+        pairs.append((ord(chars[0]), ord(chars[1]), int(adjust)))
+    return sorted(pairs)
+
+
+def c_char(code):
+    if code == ord("'") or code == ord("\\"):
+        return "'\\%c'" % code
+    if 32 <= code < 127:
+        return "'%c'" % code
+    return "%d" % code
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("bdf", help="fuente BDF de entrada")
+    parser.add_argument("output", help="ruta de salida sin extension (se generan .h y .c)")
+    parser.add_argument("--name", help="nombre de la variable (por defecto el del archivo)")
+    parser.add_argument("--first", type=int, default=32, help="primer caracter (32)")
+    parser.add_argument("--last", type=int, default=126, help="ultimo caracter (126)")
+    parser.add_argument("--kerning", default="", help='pares de kerning, por ejemplo "AV:-1"')
+    args = parser.parse_args()
+
+    name = args.name or os.path.basename(args.output)
+    ascent, descent, glyphs = parse_bdf(args.bdf)
+    height = ascent + descent
+    if height > 32:
+        sys.exit("la fuente tiene %d filas, el maximo es 32" % height)
+    pages = (height + 7) // 8
+    codes = range(args.first, args.last + 1)
+    missing = [code for code in codes if code not in glyphs]
+    if missing:
+        sys.exit("faltan los caracteres: " + ", ".join(c_char(code) for code in missing))
+
+    columns = {code: glyph_columns(glyphs[code], ascent, height) for code in codes}
+    metrics = {(glyphs[code][0], glyphs[code][1], glyphs[code][3]) for code in codes}
+    fixed = len(metrics) == 1 and all(glyphs[code][3] == 0 for code in codes)
+
+    bitmap = []
+    table = []
+    if fixed:
+        width = glyphs[args.first][1]
+        while width > 0 and all(columns[code][width - 1] == 0 for code in codes):
+            width -= 1
+        spacing = glyphs[args.first][0] - width
+        for code in codes:
+            bitmap.append((code, to_pages(columns[code][:width], pages)))
+    else:
+        width = spacing = 0
+        offset = 0
+        for code in codes:
+            advance, ink, _, xoff, _, _ = glyphs[code]
+            data = to_pages(columns[code], pages)
+            table.append((code, offset, ink, xoff, advance))
+            bitmap.append((code, data))
+            offset += len(data)
+        if offset > 0xFFFF:
+            sys.exit("la fuente ocupa mas de 64 KiB")
+    kerning = parse_kerning(args.kerning)
+
+    guard = "INC_%s_H_" % name.upper()
+    source = os.path.basename(args.bdf)
+    header = f"""/**
+ * @file {name}.h
+ * @brief Header File - Fuente {name} para el driver SH1106
+ *
+ * Generado con tools/bdf2c.py a partir de {source}, no modificar a mano.
+ */
+
+#ifndef {guard}
+#define {guard}
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106_font.h"
+
+/* === Public variable declarations ============================================================ */
+/**
+ * @brief Fuente de {height} pixeles de alto, caracteres {c_char(args.first)} a {c_char(args.last)}.
+ */
+extern const sh1106_font_t {name};
+
+#endif /* {guard} */
+"""
+    body = [f"""/**
+ * @file {name}.c
+ * @brief Source File - Fuente {name} para el driver SH1106
+ *
+ * Generado con tools/bdf2c.py a partir de {source}, no modificar a mano.
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "{name}.h"
+
+/* === Private variable declarations =========================================================== */
+static const uint8_t {name}_bitmap[] = {{"""]
+    for code, data in bitmap:
+        text = ", ".join("0x%02X" % byte for byte in data)
+        body.append(f"    {text}, // {c_char(code)}" if data else f"    // {c_char(code)}")
+    body.append("};")
+    glyph_ref = "NULL"
+    if table:
+        body.append("")
+        body.append(f"static const sh1106_glyph_t {name}_glyphs[] = {{")
+        for code, offset, ink, xoff, advance in table:
+            body.append(f"    {{{offset}, {ink}, {xoff}, {advance}}}, // {c_char(code)}")
+        body.append("};")
+        glyph_ref = f"{name}_glyphs"
+    kerning_ref = "NULL"
+    if kerning:
+        body.append("")
+        body.append(f"static const sh1106_kerning_t {name}_kerning[] = {{")
+        for left, right, adjust in kerning:
+            body.append(f"    {{{c_char(left)}, {c_char(right)}, {adjust}}},")
+        body.append("};")
+        kerning_ref = f"{name}_kerning"
+    body.append(f"""
+/* === Public variable declarations ============================================================ */
+const sh1106_font_t {name} = {{.bitmap = {name}_bitmap,
+{"":<{len(name) + 24}}.glyphs = {glyph_ref},
+{"":<{len(name) + 24}}.kerning = {kerning_ref},
+{"":<{len(name) + 24}}.kerning_count = {len(kerning)},
+{"":<{len(name) + 24}}.first = {args.first},
+{"":<{len(name) + 24}}.last = {args.last},
+{"":<{len(name) + 24}}.width = {width},
+{"":<{len(name) + 24}}.height = {height},
+{"":<{len(name) + 24}}.spacing = {spacing}}};
+""")
+    with open(args.output + ".h", "w") as out:
+        out.write(header)
+    with open(args.output + ".c", "w") as out:
+        out.write("\n".join(body))
+
+
+if __name__ == "__main__":
+    main()
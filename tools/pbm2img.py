@@ -0,0 +1,215 @@
+#!/usr/bin/env python3
+"""Convierte una imagen PBM en una imagen comprimida del driver SH1106 (sh1106_image_t).
+
+Genera un par NOMBRE.h / NOMBRE.c con la imagen en el formato de sh1106_image.h: pagina por
+pagina, una columna de 8 pixeles por byte con el bit 0 arriba, en tramos de columnas sin comprimir
+(LITERAL), de un byte repetido (REPEAT) o iguales a la pagina anterior (COPY). Los pixeles negros
+del PBM (1) son los pixeles encendidos del display; con --invert, los blancos.
+
+Uso:
+    python3 tools/pbm2img.py splash.pbm src/splash --name splash_image
+"""
+
+import argparse
+import os
+import sys
+
+LITERAL = 0x00
+REPEAT = 0x40
+COPY = 0x80
+RUN_MAX = 64
+
+
+def read_pbm(path):
+    """Devuelve (ancho, alto, filas), con cada fila como lista de 0 y 1. Acepta P1 y P4."""
+    with open(path, "rb") as pbm:
+        data = pbm.read()
+    fields = []
+    pos = 0
+    # Cabecera: numero magico, ancho y alto, separados por blancos y comentarios.
+    while len(fields) < 3:
+        while pos < len(data) and data[pos : pos + 1].isspace():
+            pos += 1
+        if data[pos : pos + 1] == b"#":
+            while pos < len(data) and data[pos : pos + 1] != b"\n":
+                pos += 1
+            continue
+        start = pos
+        while pos < len(data) and not data[pos : pos + 1].isspace():
+            pos += 1
+        fields.append(data[start:pos].decode("ascii"))
+    magic, width, height = fields[0], int(fields[1]), int(fields[2])
+    if magic == "P4":
+        pos += 1
+        stride = (width + 7) // 8
+        rows = []
+        for y in range(height):
+            line = data[pos + y * stride : pos + (y + 1) * stride]
+            rows.append([(line[x // 8] >> (7 - x % 8)) & 1 for x in range(width)])
+        return width, height, rows
+    if magic == "P1":
+        bits = [int(c) for c in data[pos:].decode("ascii") if c in "01"]
+        return width, height, [bits[y * width : (y + 1) * width] for y in range(height)]
+    sys.exit("%s no es un PBM (P1 o P4)" % path)
+
+
+def to_pages(width, height, rows, invert):
+    """Paginas de la imagen, cada una como lista de width bytes."""
+    pages = []
+    for page in range((height + 7) // 8):
+        columns = []
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                y = 8 * page + bit
+                if y < height and rows[y][x] != invert:
+                    byte |= 1 << bit
+            columns.append(byte)
+        pages.append(columns)
+    return pages
+
+
+def encode_page(row, above):
+    """Tramos de una pagina. Se elige en cada columna el tramo mas largo entre COPY y REPEAT, y las
+    columnas en las que ninguno ahorra bytes se agrupan en tramos LITERAL."""
+    out = []
+    literal = []
+
+    def flush_literal():
+        for start in range(0, len(literal), RUN_MAX):
+            chunk = literal[start : start + RUN_MAX]
+            out.append(LITERAL | (len(chunk) - 1))
+            out.extend(chunk)
+        literal.clear()
+
+    x = 0
+    while x < len(row):
+        copy = 0
+        while x + copy < len(row) and copy < RUN_MAX and row[x + copy] == above[x + copy]:
+            copy += 1
+        repeat = 0
+        while x + repeat < len(row) and repeat < RUN_MAX and row[x + repeat] == row[x]:
+            repeat += 1
+        # COPY cuesta 1 byte y REPEAT 2: por debajo de eso conviene seguir con el literal.
+        if copy >= 2 and copy >= repeat:
+            flush_literal()
+            out.append(COPY | (copy - 1))
+            x += copy
+        elif repeat >= 3:
+            flush_literal()
+            out.extend([REPEAT | (repeat - 1), row[x]])
+            x += repeat
+        else:
+            literal.append(row[x])
+            x += 1
+    flush_literal()
+    return out
+
+
+def encode(pages, width):
+    data = []
+    above = [0] * width
+    for row in pages:
+        data.extend(encode_page(row, above))
+        above = row
+    return data
+
+
+def decode(data, width, count):
+    """Descompresion de referencia, igual a la de sh1106_image.c, para verificar la salida."""
+    pages = []
+    row = [0] * width
+    pos = 0
+    for _ in range(count):
+        row = list(row)
+        x = 0
+        while x < width:
+            header = data[pos]
+            pos += 1
+            n = (header & (RUN_MAX - 1)) + 1
+            kind = header & ~(RUN_MAX - 1)
+            if kind == LITERAL:
+                row[x : x + n] = data[pos : pos + n]
+                pos += n
+            elif kind == REPEAT:
+                row[x : x + n] = [data[pos]] * n
+                pos += 1
+            x += n
+        pages.append(row)
+    return pages
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("pbm", help="imagen PBM de entrada (P1 o P4)")
+    parser.add_argument("output", help="ruta de salida sin extension (se generan .h y .c)")
+    parser.add_argument("--name", help="nombre de la variable (por defecto el del archivo)")
+    parser.add_argument("--invert", action="store_true", help="encender los pixeles blancos")
+    args = parser.parse_args()
+
+    name = args.name or os.path.basename(args.output)
+    width, height, rows = read_pbm(args.pbm)
+    if width == 0 or width > 132 or height == 0 or height > 255:
+        sys.exit("la imagen mide %dx%d, el maximo es 132x255" % (width, height))
+    pages = to_pages(width, height, rows, args.invert)
+    data = encode(pages, width)
+    if decode(data, width, len(pages)) != pages:
+        sys.exit("error interno: la imagen comprimida no coincide con la original")
+    if len(data) > 0xFFFF:
+        sys.exit("la imagen comprimida ocupa mas de 64 KiB")
+    raw = width * len(pages)
+    print("%s: %d bytes, %d sin comprimir (%.1f %%)" % (name, len(data), raw, 100 * len(data) / raw))
+
+    guard = "INC_%s_H_" % name.upper()
+    source = os.path.basename(args.pbm)
+    header = f"""/**
+ * @file {name}.h
+ * @brief Header File - Imagen {name} para el driver SH1106
+ *
+ * Generado con tools/pbm2img.py a partir de {source}, no modificar a mano.
+ */
+
+#ifndef {guard}
+#define {guard}
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "sh1106_image.h"
+
+/* === Public variable declarations ============================================================ */
+/**
+ * @brief Imagen de {width}x{height} pixeles, {len(data)} bytes comprimida ({raw} sin comprimir).
+ */
+extern const sh1106_image_t {name};
+
+#endif /* {guard} */
+"""
+    body = [f"""/**
+ * @file {name}.c
+ * @brief Source File - Imagen {name} para el driver SH1106
+ *
+ * Generado con tools/pbm2img.py a partir de {source}, no modificar a mano.
+ */
+
+/* === Inclusion de archivos de cabecera  ====================================================== */
+#include "{name}.h"
+
+/* === Private variable declarations =========================================================== */
+static const uint8_t {name}_data[] = {{"""]
+    for start in range(0, len(data), 12):
+        body.append("    " + ", ".join("0x%02X" % byte for byte in data[start : start + 12]) + ",")
+    body.append("};")
+    body.append(f"""
+/* === Public variable declarations ============================================================ */
+const sh1106_image_t {name} = {{.data = {name}_data,
+{"":<{len(name) + 25}}.size = sizeof({name}_data),
+{"":<{len(name) + 25}}.width = {width},
+{"":<{len(name) + 25}}.height = {height}}};
+""")
+    with open(args.output + ".h", "w") as out:
+        out.write(header)
+    with open(args.output + ".c", "w") as out:
+        out.write("\n".join(body))
+
+
+if __name__ == "__main__":
+    main()